@@ -116,6 +116,14 @@ function(core_add_test_library name)
   endforeach()
 endfunction()
 
+# Add a benchmark library, and add sources to list for the benchmark executable
+function(core_add_bench_library name)
+  foreach(src IN LISTS SOURCES SUPPORTED_SOURCES HEADERS OTHERS)
+    get_filename_component(src_path "${src}" ABSOLUTE)
+    set(bench_sources "${src_path}" ${bench_sources} CACHE STRING "" FORCE)
+  endforeach()
+endfunction()
+
 # Add addon dev kit headers to main application
 # Arguments:
 #   name name of the header part to add
@@ -2456,26 +2456,28 @@ void CFileItemList::Sort(SortDescription sortDescription)
   if (m_sortIgnoreFolders)
     sortDescription.sortAttributes = (SortAttribute)((int)sortDescription.sortAttributes | SortAttributeIgnoreFolders);
 
-  const Fields fields = SortUtils::GetFieldsForSorting(sortDescription.sortBy);
-  SortItems sortItems((size_t)Size());
-  for (int index = 0; index < Size(); index++)
+  // only the sort label and flags of every item are kept for sorting, the SortItem is reused
+  CSortTable sortTable(sortDescription);
+  sortTable.Reserve(m_items.size());
+  SortItem sortItem;
+  for (const auto& item : m_items)
   {
-    sortItems[index] = std::shared_ptr<SortItem>(new SortItem);
-    m_items[index]->ToSortable(*sortItems[index], fields);
-    (*sortItems[index])[FieldId] = index;
+    sortItem.clear();
+    item->ToSortable(sortItem, sortTable.GetFields());
+    sortTable.Add(sortItem);
   }
 
   // do the sorting
-  SortUtils::Sort(sortDescription, sortItems);
+  const std::vector<size_t> order = sortTable.Sort();
 
   // apply the new order to the existing CFileItems
   VECFILEITEMS sortedFileItems;
-  sortedFileItems.reserve(Size());
-  for (SortItems::const_iterator it = sortItems.begin(); it != sortItems.end(); ++it)
+  sortedFileItems.reserve(order.size());
+  for (size_t index : order)
   {
-    CFileItemPtr item = m_items[(int)(*it)->at(FieldId).asInteger()];
+    CFileItemPtr item = m_items[index];
     // Set the sort label in the CFileItem
-    item->SetSortLabel((*it)->at(FieldSort).asWideString());
+    item->SetSortLabel(sortTable.GetSortLabel(index));
 
     sortedFileItems.push_back(item);
   }
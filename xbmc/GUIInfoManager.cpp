@@ -17,6 +17,7 @@
 #include "cores/DataCacheCore.h"
 #include "filesystem/File.h"
 #include "games/tags/GameInfoTag.h"
+#include "guilib/GUIFrameProfiler.h"
 #include "guilib/guiinfo/GUIInfo.h"
 #include "guilib/guiinfo/GUIInfoHelper.h"
 #include "guilib/guiinfo/GUIInfoLabels.h"
@@ -1050,6 +1051,15 @@ const infomap player_times[] =   {{ "seektime",         PLAYER_SEEKTIME },
 ///     @skinning_v17 **[New Infolabel]** \link Player_Process_videodecoder `Player.Process(videodecoder)`\endlink
 ///     <p>
 ///   }
+///   \table_row3{   <b>`Player.Process(videodecoderthreads)`</b>,
+///                  \anchor Player_Process_videodecoderthreads
+///                  _string_,
+///     @return The threading of the software video decoder of the currently playing video,
+///     e.g. **frame, 6 threads**. Empty for decoders that don't report it.
+///     <p><hr>
+///     @skinning_v21 **[New Infolabel]** \link Player_Process_videodecoderthreads `Player.Process(videodecoderthreads)`\endlink
+///     <p>
+///   }
 ///   \table_row3{   <b>`Player.Process(deintmethod)`</b>,
 ///                  \anchor Player_Process_deintmethod
 ///                  _string_,
@@ -1154,7 +1164,8 @@ const infomap player_process[] = {{"videodecoder", PLAYER_PROCESS_VIDEODECODER},
                                   {"audiochannels", PLAYER_PROCESS_AUDIOCHANNELS},
                                   {"audiosamplerate", PLAYER_PROCESS_AUDIOSAMPLERATE},
                                   {"audiobitspersample", PLAYER_PROCESS_AUDIOBITSPERSAMPLE},
-                                  {"videoscantype", PLAYER_PROCESS_VIDEOSCANTYPE}};
+                                  {"videoscantype", PLAYER_PROCESS_VIDEOSCANTYPE},
+                                  {"videodecoderthreads", PLAYER_PROCESS_VIDEODECODERTHREADS}};
 
 /// \page modules__infolabels_boolean_conditions
 /// \subsection modules__infolabels_boolean_conditions_Weather Weather
@@ -10648,6 +10659,8 @@ TIME_FORMAT CGUIInfoManager::TranslateTimeFormat(const std::string &format)
 
 std::string CGUIInfoManager::GetLabel(int info, int contextWindow, std::string *fallback) const
 {
+  CGUIFrameProfilerScope profilerScope(CGUIFrameProfiler::Category::INFO, "Label");
+
   if (info >= CONDITIONAL_LABEL_START && info <= CONDITIONAL_LABEL_END)
   {
     return GetSkinVariableString(info, contextWindow, false);
@@ -10973,6 +10986,8 @@ std::string CGUIInfoManager::GetMultiInfoLabel(const CGUIInfo &constinfo, int co
 /// \brief Obtains the filename of the image to show from whichever subsystem is needed
 std::string CGUIInfoManager::GetImage(int info, int contextWindow, std::string *fallback)
 {
+  CGUIFrameProfilerScope profilerScope(CGUIFrameProfiler::Category::INFO, "Image");
+
   if (info >= CONDITIONAL_LABEL_START && info <= CONDITIONAL_LABEL_END)
   {
     return GetSkinVariableString(info, contextWindow, true);
@@ -43,6 +43,7 @@
 #include "filesystem/File.h"
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIControlProfiler.h"
+#include "guilib/GUIFrameProfiler.h"
 #include "guilib/GUIFontManager.h"
 #include "guilib/StereoscopicsManager.h"
 #include "guilib/TextureManager.h"
@@ -918,6 +919,8 @@ void CApplication::Render()
 
   CServiceBroker::GetRenderSystem()->EndRender();
 
+  CGUIFrameProfiler::Instance().EndFrame();
+
   // reset our info cache - we do this at the end of Render so that it is
   // fresh for the next process(), or after a windowclose animation (where process()
   // isn't called)
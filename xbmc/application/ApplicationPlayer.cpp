@@ -974,6 +974,15 @@ bool CApplicationPlayer::RenderCaptureGetPixels(unsigned int captureId, unsigned
     return false;
 }
 
+bool CApplicationPlayer::GetRenderPacingStats(CVariant& stats, bool records, bool reset)
+{
+  std::shared_ptr<IPlayer> player = GetInternal();
+  if (player)
+    return player->GetRenderPacingStats(stats, records, reset);
+  else
+    return false;
+}
+
 bool CApplicationPlayer::IsExternalPlaying() const
 {
   const std::shared_ptr<const IPlayer> player = GetInternal();
@@ -67,6 +67,7 @@ public:
   void RenderCapture(unsigned int captureId, unsigned int width, unsigned int height, int flags = 0);
   void RenderCaptureRelease(unsigned int captureId);
   bool RenderCaptureGetPixels(unsigned int captureId, unsigned int millis, uint8_t *buffer, unsigned int size);
+  bool GetRenderPacingStats(CVariant& stats, bool records, bool reset);
   bool IsExternalPlaying() const;
   bool IsRemotePlaying() const;
 
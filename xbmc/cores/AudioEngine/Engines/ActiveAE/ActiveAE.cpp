@@ -19,6 +19,7 @@ using namespace ActiveAE;
 #include "cores/AudioEngine/AEResampleFactory.h"
 #include "cores/AudioEngine/Encoders/AEEncoderFFmpeg.h"
 #include "cores/AudioEngine/Interfaces/IAudioCallback.h"
+#include "cores/AudioEngine/Utils/AEKernels.h"
 #include "cores/AudioEngine/Utils/AEStreamData.h"
 #include "cores/AudioEngine/Utils/AEStreamInfo.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
@@ -117,6 +118,7 @@ void CEngineStats::UpdateStream(CActiveAEStream *stream)
       {
         str.m_resampleRatio = stream->m_processingBuffers->GetRR();
         delay += stream->m_processingBuffers->GetDelay();
+        stream->m_processingBuffers->GetBufferStats(str.m_bufferStats);
       }
       else
       {
@@ -171,6 +173,26 @@ void CEngineStats::GetDelay(AEDelayStatus& status, CActiveAEStream *stream)
 }
 
 // this is used to sync a/v so we need to add sink latency here
+void CEngineStats::GetBufferStats(CAEBufferStats& stats, CActiveAEStream* stream)
+{
+  std::unique_lock<CCriticalSection> lock(m_lock);
+  for (const auto& str : m_streamStats)
+  {
+    if (str.m_streamId == stream->m_id)
+    {
+      stats = str.m_bufferStats;
+      break;
+    }
+  }
+  stats.sink = m_sinkBufferStats;
+}
+
+void CEngineStats::UpdateSinkBufferStats(const CAEBufferStats::Stage& stats)
+{
+  std::unique_lock<CCriticalSection> lock(m_lock);
+  m_sinkBufferStats = stats;
+}
+
 void CEngineStats::GetSyncInfo(CAESyncInfo& info, CActiveAEStream *stream)
 {
   std::unique_lock<CCriticalSection> lock(m_lock);
@@ -2117,15 +2139,7 @@ bool CActiveAE::RunStages()
 
               for(int j=0; j<out->pkt->planes; j++)
               {
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulArray((float*)out->pkt->data[j]+i*nb_floats, volume, nb_floats);
-#else
-                float* fbuffer = (float*) out->pkt->data[j]+i*nb_floats;
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  fbuffer[k] *= volume;
-                }
-#endif
+                CAEKernels::Get().Mul((float*)out->pkt->data[j] + i * nb_floats, volume, nb_floats);
               }
             }
           }
@@ -2186,24 +2200,10 @@ bool CActiveAE::RunStages()
               {
                 float *dst = (float*)out->pkt->data[j]+i*nb_floats;
                 float *src = (float*)mix->pkt->data[j]+i*nb_floats;
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulAddArray(dst, src, volume, nb_floats);
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  if (fabs(dst[k]) > 1.0f)
-                  {
-                    needClamp = true;
-                    break;
-                  }
-                }
-#else
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  dst[k] += src[k] * volume;
-                  if (fabs(dst[k]) > 1.0f)
-                    needClamp = true;
-                }
-#endif
+                const AEKernelSet& kernels = CAEKernels::Get();
+                kernels.MulAdd(dst, src, volume, nb_floats);
+                if (!needClamp && kernels.Peak(dst, nb_floats) > 1.0f)
+                  needClamp = true;
               }
             }
             mix->Return();
@@ -2337,6 +2337,7 @@ bool CActiveAE::RunStages()
 
   // serve sink buffers
   busy |= m_sinkBuffers->ResampleBuffers();
+  m_stats.UpdateSinkBufferStats(m_sinkBuffers->m_bufferStats);
   while(!m_sinkBuffers->m_outputSamples.empty())
   {
     CSampleBuffer *out = NULL;
@@ -2592,12 +2593,7 @@ void CActiveAE::MixSounds(CSoundPacket &dstSample)
       out = (float*)dstSample.data[j];
       sample_buffer = (float*)(it->sound->GetSound(false)->data[j]+start);
       int nb_floats = mix_samples * dstSample.config.channels / dstSample.planes;
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulAddArray(out, sample_buffer, volume, nb_floats);
-#else
-      for (int k = 0; k < nb_floats; ++k)
-        *out++ += *sample_buffer++ * volume;
-#endif
+      CAEKernels::Get().MulAdd(out, sample_buffer, volume, nb_floats);
     }
 
     it->samples_played += mix_samples;
@@ -2622,13 +2618,7 @@ void CActiveAE::Deamplify(CSoundPacket &dstSample)
     for(int j=0; j<dstSample.planes; j++)
     {
       float* buffer = reinterpret_cast<float*>(dstSample.data[j]);
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulArray(buffer, volume, nb_floats);
-#else
-      float *fbuffer = buffer;
-      for (int i = 0; i < nb_floats; i++)
-        *fbuffer++ *= volume;
-#endif
+      CAEKernels::Get().Mul(buffer, volume, nb_floats);
     }
   }
 }
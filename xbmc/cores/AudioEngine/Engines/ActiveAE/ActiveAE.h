@@ -191,6 +191,8 @@ public:
   void UpdateStream(CActiveAEStream *stream);
   void GetDelay(AEDelayStatus& status, CActiveAEStream *stream);
   void GetSyncInfo(CAESyncInfo& info, CActiveAEStream *stream);
+  void GetBufferStats(CAEBufferStats& stats, CActiveAEStream* stream);
+  void UpdateSinkBufferStats(const CAEBufferStats::Stage& stats);
   float GetCacheTime(CActiveAEStream *stream);
   float GetCacheTotal();
   float GetMaxDelay() const;
@@ -212,6 +214,7 @@ protected:
   AEAudioFormat m_sinkFormat;
   bool m_pcmOutput;
   bool m_sinkNeedIecPack{false};
+  CAEBufferStats::Stage m_sinkBufferStats;
   CCriticalSection m_lock;
   struct StreamStats
   {
@@ -221,6 +224,7 @@ protected:
     double m_syncError;
     unsigned int m_errorTime;
     CAESyncInfo::AESyncState m_syncState;
+    CAEBufferStats m_bufferStats;
   };
   std::vector<StreamStats> m_streamStats;
 };
@@ -286,6 +290,10 @@ protected:
   static void FreeSoundSample(uint8_t **data);
   void GetDelay(AEDelayStatus& status, CActiveAEStream *stream) { m_stats.GetDelay(status, stream); }
   void GetSyncInfo(CAESyncInfo& info, CActiveAEStream *stream) { m_stats.GetSyncInfo(info, stream); }
+  void GetBufferStats(CAEBufferStats& stats, CActiveAEStream* stream)
+  {
+    m_stats.GetBufferStats(stats, stream);
+  }
   float GetCacheTime(CActiveAEStream *stream) { return m_stats.GetCacheTime(stream); }
   float GetCacheTotal() { return m_stats.GetCacheTotal(); }
   float GetMaxDelay() { return m_stats.GetMaxDelay(); }
@@ -153,6 +153,13 @@ bool CActiveAEBufferPoolResample::Create(unsigned int totaltime, bool remap, boo
   if ((m_format.m_channelLayout.Count() < m_inputFormat.m_channelLayout.Count() && !normalize))
     m_normalize = false;
 
+  // formats carried in a wider container are packed by the resampler
+  m_sameFormat = m_inputFormat.m_channelLayout == m_format.m_channelLayout &&
+                 m_inputFormat.m_sampleRate == m_format.m_sampleRate &&
+                 m_inputFormat.m_dataFormat == m_format.m_dataFormat &&
+                 CAEUtil::DataFormatToUsedBits(m_format.m_dataFormat) ==
+                     CAEUtil::DataFormatToBits(m_format.m_dataFormat);
+
   if (m_inputFormat.m_channelLayout != m_format.m_channelLayout ||
       m_inputFormat.m_sampleRate != m_format.m_sampleRate ||
       m_inputFormat.m_dataFormat != m_format.m_dataFormat ||
@@ -215,6 +222,23 @@ bool CActiveAEBufferPoolResample::ResampleBuffers(int64_t timestamp)
         in->timestamp = timestamp;
       }
       m_outputSamples.push_back(in);
+      m_bufferStats.forwarded++;
+      busy = true;
+    }
+  }
+  else if (!m_inputSamples.empty() && CanForward(*m_inputSamples.front()))
+  {
+    // the resampler would only copy the samples, hand on the buffers instead
+    while (!m_inputSamples.empty() && CanForward(*m_inputSamples.front()))
+    {
+      in = m_inputSamples.front();
+      m_inputSamples.pop_front();
+      if (timestamp)
+      {
+        in->timestamp = timestamp;
+      }
+      m_outputSamples.push_back(in);
+      m_bufferStats.forwarded++;
       busy = true;
     }
   }
@@ -342,12 +366,24 @@ bool CActiveAEBufferPoolResample::ResampleBuffers(int64_t timestamp)
       }
 
       if (in)
+      {
+        m_bufferStats.copied++;
         in->Return();
+      }
     }
   }
   return busy;
 }
 
+bool CActiveAEBufferPoolResample::CanForward(const CSampleBuffer& in) const
+{
+  // samples still buffered in the resampler or a partly filled packet must
+  // go out first, a changed ratio or filling up packets needs the resampler
+  return m_sameFormat && m_resampleRatio == 1.0 && !m_changeResampler && !m_fillPackets &&
+         !m_procSample && in.centerMixLevel == m_centerMixLevel &&
+         m_resampler->GetBufferedSamples() == 0;
+}
+
 void CActiveAEBufferPoolResample::ConfigureResampler(bool normalizelevels, bool stereoupmix, AEQuality quality)
 {
   bool normalize = true;
@@ -497,6 +533,7 @@ bool CActiveAEBufferPoolAtempo::ProcessBuffers()
       in = m_inputSamples.front();
       m_inputSamples.pop_front();
       m_outputSamples.push_back(in);
+      m_bufferStats.forwarded++;
       busy = true;
     }
   }
@@ -607,7 +644,10 @@ bool CActiveAEBufferPoolAtempo::ProcessBuffers()
       }
 
       if (in)
+      {
+        m_bufferStats.copied++;
         in->Return();
+      }
     }
   }
   return busy;
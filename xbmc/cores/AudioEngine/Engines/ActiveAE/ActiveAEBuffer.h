@@ -10,6 +10,7 @@
 
 #include "cores/AudioEngine/Utils/AEAudioFormat.h"
 #include "cores/AudioEngine/Interfaces/AE.h"
+#include "cores/AudioEngine/Interfaces/AEStream.h"
 #include <cmath>
 #include <deque>
 #include <memory>
@@ -68,6 +69,7 @@ public:
   AEAudioFormat m_format;
   std::deque<CSampleBuffer*> m_allSamples;
   std::deque<CSampleBuffer*> m_freeSamples;
+  CAEBufferStats::Stage m_bufferStats;
 };
 
 class IAEResample;
@@ -95,12 +97,14 @@ public:
 
 protected:
   void ChangeResampler();
+  bool CanForward(const CSampleBuffer& in) const;
 
   uint8_t *m_planes[16];
   bool m_empty = true;
   bool m_drain = false;
   int64_t m_lastSamplePts = 0;
   bool m_remap = false;
+  bool m_sameFormat = false;
   CSampleBuffer *m_procSample = nullptr;
   std::unique_ptr<IAEResample> m_resampler;
   double m_resampleRatio = 1.0;
@@ -6,10 +6,14 @@
  *  See LICENSES/README.md for more information.
  */
 
+#include "cores/AudioEngine/Utils/AEKernels.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "ActiveAEResampleFFMPEG.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <cstring>
+
 extern "C" {
 #include <libavutil/channel_layout.h>
 #include <libavutil/opt.h>
@@ -18,6 +22,54 @@ extern "C" {
 
 using namespace ActiveAE;
 
+namespace
+{
+
+bool IsKernelFormat(AVSampleFormat fmt)
+{
+  switch (av_get_packed_sample_fmt(fmt))
+  {
+    case AV_SAMPLE_FMT_FLT:
+    case AV_SAMPLE_FMT_S16:
+    case AV_SAMPLE_FMT_S32:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// The AE kernels convert between float and integer samples and change the packing of float
+// samples, anything else is left to swresample
+bool CanConvert(AVSampleFormat dstFmt, AVSampleFormat srcFmt)
+{
+  if (dstFmt == srcFmt)
+    return true;
+
+  if (!IsKernelFormat(dstFmt) || !IsKernelFormat(srcFmt))
+    return false;
+
+  return av_get_packed_sample_fmt(dstFmt) == AV_SAMPLE_FMT_FLT ||
+         av_get_packed_sample_fmt(srcFmt) == AV_SAMPLE_FMT_FLT;
+}
+
+// Converts count samples of packed formats, one of them is float
+void ConvertSamples(void* dst, AVSampleFormat dstFmt, const void* src, AVSampleFormat srcFmt, uint32_t count)
+{
+  const AEKernelSet& kernels = CAEKernels::Get();
+  if (srcFmt == AV_SAMPLE_FMT_S16)
+    kernels.S16ToFloat(static_cast<float*>(dst), static_cast<const int16_t*>(src), count);
+  else if (srcFmt == AV_SAMPLE_FMT_S32)
+    kernels.S32ToFloat(static_cast<float*>(dst), static_cast<const int32_t*>(src), count);
+  else if (dstFmt == AV_SAMPLE_FMT_S16)
+    kernels.FloatToS16(static_cast<int16_t*>(dst), static_cast<const float*>(src), count);
+  else if (dstFmt == AV_SAMPLE_FMT_S32)
+    kernels.FloatToS32(static_cast<int32_t*>(dst), static_cast<const float*>(src), count);
+  else
+    memcpy(dst, src, count * sizeof(float));
+}
+
+} // namespace
+
 CActiveAEResampleFFMPEG::CActiveAEResampleFFMPEG()
 {
   m_pContext = NULL;
@@ -63,6 +115,11 @@ bool CActiveAEResampleFFMPEG::Init(SampleConfig dstConfig, SampleConfig srcConfi
     av_channel_layout_uninit(&layout);
   }
 
+  // plain sample format conversions don't need swresample
+  m_convertOnly = !force_resample && !remapLayout && m_src_rate == m_dst_rate &&
+                  m_src_chan_layout == m_dst_chan_layout && m_src_channels == m_dst_channels &&
+                  m_src_channels <= AE_CH_MAX && CanConvert(m_dst_fmt, m_src_fmt);
+
   AVChannelLayout dstChLayout = {};
   AVChannelLayout srcChLayout = {};
 
@@ -208,8 +265,29 @@ int CActiveAEResampleFFMPEG::Resample(uint8_t **dst_buffer, int dst_samples, uin
     }
   }
 
-  //! @bug libavresample isn't const correct
-  int ret = swr_convert(m_pContext, dst_buffer, dst_samples, const_cast<const uint8_t**>(src_buffer), src_samples);
+  if (m_doesResample && m_pendingSamples > 0)
+  {
+    // hand the samples kept by Convert() over to swresample
+    uint8_t* pending[AE_CH_MAX];
+    for (size_t i = 0; i < m_pending.size(); i++)
+      pending[i] = m_pending[i].data();
+    if (swr_convert(m_pContext, nullptr, 0, const_cast<const uint8_t**>(pending), m_pendingSamples) < 0)
+    {
+      CLog::Log(LOGERROR, "CActiveAEResampleFFMPEG::Resample - resample failed");
+      return -1;
+    }
+    m_pending.clear();
+    m_pendingSamples = 0;
+  }
+
+  int ret;
+  if (m_convertOnly && !m_doesResample)
+    ret = Convert(dst_buffer, dst_samples, src_buffer, src_samples);
+  else
+  {
+    //! @bug libavresample isn't const correct
+    ret = swr_convert(m_pContext, dst_buffer, dst_samples, const_cast<const uint8_t**>(src_buffer), src_samples);
+  }
   if (ret < 0)
   {
     CLog::Log(LOGERROR, "CActiveAEResampleFFMPEG::Resample - resample failed");
@@ -269,13 +347,146 @@ int CActiveAEResampleFFMPEG::Resample(uint8_t **dst_buffer, int dst_samples, uin
   return ret;
 }
 
+int CActiveAEResampleFFMPEG::Convert(uint8_t** dst_buffer, int dst_samples, uint8_t** src_buffer, int src_samples)
+{
+  const int planes = av_sample_fmt_is_planar(m_src_fmt) ? m_src_channels : 1;
+  const size_t frameSize = static_cast<size_t>(av_get_bytes_per_sample(m_src_fmt)) *
+                           (m_src_channels / planes);
+
+  // like swresample, keep what doesn't fit into dst for the next call
+  if (m_pendingSamples > 0 && src_samples > 0)
+  {
+    for (int i = 0; i < planes; i++)
+      m_pending[i].insert(m_pending[i].end(), src_buffer[i],
+                          src_buffer[i] + src_samples * frameSize);
+    m_pendingSamples += src_samples;
+  }
+
+  if (m_pendingSamples > 0)
+  {
+    const int samples = std::min(dst_samples, m_pendingSamples);
+    if (samples <= 0)
+      return 0;
+
+    uint8_t* pending[AE_CH_MAX];
+    for (int i = 0; i < planes; i++)
+      pending[i] = m_pending[i].data();
+    ConvertFrames(dst_buffer, pending, samples);
+
+    for (int i = 0; i < planes; i++)
+      m_pending[i].erase(m_pending[i].begin(), m_pending[i].begin() + samples * frameSize);
+    m_pendingSamples -= samples;
+    return samples;
+  }
+
+  const int samples = std::max(std::min(dst_samples, src_samples), 0);
+  if (samples > 0)
+    ConvertFrames(dst_buffer, src_buffer, samples);
+
+  if (src_samples > samples)
+  {
+    m_pending.resize(planes);
+    for (int i = 0; i < planes; i++)
+      m_pending[i].assign(src_buffer[i] + samples * frameSize,
+                          src_buffer[i] + src_samples * frameSize);
+    m_pendingSamples = src_samples - samples;
+  }
+
+  return samples;
+}
+
+void CActiveAEResampleFFMPEG::ConvertFrames(uint8_t** dst_buffer, uint8_t* const* src_buffer, int samples)
+{
+  const uint32_t frames = samples;
+  const uint32_t channels = m_src_channels;
+  const bool srcPlanar = av_sample_fmt_is_planar(m_src_fmt);
+  const bool dstPlanar = av_sample_fmt_is_planar(m_dst_fmt);
+  const AVSampleFormat srcFmt = av_get_packed_sample_fmt(m_src_fmt);
+  const AVSampleFormat dstFmt = av_get_packed_sample_fmt(m_dst_fmt);
+
+  // same packing, convert plane by plane
+  if (srcPlanar == dstPlanar)
+  {
+    const uint32_t planes = srcPlanar ? channels : 1;
+    const uint32_t count = srcPlanar ? frames : frames * channels;
+    for (uint32_t i = 0; i < planes; i++)
+    {
+      if (srcFmt == dstFmt)
+        memcpy(dst_buffer[i], src_buffer[i], count * av_get_bytes_per_sample(srcFmt));
+      else
+        ConvertSamples(dst_buffer[i], dstFmt, src_buffer[i], srcFmt, count);
+    }
+    return;
+  }
+
+  // the packing changes, integer samples go through float first or come from float last
+  const AEKernelSet& kernels = CAEKernels::Get();
+  if (srcFmt != AV_SAMPLE_FMT_FLT || dstFmt != AV_SAMPLE_FMT_FLT)
+    m_convertBuffer.resize(frames * channels);
+
+  float* planes[AE_CH_MAX];
+  if (srcPlanar)
+  {
+    for (uint32_t c = 0; c < channels; c++)
+    {
+      if (srcFmt == AV_SAMPLE_FMT_FLT)
+        planes[c] = reinterpret_cast<float*>(src_buffer[c]);
+      else
+      {
+        planes[c] = m_convertBuffer.data() + c * frames;
+        ConvertSamples(planes[c], AV_SAMPLE_FMT_FLT, src_buffer[c], srcFmt, frames);
+      }
+    }
+
+    if (dstFmt == AV_SAMPLE_FMT_FLT)
+      kernels.Interleave(reinterpret_cast<float*>(dst_buffer[0]), planes, channels, frames);
+    else
+    {
+      kernels.Interleave(m_convertBuffer.data(), planes, channels, frames);
+      ConvertSamples(dst_buffer[0], dstFmt, m_convertBuffer.data(), AV_SAMPLE_FMT_FLT,
+                     frames * channels);
+    }
+  }
+  else
+  {
+    const float* packed = reinterpret_cast<const float*>(src_buffer[0]);
+    if (srcFmt != AV_SAMPLE_FMT_FLT)
+    {
+      ConvertSamples(m_convertBuffer.data(), AV_SAMPLE_FMT_FLT, src_buffer[0], srcFmt,
+                     frames * channels);
+      packed = m_convertBuffer.data();
+    }
+
+    for (uint32_t c = 0; c < channels; c++)
+    {
+      if (dstFmt == AV_SAMPLE_FMT_FLT)
+        planes[c] = reinterpret_cast<float*>(dst_buffer[c]);
+      else
+        planes[c] = m_convertBuffer.data() + c * frames;
+    }
+    kernels.Deinterleave(planes, packed, channels, frames);
+
+    if (dstFmt != AV_SAMPLE_FMT_FLT)
+    {
+      for (uint32_t c = 0; c < channels; c++)
+        ConvertSamples(dst_buffer[c], dstFmt, planes[c], AV_SAMPLE_FMT_FLT, frames);
+    }
+  }
+}
+
 int64_t CActiveAEResampleFFMPEG::GetDelay(int64_t base)
 {
+  if (m_pendingSamples > 0)
+    return av_rescale_rnd(m_pendingSamples, base, m_src_rate, AV_ROUND_UP);
+
   return swr_get_delay(m_pContext, base);
 }
 
 int CActiveAEResampleFFMPEG::GetBufferedSamples()
 {
+  if (m_pendingSamples > 0)
+    return m_pendingSamples;
+
   return av_rescale_rnd(swr_get_delay(m_pContext, m_src_rate),
                                     m_dst_rate, m_src_rate, AV_ROUND_UP);
 }
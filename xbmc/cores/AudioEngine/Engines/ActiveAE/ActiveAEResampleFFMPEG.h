@@ -12,6 +12,8 @@
 #include "cores/AudioEngine/Interfaces/AE.h"
 #include "cores/AudioEngine/Interfaces/AEResample.h"
 
+#include <vector>
+
 extern "C" {
 #include <libavutil/samplefmt.h>
 }
@@ -38,6 +40,13 @@ public:
   int GetDstBufferSize(int samples) override;
 
 protected:
+  /*!
+   * \brief Converts sample format and packing with the AE kernels, for conversions
+   * without resampling or rematrixing
+   */
+  int Convert(uint8_t** dst_buffer, int dst_samples, uint8_t** src_buffer, int src_samples);
+  void ConvertFrames(uint8_t** dst_buffer, uint8_t* const* src_buffer, int samples);
+
   bool m_loaded;
   bool m_doesResample;
   uint64_t m_src_chan_layout, m_dst_chan_layout;
@@ -48,6 +57,10 @@ protected:
   int m_src_dither_bits, m_dst_dither_bits;
   SwrContext *m_pContext;
   double m_rematrix[AE_CH_MAX][AE_CH_MAX];
+  bool m_convertOnly = false;
+  std::vector<float> m_convertBuffer;
+  std::vector<std::vector<uint8_t>> m_pending; // source samples which didn't fit into dst
+  int m_pendingSamples = 0;
 };
 
 }
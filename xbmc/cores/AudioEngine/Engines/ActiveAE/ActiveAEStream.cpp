@@ -354,6 +354,13 @@ CAESyncInfo CActiveAEStream::GetSyncInfo()
   return info;
 }
 
+CAEBufferStats CActiveAEStream::GetBufferStats()
+{
+  CAEBufferStats stats;
+  m_activeAE->GetBufferStats(stats, this);
+  return stats;
+}
+
 bool CActiveAEStream::IsBuffering()
 {
   std::unique_lock<CCriticalSection> lock(m_streamLock);
@@ -752,6 +759,14 @@ void CActiveAEStreamBuffers::ForceResampler(bool force)
   m_resampleBuffers->ForceResampler(force);
 }
 
+void CActiveAEStreamBuffers::GetBufferStats(CAEBufferStats& stats) const
+{
+  if (m_resampleBuffers)
+    stats.resample = m_resampleBuffers->m_bufferStats;
+  if (m_atempoBuffers)
+    stats.atempo = m_atempoBuffers->m_bufferStats;
+}
+
 std::unique_ptr<CActiveAEBufferPool> CActiveAEStreamBuffers::GetResampleBuffers()
 {
   return std::move(m_resampleBuffers);
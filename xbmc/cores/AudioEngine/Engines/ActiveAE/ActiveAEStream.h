@@ -110,6 +110,7 @@ public:
   void FillBuffer();
   bool DoesNormalize();
   void ForceResampler(bool force);
+  void GetBufferStats(CAEBufferStats& stats) const;
   bool HasWork();
   std::unique_ptr<CActiveAEBufferPool> GetResampleBuffers();
   std::unique_ptr<CActiveAEBufferPool> GetAtempoBuffers();
@@ -148,6 +149,7 @@ public:
   unsigned int AddData(const uint8_t* const *data, unsigned int offset, unsigned int frames, ExtData *extData) override;
   double GetDelay() override;
   CAESyncInfo GetSyncInfo() override;
+  CAEBufferStats GetBufferStats() override;
   bool IsBuffering() override;
   double GetCacheTime() override;
   double GetCacheTotal() override;
@@ -46,6 +46,23 @@ public:
   AESyncState state;
 };
 
+/**
+ * Number of buffers each processing stage of a stream had to copy, and of
+ * those it handed on untouched because there was nothing to convert
+ */
+class CAEBufferStats
+{
+public:
+  struct Stage
+  {
+    uint64_t copied = 0;
+    uint64_t forwarded = 0;
+  };
+  Stage resample;
+  Stage atempo;
+  Stage sink;
+};
+
 /**
  * IAEStream Stream Interface for streaming audio
  */
@@ -94,6 +111,12 @@ public:
    */
   virtual CAESyncInfo GetSyncInfo() = 0;
 
+  /**
+   * Returns copy counters of the processing stages, for debugging
+   * @return CAEBufferStats
+   */
+  virtual CAEBufferStats GetBufferStats() { return {}; }
+
   /**
    * Returns if the stream is buffering
    * @return True if the stream is buffering
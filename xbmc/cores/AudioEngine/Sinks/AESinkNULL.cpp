@@ -0,0 +1,240 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AESinkNULL.h"
+
+#include "cores/AudioEngine/AESinkFactory.h"
+#include "cores/AudioEngine/Utils/AEUtil.h"
+#include "threads/CriticalSection.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+using namespace std::chrono;
+
+namespace
+{
+constexpr unsigned int PERIOD_MS = 20;
+constexpr unsigned int BUFFER_PERIODS = 4;
+
+const unsigned int sampleRates[] = {44100, 48000, 88200, 96000, 176400, 192000};
+const AEDataFormat dataFormats[] = {AE_FMT_FLOAT, AE_FMT_S32NE, AE_FMT_S16NE};
+
+CCriticalSection statsSection;
+CAESinkNULL::PeriodStats periodStats;
+
+double ToMilliseconds(steady_clock::duration duration)
+{
+  return duration_cast<microseconds>(duration).count() / 1000.0;
+}
+} // namespace
+
+CAESinkNULL::~CAESinkNULL()
+{
+  Deinitialize();
+}
+
+void CAESinkNULL::Register()
+{
+  AE::AESinkRegEntry entry;
+  entry.sinkName = "NULL";
+  entry.createFunc = CAESinkNULL::Create;
+  entry.enumerateFunc = CAESinkNULL::EnumerateDevicesEx;
+  AE::CAESinkFactory::RegisterSink(entry);
+}
+
+std::unique_ptr<IAESink> CAESinkNULL::Create(std::string& device, AEAudioFormat& desiredFormat)
+{
+  auto sink = std::make_unique<CAESinkNULL>();
+  if (sink->Initialize(desiredFormat, device))
+    return sink;
+
+  return {};
+}
+
+void CAESinkNULL::EnumerateDevicesEx(AEDeviceInfoList& list, bool force)
+{
+  for (const bool realtime : {true, false})
+  {
+    CAEDeviceInfo info;
+    info.m_deviceName = realtime ? "realtime" : "fast";
+    info.m_displayName = realtime ? "Null (device clock)" : "Null (unthrottled)";
+    info.m_deviceType = AE_DEVTYPE_HDMI;
+    info.m_channels = AE_CH_LAYOUT_7_1;
+    info.m_sampleRates.assign(std::begin(sampleRates), std::end(sampleRates));
+    info.m_dataFormats.assign(std::begin(dataFormats), std::end(dataFormats));
+    info.m_dataFormats.push_back(AE_FMT_RAW);
+    info.m_streamTypes = {CAEStreamInfo::STREAM_TYPE_AC3,        CAEStreamInfo::STREAM_TYPE_EAC3,
+                          CAEStreamInfo::STREAM_TYPE_DTS_512,    CAEStreamInfo::STREAM_TYPE_DTS_1024,
+                          CAEStreamInfo::STREAM_TYPE_DTS_2048,   CAEStreamInfo::STREAM_TYPE_DTSHD_CORE,
+                          CAEStreamInfo::STREAM_TYPE_DTSHD,      CAEStreamInfo::STREAM_TYPE_DTSHD_MA,
+                          CAEStreamInfo::STREAM_TYPE_TRUEHD};
+    info.m_wantsIECPassthrough = true;
+    list.push_back(info);
+  }
+}
+
+CAESinkNULL::PeriodStats CAESinkNULL::GetPeriodStats()
+{
+  std::unique_lock<CCriticalSection> lock(statsSection);
+  return periodStats;
+}
+
+void CAESinkNULL::ResetPeriodStats()
+{
+  std::unique_lock<CCriticalSection> lock(statsSection);
+  periodStats = {};
+}
+
+bool CAESinkNULL::Initialize(AEAudioFormat& format, std::string& device)
+{
+  m_realtime = device != "fast";
+
+  if (format.m_dataFormat == AE_FMT_RAW)
+  {
+    // rate and layout were set up by the iec packer, bursts are written as 16 bit samples
+    format.m_frameSize = format.m_channelLayout.Count() * 2;
+  }
+  else
+  {
+    if (std::find(std::begin(dataFormats), std::end(dataFormats), format.m_dataFormat) ==
+        std::end(dataFormats))
+      format.m_dataFormat = AE_FMT_FLOAT;
+    if (std::find(std::begin(sampleRates), std::end(sampleRates), format.m_sampleRate) ==
+        std::end(sampleRates))
+      format.m_sampleRate = 48000;
+    if (format.m_channelLayout.Count() > 8 || format.m_channelLayout.Count() == 0)
+      format.m_channelLayout = AE_CH_LAYOUT_7_1;
+
+    format.m_frameSize =
+        format.m_channelLayout.Count() * (CAEUtil::DataFormatToBits(format.m_dataFormat) >> 3);
+  }
+
+  if (format.m_sampleRate == 0 || format.m_frameSize == 0)
+  {
+    CLog::Log(LOGERROR, "CAESinkNULL::Initialize - invalid format");
+    return false;
+  }
+
+  format.m_frames = format.m_sampleRate * PERIOD_MS / 1000;
+  m_format = format;
+  m_bufferFrames = static_cast<uint64_t>(format.m_frames) * BUFFER_PERIODS;
+  m_written = 0;
+  m_lastPeriod = {};
+
+  CLog::Log(LOGDEBUG, "CAESinkNULL::Initialize - {} device, {} Hz, {} frames per period",
+            m_realtime ? "realtime" : "fast", format.m_sampleRate, format.m_frames);
+  return true;
+}
+
+void CAESinkNULL::Deinitialize()
+{
+  m_written = 0;
+  m_lastPeriod = {};
+}
+
+double CAESinkNULL::GetCacheTotal()
+{
+  return static_cast<double>(m_bufferFrames) / m_format.m_sampleRate;
+}
+
+uint64_t CAESinkNULL::GetPlayedFrames(steady_clock::time_point now) const
+{
+  const double elapsed = duration<double>(now - m_start).count();
+  return static_cast<uint64_t>(elapsed * m_format.m_sampleRate);
+}
+
+void CAESinkNULL::WaitForSpace(unsigned int frames)
+{
+  const auto now = steady_clock::now();
+
+  if (m_written == 0)
+    m_start = now;
+  else if (GetPlayedFrames(now) > m_written)
+  {
+    // the device ran dry, restart its clock at the end of the written data
+    m_start = now - duration_cast<steady_clock::duration>(
+                        duration<double>(static_cast<double>(m_written) / m_format.m_sampleRate));
+    std::unique_lock<CCriticalSection> lock(statsSection);
+    periodStats.underruns++;
+  }
+
+  // everything beyond the buffer has to be played before the new frames fit
+  const uint64_t limit = std::max<uint64_t>(m_bufferFrames, frames);
+  if (m_written + frames <= limit)
+    return;
+
+  const uint64_t played = m_written + frames - limit;
+  std::this_thread::sleep_until(
+      m_start + duration_cast<steady_clock::duration>(
+                    duration<double>(static_cast<double>(played) / m_format.m_sampleRate)));
+}
+
+unsigned int CAESinkNULL::AddPackets(uint8_t** data, unsigned int frames, unsigned int offset)
+{
+  const auto start = steady_clock::now();
+
+  if (m_realtime)
+    WaitForSpace(frames);
+  m_written += frames;
+
+  const auto end = steady_clock::now();
+
+  std::unique_lock<CCriticalSection> lock(statsSection);
+  periodStats.periods++;
+  periodStats.frames += frames;
+  if (m_lastPeriod != steady_clock::time_point{})
+  {
+    const double interval = ToMilliseconds(start - m_lastPeriod);
+    periodStats.intervalTotal += interval;
+    periodStats.intervalMax = std::max(periodStats.intervalMax, interval);
+  }
+  const double blocked = ToMilliseconds(end - start);
+  periodStats.blockedTotal += blocked;
+  periodStats.blockedMax = std::max(periodStats.blockedMax, blocked);
+  m_lastPeriod = start;
+
+  return frames;
+}
+
+void CAESinkNULL::AddPause(unsigned int millis)
+{
+  // a pause burst occupies the device like the same amount of samples
+  const unsigned int frames = m_format.m_sampleRate * millis / 1000;
+  if (m_realtime)
+    WaitForSpace(frames);
+  m_written += frames;
+}
+
+void CAESinkNULL::GetDelay(AEDelayStatus& status)
+{
+  if (!m_realtime || m_written == 0)
+  {
+    status.SetDelay(0.0);
+    return;
+  }
+
+  const uint64_t played = GetPlayedFrames(steady_clock::now());
+  const uint64_t buffered = played < m_written ? m_written - played : 0;
+  status.SetDelay(static_cast<double>(buffered) / m_format.m_sampleRate);
+}
+
+void CAESinkNULL::Drain()
+{
+  if (m_realtime && m_written > 0)
+  {
+    std::this_thread::sleep_until(
+        m_start + duration_cast<steady_clock::duration>(duration<double>(
+                      static_cast<double>(m_written) / m_format.m_sampleRate)));
+  }
+
+  m_written = 0;
+  m_lastPeriod = {};
+}
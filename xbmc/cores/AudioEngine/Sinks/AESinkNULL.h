@@ -0,0 +1,73 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/AudioEngine/Interfaces/AESink.h"
+#include "cores/AudioEngine/Utils/AEDeviceInfo.h"
+
+#include <chrono>
+#include <stdint.h>
+
+/*!
+ * \brief Sink without an audio device, for benchmarks and headless tests.
+ *
+ * It is not registered by any platform. A driver calls Register() and selects
+ * one of the devices:
+ *   - NULL:realtime  consumes frames at the pace of a simulated device clock
+ *   - NULL:fast      consumes frames as soon as they are added
+ *
+ * Every AddPackets call is timed, the results are collected over all instances
+ * and can be read with GetPeriodStats().
+ */
+class CAESinkNULL : public IAESink
+{
+public:
+  struct PeriodStats
+  {
+    uint64_t periods = 0;
+    uint64_t frames = 0;
+    uint64_t underruns = 0; // realtime only, the device clock caught up with the data
+    double intervalTotal = 0.0; // ms between the start of two consecutive periods
+    double intervalMax = 0.0;
+    double blockedTotal = 0.0; // ms AddPackets waited for the simulated device
+    double blockedMax = 0.0;
+  };
+
+  const char* GetName() override { return "NULL"; }
+
+  CAESinkNULL() = default;
+  ~CAESinkNULL() override;
+
+  static void Register();
+  static std::unique_ptr<IAESink> Create(std::string& device, AEAudioFormat& desiredFormat);
+  static void EnumerateDevicesEx(AEDeviceInfoList& list, bool force = false);
+
+  static PeriodStats GetPeriodStats();
+  static void ResetPeriodStats();
+
+  bool Initialize(AEAudioFormat& format, std::string& device) override;
+  void Deinitialize() override;
+
+  double GetCacheTotal() override;
+  unsigned int AddPackets(uint8_t** data, unsigned int frames, unsigned int offset) override;
+  void AddPause(unsigned int millis) override;
+  void GetDelay(AEDelayStatus& status) override;
+  void Drain() override;
+
+private:
+  uint64_t GetPlayedFrames(std::chrono::steady_clock::time_point now) const;
+  void WaitForSpace(unsigned int frames);
+
+  AEAudioFormat m_format;
+  bool m_realtime = false;
+  uint64_t m_bufferFrames = 0;
+  uint64_t m_written = 0;
+  std::chrono::steady_clock::time_point m_start;
+  std::chrono::steady_clock::time_point m_lastPeriod;
+};
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEKernels.h"
+
+#include "ServiceBroker.h"
+#include "utils/CPUInfo.h"
+#include "utils/log.h"
+
+#include <math.h>
+
+// the SIMD variants round after every operation, the compiler must not fuse
+// multiplications and additions here either
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace
+{
+
+inline float Clamp(float x)
+{
+  x = -1.0f > x ? -1.0f : x;
+  return 1.0f < x ? 1.0f : x;
+}
+
+void Mul(float* data, float mul, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] *= mul;
+}
+
+void MulAdd(float* data, const float* add, float mul, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] += add[i] * mul;
+}
+
+void SoftClamp(float* data, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    const float x = data[i];
+    if (x < -3.0f)
+      data[i] = -1.0f;
+    else if (x > 3.0f)
+      data[i] = 1.0f;
+    else
+    {
+      const float y = x * x;
+      data[i] = x * (27.0f + y) / (27.0f + 9.0f * y);
+    }
+  }
+}
+
+float Peak(const float* data, uint32_t count)
+{
+  float peak = 0.0f;
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    const float x = fabsf(data[i]);
+    if (x > peak)
+      peak = x;
+  }
+  return peak;
+}
+
+void Interleave(float* dst, const float* const* src, uint32_t channels, uint32_t frames)
+{
+  for (uint32_t f = 0; f < frames; ++f)
+    for (uint32_t c = 0; c < channels; ++c)
+      *dst++ = src[c][f];
+}
+
+void Deinterleave(float* const* dst, const float* src, uint32_t channels, uint32_t frames)
+{
+  for (uint32_t f = 0; f < frames; ++f)
+    for (uint32_t c = 0; c < channels; ++c)
+      dst[c][f] = *src++;
+}
+
+void FloatToS16(int16_t* dst, const float* src, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    // 1.0 rounds to 32768, saturate like the packing instructions do
+    const long sample = lrintf(Clamp(src[i]) * 32768.0f);
+    dst[i] = static_cast<int16_t>(sample > 32767 ? 32767 : sample);
+  }
+}
+
+void FloatToS32(int32_t* dst, const float* src, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    // 2^31 doesn't fit, limit to the largest float below it
+    float sample = Clamp(src[i]) * 2147483648.0f;
+    sample = 2147483520.0f < sample ? 2147483520.0f : sample;
+    dst[i] = static_cast<int32_t>(lrintf(sample));
+  }
+}
+
+void S16ToFloat(float* dst, const int16_t* src, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    dst[i] = static_cast<float>(src[i]) * (1.0f / 32768.0f);
+}
+
+void S32ToFloat(float* dst, const int32_t* src, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    dst[i] = static_cast<float>(src[i]) * (1.0f / 2147483648.0f);
+}
+
+const AEKernelSet scalarKernels = {"scalar",     Mul,          MulAdd,     SoftClamp,
+                                   Peak,         Interleave,   Deinterleave, FloatToS16,
+                                   FloatToS32,   S16ToFloat,   S32ToFloat};
+
+} // namespace
+
+const AEKernelSet& CAEKernels::Get()
+{
+  static const AEKernelSet* kernels = Select();
+  return *kernels;
+}
+
+const AEKernelSet& CAEKernels::GetScalar()
+{
+  return scalarKernels;
+}
+
+std::vector<const AEKernelSet*> CAEKernels::GetAvailable()
+{
+  std::vector<const AEKernelSet*> kernels{&scalarKernels};
+
+  const auto cpuInfo = CServiceBroker::GetCPUInfo();
+  const unsigned int features = cpuInfo ? cpuInfo->GetCPUFeatures() : 0;
+
+  if (GetAEKernelsAVX2() && (features & CPU_FEATURE_AVX2))
+    kernels.push_back(GetAEKernelsAVX2());
+  if (GetAEKernelsNEON() && (features & CPU_FEATURE_NEON))
+    kernels.push_back(GetAEKernelsNEON());
+
+  return kernels;
+}
+
+const AEKernelSet* CAEKernels::Select()
+{
+  const AEKernelSet* kernels = GetAvailable().back();
+  CLog::Log(LOGINFO, "CAEKernels::{} - using {} sample kernels", __FUNCTION__, kernels->name);
+  return kernels;
+}
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+/*!
+ * \brief Set of sample processing kernels for one instruction set.
+ *
+ * All variants produce bit identical results to the scalar implementation,
+ * so the selected variant never changes the audio output. Buffers don't need
+ * any particular alignment.
+ */
+struct AEKernelSet
+{
+  const char* name;
+
+  //! data[i] *= mul
+  void (*Mul)(float* data, float mul, uint32_t count);
+  //! data[i] += add[i] * mul, rounded after the multiplication
+  void (*MulAdd)(float* data, const float* add, float mul, uint32_t count);
+  //! tanh like soft clipping of data to -1..1, see CAEUtil::ClampArray
+  void (*SoftClamp)(float* data, uint32_t count);
+  //! largest absolute value in data, 0 for an empty buffer
+  float (*Peak)(const float* data, uint32_t count);
+
+  //! planar to packed, src holds one plane per channel
+  void (*Interleave)(float* dst, const float* const* src, uint32_t channels, uint32_t frames);
+  //! packed to planar, dst holds one plane per channel
+  void (*Deinterleave)(float* const* dst, const float* src, uint32_t channels, uint32_t frames);
+
+  //! float to integer samples, input clipped to -1..1 and rounded to nearest
+  void (*FloatToS16)(int16_t* dst, const float* src, uint32_t count);
+  void (*FloatToS32)(int32_t* dst, const float* src, uint32_t count);
+  //! integer to float samples in -1..1
+  void (*S16ToFloat)(float* dst, const int16_t* src, uint32_t count);
+  void (*S32ToFloat)(float* dst, const int32_t* src, uint32_t count);
+};
+
+class CAEKernels
+{
+public:
+  /*!
+   * \brief The fastest kernels supported by this CPU, chosen once via CCPUInfo.
+   */
+  static const AEKernelSet& Get();
+
+  /*!
+   * \brief The reference implementation in plain C++.
+   */
+  static const AEKernelSet& GetScalar();
+
+  /*!
+   * \brief All kernel sets built in and supported by this CPU, scalar first.
+   */
+  static std::vector<const AEKernelSet*> GetAvailable();
+
+private:
+  static const AEKernelSet* Select();
+};
+
+//! kernel sets of the instruction set extensions, nullptr if not built in
+const AEKernelSet* GetAEKernelsAVX2();
+const AEKernelSet* GetAEKernelsNEON();
@@ -0,0 +1,300 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEKernels.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <immintrin.h>
+
+// keep mul and add separate to stay bit exact with the scalar kernels
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+// this file is built without -mavx2, the functions are only called after
+// CCPUInfo reported AVX2 support
+#if defined(__GNUC__)
+#define AE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AE_TARGET_AVX2
+#endif
+
+namespace
+{
+
+AE_TARGET_AVX2 inline __m256 Clamp(__m256 x)
+{
+  return _mm256_min_ps(_mm256_set1_ps(1.0f), _mm256_max_ps(_mm256_set1_ps(-1.0f), x));
+}
+
+AE_TARGET_AVX2 void Transpose8x8(__m256 (&r)[8])
+{
+  const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+  const __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+  const __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+  const __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+  const __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+  const __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+  const __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+  const __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+
+  const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+  const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+  const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+  const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+  const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+  const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+  r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+  r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+  r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+  r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+  r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+  r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+  r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+  r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+}
+
+AE_TARGET_AVX2 void Mul(float* data, float mul, uint32_t count)
+{
+  const __m256 m = _mm256_set1_ps(mul);
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), m));
+
+  CAEKernels::GetScalar().Mul(data + i, mul, count - i);
+}
+
+AE_TARGET_AVX2 void MulAdd(float* data, const float* add, float mul, uint32_t count)
+{
+  const __m256 m = _mm256_set1_ps(mul);
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256 product = _mm256_mul_ps(_mm256_loadu_ps(add + i), m);
+    _mm256_storeu_ps(data + i, _mm256_add_ps(_mm256_loadu_ps(data + i), product));
+  }
+
+  CAEKernels::GetScalar().MulAdd(data + i, add + i, mul, count - i);
+}
+
+AE_TARGET_AVX2 void SoftClamp(float* data, uint32_t count)
+{
+  const __m256 c27 = _mm256_set1_ps(27.0f);
+  const __m256 c9 = _mm256_set1_ps(9.0f);
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 minusOne = _mm256_set1_ps(-1.0f);
+  const __m256 three = _mm256_set1_ps(3.0f);
+  const __m256 minusThree = _mm256_set1_ps(-3.0f);
+
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256 x = _mm256_loadu_ps(data + i);
+    const __m256 y = _mm256_mul_ps(x, x);
+    const __m256 num = _mm256_mul_ps(x, _mm256_add_ps(c27, y));
+    const __m256 den = _mm256_add_ps(c27, _mm256_mul_ps(c9, y));
+    __m256 r = _mm256_div_ps(num, den);
+    r = _mm256_blendv_ps(r, minusOne, _mm256_cmp_ps(x, minusThree, _CMP_LT_OQ));
+    r = _mm256_blendv_ps(r, one, _mm256_cmp_ps(x, three, _CMP_GT_OQ));
+    _mm256_storeu_ps(data + i, r);
+  }
+
+  CAEKernels::GetScalar().SoftClamp(data + i, count - i);
+}
+
+AE_TARGET_AVX2 float Peak(const float* data, uint32_t count)
+{
+  const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+  __m256 peak = _mm256_setzero_ps();
+
+  uint32_t i = 0;
+  // max returns the second operand for NaN, which skips them like the scalar loop
+  for (; i + 8 <= count; i += 8)
+    peak = _mm256_max_ps(_mm256_and_ps(_mm256_loadu_ps(data + i), absMask), peak);
+
+  __m128 half = _mm_max_ps(_mm256_castps256_ps128(peak), _mm256_extractf128_ps(peak, 1));
+  half = _mm_max_ps(half, _mm_movehl_ps(half, half));
+  half = _mm_max_ss(half, _mm_shuffle_ps(half, half, _MM_SHUFFLE(1, 1, 1, 1)));
+
+  const float result = _mm_cvtss_f32(half);
+  const float tail = CAEKernels::GetScalar().Peak(data + i, count - i);
+  return tail > result ? tail : result;
+}
+
+AE_TARGET_AVX2 void Interleave(float* dst,
+                               const float* const* src,
+                               uint32_t channels,
+                               uint32_t frames)
+{
+  uint32_t f = 0;
+  if (channels == 2)
+  {
+    for (; f + 8 <= frames; f += 8, dst += 16)
+    {
+      const __m256 a = _mm256_loadu_ps(src[0] + f);
+      const __m256 b = _mm256_loadu_ps(src[1] + f);
+      const __m256 lo = _mm256_unpacklo_ps(a, b);
+      const __m256 hi = _mm256_unpackhi_ps(a, b);
+      _mm256_storeu_ps(dst, _mm256_permute2f128_ps(lo, hi, 0x20));
+      _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+  }
+  else if (channels == 8)
+  {
+    for (; f + 8 <= frames; f += 8, dst += 64)
+    {
+      __m256 r[8];
+      for (int c = 0; c < 8; ++c)
+        r[c] = _mm256_loadu_ps(src[c] + f);
+      Transpose8x8(r);
+      for (int c = 0; c < 8; ++c)
+        _mm256_storeu_ps(dst + c * 8, r[c]);
+    }
+  }
+
+  if (f == 0)
+  {
+    CAEKernels::GetScalar().Interleave(dst, src, channels, frames);
+    return;
+  }
+
+  const float* tail[8];
+  for (uint32_t c = 0; c < channels; ++c)
+    tail[c] = src[c] + f;
+  CAEKernels::GetScalar().Interleave(dst, tail, channels, frames - f);
+}
+
+AE_TARGET_AVX2 void Deinterleave(float* const* dst,
+                                 const float* src,
+                                 uint32_t channels,
+                                 uint32_t frames)
+{
+  uint32_t f = 0;
+  if (channels == 2)
+  {
+    for (; f + 8 <= frames; f += 8, src += 16)
+    {
+      const __m256 x = _mm256_loadu_ps(src);
+      const __m256 y = _mm256_loadu_ps(src + 8);
+      // a0 a1 a4 a5 | a2 a3 a6 a7, fixed up by swapping the middle 64 bit pairs
+      const __m256 a = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+      const __m256 b = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(3, 1, 3, 1));
+      _mm256_storeu_ps(dst[0] + f, _mm256_castpd_ps(_mm256_permute4x64_pd(
+                                       _mm256_castps_pd(a), _MM_SHUFFLE(3, 1, 2, 0))));
+      _mm256_storeu_ps(dst[1] + f, _mm256_castpd_ps(_mm256_permute4x64_pd(
+                                       _mm256_castps_pd(b), _MM_SHUFFLE(3, 1, 2, 0))));
+    }
+  }
+  else if (channels == 8)
+  {
+    for (; f + 8 <= frames; f += 8, src += 64)
+    {
+      __m256 r[8];
+      for (int c = 0; c < 8; ++c)
+        r[c] = _mm256_loadu_ps(src + c * 8);
+      Transpose8x8(r);
+      for (int c = 0; c < 8; ++c)
+        _mm256_storeu_ps(dst[c] + f, r[c]);
+    }
+  }
+
+  if (f == 0)
+  {
+    CAEKernels::GetScalar().Deinterleave(dst, src, channels, frames);
+    return;
+  }
+
+  float* tail[8];
+  for (uint32_t c = 0; c < channels; ++c)
+    tail[c] = dst[c] + f;
+  CAEKernels::GetScalar().Deinterleave(tail, src, channels, frames - f);
+}
+
+AE_TARGET_AVX2 void FloatToS16(int16_t* dst, const float* src, uint32_t count)
+{
+  const __m256 scale = _mm256_set1_ps(32768.0f);
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256i v = _mm256_cvtps_epi32(_mm256_mul_ps(Clamp(_mm256_loadu_ps(src + i)), scale));
+    // packs saturates 32768 to 32767
+    const __m128i packed =
+        _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+  }
+
+  CAEKernels::GetScalar().FloatToS16(dst + i, src + i, count - i);
+}
+
+AE_TARGET_AVX2 void FloatToS32(int32_t* dst, const float* src, uint32_t count)
+{
+  const __m256 scale = _mm256_set1_ps(2147483648.0f);
+  const __m256 limit = _mm256_set1_ps(2147483520.0f);
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256 v = _mm256_mul_ps(Clamp(_mm256_loadu_ps(src + i)), scale);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                        _mm256_cvtps_epi32(_mm256_min_ps(limit, v)));
+  }
+
+  CAEKernels::GetScalar().FloatToS32(dst + i, src + i, count - i);
+}
+
+AE_TARGET_AVX2 void S16ToFloat(float* dst, const int16_t* src, uint32_t count)
+{
+  const __m256 scale = _mm256_set1_ps(1.0f / 32768.0f);
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256i v =
+        _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+  }
+
+  CAEKernels::GetScalar().S16ToFloat(dst + i, src + i, count - i);
+}
+
+AE_TARGET_AVX2 void S32ToFloat(float* dst, const int32_t* src, uint32_t count)
+{
+  const __m256 scale = _mm256_set1_ps(1.0f / 2147483648.0f);
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+  }
+
+  CAEKernels::GetScalar().S32ToFloat(dst + i, src + i, count - i);
+}
+
+const AEKernelSet avx2Kernels = {"avx2",       Mul,          MulAdd,     SoftClamp,
+                                 Peak,         Interleave,   Deinterleave, FloatToS16,
+                                 FloatToS32,   S16ToFloat,   S32ToFloat};
+
+} // namespace
+
+const AEKernelSet* GetAEKernelsAVX2()
+{
+  return &avx2Kernels;
+}
+
+#else
+
+const AEKernelSet* GetAEKernelsAVX2()
+{
+  return nullptr;
+}
+
+#endif
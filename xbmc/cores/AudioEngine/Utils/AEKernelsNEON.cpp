@@ -0,0 +1,230 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEKernels.h"
+
+// ARMv7 NEON has neither a division nor a round to nearest conversion, only
+// AArch64 can match the scalar kernels bit for bit
+#if defined(HAS_NEON) && defined(__aarch64__)
+
+#include <arm_neon.h>
+
+// the intrinsics are plain vector arithmetic for the compiler, don't let it
+// turn vmulq + vaddq into fmla
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace
+{
+
+inline float32x4_t Clamp(float32x4_t x)
+{
+  return vminq_f32(vdupq_n_f32(1.0f), vmaxq_f32(vdupq_n_f32(-1.0f), x));
+}
+
+void Mul(float* data, float mul, uint32_t count)
+{
+  const float32x4_t m = vdupq_n_f32(mul);
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(data + i, vmulq_f32(vld1q_f32(data + i), m));
+
+  CAEKernels::GetScalar().Mul(data + i, mul, count - i);
+}
+
+void MulAdd(float* data, const float* add, float mul, uint32_t count)
+{
+  const float32x4_t m = vdupq_n_f32(mul);
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const float32x4_t product = vmulq_f32(vld1q_f32(add + i), m);
+    vst1q_f32(data + i, vaddq_f32(vld1q_f32(data + i), product));
+  }
+
+  CAEKernels::GetScalar().MulAdd(data + i, add + i, mul, count - i);
+}
+
+void SoftClamp(float* data, uint32_t count)
+{
+  const float32x4_t c27 = vdupq_n_f32(27.0f);
+  const float32x4_t c9 = vdupq_n_f32(9.0f);
+
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const float32x4_t x = vld1q_f32(data + i);
+    const float32x4_t y = vmulq_f32(x, x);
+    const float32x4_t num = vmulq_f32(x, vaddq_f32(c27, y));
+    const float32x4_t den = vaddq_f32(c27, vmulq_f32(c9, y));
+    float32x4_t r = vdivq_f32(num, den);
+    r = vbslq_f32(vcltq_f32(x, vdupq_n_f32(-3.0f)), vdupq_n_f32(-1.0f), r);
+    r = vbslq_f32(vcgtq_f32(x, vdupq_n_f32(3.0f)), vdupq_n_f32(1.0f), r);
+    vst1q_f32(data + i, r);
+  }
+
+  CAEKernels::GetScalar().SoftClamp(data + i, count - i);
+}
+
+float Peak(const float* data, uint32_t count)
+{
+  float32x4_t peak = vdupq_n_f32(0.0f);
+  uint32_t i = 0;
+  // maxnm prefers numbers over NaN, same as the scalar comparison
+  for (; i + 4 <= count; i += 4)
+    peak = vmaxnmq_f32(peak, vabsq_f32(vld1q_f32(data + i)));
+
+  const float result = vmaxnmvq_f32(peak);
+  const float tail = CAEKernels::GetScalar().Peak(data + i, count - i);
+  return tail > result ? tail : result;
+}
+
+void Interleave(float* dst, const float* const* src, uint32_t channels, uint32_t frames)
+{
+  uint32_t f = 0;
+  if (channels == 2)
+  {
+    for (; f + 4 <= frames; f += 4, dst += 8)
+    {
+      float32x4x2_t v;
+      v.val[0] = vld1q_f32(src[0] + f);
+      v.val[1] = vld1q_f32(src[1] + f);
+      vst2q_f32(dst, v);
+    }
+  }
+  else if (channels == 4)
+  {
+    for (; f + 4 <= frames; f += 4, dst += 16)
+    {
+      float32x4x4_t v;
+      for (int c = 0; c < 4; ++c)
+        v.val[c] = vld1q_f32(src[c] + f);
+      vst4q_f32(dst, v);
+    }
+  }
+
+  if (f == 0)
+  {
+    CAEKernels::GetScalar().Interleave(dst, src, channels, frames);
+    return;
+  }
+
+  const float* tail[4];
+  for (uint32_t c = 0; c < channels; ++c)
+    tail[c] = src[c] + f;
+  CAEKernels::GetScalar().Interleave(dst, tail, channels, frames - f);
+}
+
+void Deinterleave(float* const* dst, const float* src, uint32_t channels, uint32_t frames)
+{
+  uint32_t f = 0;
+  if (channels == 2)
+  {
+    for (; f + 4 <= frames; f += 4, src += 8)
+    {
+      const float32x4x2_t v = vld2q_f32(src);
+      vst1q_f32(dst[0] + f, v.val[0]);
+      vst1q_f32(dst[1] + f, v.val[1]);
+    }
+  }
+  else if (channels == 4)
+  {
+    for (; f + 4 <= frames; f += 4, src += 16)
+    {
+      const float32x4x4_t v = vld4q_f32(src);
+      for (int c = 0; c < 4; ++c)
+        vst1q_f32(dst[c] + f, v.val[c]);
+    }
+  }
+
+  if (f == 0)
+  {
+    CAEKernels::GetScalar().Deinterleave(dst, src, channels, frames);
+    return;
+  }
+
+  float* tail[4];
+  for (uint32_t c = 0; c < channels; ++c)
+    tail[c] = dst[c] + f;
+  CAEKernels::GetScalar().Deinterleave(tail, src, channels, frames - f);
+}
+
+void FloatToS16(int16_t* dst, const float* src, uint32_t count)
+{
+  const float32x4_t scale = vdupq_n_f32(32768.0f);
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const int32x4_t lo = vcvtnq_s32_f32(vmulq_f32(Clamp(vld1q_f32(src + i)), scale));
+    const int32x4_t hi = vcvtnq_s32_f32(vmulq_f32(Clamp(vld1q_f32(src + i + 4)), scale));
+    vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+  }
+
+  CAEKernels::GetScalar().FloatToS16(dst + i, src + i, count - i);
+}
+
+void FloatToS32(int32_t* dst, const float* src, uint32_t count)
+{
+  const float32x4_t scale = vdupq_n_f32(2147483648.0f);
+  const float32x4_t limit = vdupq_n_f32(2147483520.0f);
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const float32x4_t v = vmulq_f32(Clamp(vld1q_f32(src + i)), scale);
+    vst1q_s32(dst + i, vcvtnq_s32_f32(vminq_f32(limit, v)));
+  }
+
+  CAEKernels::GetScalar().FloatToS32(dst + i, src + i, count - i);
+}
+
+void S16ToFloat(float* dst, const int16_t* src, uint32_t count)
+{
+  const float32x4_t scale = vdupq_n_f32(1.0f / 32768.0f);
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t v = vld1q_s16(src + i);
+    vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), scale));
+    vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), scale));
+  }
+
+  CAEKernels::GetScalar().S16ToFloat(dst + i, src + i, count - i);
+}
+
+void S32ToFloat(float* dst, const int32_t* src, uint32_t count)
+{
+  const float32x4_t scale = vdupq_n_f32(1.0f / 2147483648.0f);
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + i)), scale));
+
+  CAEKernels::GetScalar().S32ToFloat(dst + i, src + i, count - i);
+}
+
+const AEKernelSet neonKernels = {"neon",       Mul,          MulAdd,     SoftClamp,
+                                 Peak,         Interleave,   Deinterleave, FloatToS16,
+                                 FloatToS32,   S16ToFloat,   S32ToFloat};
+
+} // namespace
+
+const AEKernelSet* GetAEKernelsNEON()
+{
+  return &neonKernels;
+}
+
+#else
+
+const AEKernelSet* GetAEKernelsNEON()
+{
+  return nullptr;
+}
+
+#endif
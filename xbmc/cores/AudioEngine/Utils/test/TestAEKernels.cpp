@@ -0,0 +1,225 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "cores/AudioEngine/Utils/AEKernels.h"
+#include "utils/CPUInfo.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// odd sizes and offsets exercise the scalar tails and unaligned loads
+const uint32_t SIZES[] = {0, 1, 3, 7, 8, 15, 16, 31, 64, 1023};
+const uint32_t OFFSETS[] = {0, 1, 3};
+
+std::vector<float> RandomSamples(size_t count, float range)
+{
+  std::mt19937 gen(count);
+  std::uniform_real_distribution<float> dist(-range, range);
+  std::vector<float> samples(count);
+  for (float& sample : samples)
+    sample = dist(gen);
+
+  // values on the edges of the clamps and roundings
+  const float edges[] = {0.0f,  -0.0f, 1.0f,  -1.0f, 3.0f,           -3.0f,
+                         3.5f,  -3.5f, 1.5f,  -1.5f, 0.5f / 32768.0f, 1.5f / 32768.0f};
+  for (size_t i = 0; i < count && i < std::size(edges); ++i)
+    samples[count - 1 - i] = edges[i];
+
+  return samples;
+}
+
+template<typename T>
+std::vector<T> RandomIntegers(size_t count)
+{
+  std::mt19937 gen(count);
+  std::uniform_int_distribution<int32_t> dist(std::numeric_limits<T>::min(),
+                                              std::numeric_limits<T>::max());
+  std::vector<T> samples(count);
+  for (T& sample : samples)
+    sample = static_cast<T>(dist(gen));
+  if (count > 1)
+  {
+    samples[0] = std::numeric_limits<T>::min();
+    samples[1] = std::numeric_limits<T>::max();
+  }
+  return samples;
+}
+
+template<typename T>
+bool BitEqual(const std::vector<T>& a, const std::vector<T>& b)
+{
+  return a.size() == b.size() &&
+         (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
+} // namespace
+
+// every variant supported by this CPU is compared against the scalar kernels
+struct TestAEKernels : public ::testing::Test
+{
+  TestAEKernels()
+  {
+    CServiceBroker::RegisterCPUInfo(CCPUInfo::GetCPUInfo());
+    m_kernels = CAEKernels::GetAvailable();
+  }
+
+  ~TestAEKernels() { CServiceBroker::UnregisterCPUInfo(); }
+
+  const AEKernelSet& Scalar() const { return CAEKernels::GetScalar(); }
+
+  std::vector<const AEKernelSet*> m_kernels;
+};
+
+TEST_F(TestAEKernels, MulAndMulAdd)
+{
+  for (const AEKernelSet* kernels : m_kernels)
+  {
+    SCOPED_TRACE(kernels->name);
+    for (uint32_t size : SIZES)
+    {
+      for (uint32_t offset : OFFSETS)
+      {
+        std::vector<float> expected = RandomSamples(size + offset, 2.0f);
+        std::vector<float> actual = expected;
+        const std::vector<float> add = RandomSamples(size + offset + 5, 2.0f);
+
+        Scalar().Mul(expected.data() + offset, 0.7071f, size);
+        kernels->Mul(actual.data() + offset, 0.7071f, size);
+        EXPECT_TRUE(BitEqual(expected, actual)) << "Mul size " << size << " offset " << offset;
+
+        Scalar().MulAdd(expected.data() + offset, add.data() + 5, 0.3f, size);
+        kernels->MulAdd(actual.data() + offset, add.data() + 5, 0.3f, size);
+        EXPECT_TRUE(BitEqual(expected, actual)) << "MulAdd size " << size << " offset " << offset;
+      }
+    }
+  }
+}
+
+TEST_F(TestAEKernels, SoftClampAndPeak)
+{
+  for (const AEKernelSet* kernels : m_kernels)
+  {
+    SCOPED_TRACE(kernels->name);
+    for (uint32_t size : SIZES)
+    {
+      for (uint32_t offset : OFFSETS)
+      {
+        std::vector<float> expected = RandomSamples(size + offset, 4.0f);
+        std::vector<float> actual = expected;
+
+        EXPECT_EQ(Scalar().Peak(expected.data() + offset, size),
+                  kernels->Peak(actual.data() + offset, size))
+            << "Peak size " << size << " offset " << offset;
+
+        Scalar().SoftClamp(expected.data() + offset, size);
+        kernels->SoftClamp(actual.data() + offset, size);
+        EXPECT_TRUE(BitEqual(expected, actual)) << "SoftClamp size " << size << " offset " << offset;
+      }
+    }
+  }
+}
+
+TEST_F(TestAEKernels, Interleave)
+{
+  for (const AEKernelSet* kernels : m_kernels)
+  {
+    SCOPED_TRACE(kernels->name);
+    for (uint32_t channels = 1; channels <= 8; ++channels)
+    {
+      for (uint32_t frames : SIZES)
+      {
+        std::vector<std::vector<float>> planes;
+        std::vector<const float*> src;
+        for (uint32_t c = 0; c < channels; ++c)
+          planes.push_back(RandomSamples(frames + c, 1.0f));
+        for (uint32_t c = 0; c < channels; ++c)
+          src.push_back(planes[c].data() + c);
+
+        std::vector<float> expected(channels * frames);
+        std::vector<float> actual(channels * frames);
+        Scalar().Interleave(expected.data(), src.data(), channels, frames);
+        kernels->Interleave(actual.data(), src.data(), channels, frames);
+        EXPECT_TRUE(BitEqual(expected, actual)) << channels << " channels, " << frames << " frames";
+
+        std::vector<std::vector<float>> out(channels, std::vector<float>(frames));
+        std::vector<float*> dst;
+        for (auto& plane : out)
+          dst.push_back(plane.data());
+        kernels->Deinterleave(dst.data(), actual.data(), channels, frames);
+        for (uint32_t c = 0; c < channels; ++c)
+          EXPECT_TRUE(std::equal(out[c].begin(), out[c].end(), src[c]))
+              << channels << " channels, " << frames << " frames";
+      }
+    }
+  }
+}
+
+TEST_F(TestAEKernels, Conversions)
+{
+  for (const AEKernelSet* kernels : m_kernels)
+  {
+    SCOPED_TRACE(kernels->name);
+    for (uint32_t size : SIZES)
+    {
+      const std::vector<float> samples = RandomSamples(size, 1.5f);
+
+      std::vector<int16_t> expected16(size), actual16(size);
+      Scalar().FloatToS16(expected16.data(), samples.data(), size);
+      kernels->FloatToS16(actual16.data(), samples.data(), size);
+      EXPECT_TRUE(BitEqual(expected16, actual16)) << "FloatToS16 size " << size;
+
+      std::vector<int32_t> expected32(size), actual32(size);
+      Scalar().FloatToS32(expected32.data(), samples.data(), size);
+      kernels->FloatToS32(actual32.data(), samples.data(), size);
+      EXPECT_TRUE(BitEqual(expected32, actual32)) << "FloatToS32 size " << size;
+
+      std::vector<float> expected(size), actual(size);
+      const std::vector<int16_t> integers16 = RandomIntegers<int16_t>(size);
+      Scalar().S16ToFloat(expected.data(), integers16.data(), size);
+      kernels->S16ToFloat(actual.data(), integers16.data(), size);
+      EXPECT_TRUE(BitEqual(expected, actual)) << "S16ToFloat size " << size;
+
+      const std::vector<int32_t> integers32 = RandomIntegers<int32_t>(size);
+      Scalar().S32ToFloat(expected.data(), integers32.data(), size);
+      kernels->S32ToFloat(actual.data(), integers32.data(), size);
+      EXPECT_TRUE(BitEqual(expected, actual)) << "S32ToFloat size " << size;
+    }
+  }
+}
+
+TEST(TestAEKernelsScalar, ConvertsFullScale)
+{
+  const float samples[] = {-1.0f, 1.0f, 2.0f, 0.5f};
+  int16_t out16[4];
+  int32_t out32[4];
+  CAEKernels::GetScalar().FloatToS16(out16, samples, 4);
+  CAEKernels::GetScalar().FloatToS32(out32, samples, 4);
+
+  EXPECT_EQ(out16[0], -32768);
+  EXPECT_EQ(out16[1], 32767);
+  EXPECT_EQ(out16[2], 32767);
+  EXPECT_EQ(out16[3], 16384);
+  EXPECT_EQ(out32[0], std::numeric_limits<int32_t>::min());
+  EXPECT_EQ(out32[1], 2147483520);
+  EXPECT_EQ(out32[3], 1073741824);
+
+  float clamped[] = {4.0f, -4.0f, 0.0f};
+  CAEKernels::GetScalar().SoftClamp(clamped, 3);
+  EXPECT_EQ(clamped[0], 1.0f);
+  EXPECT_EQ(clamped[1], -1.0f);
+  EXPECT_EQ(clamped[2], 0.0f);
+}
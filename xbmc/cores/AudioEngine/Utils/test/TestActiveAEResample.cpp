@@ -0,0 +1,164 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEResampleFFMPEG.h"
+#include "utils/CPUInfo.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include <libavutil/channel_layout.h>
+}
+
+using namespace ActiveAE;
+
+namespace
+{
+constexpr int CHANNELS = 2;
+constexpr int FRAMES = 1000;
+
+class CTestBuffer
+{
+public:
+  CTestBuffer(AVSampleFormat fmt, int frames) : m_fmt(fmt)
+  {
+    const int planes = av_sample_fmt_is_planar(fmt) ? CHANNELS : 1;
+    m_data.resize(planes, std::vector<uint8_t>(frames * FrameSize()));
+  }
+
+  int FrameSize() const
+  {
+    return av_get_bytes_per_sample(m_fmt) * CHANNELS / static_cast<int>(std::max<size_t>(m_data.size(), 1));
+  }
+
+  // plane pointers at the given frame
+  uint8_t** At(int frame)
+  {
+    m_planes.clear();
+    for (auto& plane : m_data)
+      m_planes.push_back(plane.data() + frame * FrameSize());
+    return m_planes.data();
+  }
+
+  AVSampleFormat m_fmt;
+  std::vector<std::vector<uint8_t>> m_data;
+  std::vector<uint8_t*> m_planes;
+};
+
+CTestBuffer RandomInput(AVSampleFormat fmt)
+{
+  // below full scale, the kernels limit 1.0 to the largest float below 2^31
+  std::mt19937 gen(fmt);
+  std::uniform_int_distribution<int> bytes(0, 255);
+  std::uniform_real_distribution<float> samples(-0.999f, 0.999f);
+
+  CTestBuffer buffer(fmt, FRAMES);
+  for (auto& plane : buffer.m_data)
+  {
+    if (av_get_packed_sample_fmt(fmt) == AV_SAMPLE_FMT_FLT)
+    {
+      float* data = reinterpret_cast<float*>(plane.data());
+      for (size_t i = 0; i < plane.size() / sizeof(float); ++i)
+        data[i] = samples(gen);
+    }
+    else
+    {
+      for (uint8_t& byte : plane)
+        byte = static_cast<uint8_t>(bytes(gen));
+    }
+  }
+  return buffer;
+}
+
+// converts all frames of the input, reading at most chunk frames per call
+CTestBuffer Convert(AVSampleFormat dstFmt,
+                    CTestBuffer& input,
+                    int chunk,
+                    bool forceResample,
+                    int& buffered)
+{
+  SampleConfig srcConfig = {};
+  srcConfig.fmt = input.m_fmt;
+  srcConfig.channels = CHANNELS;
+  srcConfig.channel_layout = AV_CH_LAYOUT_STEREO;
+  srcConfig.sample_rate = 48000;
+  srcConfig.bits_per_sample = 32;
+  SampleConfig dstConfig = srcConfig;
+  dstConfig.fmt = dstFmt;
+
+  CActiveAEResampleFFMPEG resampler;
+  EXPECT_TRUE(resampler.Init(dstConfig, srcConfig, false, false, 1.0, nullptr, AE_QUALITY_MID,
+                             forceResample));
+
+  CTestBuffer output(dstFmt, FRAMES);
+  int in = 0;
+  int out = 0;
+  buffered = 0;
+  while (out < FRAMES)
+  {
+    // input packets of 170 frames don't fit into the output chunks
+    const int samples = std::min(170, FRAMES - in);
+    const int converted = resampler.Resample(output.At(out), std::min(chunk, FRAMES - out),
+                                             samples ? input.At(in) : nullptr, samples, 1.0);
+    if (converted <= 0 && samples == 0)
+      break;
+
+    in += samples;
+    out += std::max(converted, 0);
+    buffered = std::max(buffered, resampler.GetBufferedSamples());
+  }
+  EXPECT_EQ(out, FRAMES);
+  return output;
+}
+} // namespace
+
+class TestActiveAEResample
+  : public ::testing::TestWithParam<std::pair<AVSampleFormat, AVSampleFormat>>
+{
+protected:
+  TestActiveAEResample() { CServiceBroker::RegisterCPUInfo(CCPUInfo::GetCPUInfo()); }
+  ~TestActiveAEResample() override { CServiceBroker::UnregisterCPUInfo(); }
+};
+
+TEST_P(TestActiveAEResample, ConvertsLikeSwresample)
+{
+  const AVSampleFormat srcFmt = GetParam().first;
+  const AVSampleFormat dstFmt = GetParam().second;
+  CTestBuffer input = RandomInput(srcFmt);
+
+  for (int chunk : {FRAMES, 100, 33})
+  {
+    int buffered;
+    const CTestBuffer expected = Convert(dstFmt, input, chunk, true, buffered);
+    const CTestBuffer actual = Convert(dstFmt, input, chunk, false, buffered);
+    EXPECT_TRUE(expected.m_data == actual.m_data) << "chunks of " << chunk;
+
+    // what doesn't fit is kept for the next call
+    if (chunk < 170)
+    {
+      EXPECT_GT(buffered, 0) << "chunks of " << chunk;
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Formats,
+    TestActiveAEResample,
+    ::testing::Values(std::make_pair(AV_SAMPLE_FMT_FLTP, AV_SAMPLE_FMT_FLT),
+                      std::make_pair(AV_SAMPLE_FMT_FLT, AV_SAMPLE_FMT_FLTP),
+                      std::make_pair(AV_SAMPLE_FMT_FLTP, AV_SAMPLE_FMT_S16),
+                      std::make_pair(AV_SAMPLE_FMT_FLT, AV_SAMPLE_FMT_S32P),
+                      std::make_pair(AV_SAMPLE_FMT_S16, AV_SAMPLE_FMT_FLTP),
+                      std::make_pair(AV_SAMPLE_FMT_S32P, AV_SAMPLE_FMT_FLT),
+                      std::make_pair(AV_SAMPLE_FMT_S16P, AV_SAMPLE_FMT_FLTP),
+                      std::make_pair(AV_SAMPLE_FMT_FLT, AV_SAMPLE_FMT_FLT)));
@@ -95,6 +95,20 @@ bool CDataCacheCore::IsVideoHwDecoder()
 }
 
 
+void CDataCacheCore::SetVideoDecoderThreads(std::string threads)
+{
+  std::unique_lock<CCriticalSection> lock(m_videoPlayerSection);
+
+  m_playerVideoInfo.decoderThreads = std::move(threads);
+}
+
+std::string CDataCacheCore::GetVideoDecoderThreads()
+{
+  std::unique_lock<CCriticalSection> lock(m_videoPlayerSection);
+
+  return m_playerVideoInfo.decoderThreads;
+}
+
 void CDataCacheCore::SetVideoDeintMethod(std::string method)
 {
   std::unique_lock<CCriticalSection> lock(m_videoPlayerSection);
@@ -32,6 +32,8 @@ public:
   void SetVideoDecoderName(std::string name, bool isHw);
   std::string GetVideoDecoderName();
   bool IsVideoHwDecoder();
+  void SetVideoDecoderThreads(std::string threads);
+  std::string GetVideoDecoderThreads();
   void SetVideoDeintMethod(std::string method);
   std::string GetVideoDeintMethod();
   void SetVideoPixelFormat(std::string pixFormat);
@@ -203,6 +205,7 @@ protected:
   {
     std::string decoderName;
     bool isHwDecoder;
+    std::string decoderThreads;
     std::string deintMethod;
     std::string pixFormat;
     std::string stereoMode;
@@ -26,6 +26,7 @@ struct TextCacheStruct_t;
 class TiXmlElement;
 class CStreamDetails;
 class CAction;
+class CVariant;
 class IPlayerCallback;
 
 class CPlayerOptions
@@ -257,6 +258,15 @@ public:
     return false;
   }
 
+  /*!
+   * \brief Frame pacing histograms of the video renderer
+   * \param stats receives the histograms and counters
+   * \param records also return the last per frame records
+   * \param reset clear the histograms after reading them
+   * \return false if the player does not keep pacing statistics
+   */
+  virtual bool GetRenderPacingStats(CVariant& stats, bool records, bool reset) { return false; }
+
   // video and audio settings
   virtual CVideoSettings GetVideoSettings() const { return CVideoSettings(); }
   virtual void SetVideoSettings(CVideoSettings& settings) {}
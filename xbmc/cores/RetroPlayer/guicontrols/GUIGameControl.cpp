@@ -13,6 +13,7 @@
 #include "cores/RetroPlayer/RetroPlayerUtils.h"
 #include "cores/RetroPlayer/guibridge/GUIGameRenderManager.h"
 #include "cores/RetroPlayer/guibridge/GUIRenderHandle.h"
+#include "rendering/RenderSystem.h"
 #include "settings/GameSettings.h"
 #include "settings/MediaSettings.h"
 #include "utils/Geometry.h"
@@ -95,6 +96,9 @@ void CGUIGameControl::Process(unsigned int currentTime, CDirtyRegionList& dirtyr
 
 void CGUIGameControl::Render()
 {
+  // the game renderer draws with its own shaders
+  CServiceBroker::GetRenderSystem()->FlushGUIBatch();
+
   m_renderHandle->Render();
 
   CGUIControl::Render();
@@ -16,7 +16,7 @@
 #include "cores/RetroPlayer/rendering/RPRenderManager.h"
 #include "cores/RetroPlayer/savestates/ISavestate.h"
 #include "cores/RetroPlayer/savestates/SavestateDatabase.h"
-#include "cores/RetroPlayer/streams/memory/DeltaPairMemoryStream.h"
+#include "cores/RetroPlayer/streams/memory/CompressedDeltaMemoryStream.h"
 #include "filesystem/File.h"
 #include "games/GameServices.h"
 #include "games/GameSettings.h"
@@ -417,10 +417,11 @@ void CReversiblePlayback::UpdateMemoryStream()
       rewindBufferSec = 10; // Sanity check
 
     unsigned int frameCount = MathUtils::round_int(rewindBufferSec * m_gameLoop.FPS());
+    const size_t memorySize = static_cast<size_t>(gameSettings.MaxRewindMemoryMB()) * 1024 * 1024;
 
     if (!m_memoryStream)
     {
-      m_memoryStream.reset(new CDeltaPairMemoryStream);
+      m_memoryStream.reset(new CCompressedDeltaMemoryStream);
       m_memoryStream->Init(m_gameClient->SerializeSize(), frameCount);
     }
 
@@ -428,6 +429,11 @@ void CReversiblePlayback::UpdateMemoryStream()
     {
       m_memoryStream->SetMaxFrameCount(frameCount);
     }
+
+    if (m_memoryStream->MaxMemorySize() != memorySize)
+    {
+      m_memoryStream->SetMaxMemorySize(memorySize);
+    }
   }
   else
   {
@@ -0,0 +1,506 @@
+/*
+ *  Copyright (C) 2016-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "CompressedDeltaMemoryStream.h"
+
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+// Uncompressed deltas waiting for the worker before the game loop compresses
+// frames itself
+constexpr unsigned int MAX_RAW_FRAMES = 2;
+
+// Shortest run of unchanged bytes that ends a run of literals
+constexpr size_t MIN_ZERO_RUN = 8;
+
+// Shortest back reference worth encoding
+constexpr size_t MIN_MATCH = 4;
+
+constexpr unsigned int HASH_BITS = 14;
+constexpr uint32_t NO_POSITION = std::numeric_limits<uint32_t>::max();
+
+uint32_t Hash(uint32_t sequence)
+{
+  return (sequence * 2654435761U) >> (32 - HASH_BITS);
+}
+
+uint32_t Read32(const uint8_t* data)
+{
+  uint32_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+uint64_t Read64(const uint8_t* data)
+{
+  uint64_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+size_t SkipZeros(const uint8_t* delta, size_t pos, size_t size)
+{
+  while (pos + sizeof(uint64_t) <= size && Read64(delta + pos) == 0)
+    pos += sizeof(uint64_t);
+  while (pos < size && delta[pos] == 0)
+    pos++;
+  return pos;
+}
+
+bool IsZeroRun(const uint8_t* delta, size_t pos, size_t size)
+{
+  if (pos + MIN_ZERO_RUN <= size)
+    return Read64(delta + pos) == 0;
+
+  // The rest of the delta is unchanged
+  return SkipZeros(delta, pos, size) == size;
+}
+
+void WriteVarint(std::vector<uint8_t>& output, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    output.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  output.push_back(static_cast<uint8_t>(value));
+}
+
+bool ReadVarint(const uint8_t* data, size_t size, size_t& pos, uint64_t& value)
+{
+  value = 0;
+  for (unsigned int shift = 0; shift < 64; shift += 7)
+  {
+    if (pos >= size)
+      return false;
+
+    const uint8_t byte = data[pos++];
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+      return true;
+  }
+  return false;
+}
+} // namespace
+
+CCompressedDeltaMemoryStream::CCompressedDeltaMemoryStream() : CThread("RewindCompressor")
+{
+}
+
+CCompressedDeltaMemoryStream::~CCompressedDeltaMemoryStream()
+{
+  StopThread(false);
+  m_frameQueuedEvent.Set();
+  StopThread(true);
+}
+
+void CCompressedDeltaMemoryStream::Reset()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  CLinearMemoryStream::Reset();
+
+  // A frame being compressed is dropped by the worker, as its sequence number
+  // is older than any new frame
+  m_frames.clear();
+  m_nextRawSequence = m_nextSequence;
+  m_rawFrameCount = 0;
+  m_memorySize = 0;
+  m_freeBuffers.clear();
+  m_rewindDelta.reset();
+}
+
+uint64_t CCompressedDeltaMemoryStream::PastFramesAvailable() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  return static_cast<uint64_t>(m_frames.size());
+}
+
+size_t CCompressedDeltaMemoryStream::PastFramesMemorySize() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  return m_memorySize;
+}
+
+void CCompressedDeltaMemoryStream::SubmitFrameInternal()
+{
+  std::unique_ptr<uint32_t[]> delta = GetDeltaBuffer();
+
+  const uint32_t* currentFrame = m_currentFrame.get();
+  const uint32_t* nextFrame = m_nextFrame.get();
+  uint32_t* deltaWords = delta.get();
+
+  const size_t wordCount = DeltaWords();
+  for (size_t i = 0; i < wordCount; i++)
+    deltaWords[i] = currentFrame[i] ^ nextFrame[i];
+
+  // Delta is generated, bring the new frame forward (m_nextFrame is now disposable)
+  std::swap(m_currentFrame, m_nextFrame);
+
+  m_bHasNextFrame = false;
+
+  DeltaFrame frame;
+  frame.frameHistoryCount = m_currentFrameHistory++;
+
+  bool bCompressNow;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    bCompressNow = m_rawFrameCount >= MAX_RAW_FRAMES;
+  }
+
+  if (bCompressNow)
+  {
+    Compress(reinterpret_cast<const uint8_t*>(delta.get()), DeltaSize(), frame.compressed);
+    ReleaseDeltaBuffer(std::move(delta));
+  }
+  else
+  {
+    frame.rawDelta = std::move(delta);
+  }
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+
+    frame.sequence = m_nextSequence++;
+    if (frame.rawDelta)
+    {
+      m_rawFrameCount++;
+      m_memorySize += DeltaSize();
+    }
+    else
+    {
+      m_memorySize += frame.compressed.size();
+    }
+    m_frames.emplace_back(std::move(frame));
+
+    if (PastFramesAvailable() + 1 > MaxFrameCount())
+      CullPastFrames(1);
+
+    CullToMemoryBudget();
+  }
+
+  if (!bCompressNow)
+  {
+    if (!IsRunning())
+      Create();
+    m_frameQueuedEvent.Set();
+  }
+}
+
+uint64_t CCompressedDeltaMemoryStream::RewindFrames(uint64_t frameCount)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  uint64_t rewound;
+
+  for (rewound = 0; rewound < frameCount; rewound++)
+  {
+    if (m_frames.empty())
+      break;
+
+    // Wait for the worker if it's compressing the frame we need
+    if (m_frames.back().compressing)
+    {
+      m_frameCompressedCond.wait(m_critSection, [this]() {
+        return m_frames.empty() || !m_frames.back().compressing;
+      });
+      if (m_frames.empty())
+        break;
+    }
+
+    DeltaFrame& frame = m_frames.back();
+
+    const uint32_t* delta = frame.rawDelta.get();
+    if (delta == nullptr)
+    {
+      if (!m_rewindDelta)
+        m_rewindDelta.reset(new uint32_t[DeltaWords()]);
+
+      if (!Decompress(frame.compressed.data(), frame.compressed.size(),
+                      reinterpret_cast<uint8_t*>(m_rewindDelta.get()), DeltaSize()))
+      {
+        CLog::Log(LOGERROR, "CCompressedDeltaMemoryStream: Corrupt frame, dropping {} past frames",
+                  m_frames.size());
+        CullPastFrames(m_frames.size());
+        break;
+      }
+      delta = m_rewindDelta.get();
+    }
+
+    uint32_t* currentFrame = m_currentFrame.get();
+
+    const size_t wordCount = DeltaWords();
+    for (size_t i = 0; i < wordCount; i++)
+      currentFrame[i] ^= delta[i];
+
+    // Restore frame history
+    m_currentFrameHistory = frame.frameHistoryCount;
+
+    // Sequence numbers stay consecutive, no frame newer than this one is being
+    // compressed
+    m_nextSequence = frame.sequence;
+    m_nextRawSequence = std::min(m_nextRawSequence, m_nextSequence);
+
+    PopFrame(frame);
+    m_frames.pop_back();
+  }
+
+  return rewound;
+}
+
+void CCompressedDeltaMemoryStream::CullPastFrames(uint64_t frameCount)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  for (uint64_t removedCount = 0; removedCount < frameCount; removedCount++)
+  {
+    if (m_frames.empty())
+    {
+      CLog::Log(LOGDEBUG,
+                "CCompressedDeltaMemoryStream: Tried to cull {} frames too many. Check your math!",
+                frameCount - removedCount);
+      break;
+    }
+    PopFrame(m_frames.front());
+    m_frames.pop_front();
+  }
+}
+
+void CCompressedDeltaMemoryStream::Process()
+{
+  while (!m_bStop)
+  {
+    std::unique_ptr<uint32_t[]> delta;
+    uint64_t sequence = 0;
+    size_t deltaSize = 0;
+
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+
+      DeltaFrame* frame = GetNextRawFrame();
+      if (frame != nullptr)
+      {
+        delta = std::move(frame->rawDelta);
+        frame->compressing = true;
+        sequence = frame->sequence;
+        deltaSize = DeltaSize();
+      }
+    }
+
+    if (!delta)
+    {
+      m_frameQueuedEvent.Wait();
+      continue;
+    }
+
+    std::vector<uint8_t> compressed;
+    Compress(reinterpret_cast<const uint8_t*>(delta.get()), deltaSize, compressed);
+
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+
+      // The frame may have been culled in the meantime
+      DeltaFrame* frame = GetFrame(sequence);
+      if (frame != nullptr)
+      {
+        m_memorySize -= deltaSize;
+        m_memorySize += compressed.size();
+        m_rawFrameCount--;
+
+        frame->compressed = std::move(compressed);
+        frame->compressing = false;
+
+        ReleaseDeltaBuffer(std::move(delta));
+      }
+    }
+
+    m_frameCompressedCond.notifyAll();
+  }
+}
+
+std::unique_ptr<uint32_t[]> CCompressedDeltaMemoryStream::GetDeltaBuffer()
+{
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    if (!m_freeBuffers.empty())
+    {
+      std::unique_ptr<uint32_t[]> buffer = std::move(m_freeBuffers.back());
+      m_freeBuffers.pop_back();
+      return buffer;
+    }
+  }
+
+  return std::unique_ptr<uint32_t[]>(new uint32_t[DeltaWords()]);
+}
+
+void CCompressedDeltaMemoryStream::ReleaseDeltaBuffer(std::unique_ptr<uint32_t[]> buffer)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  if (m_freeBuffers.size() < MAX_RAW_FRAMES)
+    m_freeBuffers.emplace_back(std::move(buffer));
+}
+
+CCompressedDeltaMemoryStream::DeltaFrame* CCompressedDeltaMemoryStream::GetFrame(uint64_t sequence)
+{
+  if (m_frames.empty())
+    return nullptr;
+
+  const uint64_t firstSequence = m_frames.front().sequence;
+  if (sequence < firstSequence || sequence >= m_nextSequence)
+    return nullptr;
+
+  return &m_frames[sequence - firstSequence];
+}
+
+CCompressedDeltaMemoryStream::DeltaFrame* CCompressedDeltaMemoryStream::GetNextRawFrame()
+{
+  if (m_frames.empty())
+    return nullptr;
+
+  m_nextRawSequence = std::max(m_nextRawSequence, m_frames.front().sequence);
+
+  for (; m_nextRawSequence < m_nextSequence; m_nextRawSequence++)
+  {
+    DeltaFrame* frame = GetFrame(m_nextRawSequence);
+    if (frame->rawDelta && !frame->compressing)
+      return frame;
+  }
+
+  return nullptr;
+}
+
+void CCompressedDeltaMemoryStream::PopFrame(DeltaFrame& frame)
+{
+  if (frame.rawDelta || frame.compressing)
+  {
+    m_memorySize -= DeltaSize();
+    m_rawFrameCount--;
+  }
+  else
+  {
+    m_memorySize -= frame.compressed.size();
+  }
+
+  if (frame.rawDelta)
+    ReleaseDeltaBuffer(std::move(frame.rawDelta));
+}
+
+void CCompressedDeltaMemoryStream::Compress(const uint8_t* delta,
+                                            size_t size,
+                                            std::vector<uint8_t>& output)
+{
+  output.clear();
+
+  // Last position of every hashed 4 byte sequence
+  std::vector<uint32_t> table(1 << HASH_BITS, NO_POSITION);
+
+  size_t pos = 0;
+  while (pos < size)
+  {
+    // Unchanged bytes
+    const size_t zeroStart = pos;
+    pos = SkipZeros(delta, pos, size);
+    const size_t zeroRun = pos - zeroStart;
+
+    // Trailing unchanged bytes are implied
+    if (pos == size)
+      break;
+
+    // Changed bytes, up to the next run of unchanged bytes or a repetition
+    const size_t literalStart = pos;
+    size_t matchLength = 0;
+    size_t matchOffset = 0;
+    while (pos < size && !IsZeroRun(delta, pos, size))
+    {
+      if (pos + MIN_MATCH <= size)
+      {
+        const uint32_t sequence = Read32(delta + pos);
+        uint32_t& entry = table[Hash(sequence)];
+        const uint32_t candidate = entry;
+        entry = static_cast<uint32_t>(pos);
+
+        if (candidate != NO_POSITION && Read32(delta + candidate) == sequence)
+        {
+          matchLength = MIN_MATCH;
+          while (pos + matchLength < size && delta[candidate + matchLength] == delta[pos + matchLength])
+            matchLength++;
+          matchOffset = pos - candidate;
+          break;
+        }
+      }
+      pos++;
+    }
+
+    WriteVarint(output, zeroRun);
+    WriteVarint(output, pos - literalStart);
+    output.insert(output.end(), delta + literalStart, delta + pos);
+    WriteVarint(output, matchLength);
+    if (matchLength > 0)
+      WriteVarint(output, matchOffset);
+
+    pos += matchLength;
+  }
+}
+
+bool CCompressedDeltaMemoryStream::Decompress(const uint8_t* data,
+                                              size_t size,
+                                              uint8_t* delta,
+                                              size_t deltaSize)
+{
+  size_t in = 0;
+  size_t out = 0;
+
+  while (in < size)
+  {
+    uint64_t zeroRun;
+    if (!ReadVarint(data, size, in, zeroRun) || zeroRun > deltaSize - out)
+      return false;
+    std::memset(delta + out, 0, zeroRun);
+    out += zeroRun;
+
+    uint64_t literalLength;
+    if (!ReadVarint(data, size, in, literalLength) || literalLength > deltaSize - out ||
+        literalLength > size - in)
+      return false;
+    std::memcpy(delta + out, data + in, literalLength);
+    in += literalLength;
+    out += literalLength;
+
+    uint64_t matchLength;
+    if (!ReadVarint(data, size, in, matchLength) || matchLength > deltaSize - out)
+      return false;
+    if (matchLength > 0)
+    {
+      uint64_t matchOffset;
+      if (!ReadVarint(data, size, in, matchOffset) || matchOffset == 0 || matchOffset > out)
+        return false;
+
+      // Byte by byte, the reference may overlap the bytes being written
+      const uint8_t* match = delta + out - matchOffset;
+      for (size_t i = 0; i < matchLength; i++)
+        delta[out + i] = match[i];
+      out += matchLength;
+    }
+  }
+
+  std::memset(delta + out, 0, deltaSize - out);
+
+  return true;
+}
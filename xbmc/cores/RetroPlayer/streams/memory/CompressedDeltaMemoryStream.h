@@ -0,0 +1,117 @@
+/*
+ *  Copyright (C) 2016-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "LinearMemoryStream.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+#include <deque>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+namespace KODI
+{
+namespace RETRO
+{
+/*!
+ * \brief Implementation of a linear memory stream using compressed XOR deltas
+ *
+ * Like CDeltaPairMemoryStream, every past frame is stored as the XOR delta
+ * against the frame that followed it. The game loop only computes the delta,
+ * compressing it is done on a worker thread. Until then the delta is kept
+ * as is, and a rewind applies it directly.
+ *
+ * Deltas are mostly runs of unchanged (zero) bytes with some changed bytes in
+ * between, which often repeat. They are compressed into sequences of a zero
+ * run, literal bytes and an LZ77 style back reference into the delta.
+ *
+ * If the worker falls behind, the game loop compresses the frame itself so
+ * that uncompressed deltas can't pile up.
+ */
+class CCompressedDeltaMemoryStream : public CLinearMemoryStream, protected CThread
+{
+public:
+  CCompressedDeltaMemoryStream();
+
+  ~CCompressedDeltaMemoryStream() override;
+
+  // implementation of IMemoryStream via CLinearMemoryStream
+  void Reset() override;
+  uint64_t PastFramesAvailable() const override;
+  uint64_t RewindFrames(uint64_t frameCount) override;
+
+  /*!
+   * \brief Compress an XOR delta
+   *
+   * \param delta The delta
+   * \param size The size of the delta in bytes
+   * \param[out] output The compressed delta
+   */
+  static void Compress(const uint8_t* delta, size_t size, std::vector<uint8_t>& output);
+
+  /*!
+   * \brief Decompress an XOR delta
+   *
+   * \param data The compressed delta
+   * \param size The size of the compressed delta
+   * \param[out] delta The buffer receiving the delta
+   * \param deltaSize The size of the delta in bytes
+   *
+   * \return True if the delta was decompressed, false if the data is corrupt
+   */
+  static bool Decompress(const uint8_t* data, size_t size, uint8_t* delta, size_t deltaSize);
+
+protected:
+  // implementation of CLinearMemoryStream
+  void SubmitFrameInternal() override;
+  void CullPastFrames(uint64_t frameCount) override;
+  size_t PastFramesMemorySize() const override;
+
+  // implementation of CThread
+  void Process() override;
+
+private:
+  struct DeltaFrame
+  {
+    uint64_t sequence;
+    uint64_t frameHistoryCount;
+    std::unique_ptr<uint32_t[]> rawDelta; // Until compressed
+    std::vector<uint8_t> compressed;
+    bool compressing = false;
+  };
+
+  size_t DeltaSize() const { return m_paddedFrameSize; }
+  size_t DeltaWords() const { return m_paddedFrameSize / sizeof(uint32_t); }
+
+  std::unique_ptr<uint32_t[]> GetDeltaBuffer();
+  void ReleaseDeltaBuffer(std::unique_ptr<uint32_t[]> buffer);
+  DeltaFrame* GetFrame(uint64_t sequence);
+  DeltaFrame* GetNextRawFrame();
+  void PopFrame(DeltaFrame& frame);
+
+  mutable CCriticalSection m_critSection;
+  XbmcThreads::ConditionVariable m_frameCompressedCond;
+  CEvent m_frameQueuedEvent;
+
+  std::deque<DeltaFrame> m_frames;
+  uint64_t m_nextSequence = 0;
+  uint64_t m_nextRawSequence = 0;
+  unsigned int m_rawFrameCount = 0;
+  size_t m_memorySize = 0;
+  std::vector<std::unique_ptr<uint32_t[]>> m_freeBuffers;
+
+  // Decompressed delta while rewinding
+  std::unique_ptr<uint32_t[]> m_rewindDelta;
+};
+} // namespace RETRO
+} // namespace KODI
@@ -18,6 +18,7 @@ void CDeltaPairMemoryStream::Reset()
   CLinearMemoryStream::Reset();
 
   m_rewindBuffer.clear();
+  m_rewindBufferSize = 0;
 }
 
 void CDeltaPairMemoryStream::SubmitFrameInternal()
@@ -41,6 +42,8 @@ void CDeltaPairMemoryStream::SubmitFrameInternal()
     }
   }
 
+  m_rewindBufferSize += frame.buffer.size() * sizeof(DeltaPair);
+
   // Delta is generated, bring the new frame forward (m_nextFrame is now disposable)
   std::swap(m_currentFrame, m_nextFrame);
 
@@ -48,6 +51,8 @@ void CDeltaPairMemoryStream::SubmitFrameInternal()
 
   if (PastFramesAvailable() + 1 > MaxFrameCount())
     CullPastFrames(1);
+
+  CullToMemoryBudget();
 }
 
 uint64_t CDeltaPairMemoryStream::PastFramesAvailable() const
@@ -77,6 +82,7 @@ uint64_t CDeltaPairMemoryStream::RewindFrames(uint64_t frameCount)
     // Restore frame history
     m_currentFrameHistory = frame.frameHistoryCount;
 
+    m_rewindBufferSize -= bufferSize * sizeof(DeltaPair);
     m_rewindBuffer.pop_back();
   }
 
@@ -94,6 +100,7 @@ void CDeltaPairMemoryStream::CullPastFrames(uint64_t frameCount)
                 frameCount - removedCount);
       break;
     }
+    m_rewindBufferSize -= m_rewindBuffer.front().buffer.size() * sizeof(DeltaPair);
     m_rewindBuffer.pop_front();
   }
 }
@@ -36,6 +36,7 @@ protected:
   // implementation of CLinearMemoryStream
   void SubmitFrameInternal() override;
   void CullPastFrames(uint64_t frameCount) override;
+  size_t PastFramesMemorySize() const override { return m_rewindBufferSize; }
 
   /*!
    * Rewinding is implemented by applying XOR deltas on the specific parts of
@@ -62,6 +63,7 @@ protected:
   };
 
   std::deque<MemoryFrame> m_rewindBuffer;
+  size_t m_rewindBufferSize = 0;
 };
 } // namespace RETRO
 } // namespace KODI
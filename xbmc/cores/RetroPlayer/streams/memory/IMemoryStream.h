@@ -32,7 +32,8 @@ namespace RETRO
  *   - Linear memory stream: can grow in one direction. It is possible to
  *         rewind, but not fast-forward.
  *
- *         \sa CLinearMemoryStream
+ *         \sa CLinearMemoryStream, CDeltaPairMemoryStream,
+ *             CCompressedDeltaMemoryStream
  *
  *   - Nonlinear memory stream: can have frames both ahead of and behind
  *         the current frame. If a stream is rewound, it is possible to
@@ -75,6 +76,20 @@ public:
    */
   virtual void SetMaxFrameCount(uint64_t maxFrameCount) = 0;
 
+  /*!
+   * \brief Return the number of bytes past frames may use, or 0 for no limit
+   */
+  virtual size_t MaxMemorySize() const = 0;
+
+  /*!
+   * \brief Update the number of bytes past frames may use
+   *
+   * Old frames may be deleted if the limit is reduced.
+   *
+   * \param maxMemorySize The memory budget in bytes, or 0 for no limit
+   */
+  virtual void SetMaxMemorySize(size_t maxMemorySize) = 0;
+
   /*!
    * \ brief Get a pointer to which FrameSize() bytes can be written
    *
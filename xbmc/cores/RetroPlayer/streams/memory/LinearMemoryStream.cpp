@@ -56,6 +56,13 @@ void CLinearMemoryStream::SetMaxFrameCount(uint64_t maxFrameCount)
   m_maxFrames = maxFrameCount;
 }
 
+void CLinearMemoryStream::SetMaxMemorySize(size_t maxMemorySize)
+{
+  m_maxMemorySize = maxMemorySize;
+
+  CullToMemoryBudget();
+}
+
 uint8_t* CLinearMemoryStream::BeginFrame()
 {
   if (m_paddedFrameSize == 0)
@@ -102,3 +109,12 @@ uint64_t CLinearMemoryStream::BufferSize() const
 {
   return PastFramesAvailable() + (m_bHasCurrentFrame ? 1 : 0);
 }
+
+void CLinearMemoryStream::CullToMemoryBudget()
+{
+  if (m_maxMemorySize == 0)
+    return;
+
+  while (PastFramesAvailable() > 0 && PastFramesMemorySize() > m_maxMemorySize)
+    CullPastFrames(1);
+}
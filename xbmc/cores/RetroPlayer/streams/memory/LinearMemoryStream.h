@@ -30,6 +30,8 @@ public:
   size_t FrameSize() const override { return m_frameSize; }
   uint64_t MaxFrameCount() const override { return m_maxFrames; }
   void SetMaxFrameCount(uint64_t maxFrameCount) override;
+  size_t MaxMemorySize() const override { return m_maxMemorySize; }
+  void SetMaxMemorySize(size_t maxMemorySize) override;
   uint8_t* BeginFrame() override;
   void SubmitFrame() override;
   const uint8_t* CurrentFrame() const override;
@@ -44,11 +46,18 @@ protected:
   virtual void SubmitFrameInternal() = 0;
   virtual void CullPastFrames(uint64_t frameCount) = 0;
 
-  // Helper function
+  /*!
+   * \brief Return the number of bytes used by past frames
+   */
+  virtual size_t PastFramesMemorySize() const = 0;
+
+  // Helper functions
   uint64_t BufferSize() const;
+  void CullToMemoryBudget();
 
   size_t m_paddedFrameSize;
   uint64_t m_maxFrames;
+  size_t m_maxMemorySize = 0;
 
   /**
    * Simple double-buffering. After XORing the two states, the next becomes
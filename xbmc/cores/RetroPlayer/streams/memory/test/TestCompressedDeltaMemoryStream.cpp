@@ -0,0 +1,197 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/RetroPlayer/streams/memory/CompressedDeltaMemoryStream.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+constexpr size_t FRAME_SIZE = 64 * 1024 + 3; // Not a multiple of 4
+
+std::vector<uint8_t> RoundTrip(const std::vector<uint8_t>& delta)
+{
+  std::vector<uint8_t> compressed;
+  CCompressedDeltaMemoryStream::Compress(delta.data(), delta.size(), compressed);
+
+  std::vector<uint8_t> result(delta.size(), 0x55);
+  EXPECT_TRUE(CCompressedDeltaMemoryStream::Decompress(compressed.data(), compressed.size(),
+                                                       result.data(), result.size()));
+  return result;
+}
+
+// Changes a few scattered bytes, like a game updating its state
+void NextFrame(std::vector<uint8_t>& frame, std::mt19937& rng)
+{
+  for (unsigned int i = 0; i < 200; i++)
+    frame[rng() % frame.size()] = static_cast<uint8_t>(rng());
+}
+
+void Submit(IMemoryStream& stream, const std::vector<uint8_t>& frame)
+{
+  uint8_t* data = stream.BeginFrame();
+  ASSERT_NE(data, nullptr);
+  std::memcpy(data, frame.data(), frame.size());
+  stream.SubmitFrame();
+}
+} // namespace
+
+TEST(TestCompressedDeltaMemoryStream, RoundTrip)
+{
+  std::mt19937 rng(1);
+
+  std::vector<uint8_t> random(10000);
+  for (uint8_t& byte : random)
+    byte = static_cast<uint8_t>(rng());
+  EXPECT_EQ(RoundTrip(random), random);
+
+  std::vector<uint8_t> sparse(10000, 0);
+  for (size_t i = 0; i < sparse.size(); i += 97)
+    sparse[i] = static_cast<uint8_t>(rng() | 1);
+  EXPECT_EQ(RoundTrip(sparse), sparse);
+
+  std::vector<uint8_t> repeated(10000, 0);
+  for (size_t i = 0; i < repeated.size(); i++)
+    repeated[i] = (i % 64 < 8) ? static_cast<uint8_t>(i % 7 + 1) : 0;
+  EXPECT_EQ(RoundTrip(repeated), repeated);
+
+  std::vector<uint8_t> odd(13, 0);
+  odd[12] = 1;
+  EXPECT_EQ(RoundTrip(odd), odd);
+}
+
+TEST(TestCompressedDeltaMemoryStream, CompressesUnchangedBytes)
+{
+  const std::vector<uint8_t> zeros(1024 * 1024, 0);
+
+  std::vector<uint8_t> compressed;
+  CCompressedDeltaMemoryStream::Compress(zeros.data(), zeros.size(), compressed);
+  EXPECT_LT(compressed.size(), 16u);
+  EXPECT_EQ(RoundTrip(zeros), zeros);
+}
+
+TEST(TestCompressedDeltaMemoryStream, RejectsCorruptData)
+{
+  std::mt19937 rng(2);
+
+  std::vector<uint8_t> delta(4096, 0);
+  for (size_t i = 0; i < delta.size(); i += 13)
+    delta[i] = static_cast<uint8_t>(rng() | 1);
+
+  std::vector<uint8_t> compressed;
+  CCompressedDeltaMemoryStream::Compress(delta.data(), delta.size(), compressed);
+
+  std::vector<uint8_t> result(delta.size());
+
+  // Data describing a larger delta must not be accepted
+  EXPECT_FALSE(CCompressedDeltaMemoryStream::Decompress(compressed.data(), compressed.size(),
+                                                        result.data(), result.size() / 2));
+
+  // Random corruption must stay within bounds
+  for (unsigned int i = 0; i < 1000; i++)
+  {
+    std::vector<uint8_t> corrupt = compressed;
+    corrupt[rng() % corrupt.size()] ^= static_cast<uint8_t>(rng() | 1);
+    CCompressedDeltaMemoryStream::Decompress(corrupt.data(), corrupt.size(), result.data(),
+                                             result.size());
+  }
+}
+
+TEST(TestCompressedDeltaMemoryStream, RewindRestoresFrames)
+{
+  std::mt19937 rng(3);
+
+  CCompressedDeltaMemoryStream stream;
+  stream.Init(FRAME_SIZE, 100);
+
+  std::vector<std::vector<uint8_t>> frames;
+  std::vector<uint8_t> frame(FRAME_SIZE, 0);
+  for (unsigned int i = 0; i < 50; i++)
+  {
+    NextFrame(frame, rng);
+    frames.push_back(frame);
+    Submit(stream, frame);
+  }
+
+  ASSERT_EQ(stream.PastFramesAvailable(), 49u);
+  ASSERT_EQ(std::memcmp(stream.CurrentFrame(), frames[49].data(), FRAME_SIZE), 0);
+
+  EXPECT_EQ(stream.RewindFrames(10), 10u);
+  EXPECT_EQ(std::memcmp(stream.CurrentFrame(), frames[39].data(), FRAME_SIZE), 0);
+
+  // Continue from the rewound state
+  frame = frames[39];
+  for (unsigned int i = 0; i < 5; i++)
+  {
+    NextFrame(frame, rng);
+    frames[40 + i] = frame;
+    Submit(stream, frame);
+  }
+
+  EXPECT_EQ(stream.PastFramesAvailable(), 44u);
+  for (unsigned int i = 44; i > 0; i--)
+  {
+    ASSERT_EQ(stream.RewindFrames(1), 1u);
+    EXPECT_EQ(std::memcmp(stream.CurrentFrame(), frames[i - 1].data(), FRAME_SIZE), 0);
+  }
+
+  EXPECT_EQ(stream.RewindFrames(1), 0u);
+}
+
+TEST(TestCompressedDeltaMemoryStream, MaxFrameCount)
+{
+  std::mt19937 rng(4);
+
+  CCompressedDeltaMemoryStream stream;
+  stream.Init(FRAME_SIZE, 10);
+
+  std::vector<uint8_t> frame(FRAME_SIZE, 0);
+  for (unsigned int i = 0; i < 30; i++)
+  {
+    NextFrame(frame, rng);
+    Submit(stream, frame);
+  }
+
+  EXPECT_EQ(stream.PastFramesAvailable(), 9u);
+
+  stream.SetMaxFrameCount(5);
+  EXPECT_EQ(stream.PastFramesAvailable(), 4u);
+}
+
+TEST(TestCompressedDeltaMemoryStream, MaxMemorySize)
+{
+  std::mt19937 rng(5);
+
+  // Every delta is incompressible, so the budget holds a known number of frames
+  CCompressedDeltaMemoryStream stream;
+  stream.Init(FRAME_SIZE, 1000);
+  stream.SetMaxMemorySize(20 * FRAME_SIZE);
+
+  std::vector<uint8_t> frame(FRAME_SIZE, 0);
+  for (unsigned int i = 0; i < 100; i++)
+  {
+    for (uint8_t& byte : frame)
+      byte = static_cast<uint8_t>(rng());
+    Submit(stream, frame);
+  }
+
+  const uint64_t frameCount = stream.PastFramesAvailable();
+  EXPECT_GT(frameCount, 10u);
+  EXPECT_LE(frameCount, 20u);
+
+  stream.SetMaxMemorySize(5 * FRAME_SIZE);
+  EXPECT_LE(stream.PastFramesAvailable(), 5u);
+  EXPECT_GT(stream.PastFramesAvailable(), 0u);
+}
@@ -306,6 +306,14 @@ double CAudioSinkAE::GetResampleRatio()
   return m_resampleRatio;
 }
 
+CAEBufferStats CAudioSinkAE::GetBufferStats()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (m_pAudioStream)
+    return m_pAudioStream->GetBufferStats();
+  return {};
+}
+
 void CAudioSinkAE::SetResampleMode(int mode)
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
@@ -53,6 +53,11 @@ public:
    */
   double GetResampleRatio();
 
+  /*!
+   * \brief Returns how many buffers the AE stages copied or passed through
+   */
+  CAEBufferStats GetBufferStats();
+
   void SetResampleMode(int mode);
   void Flush();
   void Drain();
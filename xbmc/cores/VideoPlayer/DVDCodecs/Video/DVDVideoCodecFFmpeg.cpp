@@ -12,6 +12,7 @@
 #include "DVDCodecs/DVDFactoryCodec.h"
 #include "DVDStreamInfo.h"
 #include "ServiceBroker.h"
+#include "VideoDecoderThreading.h"
 #include "cores/FFmpeg.h"
 #include "cores/VideoPlayer/Interface/TimingConstants.h"
 #include "cores/VideoPlayer/VideoRenderers/RenderManager.h"
@@ -383,12 +384,36 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     }
     else
     {
-      int num_threads = CServiceBroker::GetCPUInfo()->GetCPUCount() * 3 / 2;
-      num_threads = std::max(1, std::min(num_threads, 16));
-      m_pCodecContext->thread_count = num_threads;
+      const auto advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+
+      VideoDecoderThreadingParams params;
+      params.mode =
+          CVideoDecoderThreading::ModeFromString(advancedSettings->m_videoDecoderThreadMode);
+      params.threads = advancedSettings->m_videoDecoderThreads;
+      params.liveMaxDelay = advancedSettings->m_videoDecoderLiveMaxDelay;
+      params.cpuCount = CServiceBroker::GetCPUInfo()->GetCPUCount();
+      params.width = hints.width;
+      params.height = hints.height;
+      params.bitDepth = hints.bitdepth;
+      if (hints.fpsrate > 0 && hints.fpsscale > 0)
+        params.fps = static_cast<double>(hints.fpsrate) / hints.fpsscale;
+      params.live = hints.realtime;
+      params.lowLatency = advancedSettings->m_videoDecoderLowLatency;
+      // MPEG-2 slices never span a macroblock row
+      if (hints.codec == AV_CODEC_ID_MPEG2VIDEO && hints.height > 0)
+        params.slices = (hints.height + 15) / 16;
+
+      const VideoDecoderThreading threading = CVideoDecoderThreading::Select(params);
+      m_pCodecContext->thread_count = threading.threads;
+      // codecs without frame threading still get slice threads in frame mode
+      if (threading.mode == VideoDecoderThreadMode::SLICE)
+        m_pCodecContext->thread_type = FF_THREAD_SLICE;
+      else
+        m_pCodecContext->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
       m_decoderState = STATE_SW_MULTI;
-      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - open frame threaded with {} threads",
-                num_threads);
+      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - open {} threaded with {} threads{}",
+                CVideoDecoderThreading::ModeToString(threading.mode), threading.threads,
+                params.live ? " (live)" : "");
     }
   }
   else
@@ -439,6 +464,16 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     return false;
   }
 
+  // ffmpeg may fall back to fewer threads or a different threading type
+  if (m_pCodecContext->active_thread_type & FF_THREAD_FRAME)
+    m_processInfo.SetVideoDecoderThreads(
+        StringUtils::Format("frame, {} threads", m_pCodecContext->thread_count));
+  else if (m_pCodecContext->active_thread_type & FF_THREAD_SLICE)
+    m_processInfo.SetVideoDecoderThreads(
+        StringUtils::Format("slice, {} threads", m_pCodecContext->thread_count));
+  else
+    m_processInfo.SetVideoDecoderThreads("single thread");
+
   m_pDecodedFrame = av_frame_alloc();
   if (!m_pDecodedFrame)
   {
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoDecoderThreading.h"
+
+#include "utils/StringUtils.h"
+
+#include <algorithm>
+
+namespace
+{
+constexpr int SD_PIXELS = 720 * 576;
+constexpr int HD_PIXELS = 1920 * 1088;
+
+// assumed for live streams that don't signal a frame rate
+constexpr double DEFAULT_FPS = 25.0;
+
+int ThreadsForStream(const VideoDecoderThreadingParams& params)
+{
+  const int pixels = params.width * params.height;
+
+  int threads;
+  if (pixels <= 0)
+    threads = CVideoDecoderThreading::MAX_THREADS;
+  else if (pixels <= SD_PIXELS)
+    threads = 4;
+  else if (pixels <= HD_PIXELS)
+    threads = 8;
+  else
+    threads = CVideoDecoderThreading::MAX_THREADS;
+
+  // high bit depth profiles take about half again as long per frame
+  if (params.bitDepth > 8)
+    threads += threads / 2;
+
+  return threads;
+}
+} // namespace
+
+VideoDecoderThreadMode CVideoDecoderThreading::ModeFromString(const std::string& mode)
+{
+  if (StringUtils::EqualsNoCase(mode, "frame"))
+    return VideoDecoderThreadMode::FRAME;
+  if (StringUtils::EqualsNoCase(mode, "slice"))
+    return VideoDecoderThreadMode::SLICE;
+  return VideoDecoderThreadMode::AUTO;
+}
+
+const char* CVideoDecoderThreading::ModeToString(VideoDecoderThreadMode mode)
+{
+  switch (mode)
+  {
+    case VideoDecoderThreadMode::FRAME:
+      return "frame";
+    case VideoDecoderThreadMode::SLICE:
+      return "slice";
+    default:
+      return "auto";
+  }
+}
+
+VideoDecoderThreading CVideoDecoderThreading::Select(const VideoDecoderThreadingParams& params)
+{
+  VideoDecoderThreading threading;
+  const int cpuCount = std::max(1, params.cpuCount);
+
+  // live streams are zapped through, keep their decoding delay low unless
+  // the resolution needs frame threads to play at all. Slice threads only
+  // help streams with several slices, others get them only on request.
+  threading.mode = params.mode;
+  if (threading.mode == VideoDecoderThreadMode::AUTO)
+  {
+    const bool uhd = params.width * params.height > HD_PIXELS;
+    const bool useSlices = params.slices > 1 || params.lowLatency;
+    threading.mode = params.live && !uhd && useSlices ? VideoDecoderThreadMode::SLICE
+                                                   : VideoDecoderThreadMode::FRAME;
+  }
+
+  if (params.threads > 0)
+    threading.threads = params.threads;
+  else if (threading.mode == VideoDecoderThreadMode::FRAME)
+    threading.threads = std::min(ThreadsForStream(params), cpuCount * 3 / 2);
+  else
+    threading.threads = std::min(ThreadsForStream(params), cpuCount);
+
+  // a slice thread without a slice of its own has nothing to do
+  if (threading.mode == VideoDecoderThreadMode::SLICE && params.threads <= 0 && params.slices > 0)
+    threading.threads = std::min(threading.threads, params.slices);
+
+  // every frame thread beyond the first holds back one more frame
+  if (threading.mode == VideoDecoderThreadMode::FRAME && params.live && params.liveMaxDelay > 0)
+  {
+    const double fps = params.fps > 0.0 ? params.fps : DEFAULT_FPS;
+    const int delayFrames = static_cast<int>(params.liveMaxDelay * fps / 1000.0);
+    threading.threads = std::min(threading.threads, delayFrames + 1);
+  }
+
+  threading.threads = std::max(1, std::min(threading.threads, MAX_THREADS));
+  return threading;
+}
@@ -0,0 +1,59 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <string>
+
+enum class VideoDecoderThreadMode
+{
+  AUTO,
+  FRAME,
+  SLICE,
+};
+
+struct VideoDecoderThreadingParams
+{
+  VideoDecoderThreadMode mode = VideoDecoderThreadMode::AUTO;
+  int threads = 0; //!< requested thread count, 0 derives it from the stream and the cpu
+  int liveMaxDelay = 0; //!< frame threading delay in ms allowed for live streams, 0 for no limit
+  int cpuCount = 1;
+  int width = 0;
+  int height = 0;
+  int bitDepth = 8;
+  int slices = 0; //!< slices per frame, 0 if unknown
+  double fps = 0.0;
+  bool live = false;
+  bool lowLatency = false; //!< slice threads for live streams whatever their slices
+};
+
+struct VideoDecoderThreading
+{
+  VideoDecoderThreadMode mode = VideoDecoderThreadMode::FRAME; //!< never AUTO
+  int threads = 1;
+};
+
+/*!
+ * \brief Threading policy for the software video decoders.
+ *
+ * Frame threading scales best but delays every frame by one frame per extra
+ * thread, slice threading adds no delay but only helps streams with several
+ * slices per frame. Live streams only get slice threads by default if they
+ * are known to have several slices. The thread count follows the amount of work per frame,
+ * small streams don't get threads they can't keep busy.
+ */
+class CVideoDecoderThreading
+{
+public:
+  static constexpr int MAX_THREADS = 16;
+
+  static VideoDecoderThreadMode ModeFromString(const std::string& mode);
+  static const char* ModeToString(VideoDecoderThreadMode mode);
+
+  static VideoDecoderThreading Select(const VideoDecoderThreadingParams& params);
+};
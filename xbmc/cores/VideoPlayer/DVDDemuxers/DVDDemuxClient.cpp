@@ -326,7 +326,7 @@ DemuxPacket* CDVDDemuxClient::Read()
   if (m_packet->iStreamId == DMX_SPECIALID_STREAMINFO)
   {
     RequestStreams();
-    CDVDDemuxUtils::FreeDemuxPacket(m_packet.release());
+    m_packet.reset();
     return CDVDDemuxUtils::AllocateDemuxPacket(0);
   }
   else if (m_packet->iStreamId == DMX_SPECIALID_STREAMCHANGE)
@@ -347,7 +347,7 @@ DemuxPacket* CDVDDemuxClient::Read()
 
   if (!IsVideoReady())
   {
-    CDVDDemuxUtils::FreeDemuxPacket(m_packet.release());
+    m_packet.reset();
     DemuxPacket *pPacket = CDVDDemuxUtils::AllocateDemuxPacket(0);
     pPacket->demuxerId = m_demuxerId;
     return pPacket;
@@ -8,8 +8,8 @@
 
 #include "DVDDemuxUtils.h"
 
+#include "DemuxPacketPool.h"
 #include "cores/VideoPlayer/Interface/DemuxCrypto.h"
-#include "utils/MemUtils.h"
 #include "utils/log.h"
 
 extern "C" {
@@ -20,8 +20,6 @@ void CDVDDemuxUtils::FreeDemuxPacket(DemuxPacket* pPacket)
 {
   if (pPacket)
   {
-    if (pPacket->pData)
-      KODI::MEMORY::AlignedFree(pPacket->pData);
     if (pPacket->iSideDataElems)
     {
       AVPacket* avPkt = av_packet_alloc();
@@ -42,40 +40,32 @@ void CDVDDemuxUtils::FreeDemuxPacket(DemuxPacket* pPacket)
         // here we make use of ffmpeg to free the side_data, we shouldn't have to allocate an intermediate AVPacket though
         av_packet_free(&avPkt);
       }
+      pPacket->pSideData = nullptr;
+      pPacket->iSideDataElems = 0;
     }
     if (pPacket->cryptoInfo)
+    {
       delete pPacket->cryptoInfo;
-    delete pPacket;
+      pPacket->cryptoInfo = nullptr;
+    }
+
+    // the payload buffer is kept for the next packet of a similar size
+    CDemuxPacketPool::GetInstance().Release(pPacket);
   }
 }
 
 DemuxPacket* CDVDDemuxUtils::AllocateDemuxPacket(int iDataSize)
 {
-  DemuxPacket* pPacket = new DemuxPacket();
-
-  if (iDataSize > 0)
-  {
-    // need to allocate a few bytes more.
-    // From avcodec.h (ffmpeg)
-    /**
-     * Required number of additionally allocated bytes at the end of the input bitstream for decoding.
-     * this is mainly needed because some optimized bitstream readers read
-     * 32 or 64 bit at once and could read over the end<br>
-     * Note, if the first 23 bits of the additional bytes are not 0 then damaged
-     * MPEG bitstreams could cause overread and segfault
-     */
-    pPacket->pData = static_cast<uint8_t*>(KODI::MEMORY::AlignedMalloc(iDataSize + AV_INPUT_BUFFER_PADDING_SIZE, 16));
-    if (!pPacket->pData)
-    {
-      FreeDemuxPacket(pPacket);
-      return NULL;
-    }
-
-    // reset the last 8 bytes to 0;
-    memset(pPacket->pData + iDataSize, 0, AV_INPUT_BUFFER_PADDING_SIZE);
-  }
-
-  return pPacket;
+  // the pool allocates a few bytes more and zeroes them.
+  // From avcodec.h (ffmpeg)
+  /**
+   * Required number of additionally allocated bytes at the end of the input bitstream for decoding.
+   * this is mainly needed because some optimized bitstream readers read
+   * 32 or 64 bit at once and could read over the end<br>
+   * Note, if the first 23 bits of the additional bytes are not 0 then damaged
+   * MPEG bitstreams could cause overread and segfault
+   */
+  return CDemuxPacketPool::GetInstance().Acquire(iDataSize);
 }
 
 DemuxPacket* CDVDDemuxUtils::AllocateDemuxPacket(unsigned int iDataSize, unsigned int encryptedSubsampleCount)
@@ -22,3 +22,8 @@ public:
   static void StoreSideData(DemuxPacket *pkt, AVPacket *src);
 };
 
+struct DemuxPacketDeleter
+{
+  void operator()(DemuxPacket* pPacket) const { CDVDDemuxUtils::FreeDemuxPacket(pPacket); }
+};
+
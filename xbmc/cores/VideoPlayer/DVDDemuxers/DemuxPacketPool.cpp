@@ -0,0 +1,195 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxPacketPool.h"
+
+#include "cores/VideoPlayer/Interface/DemuxPacket.h"
+#include "utils/MemUtils.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+CDemuxPacketPool& CDemuxPacketPool::GetInstance()
+{
+  static CDemuxPacketPool pool;
+  return pool;
+}
+
+CDemuxPacketPool::~CDemuxPacketPool()
+{
+  Trim();
+}
+
+int CDemuxPacketPool::GetSizeClass(size_t size)
+{
+  unsigned int shift = MIN_CLASS_SHIFT;
+  while (shift <= MAX_CLASS_SHIFT && (static_cast<size_t>(1) << shift) < size)
+    shift++;
+
+  if (shift > MAX_CLASS_SHIFT)
+    return -1;
+
+  return shift - MIN_CLASS_SHIFT;
+}
+
+size_t CDemuxPacketPool::GetClassCapacity(int sizeClass)
+{
+  return static_cast<size_t>(1) << (sizeClass + MIN_CLASS_SHIFT);
+}
+
+void CDemuxPacketPool::FreePacket(DemuxPacket* pPacket)
+{
+  if (pPacket->pData)
+    KODI::MEMORY::AlignedFree(pPacket->pData);
+  delete pPacket;
+}
+
+DemuxPacket* CDemuxPacketPool::Acquire(int iDataSize)
+{
+  DemuxPacket* pPacket = nullptr;
+
+  if (iDataSize <= 0)
+  {
+    {
+      std::unique_lock<CCriticalSection> lock(m_section);
+      if (!m_freeShells.empty())
+      {
+        pPacket = m_freeShells.back();
+        m_freeShells.pop_back();
+      }
+    }
+
+    if (!pPacket)
+      return new DemuxPacket();
+
+    *pPacket = DemuxPacket();
+    return pPacket;
+  }
+
+  const size_t size = static_cast<size_t>(iDataSize);
+  const int sizeClass = GetSizeClass(size);
+  const size_t capacity = sizeClass < 0 ? size : GetClassCapacity(sizeClass);
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+
+    m_stats.requests++;
+    if (sizeClass >= 0 && !m_free[sizeClass].empty())
+    {
+      pPacket = m_free[sizeClass].back();
+      m_free[sizeClass].pop_back();
+      m_stats.hits++;
+      m_stats.bytesPooled -= capacity;
+    }
+    m_stats.bytesInUse += capacity;
+    m_stats.bytesInUsePeak = std::max(m_stats.bytesInUsePeak, m_stats.bytesInUse);
+  }
+
+  if (pPacket)
+  {
+    uint8_t* pData = pPacket->pData;
+    *pPacket = DemuxPacket();
+    pPacket->pData = pData;
+    pPacket->m_bufferSize = capacity;
+  }
+  else
+  {
+    pPacket = new DemuxPacket();
+    pPacket->pData = static_cast<uint8_t*>(
+        KODI::MEMORY::AlignedMalloc(capacity + AV_INPUT_BUFFER_PADDING_SIZE, 16));
+    if (!pPacket->pData)
+    {
+      delete pPacket;
+
+      std::unique_lock<CCriticalSection> lock(m_section);
+      m_stats.bytesInUse -= capacity;
+      return nullptr;
+    }
+    pPacket->m_bufferSize = capacity;
+  }
+
+  // ffmpeg requires the padding after the payload to be zeroed
+  memset(pPacket->pData + size, 0, AV_INPUT_BUFFER_PADDING_SIZE);
+
+  return pPacket;
+}
+
+void CDemuxPacketPool::Release(DemuxPacket* pPacket)
+{
+  if (!pPacket)
+    return;
+
+  if (!pPacket->pData)
+  {
+    {
+      std::unique_lock<CCriticalSection> lock(m_section);
+      if (m_freeShells.size() < MAX_FREE_SHELLS)
+      {
+        m_freeShells.push_back(pPacket);
+        return;
+      }
+    }
+    delete pPacket;
+    return;
+  }
+
+  const size_t capacity = pPacket->m_bufferSize;
+  const int sizeClass = GetSizeClass(capacity);
+  const bool poolable = sizeClass >= 0 && GetClassCapacity(sizeClass) == capacity;
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+
+    m_stats.bytesInUse -= std::min(m_stats.bytesInUse, capacity);
+
+    if (poolable)
+    {
+      const size_t maxEntries = std::max<size_t>(2, CLASS_BUDGET / capacity);
+      if (m_free[sizeClass].size() < maxEntries)
+      {
+        m_free[sizeClass].push_back(pPacket);
+        m_stats.bytesPooled += capacity;
+        m_stats.bytesPooledPeak = std::max(m_stats.bytesPooledPeak, m_stats.bytesPooled);
+        return;
+      }
+    }
+  }
+
+  FreePacket(pPacket);
+}
+
+void CDemuxPacketPool::Trim()
+{
+  std::vector<DemuxPacket*> packets;
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    for (auto& freeList : m_free)
+    {
+      packets.insert(packets.end(), freeList.begin(), freeList.end());
+      freeList.clear();
+    }
+    packets.insert(packets.end(), m_freeShells.begin(), m_freeShells.end());
+    m_freeShells.clear();
+    m_stats.bytesPooled = 0;
+  }
+
+  for (DemuxPacket* pPacket : packets)
+    FreePacket(pPacket);
+}
+
+CDemuxPacketPool::Stats CDemuxPacketPool::GetStats() const
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  return m_stats;
+}
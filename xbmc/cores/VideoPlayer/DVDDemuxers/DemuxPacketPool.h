@@ -0,0 +1,84 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct DemuxPacket;
+
+/*!
+ * \brief Thread-safe recycler for DemuxPacket objects and their payload buffers.
+ *
+ * Payloads are grouped into power-of-two size classes. A released packet keeps its
+ * buffer and is handed out again to the next request that fits into the same class,
+ * so steady state playback does not hit the heap for every packet.
+ * Payloads larger than the biggest class bypass the pool.
+ */
+class CDemuxPacketPool
+{
+public:
+  struct Stats
+  {
+    uint64_t requests = 0; //!< buffers requested from the pool
+    uint64_t hits = 0; //!< requests served from a recycled buffer
+    size_t bytesInUse = 0; //!< payload bytes currently handed out
+    size_t bytesInUsePeak = 0; //!< high-water mark of bytesInUse
+    size_t bytesPooled = 0; //!< payload bytes kept for reuse
+    size_t bytesPooledPeak = 0; //!< high-water mark of bytesPooled
+
+    double HitRate() const { return requests ? static_cast<double>(hits) / requests : 0.0; }
+  };
+
+  static CDemuxPacketPool& GetInstance();
+
+  /*!
+   * \brief Get a cleared packet with room for at least iDataSize bytes of payload
+   * plus the padding required by ffmpeg. The padding is zeroed.
+   * \return nullptr if the payload could not be allocated
+   */
+  DemuxPacket* Acquire(int iDataSize);
+
+  /*!
+   * \brief Give a packet back. Side data and crypto info must already be freed.
+   */
+  void Release(DemuxPacket* pPacket);
+
+  /*!
+   * \brief Free all recycled packets, e.g. after playback has ended.
+   */
+  void Trim();
+
+  Stats GetStats() const;
+
+private:
+  CDemuxPacketPool() = default;
+  ~CDemuxPacketPool();
+  CDemuxPacketPool(const CDemuxPacketPool&) = delete;
+  CDemuxPacketPool& operator=(const CDemuxPacketPool&) = delete;
+
+  static constexpr unsigned int MIN_CLASS_SHIFT = 10; // 1 KiB
+  static constexpr unsigned int MAX_CLASS_SHIFT = 23; // 8 MiB
+  static constexpr unsigned int NUM_CLASSES = MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1;
+  static constexpr size_t CLASS_BUDGET = 8 * 1024 * 1024;
+  static constexpr size_t MAX_FREE_SHELLS = 256;
+
+  static int GetSizeClass(size_t size);
+  static size_t GetClassCapacity(int sizeClass);
+  static void FreePacket(DemuxPacket* pPacket);
+
+  mutable CCriticalSection m_section;
+  std::array<std::vector<DemuxPacket*>, NUM_CLASSES> m_free;
+  std::vector<DemuxPacket*> m_freeShells;
+  Stats m_stats;
+};
@@ -32,33 +32,64 @@ CDVDMessageQueue::~CDVDMessageQueue()
 {
   // remove all remaining messages
   Flush(CDVDMsg::NONE);
+  m_ring.clear();
 }
 
 void CDVDMessageQueue::Init()
 {
   m_iDataSize = 0;
   m_bAbortRequest = false;
-  m_bInitialized = true;
   m_TimeBack = DVD_NOPTS_VALUE;
   m_TimeFront = DVD_NOPTS_VALUE;
   m_drain = false;
+
+  // neither producer nor consumer are running yet
+  if (m_ringEnabled)
+  {
+    m_ring.clear();
+    m_ring.resize(RING_SIZE);
+    m_ringHead = 0;
+    m_ringTail = 0;
+    m_ringFlush = 0;
+    m_producer = std::this_thread::get_id();
+  }
+
+  m_bInitialized = true;
 }
 
 void CDVDMessageQueue::Flush(CDVDMsg::Message type)
 {
   std::unique_lock<CCriticalSection> lock(m_section);
 
-  m_messages.remove_if([type](const DVDMessageListItem &item){
-    return type == CDVDMsg::NONE || item.message->IsType(type);
+  m_messages.remove_if([this, type](const DVDMessageListItem &item){
+    if (type != CDVDMsg::NONE && !item.message->IsType(type))
+      return false;
+
+    if (item.message->IsType(CDVDMsg::DEMUXER_PACKET))
+      m_iDataSize -= PacketSize(item.message);
+    return true;
   });
 
   m_prioMessages.remove_if([type](const DVDMessageListItem &item){
     return type == CDVDMsg::NONE || item.message->IsType(type);
   });
 
+  m_messageCount = m_messages.size();
+
   if (type == CDVDMsg::DEMUXER_PACKET ||  type == CDVDMsg::NONE)
   {
-    m_iDataSize = 0;
+    // the ring only holds demuxer packets. the consumer drops everything below the
+    // flush mark the next time it looks at the ring. it only takes packets under the
+    // lock, so their size is removed here. a packet the producer is putting meanwhile
+    // has been accounted before being published and stays in the ring
+    if (!m_ring.empty())
+    {
+      const uint64_t tail = m_ringTail.load();
+      for (uint64_t i = std::max(m_ringHead.load(), m_ringFlush.load()); i < tail; ++i)
+        m_iDataSize -= m_ring[i % m_ring.size()].size;
+      m_ringFlush = tail;
+    }
+
     m_TimeBack = DVD_NOPTS_VALUE;
     m_TimeFront = DVD_NOPTS_VALUE;
   }
@@ -80,6 +111,10 @@ void CDVDMessageQueue::End()
 
   Flush(CDVDMsg::NONE);
 
+  // the consumer has been stopped, release the packets still held by the ring
+  for (auto& slot : m_ring)
+    slot.message.reset();
+
   m_bInitialized = false;
   m_iDataSize = 0;
   m_bAbortRequest = false;
@@ -99,6 +134,12 @@ MsgQueueReturnCode CDVDMessageQueue::Put(const std::shared_ptr<CDVDMsg>& pMsg,
                                          int priority,
                                          bool front)
 {
+  // fast path for plain data packets coming from the producer thread
+  if (m_ringEnabled && front && priority == 0 && m_bInitialized && pMsg &&
+      pMsg->IsType(CDVDMsg::DEMUXER_PACKET) && std::this_thread::get_id() == m_producer &&
+      PutRing(pMsg))
+    return MSGQ_OK;
+
   std::unique_lock<CCriticalSection> lock(m_section);
 
   if (!m_bInitialized)
@@ -126,17 +167,17 @@ MsgQueueReturnCode CDVDMessageQueue::Put(const std::shared_ptr<CDVDMsg>& pMsg,
   }
   else
   {
-    if (m_messages.empty())
+    if (m_messages.empty() && !HasRingData())
     {
-      m_iDataSize = 0;
       m_TimeBack = DVD_NOPTS_VALUE;
       m_TimeFront = DVD_NOPTS_VALUE;
     }
 
     if (front)
-      m_messages.emplace_front(pMsg, priority);
+      m_messages.emplace_front(pMsg, priority, m_sequence++);
     else
-      m_messages.emplace_back(pMsg, priority);
+      m_messages.emplace_back(pMsg, priority, --m_backSequence);
+    m_messageCount = m_messages.size();
   }
 
   if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET) && priority == 0)
@@ -146,9 +187,9 @@ MsgQueueReturnCode CDVDMessageQueue::Put(const std::shared_ptr<CDVDMsg>& pMsg,
     {
       m_iDataSize += packet->iSize;
       if (front)
-        UpdateTimeFront();
+        UpdateTimeFront(pMsg);
       else
-        UpdateTimeBack();
+        UpdateTimeBack(pMsg);
     }
   }
 
@@ -158,6 +199,124 @@ MsgQueueReturnCode CDVDMessageQueue::Put(const std::shared_ptr<CDVDMsg>& pMsg,
   return MSGQ_OK;
 }
 
+bool CDVDMessageQueue::PutRing(const std::shared_ptr<CDVDMsg>& pMsg)
+{
+  const uint64_t tail = m_ringTail.load(std::memory_order_relaxed);
+  const uint64_t head = m_ringHead.load();
+  if (tail - head >= m_ring.size())
+    return false;
+
+  if (tail <= std::max(head, m_ringFlush.load()) && m_messageCount == 0)
+  {
+    m_TimeBack = DVD_NOPTS_VALUE;
+    m_TimeFront = DVD_NOPTS_VALUE;
+  }
+
+  // account before publishing, the packet may be taken or flushed right away. the size
+  // is only ever changed by adding or removing the size of a packet, so it stays exact
+  // without the producer taking the lock
+  RingSlot& slot = m_ring[tail % m_ring.size()];
+  slot.message = pMsg;
+  slot.size = PacketSize(pMsg);
+  slot.sequence = m_sequence++;
+  m_iDataSize += slot.size;
+  UpdateTimeFront(pMsg);
+  m_ringTail = tail + 1;
+
+  // only wake the consumer if it is actually waiting
+  if (m_waiting)
+    m_hEvent.Set();
+
+  return true;
+}
+
+CDVDMessageQueue::RingSlot* CDVDMessageQueue::PeekRing()
+{
+  if (m_ring.empty())
+    return nullptr;
+
+  uint64_t head = m_ringHead.load(std::memory_order_relaxed);
+  const uint64_t flush = m_ringFlush.load();
+  while (head < flush)
+  {
+    m_ring[head % m_ring.size()].message.reset();
+    m_ringHead = ++head;
+  }
+
+  if (head == m_ringTail.load())
+    return nullptr;
+
+  return &m_ring[head % m_ring.size()];
+}
+
+bool CDVDMessageQueue::HasRingData() const
+{
+  if (m_ring.empty())
+    return false;
+
+  const uint64_t head = std::max(m_ringHead.load(), m_ringFlush.load());
+  return m_ringTail.load() > head;
+}
+
+unsigned CDVDMessageQueue::RingPacketCount() const
+{
+  if (m_ring.empty())
+    return 0;
+
+  const uint64_t head = std::max(m_ringHead.load(), m_ringFlush.load());
+  const uint64_t tail = m_ringTail.load();
+  return tail > head ? static_cast<unsigned>(tail - head) : 0;
+}
+
+const std::shared_ptr<CDVDMsg>* CDVDMessageQueue::PeekOldest()
+{
+  RingSlot* slot = PeekRing();
+  if (slot && (m_messages.empty() || slot->sequence < m_messages.back().sequence))
+    return &slot->message;
+  if (!m_messages.empty())
+    return &m_messages.back().message;
+  return nullptr;
+}
+
+bool CDVDMessageQueue::TakeRing(std::shared_ptr<CDVDMsg>& pMsg)
+{
+  RingSlot* slot = PeekRing();
+  if (!slot)
+    return false;
+
+  pMsg = std::move(slot->message);
+  m_iDataSize -= slot->size;
+  m_ringHead = m_ringHead.load(std::memory_order_relaxed) + 1;
+
+  return true;
+}
+
+bool CDVDMessageQueue::TakeOldest(std::shared_ptr<CDVDMsg>& pMsg)
+{
+  RingSlot* slot = PeekRing();
+  if (slot && (m_messages.empty() || slot->sequence < m_messages.back().sequence))
+    return TakeRing(pMsg);
+
+  if (m_messages.empty())
+    return false;
+
+  DVDMessageListItem& item(m_messages.back());
+  pMsg = std::move(item.message);
+  m_messages.pop_back();
+  m_messageCount = m_messages.size();
+
+  if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET))
+    m_iDataSize -= PacketSize(pMsg);
+
+  return true;
+}
+
+int CDVDMessageQueue::PacketSize(const std::shared_ptr<CDVDMsg>& pMsg)
+{
+  DemuxPacket* packet = static_cast<CDVDMsgDemuxerPacket*>(pMsg.get())->GetPacket();
+  return packet ? packet->iSize : 0;
+}
+
 MsgQueueReturnCode CDVDMessageQueue::Get(std::shared_ptr<CDVDMsg>& pMsg,
                                          std::chrono::milliseconds timeout,
                                          int& priority)
@@ -174,27 +333,28 @@ MsgQueueReturnCode CDVDMessageQueue::Get(std::shared_ptr<CDVDMsg>& pMsg,
 
   while (!m_bAbortRequest)
   {
-    std::list<DVDMessageListItem> &msgs = (priority > 0 || !m_prioMessages.empty()) ? m_prioMessages : m_messages;
-
-    if (!msgs.empty() && (msgs.back().priority >= priority || m_drain))
+    if (priority > 0 || !m_prioMessages.empty())
     {
-      DVDMessageListItem& item(msgs.back());
-      priority = item.priority;
-
-      if (item.message->IsType(CDVDMsg::DEMUXER_PACKET) && item.priority == 0)
+      if (!m_prioMessages.empty() && (m_prioMessages.back().priority >= priority || m_drain))
       {
-        DemuxPacket* packet =
-            std::static_pointer_cast<CDVDMsgDemuxerPacket>(item.message)->GetPacket();
-        if (packet)
-        {
-          m_iDataSize -= packet->iSize;
-        }
+        DVDMessageListItem& item(m_prioMessages.back());
+        priority = item.priority;
+        pMsg = std::move(item.message);
+        m_prioMessages.pop_back();
+        ret = MSGQ_OK;
       }
-
-      pMsg = std::move(item.message);
-      msgs.pop_back();
-      UpdateTimeBack();
+    }
+    else if (TakeOldest(pMsg))
+    {
+      priority = 0;
       ret = MSGQ_OK;
+    }
+
+    if (ret == MSGQ_OK)
+    {
+      const std::shared_ptr<CDVDMsg>* next = PeekOldest();
+      if (next)
+        UpdateTimeBack(*next);
       break;
     }
     else if (timeout == 0ms)
@@ -204,11 +364,22 @@ MsgQueueReturnCode CDVDMessageQueue::Get(std::shared_ptr<CDVDMsg>& pMsg,
     }
     else
     {
+      m_waiting = true;
       m_hEvent.Reset();
+
+      // the producer does not take the lock for ring packets, check again after the reset
+      if (priority == 0 && m_prioMessages.empty() && HasRingData())
+      {
+        m_waiting = false;
+        continue;
+      }
+
       lock.unlock();
 
       // wait for a new message
-      if (!m_hEvent.Wait(timeout))
+      const bool signaled = m_hEvent.Wait(timeout);
+      m_waiting = false;
+      if (!signaled)
         return MSGQ_TIMEOUT;
 
       lock.lock();
@@ -221,48 +392,38 @@ MsgQueueReturnCode CDVDMessageQueue::Get(std::shared_ptr<CDVDMsg>& pMsg,
   return (MsgQueueReturnCode)ret;
 }
 
-void CDVDMessageQueue::UpdateTimeFront()
+void CDVDMessageQueue::UpdateTimeFront(const std::shared_ptr<CDVDMsg>& pMsg)
 {
-  if (!m_messages.empty())
+  if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET))
   {
-    auto &item = m_messages.front();
-    if (item.message->IsType(CDVDMsg::DEMUXER_PACKET))
+    DemuxPacket* packet = std::static_pointer_cast<CDVDMsgDemuxerPacket>(pMsg)->GetPacket();
+    if (packet)
     {
-      DemuxPacket* packet =
-          std::static_pointer_cast<CDVDMsgDemuxerPacket>(item.message)->GetPacket();
-      if (packet)
-      {
-        if (packet->dts != DVD_NOPTS_VALUE)
-          m_TimeFront = packet->dts;
-        else if (packet->pts != DVD_NOPTS_VALUE)
-          m_TimeFront = packet->pts;
+      if (packet->dts != DVD_NOPTS_VALUE)
+        m_TimeFront = packet->dts;
+      else if (packet->pts != DVD_NOPTS_VALUE)
+        m_TimeFront = packet->pts;
 
-        if (m_TimeBack == DVD_NOPTS_VALUE)
-          m_TimeBack = m_TimeFront;
-      }
+      if (m_TimeBack == DVD_NOPTS_VALUE)
+        m_TimeBack = m_TimeFront.load();
     }
   }
 }
 
-void CDVDMessageQueue::UpdateTimeBack()
+void CDVDMessageQueue::UpdateTimeBack(const std::shared_ptr<CDVDMsg>& pMsg)
 {
-  if (!m_messages.empty())
+  if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET))
   {
-    auto &item = m_messages.back();
-    if (item.message->IsType(CDVDMsg::DEMUXER_PACKET))
+    DemuxPacket* packet = std::static_pointer_cast<CDVDMsgDemuxerPacket>(pMsg)->GetPacket();
+    if (packet)
     {
-      DemuxPacket* packet =
-          std::static_pointer_cast<CDVDMsgDemuxerPacket>(item.message)->GetPacket();
-      if (packet)
-      {
-        if (packet->dts != DVD_NOPTS_VALUE)
-          m_TimeBack = packet->dts;
-        else if (packet->pts != DVD_NOPTS_VALUE)
-          m_TimeBack = packet->pts;
+      if (packet->dts != DVD_NOPTS_VALUE)
+        m_TimeBack = packet->dts;
+      else if (packet->pts != DVD_NOPTS_VALUE)
+        m_TimeBack = packet->pts;
 
-        if (m_TimeFront == DVD_NOPTS_VALUE)
-          m_TimeFront = m_TimeBack;
-      }
+      if (m_TimeFront == DVD_NOPTS_VALUE)
+        m_TimeFront = m_TimeBack.load();
     }
   }
 }
@@ -285,6 +446,8 @@ unsigned CDVDMessageQueue::GetPacketCount(CDVDMsg::Message type)
     if(item.message->IsType(type))
       count++;
   }
+  if (type == CDVDMsg::DEMUXER_PACKET)
+    count += RingPacketCount();
 
   return count;
 }
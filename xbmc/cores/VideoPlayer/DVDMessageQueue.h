@@ -16,12 +16,16 @@
 #include <atomic>
 #include <list>
 #include <string>
+#include <thread>
+#include <vector>
 
 struct DVDMessageListItem
 {
-  DVDMessageListItem(std::shared_ptr<CDVDMsg> msg, int prio) : message(std::move(msg))
+  DVDMessageListItem(std::shared_ptr<CDVDMsg> msg, int prio, int64_t seq = 0)
+    : message(std::move(msg))
   {
     priority = prio;
+    sequence = seq;
   }
   DVDMessageListItem() { priority = 0; }
   DVDMessageListItem(const DVDMessageListItem&) = delete;
@@ -31,6 +35,7 @@ struct DVDMessageListItem
 
   std::shared_ptr<CDVDMsg> message;
   int priority;
+  int64_t sequence = 0;
 };
 
 enum MsgQueueReturnCode
@@ -73,6 +78,13 @@ public:
     return Get(pMsg, timeout, priority);
   }
 
+  /*!
+   * \brief Let demuxer packets that are put by the thread calling Init() bypass the lock
+   * through a single-producer/single-consumer ring. Requires a single thread calling Get().
+   * Must be set before Init().
+   */
+  void SetSingleProducerMode(bool enabled) { m_ringEnabled = enabled; }
+
   int GetDataSize() const { return m_iDataSize; }
   int GetTimeSize() const;
   unsigned GetPacketCount(CDVDMsg::Message type);
@@ -92,19 +104,36 @@ public:
 
 private:
   MsgQueueReturnCode Put(const std::shared_ptr<CDVDMsg>& pMsg, int priority, bool front);
-  void UpdateTimeFront();
-  void UpdateTimeBack();
+  void UpdateTimeFront(const std::shared_ptr<CDVDMsg>& pMsg);
+  void UpdateTimeBack(const std::shared_ptr<CDVDMsg>& pMsg);
+  static int PacketSize(const std::shared_ptr<CDVDMsg>& pMsg);
+
+  // ring of demuxer packets, written by the producer thread without the lock and read by the
+  // consumer under the lock
+  struct RingSlot
+  {
+    std::shared_ptr<CDVDMsg> message;
+    int size = 0;
+    int64_t sequence = 0;
+  };
+  bool PutRing(const std::shared_ptr<CDVDMsg>& pMsg);
+  bool TakeRing(std::shared_ptr<CDVDMsg>& pMsg);
+  bool TakeOldest(std::shared_ptr<CDVDMsg>& pMsg);
+  const std::shared_ptr<CDVDMsg>* PeekOldest();
+  RingSlot* PeekRing();
+  bool HasRingData() const;
+  unsigned RingPacketCount() const;
 
   CEvent m_hEvent;
   mutable CCriticalSection m_section;
 
   std::atomic<bool> m_bAbortRequest = false;
-  bool m_bInitialized;
+  std::atomic<bool> m_bInitialized;
   bool m_drain = false;
 
-  int m_iDataSize;
-  double m_TimeFront;
-  double m_TimeBack;
+  std::atomic<int> m_iDataSize;
+  std::atomic<double> m_TimeFront;
+  std::atomic<double> m_TimeBack;
   double m_TimeSize;
 
   int m_iMaxDataSize;
@@ -112,5 +141,19 @@ private:
 
   std::list<DVDMessageListItem> m_messages;
   std::list<DVDMessageListItem> m_prioMessages;
+  std::atomic<size_t> m_messageCount{0};
+
+  static constexpr size_t RING_SIZE = 4096;
+  bool m_ringEnabled = false;
+  std::thread::id m_producer;
+  std::vector<RingSlot> m_ring;
+  std::atomic<uint64_t> m_ringHead{0};
+  std::atomic<uint64_t> m_ringTail{0};
+  std::atomic<uint64_t> m_ringFlush{0};
+  std::atomic<bool> m_waiting{false};
+
+  // messages are taken in order of sequence, PutBack() counts down from zero
+  std::atomic<int64_t> m_sequence{1};
+  int64_t m_backSequence = 0;
 };
 
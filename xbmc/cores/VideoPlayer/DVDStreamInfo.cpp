@@ -44,6 +44,7 @@ void CDVDStreamInfo::Clear()
   flags = 0;
   filename.clear();
   dvd = false;
+  realtime = false;
 
   extradata = {};
 
@@ -199,6 +200,7 @@ void CDVDStreamInfo::Assign(const CDVDStreamInfo& right, bool withextradata)
   flags = right.flags;
   filename = right.filename;
   dvd = right.dvd;
+  realtime = right.realtime;
 
   if (withextradata && right.extradata)
   {
@@ -53,6 +53,7 @@ public:
   int flags;
   std::string filename;
   bool dvd;
+  bool realtime; // stream comes from a live input, e.g. live TV
   int codecOptions;
 
   // VIDEO
@@ -15,6 +15,7 @@
 #include "DVDDemuxers/DVDDemuxUtils.h"
 #include "DVDDemuxers/DVDDemuxVobsub.h"
 #include "DVDDemuxers/DVDFactoryDemuxer.h"
+#include "DVDDemuxers/DemuxPacketPool.h"
 #include "DVDInputStreams/DVDFactoryInputStream.h"
 #include "DVDInputStreams/DVDInputStream.h"
 #include "DVDMessage.h"
@@ -2584,6 +2585,15 @@ void CVideoPlayer::OnExit()
 
   m_messenger.End();
 
+  const CDemuxPacketPool::Stats poolStats = CDemuxPacketPool::GetInstance().GetStats();
+  CLog::Log(LOGDEBUG,
+            "CVideoPlayer::OnExit - packet pool: {} requests, {:.1f}% hit, peak in use {}, peak "
+            "pooled {}",
+            poolStats.requests, poolStats.HitRate() * 100,
+            StringUtils::SizeToString(poolStats.bytesInUsePeak),
+            StringUtils::SizeToString(poolStats.bytesPooledPeak));
+  CDemuxPacketPool::GetInstance().Trim();
+
   CFFmpegLog::ClearLogLevel();
   m_bStop = true;
 
@@ -3307,6 +3317,10 @@ void CVideoPlayer::GetGeneralInfo(std::string& strGeneralInfo)
         strBuf += StringUtils::Format(" {} msec", DVD_TIME_TO_MSEC(m_State.cache_delay));
     }
 
+    const CDemuxPacketPool::Stats poolStats = CDemuxPacketPool::GetInstance().GetStats();
+    strBuf += StringUtils::Format(", pkt pool: {:.0f}% hit, peak {}", poolStats.HitRate() * 100,
+                                  StringUtils::SizeToString(poolStats.bytesInUsePeak));
+
     strGeneralInfo = StringUtils::Format("Player: a/v:{: 6.3f}, {}", dDiff, strBuf);
   }
 }
@@ -3739,6 +3753,10 @@ bool CVideoPlayer::OpenVideoStream(CDVDStreamInfo& hint, bool reset)
   if(pMenus && pMenus->IsInMenu())
     hint.stills = true;
 
+  // the decoder picks its threading by this, the realtime state of the player is only
+  // updated later on, the audio sync of the first streams depends on that
+  hint.realtime = m_pInputStream && m_pInputStream->IsRealtime();
+
   if (hint.stereo_mode.empty())
   {
     CGUIComponent *gui = CServiceBroker::GetGUI();
@@ -5078,6 +5096,15 @@ bool CVideoPlayer::RenderCaptureGetPixels(unsigned int captureId, unsigned int m
   return m_renderManager.RenderCaptureGetPixels(captureId, millis, buffer, size);
 }
 
+bool CVideoPlayer::GetRenderPacingStats(CVariant& stats, bool records, bool reset)
+{
+  CRenderPacingStats& pacingStats = m_renderManager.GetPacingStats();
+  pacingStats.Export(stats, records);
+  if (reset)
+    pacingStats.Reset();
+  return true;
+}
+
 void CVideoPlayer::VideoParamsChange()
 {
   m_messenger.Put(std::make_shared<CDVDMsg>(CDVDMsg::PLAYER_AVCHANGE));
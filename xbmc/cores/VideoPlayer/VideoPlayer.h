@@ -354,6 +354,7 @@ public:
   void RenderCapture(unsigned int captureId, unsigned int width, unsigned int height, int flags) override;
   void RenderCaptureRelease(unsigned int captureId) override;
   bool RenderCaptureGetPixels(unsigned int captureId, unsigned int millis, uint8_t *buffer, unsigned int size) override;
+  bool GetRenderPacingStats(CVariant& stats, bool records, bool reset) override;
 
   // IDispResource interface
   void OnLostDisplay() override;
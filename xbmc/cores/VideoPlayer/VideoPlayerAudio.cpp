@@ -63,6 +63,7 @@ CVideoPlayerAudio::CVideoPlayerAudio(CDVDClock* pClock, CDVDMessageQueue& parent
 
   m_messageQueue.SetMaxDataSize(6 * 1024 * 1024);
   m_messageQueue.SetMaxTimeSize(8.0);
+  m_messageQueue.SetSingleProducerMode(true);
   m_disconAdjustTimeMs = processInfo.GetMaxPassthroughOffSyncDuration();
 }
 
@@ -208,6 +209,12 @@ void CVideoPlayerAudio::UpdatePlayerInfo()
   else if (m_synctype == SYNC_RESAMPLE)
     s << ", rr:" << std::fixed << std::setprecision(5) << 1.0 / m_audioSink.GetResampleRatio();
 
+  // buffers copied / passed through by the resample, atempo and sink stages
+  const CAEBufferStats stats = m_audioSink.GetBufferStats();
+  s << ", copies r:" << stats.resample.copied << "/" << stats.resample.forwarded
+    << " t:" << stats.atempo.copied << "/" << stats.atempo.forwarded << " s:" << stats.sink.copied
+    << "/" << stats.sink.forwarded;
+
   SInfo info;
   info.info        = s.str();
   info.pts         = m_audioSink.GetPlayingPts();
@@ -0,0 +1,306 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoPlayerHeadless.h"
+
+#include "DVDCodecs/Audio/DVDAudioCodec.h"
+#include "DVDCodecs/DVDFactoryCodec.h"
+#include "DVDCodecs/Video/DVDVideoCodec.h"
+#include "DVDDemuxers/DVDDemux.h"
+#include "DVDDemuxers/DVDDemuxUtils.h"
+#include "DVDDemuxers/DVDFactoryDemuxer.h"
+#include "DVDInputStreams/DVDFactoryInputStream.h"
+#include "DVDInputStreams/DVDInputStream.h"
+#include "DVDStreamInfo.h"
+#include "FileItem.h"
+#include "Process/ProcessInfo.h"
+#include "URL.h"
+#include "cores/VideoPlayer/Interface/DemuxPacket.h"
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+namespace
+{
+double CpuTimeMs()
+{
+  return static_cast<double>(std::clock()) * 1000 / CLOCKS_PER_SEC;
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+} // namespace
+
+CVideoPlayerHeadless::CVideoPlayerHeadless(const HeadlessPipelineOptions& options)
+  : m_options(options), m_picture(std::make_unique<VideoPicture>())
+{
+  m_renderer.SetOutputSize(m_options.width, m_options.height);
+}
+
+CVideoPlayerHeadless::~CVideoPlayerHeadless()
+{
+  Close();
+}
+
+bool CVideoPlayerHeadless::Open(const CFileItem& item)
+{
+  Close();
+
+  const std::string redactPath = CURL::GetRedacted(item.GetPath());
+
+  m_input = CDVDFactoryInputStream::CreateInputStream(nullptr, item);
+  if (!m_input || !m_input->Open())
+  {
+    CLog::Log(LOGERROR, "CVideoPlayerHeadless::Open - failed to open {}", redactPath);
+    return false;
+  }
+
+  try
+  {
+    m_demuxer.reset(CDVDFactoryDemuxer::CreateDemuxer(m_input));
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "CVideoPlayerHeadless::Open - exception thrown when opening demuxer");
+  }
+  if (!m_demuxer)
+  {
+    CLog::Log(LOGERROR, "CVideoPlayerHeadless::Open - failed to create demuxer for {}",
+              redactPath);
+    return false;
+  }
+
+  CDemuxStream* videoStream = nullptr;
+  CDemuxStream* audioStream = nullptr;
+  for (CDemuxStream* stream : m_demuxer->GetStreams())
+  {
+    if (!stream)
+      continue;
+
+    // ignore picture attachments (e.g. jpeg artwork)
+    if (!videoStream && stream->type == STREAM_VIDEO &&
+        !(stream->flags & AV_DISPOSITION_ATTACHED_PIC))
+      videoStream = stream;
+    else if (!audioStream && stream->type == STREAM_AUDIO)
+      audioStream = stream;
+    else
+      m_demuxer->EnableStream(stream->demuxerId, stream->uniqueId, false);
+  }
+
+  m_processInfo.reset(CProcessInfo::CreateInstance());
+  std::vector<AVPixelFormat> formats = CHeadlessRenderer::GetSupportedFormats();
+  m_processInfo->SetPixFormats(formats);
+
+  if (videoStream && m_options.decodeVideo)
+  {
+    CDVDStreamInfo hint(*videoStream, true);
+    hint.codecOptions = CODEC_FORCE_SOFTWARE;
+    m_videoCodec = CDVDFactoryCodec::CreateVideoCodec(hint, *m_processInfo);
+    if (!m_videoCodec)
+    {
+      CLog::Log(LOGERROR, "CVideoPlayerHeadless::Open - no video codec for {}", redactPath);
+      return false;
+    }
+  }
+  if (videoStream)
+    m_videoStream = videoStream->uniqueId;
+
+  if (audioStream && m_options.decodeAudio)
+  {
+    CDVDStreamInfo hint(*audioStream, true);
+    m_audioCodec = CDVDFactoryCodec::CreateAudioCodec(hint, *m_processInfo, false, true,
+                                                      CAEStreamInfo::STREAM_TYPE_NULL);
+    if (!m_audioCodec)
+      CLog::Log(LOGWARNING, "CVideoPlayerHeadless::Open - no audio codec, not measuring A/V sync");
+  }
+  if (audioStream)
+    m_audioStream = audioStream->uniqueId;
+
+  CLog::Log(LOGDEBUG, "CVideoPlayerHeadless::Open - video: {} audio: {}",
+            m_videoCodec ? m_videoCodec->GetName() : "none",
+            m_audioCodec ? m_audioCodec->GetName() : "none");
+  return true;
+}
+
+void CVideoPlayerHeadless::Close()
+{
+  if (m_picture->videoBuffer)
+  {
+    m_picture->videoBuffer->Release();
+    m_picture->videoBuffer = nullptr;
+  }
+  m_videoCodec.reset();
+  m_audioCodec.reset();
+  m_demuxer.reset();
+  m_input.reset();
+  m_processInfo.reset();
+  m_videoStream = -1;
+  m_audioStream = -1;
+}
+
+bool CVideoPlayerHeadless::Run()
+{
+  if (!m_demuxer)
+    return false;
+
+  m_stats = {};
+  m_firstPts = DVD_NOPTS_VALUE;
+  m_lastPts = DVD_NOPTS_VALUE;
+  m_audioEnd = DVD_NOPTS_VALUE;
+  m_cpuTotal = 0.0;
+  m_presentTotal = 0.0;
+  m_syncErrorTotal = 0.0;
+  m_syncErrorCount = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  m_cpuLast = CpuTimeMs();
+
+  while (m_options.maxFrames <= 0 || m_stats.frames < m_options.maxFrames)
+  {
+    DemuxPacket* packet = m_demuxer->Read();
+    if (!packet)
+      break;
+
+    m_stats.packets++;
+    if (packet->iStreamId == m_videoStream)
+      DecodeVideo(packet);
+    else if (packet->iStreamId == m_audioStream)
+      DecodeAudio(packet);
+
+    CDVDDemuxUtils::FreeDemuxPacket(packet);
+  }
+
+  // squeeze out the pictures the decoder holds back
+  if (m_videoCodec)
+    DecodeVideo(nullptr);
+
+  m_stats.seconds = ElapsedMs(start) / 1000;
+  if (m_firstPts != DVD_NOPTS_VALUE)
+    m_stats.mediaSeconds = (m_lastPts - m_firstPts) / DVD_TIME_BASE;
+  if (m_stats.frames > 0)
+  {
+    m_stats.cpuAvg = m_cpuTotal / m_stats.frames;
+    m_stats.presentAvg = m_presentTotal / m_stats.frames;
+  }
+  if (m_syncErrorCount > 0)
+    m_stats.syncErrorAvg = m_syncErrorTotal / m_syncErrorCount;
+
+  CLog::Log(LOGDEBUG,
+            "CVideoPlayerHeadless::Run - {} frames, {} dropped in {:.3f}s ({:.1f} fps), "
+            "cpu {:.2f}/{:.2f} ms, present {:.2f} ms, sync error {:.1f}/{:.1f} ms",
+            m_stats.frames, m_stats.droppedFrames, m_stats.seconds, m_stats.Fps(),
+            m_stats.cpuAvg, m_stats.cpuMax, m_stats.presentAvg, m_stats.syncErrorAvg,
+            m_stats.syncErrorMax);
+
+  return m_stats.frames > 0 || (!m_videoCodec && m_stats.packets > 0);
+}
+
+void CVideoPlayerHeadless::DecodeVideo(DemuxPacket* packet)
+{
+  if (!m_videoCodec)
+    return;
+
+  if (packet)
+  {
+    if (!m_videoCodec->AddData(*packet))
+      CLog::Log(LOGWARNING, "CVideoPlayerHeadless::DecodeVideo - decoder rejected packet");
+  }
+  else
+    m_videoCodec->SetCodecControl(DVD_CODEC_CTRL_DRAIN);
+
+  while (m_options.maxFrames <= 0 || m_stats.frames < m_options.maxFrames)
+  {
+    const CDVDVideoCodec::VCReturn ret = m_videoCodec->GetPicture(m_picture.get());
+    if (ret == CDVDVideoCodec::VC_NONE)
+      continue;
+    if (ret != CDVDVideoCodec::VC_PICTURE)
+      break;
+
+    if (m_picture->iFlags & DVP_FLAG_DROPPED)
+    {
+      m_stats.droppedFrames++;
+      continue;
+    }
+
+    if (!Present())
+      m_stats.droppedFrames++;
+  }
+}
+
+void CVideoPlayerHeadless::DecodeAudio(DemuxPacket* packet)
+{
+  if (!m_audioCodec)
+    return;
+
+  if (!m_audioCodec->AddData(*packet))
+    return;
+
+  DVDAudioFrame frame;
+  while (true)
+  {
+    frame.nb_frames = 0;
+    m_audioCodec->GetData(frame);
+    if (frame.nb_frames == 0)
+      break;
+
+    m_stats.audioFrames++;
+    if (frame.pts != DVD_NOPTS_VALUE)
+      m_audioEnd = frame.pts + frame.duration;
+    else if (m_audioEnd != DVD_NOPTS_VALUE)
+      m_audioEnd += frame.duration;
+  }
+}
+
+bool CVideoPlayerHeadless::Present()
+{
+  const double pts = m_picture->pts;
+
+  if (m_options.present)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    if (!m_renderer.AddVideoPicture(*m_picture))
+      return false;
+    m_presentTotal += ElapsedMs(start);
+  }
+
+  m_stats.frames++;
+
+  // everything since the last picture, the codec threads included
+  const double cpu = CpuTimeMs();
+  m_cpuTotal += cpu - m_cpuLast;
+  m_stats.cpuMax = std::max(m_stats.cpuMax, cpu - m_cpuLast);
+  m_cpuLast = cpu;
+
+  if (pts == DVD_NOPTS_VALUE)
+    return true;
+
+  if (m_firstPts == DVD_NOPTS_VALUE)
+    m_firstPts = pts;
+  m_lastPts = pts;
+
+  if (m_audioEnd != DVD_NOPTS_VALUE)
+  {
+    const double error = std::abs(pts - m_audioEnd) * 1000 / DVD_TIME_BASE;
+    m_syncErrorTotal += error;
+    m_syncErrorCount++;
+    m_stats.syncErrorMax = std::max(m_stats.syncErrorMax, error);
+  }
+
+  return true;
+}
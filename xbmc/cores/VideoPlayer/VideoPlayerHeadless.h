@@ -0,0 +1,103 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/VideoPlayer/VideoRenderers/HeadlessRenderer.h"
+
+#include <memory>
+
+class CDVDAudioCodec;
+class CDVDDemux;
+class CDVDInputStream;
+class CDVDVideoCodec;
+class CFileItem;
+class CProcessInfo;
+struct DemuxPacket;
+struct VideoPicture;
+
+struct HeadlessPipelineOptions
+{
+  bool decodeVideo = true; //!< false only demuxes
+  bool decodeAudio = true;
+  bool present = true; //!< convert every picture to BGRA in memory
+  unsigned int width = 0; //!< size of the presented pictures, 0 keeps the picture size
+  unsigned int height = 0;
+  int maxFrames = 0; //!< stop after this many video frames, 0 runs to the end of the file
+};
+
+struct HeadlessPipelineStats
+{
+  int packets = 0;
+  int frames = 0;
+  int droppedFrames = 0;
+  int audioFrames = 0;
+  double seconds = 0.0; //!< wall clock time of the run
+  double mediaSeconds = 0.0; //!< video time covered by the decoded frames
+  double cpuAvg = 0.0; //!< process cpu time per frame in ms, includes codec threads
+  double cpuMax = 0.0;
+  double presentAvg = 0.0; //!< conversion time per frame in ms
+  double syncErrorAvg = 0.0; //!< video pts minus decoded audio position in ms, absolute
+  double syncErrorMax = 0.0;
+
+  double Fps() const { return seconds > 0 ? frames / seconds : 0.0; }
+};
+
+/*!
+ * \brief Demux, decode and present a file without a window system.
+ *
+ * Runs the demuxer and the software codecs VideoPlayer would use as fast as
+ * possible and presents the pictures to a CHeadlessRenderer. The A/V sync
+ * error compares every picture with the end of the audio decoded so far, it
+ * grows with the delay of the video decoder and bad interleaving.
+ */
+class CVideoPlayerHeadless
+{
+public:
+  explicit CVideoPlayerHeadless(const HeadlessPipelineOptions& options = {});
+  ~CVideoPlayerHeadless();
+
+  bool Open(const CFileItem& item);
+  void Close();
+
+  /*!
+   * \brief Runs the pipeline until the end of the file or maxFrames.
+   * \return false if no frame could be decoded
+   */
+  bool Run();
+
+  const HeadlessPipelineStats& GetStats() const { return m_stats; }
+  const CHeadlessRenderer& GetRenderer() const { return m_renderer; }
+
+private:
+  void DecodeVideo(DemuxPacket* packet);
+  void DecodeAudio(DemuxPacket* packet);
+  bool Present();
+
+  HeadlessPipelineOptions m_options;
+  HeadlessPipelineStats m_stats;
+  CHeadlessRenderer m_renderer;
+
+  std::unique_ptr<CProcessInfo> m_processInfo;
+  std::shared_ptr<CDVDInputStream> m_input;
+  std::unique_ptr<CDVDDemux> m_demuxer;
+  std::unique_ptr<CDVDVideoCodec> m_videoCodec;
+  std::unique_ptr<CDVDAudioCodec> m_audioCodec;
+  int m_videoStream = -1;
+  int m_audioStream = -1;
+
+  std::unique_ptr<VideoPicture> m_picture;
+  double m_firstPts = 0.0;
+  double m_lastPts = 0.0;
+  double m_audioEnd = 0.0; //!< pts of the end of the decoded audio
+  double m_cpuTotal = 0.0;
+  double m_cpuLast = 0.0;
+  double m_presentTotal = 0.0;
+  double m_syncErrorTotal = 0.0;
+  int m_syncErrorCount = 0;
+};
@@ -68,6 +68,7 @@ CVideoPlayerVideo::CVideoPlayerVideo(CDVDClock* pClock
   m_fForcedAspectRatio = 0;
   m_messageQueue.SetMaxDataSize(40 * 1024 * 1024);
   m_messageQueue.SetMaxTimeSize(8.0);
+  m_messageQueue.SetSingleProducerMode(true);
 
   m_iDroppedFrames = 0;
   m_fFrameRate = 25;
@@ -554,6 +555,7 @@ void CVideoPlayerVideo::Process()
       {
         m_iDroppedFrames++;
         m_ptsTracker.Flush();
+        RecordDrop(RenderPacingEvent::DECODER_DROPPED, pts);
       }
       if (m_messageQueue.GetDataSize() == 0 ||  m_speed < 0)
       {
@@ -753,6 +755,7 @@ bool CVideoPlayerVideo::ProcessDecoderOutput(double &frametime, double &pts)
     {
       m_iDroppedFrames++;
       m_ptsTracker.Flush();
+      RecordDrop(RenderPacingEvent::OUTPUT_DROPPED, m_picture.pts);
     }
 
     if (m_syncState == IDVDStreamPlayer::SYNC_STARTING &&
@@ -1078,6 +1081,16 @@ void CVideoPlayerVideo::CalcFrameRate()
   }
 }
 
+void CVideoPlayerVideo::RecordDrop(RenderPacingEvent event, double pts)
+{
+  int lateframes, queued, discard;
+  double renderPts;
+  m_renderManager.GetStats(lateframes, renderPts, queued, discard);
+
+  const double clock = m_pClock->GetClock();
+  m_renderManager.GetPacingStats().Record(event, clock, pts, clock - pts, queued);
+}
+
 int CVideoPlayerVideo::CalcDropRequirement(double pts)
 {
   int result = 0;
@@ -103,6 +103,7 @@ protected:
   void ResetFrameRateCalc();
   void CalcFrameRate();
   int CalcDropRequirement(double pts);
+  void RecordDrop(RenderPacingEvent event, double pts);
 
   double m_iSubtitleDelay;
 
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "HeadlessRenderer.h"
+
+#include "cores/VideoPlayer/Buffers/VideoBuffer.h"
+#include "cores/VideoPlayer/DVDCodecs/Video/DVDVideoCodec.h"
+#include "utils/log.h"
+
+extern "C" {
+#include <libswscale/swscale.h>
+}
+
+CHeadlessRenderer::~CHeadlessRenderer()
+{
+  if (m_context)
+    sws_freeContext(m_context);
+}
+
+void CHeadlessRenderer::SetOutputSize(unsigned int width, unsigned int height)
+{
+  m_outputWidth = width;
+  m_outputHeight = height;
+}
+
+bool CHeadlessRenderer::AddVideoPicture(const VideoPicture& picture)
+{
+  if (!picture.videoBuffer)
+    return false;
+
+  const unsigned int width = m_outputWidth ? m_outputWidth : picture.iDisplayWidth;
+  const unsigned int height = m_outputHeight ? m_outputHeight : picture.iDisplayHeight;
+  if (width == 0 || height == 0)
+    return false;
+
+  const AVPixelFormat format = picture.videoBuffer->GetFormat();
+  m_context = sws_getCachedContext(m_context, picture.iWidth, picture.iHeight, format, width,
+                                   height, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, nullptr, nullptr,
+                                   nullptr);
+  if (!m_context)
+  {
+    CLog::Log(LOGERROR, "CHeadlessRenderer::AddVideoPicture - unsupported format {} {}x{}",
+              static_cast<int>(format), picture.iWidth, picture.iHeight);
+    return false;
+  }
+
+  m_width = width;
+  m_height = height;
+  m_pixels.resize(static_cast<size_t>(GetStride()) * m_height);
+
+  uint8_t* planes[YuvImage::MAX_PLANES];
+  int strides[YuvImage::MAX_PLANES];
+  picture.videoBuffer->GetPlanes(planes);
+  picture.videoBuffer->GetStrides(strides);
+
+  uint8_t* src[] = {planes[0], planes[1], planes[2], nullptr};
+  int srcStride[] = {strides[0], strides[1], strides[2], 0};
+  uint8_t* dst[] = {m_pixels.data(), nullptr, nullptr, nullptr};
+  int dstStride[] = {static_cast<int>(GetStride()), 0, 0, 0};
+  sws_scale(m_context, src, srcStride, 0, picture.iHeight, dst, dstStride);
+
+  return true;
+}
+
+std::vector<AVPixelFormat> CHeadlessRenderer::GetSupportedFormats()
+{
+  // everything the software decoders output for the GL renderers
+  return {AV_PIX_FMT_YUV420P,   AV_PIX_FMT_YUVJ420P,  AV_PIX_FMT_YUV420P9,
+          AV_PIX_FMT_YUV420P10, AV_PIX_FMT_YUV420P12, AV_PIX_FMT_YUV420P14,
+          AV_PIX_FMT_YUV420P16, AV_PIX_FMT_NV12,      AV_PIX_FMT_YUYV422,
+          AV_PIX_FMT_UYVY422};
+}
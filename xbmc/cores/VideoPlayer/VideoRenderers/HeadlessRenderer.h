@@ -0,0 +1,55 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+extern "C" {
+#include <libavutil/pixfmt.h>
+}
+
+struct SwsContext;
+struct VideoPicture;
+
+/*!
+ * \brief In-memory presenter for pictures of the software decoders.
+ *
+ * Converts every picture to BGRA, the format a CRenderCapture hands out,
+ * without a window system or GPU. Used to benchmark the decoding pipeline.
+ */
+class CHeadlessRenderer
+{
+public:
+  CHeadlessRenderer() = default;
+  ~CHeadlessRenderer();
+
+  /*!
+   * \brief Size of the converted pictures, 0 keeps the display size of the
+   * picture.
+   */
+  void SetOutputSize(unsigned int width, unsigned int height);
+
+  bool AddVideoPicture(const VideoPicture& picture);
+
+  const uint8_t* GetPixels() const { return m_pixels.data(); }
+  unsigned int GetWidth() const { return m_width; }
+  unsigned int GetHeight() const { return m_height; }
+  unsigned int GetStride() const { return m_width * 4; }
+
+  static std::vector<AVPixelFormat> GetSupportedFormats();
+
+private:
+  SwsContext* m_context = nullptr;
+  unsigned int m_outputWidth = 0;
+  unsigned int m_outputHeight = 0;
+  unsigned int m_width = 0;
+  unsigned int m_height = 0;
+  std::vector<uint8_t> m_pixels;
+};
@@ -14,12 +14,15 @@
 #include "ServiceBroker.h"
 #include "application/Application.h"
 #include "cores/VideoPlayer/Interface/TimingConstants.h"
+#include "filesystem/File.h"
 #include "messaging/ApplicationMessenger.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "utils/JSONVariantWriter.h"
 #include "utils/StringUtils.h"
+#include "utils/Variant.h"
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
@@ -376,6 +379,7 @@ void CRenderManager::PreInit()
 
   m_QueueSize   = 2;
   m_QueueSkip   = 0;
+  m_pacingStats.Reset();
   m_presentstep = PRESENT_IDLE;
   m_bRenderGUI = true;
 
@@ -394,6 +398,8 @@ void CRenderManager::UnInit()
     }
   }
 
+  WritePacingStats();
+
   std::unique_lock<CCriticalSection> lock(m_statelock);
 
   m_overlays.UnInit();
@@ -1102,6 +1108,9 @@ int CRenderManager::WaitForBuffer(volatile std::atomic_bool& bStop,
       sleeptime = 0ms;
     sleeptime = std::min(sleeptime, 20ms);
     m_presentevent.wait(lock, sleeptime);
+    for (int idx : m_queued)
+      m_pacingStats.Record(RenderPacingEvent::DISCARDED, clock, m_Queue[idx].pts,
+                           clock - m_Queue[idx].pts, m_queued.size());
     DiscardBuffer();
     return 0;
   }
@@ -1214,6 +1223,9 @@ void CRenderManager::PrepareNextRender()
       {
         m_discard.push_back(m_presentsourcePast);
         m_QueueSkip++;
+        const double pts = m_Queue[m_presentsourcePast].pts;
+        m_pacingStats.Record(RenderPacingEvent::SKIPPED, frameOnScreen, pts, renderPts - pts,
+                             m_queued.size());
       }
       m_presentsourcePast = m_queued.front();
       m_queued.pop_front();
@@ -1233,6 +1245,9 @@ void CRenderManager::PrepareNextRender()
     m_presentpts = m_Queue[idx].pts - m_displayLatency;
     m_presentevent.notifyAll();
 
+    m_pacingStats.Record(RenderPacingEvent::PRESENTED, frameOnScreen, m_Queue[idx].pts,
+                         renderPts - m_Queue[idx].pts, m_queued.size());
+
     m_playerPort->UpdateRenderBuffers(m_queued.size(), m_discard.size(), m_free.size());
   }
   else if (!combined && renderPts > (nextFramePts - frametime))
@@ -1244,6 +1259,16 @@ void CRenderManager::PrepareNextRender()
     m_queued.pop_front();
     m_presentpts = m_Queue[m_presentsource].pts - m_displayLatency - frametime / 2;
     m_presentevent.notifyAll();
+
+    m_pacingStats.Record(RenderPacingEvent::PRESENTED_EARLY, frameOnScreen,
+                         m_Queue[m_presentsource].pts, renderPts - m_Queue[m_presentsource].pts,
+                         m_queued.size());
+  }
+  else
+  {
+    // the frame on screen stays for another display period
+    m_pacingStats.Record(RenderPacingEvent::REPEATED, frameOnScreen, nextFramePts,
+                         renderPts - nextFramePts, m_queued.size());
   }
 }
 
@@ -1262,6 +1287,28 @@ void CRenderManager::DiscardBuffer()
   m_presentevent.notifyAll();
 }
 
+void CRenderManager::WritePacingStats()
+{
+  const std::string& path = CServiceBroker::GetSettingsComponent()
+                                ->GetAdvancedSettings()
+                                ->m_videoRenderPacingFile;
+  if (path.empty() || m_pacingStats.GetCount(RenderPacingEvent::PRESENTED) == 0)
+    return;
+
+  CVariant stats;
+  m_pacingStats.Export(stats, true);
+
+  std::string json;
+  XFILE::CFile file;
+  if (!CJSONVariantWriter::Write(stats, json, false) || !file.OpenForWrite(path, true) ||
+      file.Write(json.c_str(), json.size()) != static_cast<ssize_t>(json.size()))
+  {
+    CLog::Log(LOGERROR, "CRenderManager::WritePacingStats - failed to write {}", path);
+    return;
+  }
+  CLog::Log(LOGDEBUG, "CRenderManager::WritePacingStats - wrote {}", path);
+}
+
 bool CRenderManager::GetStats(int &lateframes, double &pts, int &queued, int &discard)
 {
   std::unique_lock<CCriticalSection> lock(m_presentlock);
@@ -12,6 +12,7 @@
 #include "DebugRenderer.h"
 #include "cores/VideoPlayer/VideoRenderers/BaseRenderer.h"
 #include "cores/VideoPlayer/VideoRenderers/OverlayRenderer.h"
+#include "cores/VideoPlayer/VideoRenderers/RenderPacingStats.h"
 #include "cores/VideoSettings.h"
 #include "threads/CriticalSection.h"
 #include "threads/Event.h"
@@ -94,6 +95,12 @@ public:
 
   int GetSkippedFrames()  { return m_QueueSkip; }
 
+  /**
+   * Pacing telemetry of the frames passing the render queue, the player adds
+   * the frames it drops before they get here.
+   */
+  CRenderPacingStats& GetPacingStats() { return m_pacingStats; }
+
   bool Configure(const VideoPicture& picture, float fps, unsigned int orientation, int buffers = 0);
   bool AddVideoPicture(const VideoPicture& picture, volatile std::atomic_bool& bStop, EINTERLACEMETHOD deintMethod, bool wait);
   void AddOverlay(std::shared_ptr<CDVDOverlay> o, double pts);
@@ -141,6 +148,7 @@ protected:
 
   void UpdateLatencyTweak();
   void CheckEnableClockSync();
+  void WritePacingStats();
 
   CBaseRenderer *m_pRenderer = nullptr;
   OVERLAY::CRenderer m_overlays;
@@ -190,6 +198,7 @@ protected:
 
   int m_QueueSize = 2;
   int m_QueueSkip = 0;
+  CRenderPacingStats m_pacingStats;
 
   struct SPresent
   {
@@ -0,0 +1,201 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "RenderPacingStats.h"
+
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
+#include "utils/Variant.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+double ToMsec(double time)
+{
+  return time * 1000 / DVD_TIME_BASE;
+}
+
+template<size_t N>
+void Clear(std::array<std::atomic<uint32_t>, N>& histogram)
+{
+  for (auto& bin : histogram)
+    bin.store(0, std::memory_order_relaxed);
+}
+
+template<size_t N>
+CVariant ToVariant(const std::array<std::atomic<uint32_t>, N>& histogram, size_t first, size_t last)
+{
+  CVariant bins(CVariant::VariantTypeArray);
+  for (size_t i = first; i < last; i++)
+    bins.push_back(histogram[i].load(std::memory_order_relaxed));
+  return bins;
+}
+} // namespace
+
+CRenderPacingStats::CRenderPacingStats()
+{
+  Reset();
+}
+
+void CRenderPacingStats::Record(
+    RenderPacingEvent event, double clock, double pts, double error, int queued)
+{
+  const uint64_t n = m_head.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = m_ring[n % RING_SIZE];
+
+  slot.sequence.store(2 * n + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.clock.store(clock, std::memory_order_relaxed);
+  slot.pts.store(pts, std::memory_order_relaxed);
+  slot.error.store(error, std::memory_order_relaxed);
+  slot.queued.store(queued, std::memory_order_relaxed);
+  slot.event.store(static_cast<uint8_t>(event), std::memory_order_relaxed);
+  slot.sequence.store(2 * n + 2, std::memory_order_release);
+
+  m_events[static_cast<size_t>(event)].fetch_add(1, std::memory_order_relaxed);
+
+  if (event != RenderPacingEvent::PRESENTED && event != RenderPacingEvent::PRESENTED_EARLY)
+    return;
+
+  const double errorMs = std::floor(ToMsec(error));
+  size_t bin;
+  if (errorMs < -ERROR_RANGE_MS)
+    bin = 0;
+  else if (errorMs >= ERROR_RANGE_MS)
+    bin = ERROR_BINS + 1;
+  else
+    bin = static_cast<size_t>(errorMs + ERROR_RANGE_MS) / ERROR_BIN_MS + 1;
+  m_error[bin].fetch_add(1, std::memory_order_relaxed);
+
+  m_queued[std::min(std::max(queued, 0), QUEUE_BINS - 1)].fetch_add(1, std::memory_order_relaxed);
+
+  // frames are only flipped by the render thread, no need to guard the last present
+  if (m_hasLastPresent.load(std::memory_order_relaxed))
+  {
+    const double interval = ToMsec(clock - m_lastPresent.load(std::memory_order_relaxed));
+    if (interval >= 0)
+    {
+      const size_t intervalBin = std::min(static_cast<size_t>(interval / INTERVAL_BIN_MS),
+                                          static_cast<size_t>(INTERVAL_BINS));
+      m_interval[intervalBin].fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  m_lastPresent.store(clock, std::memory_order_relaxed);
+  m_hasLastPresent.store(true, std::memory_order_relaxed);
+}
+
+void CRenderPacingStats::Reset()
+{
+  for (auto& count : m_events)
+    count.store(0, std::memory_order_relaxed);
+  Clear(m_error);
+  Clear(m_interval);
+  Clear(m_queued);
+  m_hasLastPresent.store(false, std::memory_order_relaxed);
+  m_tail.store(m_head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+std::vector<RenderPacingRecord> CRenderPacingStats::GetRecords() const
+{
+  const uint64_t head = m_head.load(std::memory_order_acquire);
+  uint64_t n = m_tail.load(std::memory_order_relaxed);
+  if (head - n > RING_SIZE)
+    n = head - RING_SIZE;
+
+  std::vector<RenderPacingRecord> records;
+  records.reserve(head - n);
+  for (; n < head; n++)
+  {
+    const Slot& slot = m_ring[n % RING_SIZE];
+
+    // skip records that are still written or already overwritten
+    const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * n + 2)
+      continue;
+
+    RenderPacingRecord record;
+    record.clock = slot.clock.load(std::memory_order_relaxed);
+    record.pts = slot.pts.load(std::memory_order_relaxed);
+    record.error = slot.error.load(std::memory_order_relaxed);
+    record.queued = slot.queued.load(std::memory_order_relaxed);
+    record.event = static_cast<RenderPacingEvent>(slot.event.load(std::memory_order_relaxed));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+      continue;
+
+    records.push_back(record);
+  }
+  return records;
+}
+
+uint64_t CRenderPacingStats::GetCount(RenderPacingEvent event) const
+{
+  return m_events[static_cast<size_t>(event)].load(std::memory_order_relaxed);
+}
+
+void CRenderPacingStats::Export(CVariant& result, bool records) const
+{
+  result["events"] = CVariant(CVariant::VariantTypeObject);
+  for (size_t i = 0; i < m_events.size(); i++)
+    result["events"][EventToString(static_cast<RenderPacingEvent>(i))] =
+        m_events[i].load(std::memory_order_relaxed);
+
+  CVariant& error = result["presenterror"];
+  error["binms"] = ERROR_BIN_MS;
+  error["minms"] = -ERROR_RANGE_MS;
+  error["below"] = m_error.front().load(std::memory_order_relaxed);
+  error["bins"] = ToVariant(m_error, 1, ERROR_BINS + 1);
+  error["above"] = m_error.back().load(std::memory_order_relaxed);
+
+  CVariant& interval = result["presentinterval"];
+  interval["binms"] = INTERVAL_BIN_MS;
+  interval["bins"] = ToVariant(m_interval, 0, INTERVAL_BINS);
+  interval["above"] = m_interval.back().load(std::memory_order_relaxed);
+
+  result["queuedepth"] = ToVariant(m_queued, 0, QUEUE_BINS);
+
+  if (!records)
+    return;
+
+  result["records"] = CVariant(CVariant::VariantTypeArray);
+  for (const auto& record : GetRecords())
+  {
+    CVariant item;
+    item["event"] = EventToString(record.event);
+    item["clock"] = ToMsec(record.clock);
+    item["pts"] = ToMsec(record.pts);
+    item["error"] = ToMsec(record.error);
+    item["queued"] = record.queued;
+    result["records"].push_back(std::move(item));
+  }
+}
+
+const char* CRenderPacingStats::EventToString(RenderPacingEvent event)
+{
+  switch (event)
+  {
+    case RenderPacingEvent::PRESENTED:
+      return "presented";
+    case RenderPacingEvent::PRESENTED_EARLY:
+      return "presentedearly";
+    case RenderPacingEvent::REPEATED:
+      return "repeated";
+    case RenderPacingEvent::SKIPPED:
+      return "skipped";
+    case RenderPacingEvent::DISCARDED:
+      return "discarded";
+    case RenderPacingEvent::DECODER_DROPPED:
+      return "decoderdropped";
+    case RenderPacingEvent::OUTPUT_DROPPED:
+      return "outputdropped";
+    default:
+      return "unknown";
+  }
+}
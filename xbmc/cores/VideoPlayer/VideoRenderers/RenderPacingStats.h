@@ -0,0 +1,103 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class CVariant;
+
+enum class RenderPacingEvent : uint8_t
+{
+  PRESENTED, //!< frame flipped on time or late
+  PRESENTED_EARLY, //!< frame flipped half a display period early to hit the right field
+  REPEATED, //!< previous frame stays on screen, the next one is not due yet
+  SKIPPED, //!< render queue skipped a late frame
+  DISCARDED, //!< queued frames thrown away because the gui does not render
+  DECODER_DROPPED, //!< decoder dropped a frame to catch up
+  OUTPUT_DROPPED, //!< player dropped a decoded frame before it reached the renderer
+  COUNT
+};
+
+struct RenderPacingRecord
+{
+  double clock = 0.0; //!< player clock at the event, DVD time
+  double pts = 0.0; //!< pts of the frame, DVD time
+  double error = 0.0; //!< render pts minus frame pts in DVD time, > 0 means late
+  int queued = 0; //!< frames waiting in the render queue
+  RenderPacingEvent event = RenderPacingEvent::PRESENTED;
+};
+
+/*!
+ * \brief Per frame pacing telemetry of the video render queue.
+ *
+ * The render thread and the video player thread record events without taking
+ * a lock: counters and histograms are relaxed atomics, the last records are
+ * kept in a ring buffer whose slots are guarded by a sequence number, readers
+ * skip slots that are overwritten while being copied.
+ */
+class CRenderPacingStats
+{
+public:
+  static constexpr int RING_SIZE = 1024;
+
+  static constexpr int ERROR_BIN_MS = 2;
+  static constexpr int ERROR_RANGE_MS = 50; //!< bins cover [-range, range)
+  static constexpr int ERROR_BINS = 2 * ERROR_RANGE_MS / ERROR_BIN_MS;
+
+  static constexpr int INTERVAL_BIN_MS = 1;
+  static constexpr int INTERVAL_BINS = 100;
+
+  static constexpr int QUEUE_BINS = 16;
+
+  CRenderPacingStats();
+
+  void Record(RenderPacingEvent event, double clock, double pts, double error, int queued);
+  void Reset();
+
+  std::vector<RenderPacingRecord> GetRecords() const;
+  uint64_t GetCount(RenderPacingEvent event) const;
+
+  /*!
+   * \brief Histograms and counters as a variant, the last records are
+   * included on request.
+   */
+  void Export(CVariant& result, bool records) const;
+
+  static const char* EventToString(RenderPacingEvent event);
+
+private:
+  // a slot holds the sequence 2 * n + 2 once record n is complete
+  struct Slot
+  {
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<double> clock{0.0};
+    std::atomic<double> pts{0.0};
+    std::atomic<double> error{0.0};
+    std::atomic<int> queued{0};
+    std::atomic<uint8_t> event{0};
+  };
+
+  template<size_t N>
+  using Histogram = std::array<std::atomic<uint32_t>, N>;
+
+  std::atomic<uint64_t> m_head{0};
+  std::atomic<uint64_t> m_tail{0}; //!< first record after the last reset
+  std::array<Slot, RING_SIZE> m_ring;
+
+  std::array<std::atomic<uint64_t>, static_cast<size_t>(RenderPacingEvent::COUNT)> m_events;
+  Histogram<ERROR_BINS + 2> m_error; //!< first and last bin collect the outliers
+  Histogram<INTERVAL_BINS + 1> m_interval; //!< last bin collects the outliers
+  Histogram<QUEUE_BINS> m_queued;
+  std::atomic<double> m_lastPresent{0.0};
+  std::atomic_bool m_hasLastPresent{false};
+};
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDCodecs/Video/VideoDecoderThreading.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+VideoDecoderThreadingParams Params(int width, int height, int cpuCount, bool live = false)
+{
+  VideoDecoderThreadingParams params;
+  params.width = width;
+  params.height = height;
+  params.cpuCount = cpuCount;
+  params.live = live;
+  params.liveMaxDelay = 100;
+  params.fps = 25.0;
+  return params;
+}
+} // namespace
+
+TEST(TestVideoDecoderThreading, ParsesModes)
+{
+  EXPECT_EQ(CVideoDecoderThreading::ModeFromString("frame"), VideoDecoderThreadMode::FRAME);
+  EXPECT_EQ(CVideoDecoderThreading::ModeFromString("Slice"), VideoDecoderThreadMode::SLICE);
+  EXPECT_EQ(CVideoDecoderThreading::ModeFromString("auto"), VideoDecoderThreadMode::AUTO);
+  EXPECT_EQ(CVideoDecoderThreading::ModeFromString("bogus"), VideoDecoderThreadMode::AUTO);
+}
+
+TEST(TestVideoDecoderThreading, FileUsesFrameThreadsByResolution)
+{
+  VideoDecoderThreading threading = CVideoDecoderThreading::Select(Params(720, 576, 16));
+  EXPECT_EQ(threading.mode, VideoDecoderThreadMode::FRAME);
+  EXPECT_EQ(threading.threads, 4);
+
+  threading = CVideoDecoderThreading::Select(Params(1920, 1080, 16));
+  EXPECT_EQ(threading.threads, 8);
+
+  threading = CVideoDecoderThreading::Select(Params(3840, 2160, 16));
+  EXPECT_EQ(threading.threads, 16);
+
+  // limited by the cpu, frame threads oversubscribe by half
+  threading = CVideoDecoderThreading::Select(Params(3840, 2160, 4));
+  EXPECT_EQ(threading.threads, 6);
+
+  // unknown size keeps the old behaviour
+  threading = CVideoDecoderThreading::Select(Params(0, 0, 8));
+  EXPECT_EQ(threading.threads, 12);
+}
+
+TEST(TestVideoDecoderThreading, HighBitDepthGetsMoreThreads)
+{
+  VideoDecoderThreadingParams params = Params(1920, 1080, 16);
+  params.bitDepth = 10;
+  EXPECT_EQ(CVideoDecoderThreading::Select(params).threads, 12);
+}
+
+TEST(TestVideoDecoderThreading, LiveHDWithSlicesUsesSliceThreads)
+{
+  VideoDecoderThreadingParams params = Params(1920, 1080, 4, true);
+  params.slices = 68;
+  VideoDecoderThreading threading = CVideoDecoderThreading::Select(params);
+  EXPECT_EQ(threading.mode, VideoDecoderThreadMode::SLICE);
+  EXPECT_EQ(threading.threads, 4);
+
+  // no more threads than slices
+  params = Params(720, 576, 16, true);
+  params.slices = 2;
+  threading = CVideoDecoderThreading::Select(params);
+  EXPECT_EQ(threading.mode, VideoDecoderThreadMode::SLICE);
+  EXPECT_EQ(threading.threads, 2);
+}
+
+TEST(TestVideoDecoderThreading, LiveHDWithoutSlicesUsesFrameThreads)
+{
+  // unknown slices, limited by the live delay
+  VideoDecoderThreadingParams params = Params(1920, 1080, 4, true);
+  VideoDecoderThreading threading = CVideoDecoderThreading::Select(params);
+  EXPECT_EQ(threading.mode, VideoDecoderThreadMode::FRAME);
+  EXPECT_EQ(threading.threads, 3);
+
+  params.slices = 1;
+  EXPECT_EQ(CVideoDecoderThreading::Select(params).mode, VideoDecoderThreadMode::FRAME);
+
+  // files never pick slice threads on their own
+  params = Params(1920, 1080, 4);
+  params.slices = 68;
+  EXPECT_EQ(CVideoDecoderThreading::Select(params).mode, VideoDecoderThreadMode::FRAME);
+}
+
+TEST(TestVideoDecoderThreading, LiveLowLatencyUsesSliceThreads)
+{
+  VideoDecoderThreadingParams params = Params(1920, 1080, 4, true);
+  params.lowLatency = true;
+  VideoDecoderThreading threading = CVideoDecoderThreading::Select(params);
+  EXPECT_EQ(threading.mode, VideoDecoderThreadMode::SLICE);
+  EXPECT_EQ(threading.threads, 4);
+
+  params.slices = 1;
+  EXPECT_EQ(CVideoDecoderThreading::Select(params).mode, VideoDecoderThreadMode::SLICE);
+}
+
+TEST(TestVideoDecoderThreading, LiveUHDLimitsFrameDelay)
+{
+  // 100 ms at 25 fps allows two frames of delay
+  VideoDecoderThreadingParams params = Params(3840, 2160, 16, true);
+  VideoDecoderThreading threading = CVideoDecoderThreading::Select(params);
+  EXPECT_EQ(threading.mode, VideoDecoderThreadMode::FRAME);
+  EXPECT_EQ(threading.threads, 3);
+
+  params.fps = 50.0;
+  EXPECT_EQ(CVideoDecoderThreading::Select(params).threads, 6);
+
+  params.liveMaxDelay = 0;
+  EXPECT_EQ(CVideoDecoderThreading::Select(params).threads, 16);
+
+  // a forced frame mode is limited as well
+  params = Params(1920, 1080, 16, true);
+  params.mode = VideoDecoderThreadMode::FRAME;
+  EXPECT_EQ(CVideoDecoderThreading::Select(params).threads, 3);
+}
+
+TEST(TestVideoDecoderThreading, RequestedThreadsAreClamped)
+{
+  VideoDecoderThreadingParams params = Params(720, 576, 2);
+  params.mode = VideoDecoderThreadMode::SLICE;
+  params.threads = 6;
+  VideoDecoderThreading threading = CVideoDecoderThreading::Select(params);
+  EXPECT_EQ(threading.mode, VideoDecoderThreadMode::SLICE);
+  EXPECT_EQ(threading.threads, 6);
+
+  params.threads = 64;
+  EXPECT_EQ(CVideoDecoderThreading::Select(params).threads, CVideoDecoderThreading::MAX_THREADS);
+
+  params = Params(640, 360, 0);
+  EXPECT_EQ(CVideoDecoderThreading::Select(params).threads, 1);
+}
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (C) 2022- Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DemuxPacketPool.h"
+#include "cores/VideoPlayer/Interface/DemuxPacket.h"
+
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+class TestDemuxPacketPool : public ::testing::Test
+{
+protected:
+  // start every test with empty free lists, so recycled packets are predictable
+  TestDemuxPacketPool() { m_pool.Trim(); }
+  ~TestDemuxPacketPool() override { m_pool.Trim(); }
+
+  CDemuxPacketPool& m_pool = CDemuxPacketPool::GetInstance();
+};
+
+TEST_F(TestDemuxPacketPool, ReusesBufferOfSameSizeClass)
+{
+  DemuxPacket* packet = m_pool.Acquire(1000);
+  ASSERT_NE(packet, nullptr);
+  ASSERT_NE(packet->pData, nullptr);
+  EXPECT_EQ(packet->m_bufferSize, 1024u);
+  uint8_t* data = packet->pData;
+  m_pool.Release(packet);
+
+  // same class, the buffer is handed out again
+  DemuxPacket* reused = m_pool.Acquire(600);
+  EXPECT_EQ(reused, packet);
+  EXPECT_EQ(reused->pData, data);
+  EXPECT_EQ(reused->m_bufferSize, 1024u);
+
+  // next class up can't use the pooled buffer
+  DemuxPacket* bigger = m_pool.Acquire(1025);
+  EXPECT_NE(bigger, packet);
+  EXPECT_EQ(bigger->m_bufferSize, 2048u);
+
+  const CDemuxPacketPool::Stats stats = m_pool.GetStats();
+  EXPECT_GE(stats.hits, 1u);
+
+  m_pool.Release(reused);
+  m_pool.Release(bigger);
+}
+
+TEST_F(TestDemuxPacketPool, ClearsReusedPacket)
+{
+  DemuxPacket* packet = m_pool.Acquire(1024);
+  ASSERT_NE(packet, nullptr);
+  packet->iSize = 1024;
+  packet->iStreamId = 3;
+  packet->dts = 1.0;
+  // dirty the whole buffer including the padding
+  memset(packet->pData, 0xff, packet->m_bufferSize + AV_INPUT_BUFFER_PADDING_SIZE);
+  m_pool.Release(packet);
+
+  DemuxPacket* reused = m_pool.Acquire(100);
+  ASSERT_EQ(reused, packet);
+  EXPECT_EQ(reused->iSize, 0);
+  EXPECT_EQ(reused->iStreamId, -1);
+  EXPECT_NE(reused->dts, 1.0);
+
+  // ffmpeg reads the padding after the requested size
+  for (int i = 0; i < AV_INPUT_BUFFER_PADDING_SIZE; i++)
+    EXPECT_EQ(reused->pData[100 + i], 0) << "padding byte " << i;
+
+  m_pool.Release(reused);
+}
+
+TEST_F(TestDemuxPacketPool, ReusesShellsWithoutPayload)
+{
+  DemuxPacket* shell = m_pool.Acquire(0);
+  ASSERT_NE(shell, nullptr);
+  EXPECT_EQ(shell->pData, nullptr);
+  shell->iStreamId = 3;
+  m_pool.Release(shell);
+
+  DemuxPacket* reused = m_pool.Acquire(-1);
+  EXPECT_EQ(reused, shell);
+  EXPECT_EQ(reused->pData, nullptr);
+  EXPECT_EQ(reused->iStreamId, -1);
+
+  // shells don't count as payload requests
+  EXPECT_EQ(m_pool.GetStats().bytesInUse, 0u);
+
+  m_pool.Release(reused);
+}
+
+TEST_F(TestDemuxPacketPool, KeepsClassWithinBudget)
+{
+  // 1 MiB packets, the budget of 8 MiB per class holds 8 of them
+  constexpr size_t packetSize = 1024 * 1024;
+  std::vector<DemuxPacket*> packets;
+  for (int i = 0; i < 12; i++)
+  {
+    packets.push_back(m_pool.Acquire(packetSize));
+    ASSERT_NE(packets.back(), nullptr);
+  }
+  EXPECT_EQ(m_pool.GetStats().bytesInUse, 12 * packetSize);
+
+  for (DemuxPacket* packet : packets)
+    m_pool.Release(packet);
+
+  const CDemuxPacketPool::Stats stats = m_pool.GetStats();
+  EXPECT_EQ(stats.bytesInUse, 0u);
+  EXPECT_EQ(stats.bytesPooled, 8 * packetSize);
+}
+
+TEST_F(TestDemuxPacketPool, StatsReturnToZero)
+{
+  ASSERT_EQ(m_pool.GetStats().bytesInUse, 0u);
+  ASSERT_EQ(m_pool.GetStats().bytesPooled, 0u);
+
+  // last size is above the largest class and bypasses the pool
+  std::vector<DemuxPacket*> packets;
+  for (int size : {1, 1024, 5000, 70000, 9 * 1024 * 1024})
+    packets.push_back(m_pool.Acquire(size));
+
+  CDemuxPacketPool::Stats stats = m_pool.GetStats();
+  EXPECT_EQ(stats.bytesInUse, 1024u + 1024u + 8192u + 131072u + 9u * 1024 * 1024);
+  EXPECT_GE(stats.bytesInUsePeak, stats.bytesInUse);
+
+  for (DemuxPacket* packet : packets)
+    m_pool.Release(packet);
+
+  stats = m_pool.GetStats();
+  EXPECT_EQ(stats.bytesInUse, 0u);
+  EXPECT_EQ(stats.bytesPooled, 1024u + 1024u + 8192u + 131072u);
+
+  m_pool.Trim();
+  EXPECT_EQ(m_pool.GetStats().bytesPooled, 0u);
+}
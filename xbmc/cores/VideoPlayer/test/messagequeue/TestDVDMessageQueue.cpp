@@ -0,0 +1,191 @@
+/*
+ *  Copyright (C) 2022- Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxUtils.h"
+#include "cores/VideoPlayer/DVDMessage.h"
+#include "cores/VideoPlayer/DVDMessageQueue.h"
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
+
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+std::shared_ptr<CDVDMsg> MakePacket(int size, double dts)
+{
+  DemuxPacket* packet = CDVDDemuxUtils::AllocateDemuxPacket(size);
+  packet->iSize = size;
+  packet->dts = dts;
+  return std::make_shared<CDVDMsgDemuxerPacket>(packet);
+}
+
+double GetDts(const std::shared_ptr<CDVDMsg>& msg)
+{
+  return std::static_pointer_cast<CDVDMsgDemuxerPacket>(msg)->GetPacket()->dts;
+}
+} // namespace
+
+class TestDVDMessageQueue : public ::testing::TestWithParam<bool>
+{
+protected:
+  TestDVDMessageQueue() : m_queue("test")
+  {
+    m_queue.SetMaxDataSize(1024 * 1024);
+    m_queue.SetSingleProducerMode(GetParam());
+    m_queue.Init();
+  }
+
+  ~TestDVDMessageQueue() override { m_queue.End(); }
+
+  CDVDMessageQueue m_queue;
+};
+
+TEST_P(TestDVDMessageQueue, KeepsOrderOfPacketsAndControlMessages)
+{
+  m_queue.Put(MakePacket(100, DVD_MSEC_TO_TIME(0)));
+  m_queue.Put(std::make_shared<CDVDMsg>(CDVDMsg::GENERAL_EOF));
+  m_queue.Put(MakePacket(100, DVD_MSEC_TO_TIME(40)));
+
+  EXPECT_EQ(m_queue.GetDataSize(), 200);
+  EXPECT_EQ(m_queue.GetPacketCount(CDVDMsg::DEMUXER_PACKET), 2u);
+
+  std::shared_ptr<CDVDMsg> msg;
+  ASSERT_EQ(m_queue.Get(msg, 0ms), MSGQ_OK);
+  EXPECT_TRUE(msg->IsType(CDVDMsg::DEMUXER_PACKET));
+  EXPECT_EQ(GetDts(msg), DVD_MSEC_TO_TIME(0));
+
+  ASSERT_EQ(m_queue.Get(msg, 0ms), MSGQ_OK);
+  EXPECT_TRUE(msg->IsType(CDVDMsg::GENERAL_EOF));
+
+  ASSERT_EQ(m_queue.Get(msg, 0ms), MSGQ_OK);
+  EXPECT_EQ(GetDts(msg), DVD_MSEC_TO_TIME(40));
+
+  EXPECT_EQ(m_queue.GetDataSize(), 0);
+  EXPECT_EQ(m_queue.Get(msg, 0ms), MSGQ_TIMEOUT);
+}
+
+TEST_P(TestDVDMessageQueue, PriorityAndPutBack)
+{
+  m_queue.Put(MakePacket(100, DVD_MSEC_TO_TIME(0)));
+  m_queue.Put(std::make_shared<CDVDMsg>(CDVDMsg::GENERAL_RESYNC), 1);
+  m_queue.PutBack(MakePacket(100, DVD_MSEC_TO_TIME(-40)));
+
+  std::shared_ptr<CDVDMsg> msg;
+  ASSERT_EQ(m_queue.Get(msg, 0ms), MSGQ_OK);
+  EXPECT_TRUE(msg->IsType(CDVDMsg::GENERAL_RESYNC));
+
+  ASSERT_EQ(m_queue.Get(msg, 0ms), MSGQ_OK);
+  EXPECT_EQ(GetDts(msg), DVD_MSEC_TO_TIME(-40));
+
+  ASSERT_EQ(m_queue.Get(msg, 0ms), MSGQ_OK);
+  EXPECT_EQ(GetDts(msg), DVD_MSEC_TO_TIME(0));
+}
+
+TEST_P(TestDVDMessageQueue, FlushDropsPacketsOnly)
+{
+  m_queue.Put(MakePacket(100, DVD_MSEC_TO_TIME(0)));
+  m_queue.Put(std::make_shared<CDVDMsg>(CDVDMsg::GENERAL_EOF));
+  m_queue.Put(MakePacket(100, DVD_MSEC_TO_TIME(40)));
+
+  m_queue.Flush();
+  EXPECT_EQ(m_queue.GetDataSize(), 0);
+  EXPECT_EQ(m_queue.GetLevel(), 0);
+  EXPECT_EQ(m_queue.GetPacketCount(CDVDMsg::DEMUXER_PACKET), 0u);
+
+  std::shared_ptr<CDVDMsg> msg;
+  ASSERT_EQ(m_queue.Get(msg, 0ms), MSGQ_OK);
+  EXPECT_TRUE(msg->IsType(CDVDMsg::GENERAL_EOF));
+  EXPECT_EQ(m_queue.Get(msg, 0ms), MSGQ_TIMEOUT);
+
+  m_queue.Put(MakePacket(100, DVD_MSEC_TO_TIME(80)));
+  ASSERT_EQ(m_queue.Get(msg, 0ms), MSGQ_OK);
+  EXPECT_EQ(GetDts(msg), DVD_MSEC_TO_TIME(80));
+}
+
+TEST_P(TestDVDMessageQueue, TimeBasedLevel)
+{
+  m_queue.SetMaxTimeSize(1.0);
+  for (int i = 0; i <= 10; i++)
+    m_queue.Put(MakePacket(10, DVD_MSEC_TO_TIME(i * 50)));
+
+  EXPECT_FALSE(m_queue.IsDataBased());
+  EXPECT_EQ(m_queue.GetLevel(), 50);
+
+  std::shared_ptr<CDVDMsg> msg;
+  ASSERT_EQ(m_queue.Get(msg, 0ms), MSGQ_OK);
+  EXPECT_EQ(m_queue.GetLevel(), 45);
+}
+
+TEST_P(TestDVDMessageQueue, ProducerConsumerThreads)
+{
+  constexpr int packets = 20000;
+
+  std::thread consumer([this]() {
+    std::shared_ptr<CDVDMsg> msg;
+    for (int i = 0; i < packets; i++)
+    {
+      ASSERT_EQ(m_queue.Get(msg, 5s), MSGQ_OK);
+      ASSERT_EQ(GetDts(msg), static_cast<double>(i));
+    }
+  });
+
+  for (int i = 0; i < packets; i++)
+    m_queue.Put(MakePacket(1, i));
+
+  consumer.join();
+  EXPECT_EQ(m_queue.GetDataSize(), 0);
+}
+
+TEST_P(TestDVDMessageQueue, FlushWhileProducing)
+{
+  constexpr int packets = 20000;
+
+  std::thread producer([this]() {
+    for (int i = 0; i < packets; i++)
+    {
+      m_queue.Put(MakePacket(1, i));
+      if (i % 10 == 0)
+        m_queue.Put(std::make_shared<CDVDMsgInt>(CDVDMsg::GENERAL_RESYNC, i));
+    }
+    m_queue.Put(std::make_shared<CDVDMsg>(CDVDMsg::GENERAL_EOF));
+  });
+
+  // control messages must never overtake packets put before them
+  double lastDts = -1;
+  int taken = 0;
+  std::shared_ptr<CDVDMsg> msg;
+  while (true)
+  {
+    ASSERT_EQ(m_queue.Get(msg, 5s), MSGQ_OK);
+    if (msg->IsType(CDVDMsg::GENERAL_EOF))
+      break;
+
+    if (msg->IsType(CDVDMsg::GENERAL_RESYNC))
+    {
+      const int position = std::static_pointer_cast<CDVDMsgInt>(msg)->m_value;
+      ASSERT_LE(lastDts, static_cast<double>(position));
+    }
+    else
+    {
+      ASSERT_LT(lastDts, GetDts(msg));
+      lastDts = GetDts(msg);
+    }
+
+    if (++taken % 100 == 0)
+      m_queue.Flush();
+  }
+
+  producer.join();
+  EXPECT_EQ(m_queue.GetDataSize(), 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(SingleProducerMode, TestDVDMessageQueue, ::testing::Bool());
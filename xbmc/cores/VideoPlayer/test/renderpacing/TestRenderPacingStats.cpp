@@ -0,0 +1,177 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
+#include "cores/VideoPlayer/VideoRenderers/RenderPacingStats.h"
+#include "utils/Variant.h"
+
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr double FRAME_TIME = DVD_TIME_BASE / 25.0;
+
+void Present(CRenderPacingStats& stats, int frame, double errorMs, int queued = 2)
+{
+  const double pts = frame * FRAME_TIME;
+  const double error = DVD_MSEC_TO_TIME(errorMs);
+  stats.Record(RenderPacingEvent::PRESENTED, pts + error, pts, error, queued);
+}
+} // namespace
+
+TEST(TestRenderPacingStats, CountsEvents)
+{
+  CRenderPacingStats stats;
+  Present(stats, 0, 0);
+  Present(stats, 1, 0);
+  stats.Record(RenderPacingEvent::SKIPPED, 0, 0, 0, 0);
+  stats.Record(RenderPacingEvent::DECODER_DROPPED, 0, 0, 0, 0);
+
+  EXPECT_EQ(stats.GetCount(RenderPacingEvent::PRESENTED), 2u);
+  EXPECT_EQ(stats.GetCount(RenderPacingEvent::SKIPPED), 1u);
+  EXPECT_EQ(stats.GetCount(RenderPacingEvent::DECODER_DROPPED), 1u);
+  EXPECT_EQ(stats.GetCount(RenderPacingEvent::REPEATED), 0u);
+
+  const auto records = stats.GetRecords();
+  ASSERT_EQ(records.size(), 4u);
+  EXPECT_EQ(records[1].event, RenderPacingEvent::PRESENTED);
+  EXPECT_DOUBLE_EQ(records[1].pts, FRAME_TIME);
+  EXPECT_EQ(records[3].event, RenderPacingEvent::DECODER_DROPPED);
+}
+
+TEST(TestRenderPacingStats, PresentErrorHistogram)
+{
+  CRenderPacingStats stats;
+  Present(stats, 0, -100); // below the range
+  Present(stats, 1, -1); // [-2, 0)
+  Present(stats, 2, 0); // [0, 2)
+  Present(stats, 3, 3); // [2, 4)
+  Present(stats, 4, 49); // last bin
+  Present(stats, 5, 50); // above the range
+
+  CVariant result;
+  stats.Export(result, false);
+
+  const CVariant& error = result["presenterror"];
+  EXPECT_EQ(error["binms"].asInteger(), CRenderPacingStats::ERROR_BIN_MS);
+  EXPECT_EQ(error["minms"].asInteger(), -CRenderPacingStats::ERROR_RANGE_MS);
+  EXPECT_EQ(error["below"].asUnsignedInteger(), 1u);
+  EXPECT_EQ(error["above"].asUnsignedInteger(), 1u);
+
+  const CVariant& bins = error["bins"];
+  ASSERT_EQ(bins.size(), static_cast<unsigned int>(CRenderPacingStats::ERROR_BINS));
+  const int zero = CRenderPacingStats::ERROR_BINS / 2;
+  EXPECT_EQ(bins[zero - 1].asUnsignedInteger(), 1u);
+  EXPECT_EQ(bins[zero].asUnsignedInteger(), 1u);
+  EXPECT_EQ(bins[zero + 1].asUnsignedInteger(), 1u);
+  EXPECT_EQ(bins[CRenderPacingStats::ERROR_BINS - 1].asUnsignedInteger(), 1u);
+
+  EXPECT_FALSE(result.isMember("records"));
+}
+
+TEST(TestRenderPacingStats, IntervalAndQueueDepth)
+{
+  CRenderPacingStats stats;
+  Present(stats, 0, 0, 1);
+  Present(stats, 1, 0, 3);
+  Present(stats, 3, 0, 40); // a frame went missing, queue depth is clamped
+  // repeats don't count as presents
+  stats.Record(RenderPacingEvent::REPEATED, 4 * FRAME_TIME, 4 * FRAME_TIME, 0, 2);
+
+  CVariant result;
+  stats.Export(result, true);
+
+  const CVariant& interval = result["presentinterval"]["bins"];
+  EXPECT_EQ(interval[40].asUnsignedInteger(), 1u);
+  EXPECT_EQ(interval[80].asUnsignedInteger(), 1u);
+
+  const CVariant& queued = result["queuedepth"];
+  ASSERT_EQ(queued.size(), static_cast<unsigned int>(CRenderPacingStats::QUEUE_BINS));
+  EXPECT_EQ(queued[1].asUnsignedInteger(), 1u);
+  EXPECT_EQ(queued[3].asUnsignedInteger(), 1u);
+  EXPECT_EQ(queued[CRenderPacingStats::QUEUE_BINS - 1].asUnsignedInteger(), 1u);
+
+  EXPECT_EQ(result["events"]["repeated"].asUnsignedInteger(), 1u);
+  ASSERT_EQ(result["records"].size(), 4u);
+  EXPECT_EQ(result["records"][3]["event"].asString(), "repeated");
+  EXPECT_DOUBLE_EQ(result["records"][1]["pts"].asDouble(), 40.0);
+}
+
+TEST(TestRenderPacingStats, RingKeepsLastRecords)
+{
+  CRenderPacingStats stats;
+  const int frames = CRenderPacingStats::RING_SIZE + 10;
+  for (int i = 0; i < frames; i++)
+    Present(stats, i, 0);
+
+  const auto records = stats.GetRecords();
+  ASSERT_EQ(records.size(), static_cast<size_t>(CRenderPacingStats::RING_SIZE));
+  EXPECT_DOUBLE_EQ(records.front().pts, 10 * FRAME_TIME);
+  EXPECT_DOUBLE_EQ(records.back().pts, (frames - 1) * FRAME_TIME);
+}
+
+TEST(TestRenderPacingStats, Reset)
+{
+  CRenderPacingStats stats;
+  Present(stats, 0, 0);
+  Present(stats, 1, 0);
+  stats.Reset();
+
+  EXPECT_EQ(stats.GetCount(RenderPacingEvent::PRESENTED), 0u);
+  EXPECT_TRUE(stats.GetRecords().empty());
+
+  // the first present after a reset has no interval
+  Present(stats, 5, 0);
+  CVariant result;
+  stats.Export(result, false);
+  unsigned int intervals = result["presentinterval"]["above"].asUnsignedInteger();
+  for (auto it = result["presentinterval"]["bins"].begin_array();
+       it != result["presentinterval"]["bins"].end_array(); ++it)
+    intervals += it->asUnsignedInteger();
+  EXPECT_EQ(intervals, 0u);
+  EXPECT_EQ(stats.GetRecords().size(), 1u);
+}
+
+TEST(TestRenderPacingStats, ConcurrentWriters)
+{
+  CRenderPacingStats stats;
+  constexpr int EVENTS = 20000;
+  std::atomic_bool done{false};
+
+  // the reader must only ever see complete records
+  std::thread reader([&]() {
+    while (!done)
+    {
+      for (const auto& record : stats.GetRecords())
+      {
+        if (record.event == RenderPacingEvent::PRESENTED)
+          ASSERT_DOUBLE_EQ(record.clock, record.pts);
+        else
+          ASSERT_DOUBLE_EQ(record.clock, -record.pts);
+      }
+    }
+  });
+
+  std::thread player([&]() {
+    for (int i = 0; i < EVENTS; i++)
+      stats.Record(RenderPacingEvent::DECODER_DROPPED, -i, i, 0, 1);
+  });
+  for (int i = 0; i < EVENTS; i++)
+    stats.Record(RenderPacingEvent::PRESENTED, i, i, 0, 1);
+
+  player.join();
+  done = true;
+  reader.join();
+
+  EXPECT_EQ(stats.GetCount(RenderPacingEvent::PRESENTED), static_cast<uint64_t>(EVENTS));
+  EXPECT_EQ(stats.GetCount(RenderPacingEvent::DECODER_DROPPED), static_cast<uint64_t>(EVENTS));
+  EXPECT_EQ(stats.GetRecords().size(), static_cast<size_t>(CRenderPacingStats::RING_SIZE));
+}
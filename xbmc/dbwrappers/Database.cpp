@@ -401,6 +401,35 @@ bool CDatabase::ExecuteQuery(const std::string& strQuery)
   return bReturn;
 }
 
+bool CDatabase::ExecuteQuery(const std::string& strQuery, const dbiplus::BindParams& params)
+{
+  if (m_multipleExecute)
+  {
+    if (nullptr == m_pDB)
+      return false;
+    m_multipleQueries.push_back(m_pDB->prepare_params(strQuery, params));
+    return true;
+  }
+
+  bool bReturn = false;
+
+  try
+  {
+    if (nullptr == m_pDB)
+      return bReturn;
+    if (nullptr == m_pDS)
+      return bReturn;
+    m_pDS->exec(strQuery, params);
+    bReturn = true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "{} - failed to execute query '{}'", __FUNCTION__, strQuery);
+  }
+
+  return bReturn;
+}
+
 bool CDatabase::ResultQuery(const std::string& strQuery) const
 {
   bool bReturn = false;
@@ -8,16 +8,18 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace dbiplus
 {
 class Database;
 class Dataset;
+class field_value;
+typedef std::vector<field_value> BindParams;
 } // namespace dbiplus
 
-#include <memory>
-#include <string>
-#include <vector>
-
 class DatabaseSettings; // forward
 class CDbUrl;
 class CProfileManager;
@@ -174,6 +176,18 @@ public:
    */
   bool ExecuteQuery(const std::string& strQuery);
 
+  /*!
+   * @brief Execute a query with '?' placeholders that does not return any result.
+   *        The statement is compiled once and kept by the connection, so this suits
+   *        statements that are run over and over with different values.
+   *        Queued as plain query if BeginMultipleExecute() has been called.
+   * @param strQuery The query to execute.
+   * @param params The values bound to the placeholders, in order.
+   * @return True if the query was executed successfully, false otherwise.
+   * @sa ExecuteQuery
+   */
+  bool ExecuteQuery(const std::string& strQuery, const dbiplus::BindParams& params);
+
   /*!
    * @brief Execute a query that returns a result.
    * @remarks Call m_pDS->close(); to clean up the dataset when done.
@@ -80,6 +80,62 @@ std::string Database::prepare(const char* format, ...)
   return result;
 }
 
+std::string Database::prepare_params(const std::string& sql, const BindParams& params)
+{
+  std::string result;
+  result.reserve(sql.size() + params.size() * 8);
+
+  size_t param = 0;
+  char quote = 0;
+  for (char c : sql)
+  {
+    if (quote)
+    {
+      if (c == quote)
+        quote = 0;
+    }
+    else if (c == '\'' || c == '"')
+      quote = c;
+    else if (c == '?' && param < params.size())
+    {
+      const field_value& value = params[param++];
+      if (value.get_isNull())
+        result += "NULL";
+      else
+      {
+        switch (value.get_fType())
+        {
+          case ft_String:
+          case ft_Char:
+          case ft_WideString:
+          case ft_Object:
+            result += prepare("'%s'", value.get_asString().c_str());
+            break;
+          case ft_Boolean:
+            result += value.get_asBool() ? "1" : "0";
+            break;
+          case ft_Float:
+          case ft_Double:
+          case ft_LongDouble:
+            result += prepare("%.17g", value.get_asDouble());
+            break;
+          default:
+            result += value.get_asString();
+            break;
+        }
+      }
+      continue;
+    }
+    result += c;
+  }
+
+  if (param != params.size())
+    CLog::Log(LOGWARNING, "{}: {} parameters passed for {} placeholders in {}", __FUNCTION__,
+              params.size(), param, sql);
+
+  return result;
+}
+
 //************* Dataset implementation ***************
 
 Dataset::Dataset() : select_sql("")
@@ -203,6 +259,16 @@ void Dataset::parse_sql(std::string& sql)
   } //for
 }
 
+int Dataset::exec(const std::string& sql, const BindParams& params)
+{
+  return exec(db->prepare_params(sql, params));
+}
+
+bool Dataset::query(const std::string& sql, const BindParams& params)
+{
+  return query(db->prepare_params(sql, params));
+}
+
 void Dataset::close(void)
 {
   haveError = false;
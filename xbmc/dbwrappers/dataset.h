@@ -15,11 +15,14 @@
 #include "qry_dat.h"
 
 #include <cstdio>
+#include <functional>
 #include <list>
 #include <map>
 #include <stdarg.h>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace dbiplus
 {
@@ -28,6 +31,7 @@ class Dataset; // forward declaration of class Dataset
 #define S_NO_CONNECTION "No active connection";
 
 #define DB_BUFF_MAX 8 * 1024 // Maximum buffer's capacity
+#define DB_STATEMENT_CACHE_SIZE 64 // Compiled statements kept per connection
 
 #define DB_CONNECTION_NONE 0
 #define DB_CONNECTION_OK 1
@@ -41,6 +45,16 @@ class Dataset; // forward declaration of class Dataset
 #define DB_UNEXPECTED 7 // This shouldn't ever happen
 #define DB_UNEXPECTED_RESULT -1 //For integer functions
 
+typedef std::vector<field_value> BindParams; // values for the '?' placeholders of a statement
+
+/* returns a parameter binding NULL */
+inline field_value null_value()
+{
+  field_value v;
+  v.set_isNull();
+  return v;
+}
+
 /******************* Class Database definition ********************
 
    represents  connection with database server;
@@ -162,6 +176,14 @@ public:
    */
   virtual std::string vprepare(const char* format, va_list args) = 0;
 
+  /*! \brief Substitute the '?' placeholders of a SQL statement with escaped values, for
+   backends or callers that can't bind them
+   \param sql - statement with '?' placeholders
+   \param params - values for the placeholders, in order
+   \return escaped and formatted string.
+   */
+  std::string prepare_params(const std::string& sql, const BindParams& params);
+
   virtual bool in_transaction() { return false; }
 };
 
@@ -193,6 +215,68 @@ enum sqlType
 typedef std::list<std::string> StringList;
 typedef std::map<std::string, field_value> ParamList;
 
+/******************* Class StatementCache definition **************
+
+  keeps the most recently used compiled statements of a connection
+
+******************************************************************/
+template<typename Statement>
+class StatementCache
+{
+public:
+  explicit StatementCache(std::function<void(Statement*)> finalize,
+                          size_t capacity = DB_STATEMENT_CACHE_SIZE)
+    : m_finalize(std::move(finalize)), m_capacity(capacity)
+  {
+  }
+  ~StatementCache() { clear(); }
+
+  /* returns the statement compiled for sql, NULL if it isn't cached */
+  Statement* get(const std::string& sql)
+  {
+    auto it = m_index.find(sql);
+    if (it == m_index.end())
+      return NULL;
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    return it->second->second;
+  }
+
+  /* takes ownership of stmt, finalizes the least recently used statement when full */
+  void put(const std::string& sql, Statement* stmt)
+  {
+    m_lru.emplace_front(sql, stmt);
+    m_index[sql] = m_lru.begin();
+    if (m_lru.size() > m_capacity)
+    {
+      m_index.erase(m_lru.back().first);
+      m_finalize(m_lru.back().second);
+      m_lru.pop_back();
+    }
+  }
+
+  /* finalizes all statements, must be done before the connection is closed */
+  void clear()
+  {
+    for (auto& entry : m_lru)
+      m_finalize(entry.second);
+    m_lru.clear();
+    m_index.clear();
+  }
+
+  size_t size() const { return m_lru.size(); }
+
+private:
+  StatementCache(const StatementCache&) = delete;
+  StatementCache& operator=(const StatementCache&) = delete;
+
+  typedef std::list<std::pair<std::string, Statement*>> LruList;
+
+  std::function<void(Statement*)> m_finalize;
+  size_t m_capacity;
+  LruList m_lru; // most recently used first
+  std::unordered_map<std::string, typename LruList::iterator> m_index;
+};
+
 class Dataset
 {
 protected:
@@ -313,6 +397,11 @@ public:
   virtual const void* getExecRes() = 0;
   /* as open, but with our query exec Sql */
   virtual bool query(const std::string& sql) = 0;
+  /* func. executes a statement with '?' placeholders bound to params, without results to
+   return. Backends keep the compiled statement for the next call with the same sql. */
+  virtual int exec(const std::string& sql, const BindParams& params);
+  /* as query, with '?' placeholders bound to params */
+  virtual bool query(const std::string& sql, const BindParams& params);
   /* Close SQL Query*/
   virtual void close();
   /* This function looks for field Field_name with value equal Field_value
@@ -17,8 +17,11 @@
 #include <algorithm>
 #include <array>
 #include <iostream>
+#include <memory>
 #include <set>
 #include <string>
+#include <type_traits>
+#include <vector>
 #ifdef HAS_MYSQL
 #include <mysql/errmsg.h>
 #elif defined(HAS_MARIADB)
@@ -37,7 +40,7 @@ namespace dbiplus
 
 //************* MysqlDatabase implementation ***************
 
-MysqlDatabase::MysqlDatabase()
+MysqlDatabase::MysqlDatabase() : statements([](MYSQL_STMT* stmt) { mysql_stmt_close(stmt); })
 {
 
   active = false;
@@ -276,6 +279,8 @@ void MysqlDatabase::disconnect(void)
 {
   if (conn != NULL)
   {
+    // statements belong to the connection
+    statements.clear();
     mysql_close(conn);
     conn = NULL;
   }
@@ -508,6 +513,56 @@ int MysqlDatabase::query_with_reconnect(const char* query)
   return result;
 }
 
+MYSQL_STMT* MysqlDatabase::execute_prepared(const std::string& sql,
+                                            MYSQL_BIND* params,
+                                            unsigned int count)
+{
+  for (int attempt = 0;; attempt++)
+  {
+    int result = MYSQL_OK;
+    MYSQL_STMT* stmt = statements.get(sql);
+    if (stmt == NULL)
+    {
+      if ((stmt = mysql_stmt_init(conn)) == NULL)
+        throw DbErrors("Can't allocate statement: '%s'", db.c_str());
+
+      if (mysql_stmt_prepare(stmt, sql.c_str(), sql.size()) == MYSQL_OK)
+        statements.put(sql, stmt);
+      else
+      {
+        result = mysql_stmt_errno(stmt);
+        mysql_stmt_close(stmt);
+        stmt = NULL;
+      }
+    }
+
+    if (stmt != NULL)
+    {
+      if (mysql_stmt_param_count(stmt) != count)
+        throw DbErrors("%u parameters passed for %lu placeholders\nQuery: %s", count,
+                       static_cast<unsigned long>(mysql_stmt_param_count(stmt)), sql.c_str());
+
+      if (mysql_stmt_bind_param(stmt, params) != MYSQL_OK || mysql_stmt_execute(stmt) != MYSQL_OK)
+        result = mysql_stmt_errno(stmt);
+    }
+
+    if (result == MYSQL_OK)
+      return stmt;
+
+    if ((result == CR_SERVER_GONE_ERROR || result == CR_SERVER_LOST) && attempt == 0)
+    {
+      CLog::Log(LOGINFO, "MYSQL server has gone. Will try to reconnect.");
+      // reconnecting drops the cached statements
+      active = false;
+      connect(true);
+      continue;
+    }
+
+    setErr(result, sql.c_str());
+    throw DbErrors("%s", getErrorMsg());
+  }
+}
+
 long MysqlDatabase::nextid(const char* sname)
 {
   CLog::Log(LOGDEBUG, "MysqlDatabase::nextid for {}", sname);
@@ -1803,6 +1858,139 @@ static size_t ci_find(const std::string& where, const std::string& what)
     return loc - where.begin();
 }
 
+namespace
+{
+// storage for the parameters of a prepared statement, must outlive its execution
+class CParamBinds
+{
+public:
+  explicit CParamBinds(const BindParams& params)
+    : m_binds(params.size()),
+      m_ints(params.size()),
+      m_doubles(params.size()),
+      m_strings(params.size()),
+      m_lengths(params.size())
+  {
+    for (size_t i = 0; i < params.size(); i++)
+    {
+      const field_value& value = params[i];
+      MYSQL_BIND& bind = m_binds[i];
+      if (value.get_isNull())
+      {
+        bind.buffer_type = MYSQL_TYPE_NULL;
+        continue;
+      }
+
+      switch (value.get_fType())
+      {
+        case ft_Boolean:
+        case ft_Short:
+        case ft_UShort:
+        case ft_Int:
+        case ft_UInt:
+        case ft_Int64:
+          m_ints[i] = value.get_asInt64();
+          bind.buffer_type = MYSQL_TYPE_LONGLONG;
+          bind.buffer = &m_ints[i];
+          break;
+        case ft_Float:
+        case ft_Double:
+        case ft_LongDouble:
+          m_doubles[i] = value.get_asDouble();
+          bind.buffer_type = MYSQL_TYPE_DOUBLE;
+          bind.buffer = &m_doubles[i];
+          break;
+        default:
+          m_strings[i] = value.get_asString();
+          m_lengths[i] = m_strings[i].size();
+          bind.buffer_type = MYSQL_TYPE_STRING;
+          bind.buffer = const_cast<char*>(m_strings[i].data());
+          bind.buffer_length = m_lengths[i];
+          bind.length = &m_lengths[i];
+          break;
+      }
+    }
+  }
+
+  MYSQL_BIND* get() { return m_binds.empty() ? NULL : m_binds.data(); }
+  unsigned int size() const { return static_cast<unsigned int>(m_binds.size()); }
+
+private:
+  std::vector<MYSQL_BIND> m_binds;
+  std::vector<long long> m_ints;
+  std::vector<double> m_doubles;
+  std::vector<std::string> m_strings;
+  std::vector<unsigned long> m_lengths;
+};
+
+// my_bool in older client libraries, bool since MySQL 8
+using NullFlag = std::remove_pointer_t<decltype(MYSQL_BIND::is_null)>;
+
+constexpr unsigned long RESULT_BUFFER_SIZE = 256;
+} // namespace
+
+static void convert_field_value(field_value& v, enum_field_types type, const char* value)
+{
+  switch (type)
+  {
+    case MYSQL_TYPE_LONGLONG:
+      if (value != nullptr)
+      {
+        v.set_asInt64(strtoll(value, nullptr, 10));
+      }
+      else
+      {
+        v.set_asInt64(0);
+      }
+      break;
+    case MYSQL_TYPE_DECIMAL:
+    case MYSQL_TYPE_NEWDECIMAL:
+    case MYSQL_TYPE_TINY:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+      if (value != NULL)
+      {
+        v.set_asInt(atoi(value));
+      }
+      else
+      {
+        v.set_asInt(0);
+      }
+      break;
+    case MYSQL_TYPE_FLOAT:
+    case MYSQL_TYPE_DOUBLE:
+      if (value != NULL)
+      {
+        v.set_asDouble(atof(value));
+      }
+      else
+      {
+        v.set_asDouble(0);
+      }
+      break;
+    case MYSQL_TYPE_STRING:
+    case MYSQL_TYPE_VAR_STRING:
+    case MYSQL_TYPE_VARCHAR:
+      if (value != NULL)
+        v.set_asString(value);
+      break;
+    case MYSQL_TYPE_TINY_BLOB:
+    case MYSQL_TYPE_MEDIUM_BLOB:
+    case MYSQL_TYPE_LONG_BLOB:
+    case MYSQL_TYPE_BLOB:
+      if (value != NULL)
+        v.set_asString(value);
+      break;
+    case MYSQL_TYPE_NULL:
+    default:
+      CLog::Log(LOGDEBUG, "MYSQL: Unknown field type: {}", type);
+      v.set_asString("");
+      v.set_isNull();
+      break;
+  }
+}
+
 int MysqlDataset::exec(const std::string& sql)
 {
   if (!handle())
@@ -1848,6 +2036,17 @@ int MysqlDataset::exec(const std::string& sql)
   }
 }
 
+int MysqlDataset::exec(const std::string& sql, const BindParams& params)
+{
+  if (!handle())
+    throw DbErrors("No Database Connection");
+  exec_res.clear();
+
+  CParamBinds binds(params);
+  static_cast<MysqlDatabase*>(db)->execute_prepared(sql, binds.get(), binds.size());
+  return MYSQL_OK;
+}
+
 int MysqlDataset::exec()
 {
   return exec(sql);
@@ -1902,70 +2101,110 @@ bool MysqlDataset::query(const std::string& query)
     sql_record* res = new sql_record;
     res->resize(numColumns);
     for (unsigned int i = 0; i < numColumns; i++)
-    {
-      field_value& v = res->at(i);
-      switch (fields[i].type)
+      convert_field_value(res->at(i), fields[i].type, row[i]);
+    result.records.push_back(res);
+  }
+  mysql_free_result(stmt);
+  active = true;
+  ds_state = dsSelect;
+  this->first();
+  return true;
+}
+
+bool MysqlDataset::query(const std::string& sql, const BindParams& params)
+{
+  if (!handle())
+    throw DbErrors("No Database Connection");
+  std::string qry = sql;
+  if (qry.find("select") == std::string::npos && qry.find("SELECT") == std::string::npos)
+    throw DbErrors("MUST be select SQL!");
+
+  close();
+
+  size_t loc;
+
+  // mysql doesn't understand CAST(foo as integer) => change to CAST(foo as signed integer)
+  while ((loc = ci_find(qry, "as integer)")) != std::string::npos)
+    qry = qry.insert(loc + 3, "signed ");
+
+  CParamBinds binds(params);
+  MYSQL_STMT* stmt =
+      static_cast<MysqlDatabase*>(db)->execute_prepared(qry, binds.get(), binds.size());
+
+  MYSQL_RES* meta = mysql_stmt_result_metadata(stmt);
+  if (meta == NULL)
+  {
+    mysql_stmt_free_result(stmt);
+    throw DbErrors("Missing result set!");
+  }
+
+  // column headers
+  const unsigned int numColumns = mysql_num_fields(meta);
+  MYSQL_FIELD* fields = mysql_fetch_fields(meta);
+  result.record_header.resize(numColumns);
+  for (unsigned int i = 0; i < numColumns; i++)
+    result.record_header[i].name = fields[i].name;
+
+  // all columns are fetched as text, the same as the plain queries return them
+  std::vector<MYSQL_BIND> columns(numColumns);
+  std::vector<std::string> buffers(numColumns, std::string(RESULT_BUFFER_SIZE, '\0'));
+  std::vector<unsigned long> lengths(numColumns);
+  std::unique_ptr<NullFlag[]> nulls(new NullFlag[numColumns]());
+  for (unsigned int i = 0; i < numColumns; i++)
+  {
+    columns[i].buffer_type = MYSQL_TYPE_STRING;
+    columns[i].buffer = &buffers[i][0];
+    columns[i].buffer_length = RESULT_BUFFER_SIZE;
+    columns[i].length = &lengths[i];
+    columns[i].is_null = &nulls[i];
+  }
+
+  int res = MYSQL_OK;
+  if (mysql_stmt_bind_result(stmt, columns.data()) == MYSQL_OK)
+  {
+    // returned rows
+    std::string value;
+    while ((res = mysql_stmt_fetch(stmt)) == MYSQL_OK || res == MYSQL_DATA_TRUNCATED)
+    { // have a row of data
+      sql_record* rec = new sql_record;
+      rec->resize(numColumns);
+      for (unsigned int i = 0; i < numColumns; i++)
       {
-        case MYSQL_TYPE_LONGLONG:
-          if (row[i] != nullptr)
-          {
-            v.set_asInt64(strtoll(row[i], nullptr, 10));
-          }
-          else
-          {
-            v.set_asInt64(0);
-          }
-          break;
-        case MYSQL_TYPE_DECIMAL:
-        case MYSQL_TYPE_NEWDECIMAL:
-        case MYSQL_TYPE_TINY:
-        case MYSQL_TYPE_SHORT:
-        case MYSQL_TYPE_INT24:
-        case MYSQL_TYPE_LONG:
-          if (row[i] != NULL)
-          {
-            v.set_asInt(atoi(row[i]));
-          }
-          else
-          {
-            v.set_asInt(0);
-          }
-          break;
-        case MYSQL_TYPE_FLOAT:
-        case MYSQL_TYPE_DOUBLE:
-          if (row[i] != NULL)
-          {
-            v.set_asDouble(atof(row[i]));
-          }
-          else
-          {
-            v.set_asDouble(0);
-          }
-          break;
-        case MYSQL_TYPE_STRING:
-        case MYSQL_TYPE_VAR_STRING:
-        case MYSQL_TYPE_VARCHAR:
-          if (row[i] != NULL)
-            v.set_asString((const char*)row[i]);
-          break;
-        case MYSQL_TYPE_TINY_BLOB:
-        case MYSQL_TYPE_MEDIUM_BLOB:
-        case MYSQL_TYPE_LONG_BLOB:
-        case MYSQL_TYPE_BLOB:
-          if (row[i] != NULL)
-            v.set_asString((const char*)row[i]);
-          break;
-        case MYSQL_TYPE_NULL:
-        default:
-          CLog::Log(LOGDEBUG, "MYSQL: Unknown field type: {}", fields[i].type);
-          v.set_asString("");
-          v.set_isNull();
-          break;
+        if (nulls[i])
+        {
+          convert_field_value(rec->at(i), fields[i].type, NULL);
+          continue;
+        }
+
+        if (lengths[i] > RESULT_BUFFER_SIZE)
+        {
+          // value didn't fit, fetch the whole column again
+          value.assign(lengths[i], '\0');
+          MYSQL_BIND column = columns[i];
+          column.buffer = &value[0];
+          column.buffer_length = lengths[i];
+          mysql_stmt_fetch_column(stmt, &column, i, 0);
+        }
+        else
+          value.assign(buffers[i].data(), lengths[i]);
+
+        convert_field_value(rec->at(i), fields[i].type, value.c_str());
       }
+      result.records.push_back(rec);
     }
-    result.records.push_back(res);
   }
-  mysql_free_result(stmt);
+  else
+    res = 1;
+
+  if (res != MYSQL_NO_DATA)
+    db->setErr(mysql_stmt_errno(stmt), qry.c_str());
+
+  mysql_free_result(meta);
+  mysql_stmt_free_result(stmt);
+
+  if (res != MYSQL_NO_DATA)
+    throw DbErrors("%s", db->getErrorMsg());
+
   active = true;
   ds_state = dsSelect;
   this->first();
@@ -31,6 +31,8 @@ protected:
   MYSQL* conn;
   bool _in_transaction;
   int last_err;
+  /* compiled statements of the parameterized exec/query calls */
+  StatementCache<MYSQL_STMT> statements;
 
 public:
   /* default constructor */
@@ -78,6 +80,9 @@ public:
 
   bool in_transaction() override { return _in_transaction; }
   int query_with_reconnect(const char* query);
+  /* executes the cached statement for sql with count params bound, reconnects once if the
+   server has gone away */
+  MYSQL_STMT* execute_prepared(const std::string& sql, MYSQL_BIND* params, unsigned int count);
   void configure_connection();
 
 private:
@@ -137,9 +142,11 @@ or insert() operations default = false) */
   /* func. executes a query without results to return */
   int exec() override;
   int exec(const std::string& sql) override;
+  int exec(const std::string& sql, const BindParams& params) override;
   const void* getExecRes() override;
   /* as open, but with our query exec Sql */
   bool query(const std::string& query) override;
+  bool query(const std::string& sql, const BindParams& params) override;
   /* func. closes a query */
   void close(void) override;
   /* Cancel changes, made in insert or edit states of dataset */
@@ -67,6 +67,7 @@ private:
 public:
   field_value();
   explicit field_value(const char* s);
+  explicit field_value(const std::string& s);
   explicit field_value(const bool b);
   explicit field_value(const char c);
   explicit field_value(const short s);
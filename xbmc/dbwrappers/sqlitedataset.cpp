@@ -208,7 +208,7 @@ static int busy_callback(void*, int busyCount)
 
 //************* SqliteDatabase implementation ***************
 
-SqliteDatabase::SqliteDatabase()
+SqliteDatabase::SqliteDatabase() : statements([](sqlite3_stmt* stmt) { sqlite3_finalize(stmt); })
 {
 
   active = false;
@@ -383,10 +383,26 @@ void SqliteDatabase::disconnect(void)
 {
   if (active == false)
     return;
+  // statements must be finalized before the connection can be closed
+  statements.clear();
   sqlite3_close(conn);
   active = false;
 }
 
+sqlite3_stmt* SqliteDatabase::prepareCached(const std::string& sql)
+{
+  sqlite3_stmt* stmt = statements.get(sql);
+  if (stmt)
+    return stmt;
+
+  if (setErr(sqlite3_prepare_v2(conn, sql.c_str(), -1, &stmt, NULL),
+             sql.c_str()) != SQLITE_OK)
+    throw DbErrors("%s", getErrorMsg());
+
+  statements.put(sql, stmt);
+  return stmt;
+}
+
 int SqliteDatabase::create()
 {
   return connect(true);
@@ -875,23 +891,59 @@ const void* SqliteDataset::getExecRes()
   return &exec_res;
 }
 
-bool SqliteDataset::query(const std::string& query)
+void SqliteDataset::bind_params(sqlite3_stmt* stmt,
+                                const std::string& sql,
+                                const BindParams& params)
 {
-  if (!handle())
-    throw DbErrors("No Database Connection");
-  const std::string& qry = query;
-  int fs = qry.find("select");
-  int fS = qry.find("SELECT");
-  if (!(fs >= 0 || fS >= 0))
-    throw DbErrors("MUST be select SQL!");
-
-  close();
+  if (static_cast<int>(params.size()) != sqlite3_bind_parameter_count(stmt))
+    throw DbErrors("%u parameters passed for %d placeholders\nQuery: %s",
+                   static_cast<unsigned int>(params.size()), sqlite3_bind_parameter_count(stmt),
+                   sql.c_str());
 
-  sqlite3_stmt* stmt = NULL;
-  if (db->setErr(sqlite3_prepare_v2(handle(), query.c_str(), -1, &stmt, NULL), query.c_str()) !=
-      SQLITE_OK)
-    throw DbErrors("%s", db->getErrorMsg());
+  for (unsigned int i = 0; i < params.size(); i++)
+  {
+    const field_value& value = params[i];
+    const int index = i + 1;
+    int res;
+    if (value.get_isNull())
+      res = sqlite3_bind_null(stmt, index);
+    else
+    {
+      switch (value.get_fType())
+      {
+        case ft_Boolean:
+        case ft_Short:
+        case ft_UShort:
+        case ft_Int:
+        case ft_UInt:
+        case ft_Int64:
+          res = sqlite3_bind_int64(stmt, index, value.get_asInt64());
+          break;
+        case ft_Float:
+        case ft_Double:
+        case ft_LongDouble:
+          res = sqlite3_bind_double(stmt, index, value.get_asDouble());
+          break;
+        default:
+        {
+          const std::string str = value.get_asString();
+          res = sqlite3_bind_text(stmt, index, str.c_str(), static_cast<int>(str.size()),
+                                  SQLITE_TRANSIENT);
+          break;
+        }
+      }
+    }
+    if (db->setErr(res, sql.c_str()) != SQLITE_OK)
+    {
+      sqlite3_reset(stmt);
+      sqlite3_clear_bindings(stmt);
+      throw DbErrors("%s", db->getErrorMsg());
+    }
+  }
+}
 
+void SqliteDataset::fetch_rows(sqlite3_stmt* stmt)
+{
   // column headers
   const unsigned int numColumns = sqlite3_column_count(stmt);
   result.record_header.resize(numColumns);
@@ -929,6 +981,73 @@ bool SqliteDataset::query(const std::string& query)
     }
     result.records.push_back(res);
   }
+}
+
+int SqliteDataset::exec(const std::string& sql, const BindParams& params)
+{
+  if (!handle())
+    throw DbErrors("No Database Connection");
+  exec_res.clear();
+
+  sqlite3_stmt* stmt = static_cast<SqliteDatabase*>(db)->prepareCached(sql);
+  bind_params(stmt, sql, params);
+
+  int res = sqlite3_step(stmt);
+  if (res == SQLITE_DONE || res == SQLITE_ROW)
+    res = SQLITE_OK;
+  // the error details are lost once the statement is reset
+  db->setErr(res, sql.c_str());
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+
+  if (res != SQLITE_OK)
+    throw DbErrors("%s", db->getErrorMsg());
+  return res;
+}
+
+bool SqliteDataset::query(const std::string& sql, const BindParams& params)
+{
+  if (!handle())
+    throw DbErrors("No Database Connection");
+  if (sql.find("select") == std::string::npos && sql.find("SELECT") == std::string::npos)
+    throw DbErrors("MUST be select SQL!");
+
+  close();
+
+  sqlite3_stmt* stmt = static_cast<SqliteDatabase*>(db)->prepareCached(sql);
+  bind_params(stmt, sql, params);
+  fetch_rows(stmt);
+
+  const int res = db->setErr(sqlite3_reset(stmt), sql.c_str());
+  sqlite3_clear_bindings(stmt);
+  if (res != SQLITE_OK)
+    throw DbErrors("%s", db->getErrorMsg());
+
+  active = true;
+  ds_state = dsSelect;
+  this->first();
+  return true;
+}
+
+bool SqliteDataset::query(const std::string& query)
+{
+  if (!handle())
+    throw DbErrors("No Database Connection");
+  const std::string& qry = query;
+  int fs = qry.find("select");
+  int fS = qry.find("SELECT");
+  if (!(fs >= 0 || fS >= 0))
+    throw DbErrors("MUST be select SQL!");
+
+  close();
+
+  sqlite3_stmt* stmt = NULL;
+  if (db->setErr(sqlite3_prepare_v2(handle(), query.c_str(), -1, &stmt, NULL), query.c_str()) !=
+      SQLITE_OK)
+    throw DbErrors("%s", db->getErrorMsg());
+
+  fetch_rows(stmt);
+
   if (db->setErr(sqlite3_finalize(stmt), query.c_str()) == SQLITE_OK)
   {
     active = true;
@@ -32,6 +32,8 @@ protected:
   sqlite3* conn;
   bool _in_transaction;
   int last_err;
+  /* compiled statements of the parameterized exec/query calls */
+  StatementCache<sqlite3_stmt> statements;
 
 public:
   /* default constructor */
@@ -43,6 +45,8 @@ public:
 
   /* func. returns connection handle with SQLite-server */
   sqlite3* getHandle() { return conn; }
+  /* func. returns the compiled statement for sql, reset and ready for binding */
+  sqlite3_stmt* prepareCached(const std::string& sql);
   /* func. returns current status about SQLite-server connection */
   int status() override;
   int setErr(int err_code, const char* qry) override;
@@ -110,6 +114,10 @@ protected:
   /* This function works only with MySQL database
   Filling the fields information from select statement */
   void fill_fields() override;
+  /* Bind params to the placeholders of stmt */
+  void bind_params(sqlite3_stmt* stmt, const std::string& sql, const BindParams& params);
+  /* Fill the result set with the rows returned by stmt */
+  void fetch_rows(sqlite3_stmt* stmt);
   /* Changing field values during dataset navigation */
   virtual void free_row(); // free the memory allocated for the current row
 
@@ -131,9 +139,11 @@ or insert() operations default = false) */
   /* func. executes a query without results to return */
   int exec() override;
   int exec(const std::string& sql) override;
+  int exec(const std::string& sql, const BindParams& params) override;
   const void* getExecRes() override;
   /* as open, but with our query exec Sql */
   bool query(const std::string& query) override;
+  bool query(const std::string& sql, const BindParams& params) override;
   /* func. closes a query */
   void close(void) override;
   /* Cancel changes, made in insert or edit states of dataset */
@@ -0,0 +1,118 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "dbwrappers/sqlitedataset.h"
+#include "filesystem/File.h"
+#include "test/TestUtils.h"
+#include "utils/URIUtils.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace dbiplus;
+
+class TestSqliteDataset : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_file = XBMC_CREATETEMPFILE(".db");
+    ASSERT_NE(m_file, nullptr);
+    const std::string path = XBMC_TEMPFILEPATH(m_file);
+
+    m_db.setHostName(URIUtils::GetDirectory(path).c_str());
+    m_db.setDatabase(URIUtils::GetFileName(path).c_str());
+    ASSERT_EQ(m_db.connect(true), DB_CONNECTION_OK);
+
+    m_ds.reset(m_db.CreateDataset());
+    m_ds->exec("CREATE TABLE song (idSong INTEGER PRIMARY KEY, strTitle TEXT, iTrack INTEGER, "
+               "rating FLOAT, strMusicBrainzTrackID TEXT)");
+  }
+
+  void TearDown() override
+  {
+    m_ds.reset();
+    m_db.disconnect();
+    XBMC_DELETETEMPFILE(m_file);
+  }
+
+  XFILE::CFile* m_file = nullptr;
+  SqliteDatabase m_db;
+  std::unique_ptr<Dataset> m_ds;
+};
+
+TEST_F(TestSqliteDataset, BindsParameters)
+{
+  const std::string insert = "INSERT INTO song (idSong, strTitle, iTrack, rating, "
+                             "strMusicBrainzTrackID) VALUES (NULL, ?, ?, ?, ?)";
+  m_ds->exec(insert,
+             {field_value("Don't Stop"), field_value(3), field_value(7.5), null_value()});
+  m_ds->exec(insert, {field_value("?"), field_value(int64_t(1) << 40), field_value(0.0),
+                      field_value("mbid")});
+
+  ASSERT_TRUE(m_ds->query("SELECT * FROM song WHERE iTrack = ?", {field_value(3)}));
+  ASSERT_EQ(m_ds->num_rows(), 1);
+  EXPECT_EQ(m_ds->fv("strTitle").get_asString(), "Don't Stop");
+  EXPECT_DOUBLE_EQ(m_ds->fv("rating").get_asDouble(), 7.5);
+  EXPECT_TRUE(m_ds->fv("strMusicBrainzTrackID").get_isNull());
+  m_ds->close();
+
+  ASSERT_TRUE(m_ds->query("SELECT * FROM song WHERE strMusicBrainzTrackID = ?",
+                          {field_value("mbid")}));
+  ASSERT_EQ(m_ds->num_rows(), 1);
+  EXPECT_EQ(m_ds->fv("strTitle").get_asString(), "?");
+  EXPECT_EQ(m_ds->fv("iTrack").get_asInt64(), int64_t(1) << 40);
+  EXPECT_EQ(m_ds->lastinsertid(), 2);
+  m_ds->close();
+}
+
+TEST_F(TestSqliteDataset, ReportsErrors)
+{
+  // wrong number of parameters
+  EXPECT_THROW(m_ds->exec("INSERT INTO song (strTitle) VALUES (?)", {}), DbErrors);
+  // constraint violation, the statement stays usable afterwards
+  const std::string insert = "INSERT INTO song (idSong, strTitle) VALUES (?, ?)";
+  m_ds->exec(insert, {field_value(1), field_value("a")});
+  EXPECT_THROW(m_ds->exec(insert, {field_value(1), field_value("b")}), DbErrors);
+  m_ds->exec(insert, {field_value(2), field_value("b")});
+
+  ASSERT_TRUE(m_ds->query("SELECT count(*) FROM song", {}));
+  EXPECT_EQ(m_ds->fv(0).get_asInt(), 2);
+  m_ds->close();
+}
+
+TEST_F(TestSqliteDataset, SubstitutesParameters)
+{
+  // quoted placeholders are left alone
+  EXPECT_EQ(m_db.prepare_params("SELECT '?' FROM song WHERE strTitle = ? AND idSong IS ?",
+                                {field_value("it's"), null_value()}),
+            "SELECT '?' FROM song WHERE strTitle = 'it''s' AND idSong IS NULL");
+}
+
+TEST(TestStatementCache, EvictsLeastRecentlyUsed)
+{
+  std::vector<int> finalized;
+  StatementCache<int> cache([&finalized](int* stmt) { finalized.push_back(*stmt); }, 2);
+
+  int a = 1, b = 2, c = 3;
+  cache.put("a", &a);
+  cache.put("b", &b);
+  EXPECT_EQ(cache.get("a"), &a);
+
+  cache.put("c", &c);
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_EQ(cache.get("b"), nullptr);
+  EXPECT_EQ(finalized, std::vector<int>{2});
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(finalized, (std::vector<int>{2, 3, 1}));
+}
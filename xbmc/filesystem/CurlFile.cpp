@@ -251,6 +251,7 @@ CCurlFile::CReadState::CReadState()
   m_stillRunning = 0;
   m_filePos = 0;
   m_fileSize = 0;
+  m_rangeEnd = -1;
   m_bufferSize = 0;
   m_cancelled = false;
   m_bFirstLoop = true;
@@ -273,6 +274,10 @@ CCurlFile::CReadState::~CReadState()
 
 bool CCurlFile::CReadState::Seek(int64_t pos)
 {
+  // a bounded transfer never delivers anything past its range end
+  if (m_rangeEnd >= 0 && pos > m_rangeEnd)
+    return false;
+
   if(pos == m_filePos)
     return true;
 
@@ -320,6 +325,16 @@ bool CCurlFile::CReadState::Seek(int64_t pos)
 
 void CCurlFile::CReadState::SetResume(void)
 {
+  if (m_rangeEnd >= m_filePos)
+  {
+    // Bounded request, the server only sends the bytes up to and including m_rangeEnd
+    const std::string range = StringUtils::Format("{}-{}", m_filePos, m_rangeEnd);
+    g_curlInterface.easy_setopt(m_easyHandle, CURLOPT_RANGE, range.c_str());
+    g_curlInterface.easy_setopt(m_easyHandle, CURLOPT_RESUME_FROM_LARGE, (curl_off_t)0);
+    m_sendRange = false;
+    return;
+  }
+
   /*
    * Explicitly set RANGE header when filepos=0 as some http servers require us to always send the range
    * request header. If we don't the server may provide different content causing seeking to fail.
@@ -377,6 +392,19 @@ long CCurlFile::CReadState::Connect(unsigned int size)
     if (length < 0)
       length = 0.0;
     m_fileSize = m_filePos + (int64_t)length;
+
+    // for bounded requests the length only covers the range, take the total from Content-Range
+    if (m_rangeEnd >= m_filePos)
+    {
+      const std::string contentRange = m_httpheader.GetValue("content-range");
+      const size_t slash = contentRange.rfind('/');
+      if (slash != std::string::npos)
+      {
+        const int64_t total = strtoll(contentRange.c_str() + slash + 1, nullptr, 10);
+        if (total > 0)
+          m_fileSize = total;
+      }
+    }
   }
 
   long response;
@@ -397,6 +425,7 @@ void CCurlFile::CReadState::Disconnect()
   m_overflowSize = 0;
   m_filePos = 0;
   m_fileSize = 0;
+  m_rangeEnd = -1;
   m_bufferSize = 0;
   m_readBuffer = 0;
 
@@ -463,6 +492,7 @@ void CCurlFile::Close()
   m_opened = false;
   m_forWrite = false;
   m_inError = false;
+  m_rangeEnd = -1;
 
   if (m_dnsCacheList)
     g_curlInterface.slist_free_all(m_dnsCacheList);
@@ -1175,6 +1205,14 @@ bool CCurlFile::Open(const CURL& url)
   return true;
 }
 
+bool CCurlFile::OpenRange(const CURL& url, int64_t start, int64_t end)
+{
+  m_state->m_filePos = start;
+  m_state->m_rangeEnd = end;
+
+  return Open(url);
+}
+
 bool CCurlFile::OpenForWrite(const CURL& url, bool bOverWrite)
 {
   if(m_opened)
@@ -1387,6 +1425,15 @@ bool CCurlFile::Exists(const CURL& url)
   return false;
 }
 
+bool CCurlFile::CanReuse(const CReadState* state, int64_t rangeEnd)
+{
+  // an open ended transfer would keep sending past a bounded request and a bounded
+  // transfer stops at its range end, so only reuse a transfer asking for the same
+  if (state->m_rangeEnd < 0)
+    return rangeEnd < 0;
+  return rangeEnd >= 0 && rangeEnd <= state->m_rangeEnd;
+}
+
 int64_t CCurlFile::Seek(int64_t iFilePosition, int iWhence)
 {
   int64_t nextPos = m_state->m_filePos;
@@ -1415,7 +1462,11 @@ int64_t CCurlFile::Seek(int64_t iFilePosition, int iWhence)
   // We can't seek beyond EOF
   if (m_state->m_fileSize && nextPos > m_state->m_fileSize) return -1;
 
-  if(m_state->Seek(nextPos))
+  // a range end set through IOCTRL_SET_RANGE_END only applies to this seek
+  const int64_t rangeEnd = m_rangeEnd >= nextPos ? m_rangeEnd : -1;
+  m_rangeEnd = -1;
+
+  if (CanReuse(m_state, rangeEnd) && m_state->Seek(nextPos))
     return nextPos;
 
   if (m_multisession)
@@ -1438,7 +1489,7 @@ int64_t CCurlFile::Seek(int64_t iFilePosition, int iWhence)
       m_state     = m_oldState;
       m_oldState  = tmp;
 
-      if (m_state->Seek(nextPos))
+      if (CanReuse(m_state, rangeEnd) && m_state->Seek(nextPos))
         return nextPos;
 
       m_state->Disconnect();
@@ -1455,6 +1506,7 @@ int64_t CCurlFile::Seek(int64_t iFilePosition, int iWhence)
   SetRequestHeaders(m_state);
 
   m_state->m_filePos = nextPos;
+  m_state->m_rangeEnd = rangeEnd;
   m_state->m_sendRange = true;
   m_state->m_bRetry = m_allowRetry;
 
@@ -1471,6 +1523,7 @@ int64_t CCurlFile::Seek(int64_t iFilePosition, int iWhence)
       }
       // Retry without multisession
       m_multisession = false;
+      m_rangeEnd = rangeEnd;
       return Seek(iFilePosition, iWhence);
     }
     else
@@ -2091,6 +2144,12 @@ int CCurlFile::IoControl(EIoControl request, void* param)
     return 0;
   }
 
+  if (request == IOCTRL_SET_RANGE_END)
+  {
+    m_rangeEnd = *static_cast<int64_t*>(param);
+    return 0;
+  }
+
   return -1;
 }
 
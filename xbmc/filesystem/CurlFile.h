@@ -38,6 +38,11 @@ namespace XFILE
       CCurlFile();
       ~CCurlFile() override;
       bool Open(const CURL& url) override;
+      /*!
+       * \brief Open the file with a bounded request for the bytes from start up to and including
+       * end. Seeks after the open are open ended unless IOCTRL_SET_RANGE_END is set again.
+       */
+      bool OpenRange(const CURL& url, int64_t start, int64_t end);
       bool OpenForWrite(const CURL& url, bool bOverWrite = false) override;
       bool ReOpen(const CURL& url) override;
       bool Exists(const CURL& url) override;
@@ -108,6 +113,7 @@ namespace XFILE
           bool m_cancelled;
           int64_t m_fileSize;
           int64_t m_filePos;
+          int64_t m_rangeEnd; // last byte requested, -1 if open ended
           bool m_bFirstLoop;
           bool m_isPaused;
           bool m_sendRange;
@@ -143,6 +149,7 @@ namespace XFILE
       void SetCommonOptions(CReadState* state, bool failOnError = true);
       void SetRequestHeaders(CReadState* state);
       void SetCorrectHeaders(CReadState* state);
+      static bool CanReuse(const CReadState* state, int64_t rangeEnd);
       bool Service(const std::string& strURL, std::string& strHTML);
       std::string GetInfoString(int infoType);
 
@@ -184,6 +191,7 @@ namespace XFILE
       bool m_skipshout;
       bool m_postdataset;
       bool m_allowRetry;
+      int64_t m_rangeEnd = -1;
       bool m_verifyPeer = true;
       bool m_failOnError = true;
       curl_slist* m_dnsCacheList = nullptr;
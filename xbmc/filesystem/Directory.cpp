@@ -323,7 +323,10 @@ bool CDirectory::Create(const CURL& url)
     std::unique_ptr<IDirectory> pDirectory(CDirectoryFactory::Create(realURL));
     if (pDirectory)
       if(pDirectory->Create(realURL))
+      {
+        g_directoryCache.ClearFile(URIUtils::SubstitutePath(url).Get());
         return true;
+      }
   }
   XBMCCOMMONS_HANDLE_UNCHECKED
   catch (...) { CLog::Log(LOGERROR, "{} - Unhandled exception", __FUNCTION__); }
@@ -342,15 +345,19 @@ bool CDirectory::Exists(const CURL& url, bool bUseCache /* = true */)
   try
   {
     CURL realURL = URIUtils::SubstitutePath(url);
+    std::string realPath(realURL.Get());
+    URIUtils::AddSlashAtEnd(realPath);
     if (bUseCache)
     {
       bool bPathInCache;
-      std::string realPath(realURL.Get());
-      URIUtils::AddSlashAtEnd(realPath);
       if (g_directoryCache.FileExists(realPath, bPathInCache))
         return true;
       if (bPathInCache)
         return false;
+
+      bool bExists;
+      if (g_directoryCache.GetCachedExists(realPath, bExists))
+        return bExists;
     }
 
     if (CPasswordManager::GetInstance().IsURLSupported(realURL) && realURL.GetUserName().empty())
@@ -358,7 +365,11 @@ bool CDirectory::Exists(const CURL& url, bool bUseCache /* = true */)
 
     std::unique_ptr<IDirectory> pDirectory(CDirectoryFactory::Create(realURL));
     if (pDirectory)
-      return pDirectory->Exists(realURL);
+    {
+      const bool bExists = pDirectory->Exists(realURL);
+      g_directoryCache.SetCachedExists(realPath, bExists);
+      return bExists;
+    }
   }
   XBMCCOMMONS_HANDLE_UNCHECKED
   catch (...) { CLog::Log(LOGERROR, "{} - Unhandled exception", __FUNCTION__); }
@@ -17,11 +17,15 @@
 
 #include <algorithm>
 #include <climits>
+#include <errno.h>
 #include <mutex>
 
 // Maximum number of directories to keep in our cache
 #define MAX_CACHED_DIRS 50
 
+// Maximum number of Exists()/Stat() results to keep in our cache
+#define MAX_CACHED_STATS 10000
+
 using namespace XFILE;
 
 CDirectoryCache::CDir::CDir(DIR_CACHE_TYPE cacheType) : m_Items(std::make_unique<CFileItemList>())
@@ -46,6 +50,7 @@ CDirectoryCache::CDirectoryCache(void)
   m_cacheHits = 0;
   m_cacheMisses = 0;
 #endif
+  ResetStatCacheTTLs();
 }
 
 CDirectoryCache::~CDirectoryCache(void) = default;
@@ -126,6 +131,7 @@ void CDirectoryCache::ClearDirectory(const std::string& strPath)
   URIUtils::RemoveSlashAtEnd(storedPath);
 
   m_cache.erase(storedPath);
+  ClearStatEntries(storedPath);
 }
 
 void CDirectoryCache::ClearSubPaths(const std::string& strPath)
@@ -143,6 +149,8 @@ void CDirectoryCache::ClearSubPaths(const std::string& strPath)
     else
       i++;
   }
+
+  ClearStatEntries(storedPath);
 }
 
 void CDirectoryCache::AddFile(const std::string& strFile)
@@ -150,8 +158,14 @@ void CDirectoryCache::AddFile(const std::string& strFile)
   std::unique_lock<CCriticalSection> lock(m_cs);
 
   // Get rid of any URL options, else the compare may be wrong
-  std::string strPath = URIUtils::GetDirectory(CURL(strFile).GetWithoutOptions());
+  const std::string strFileWithoutOptions = CURL(strFile).GetWithoutOptions();
+  std::string strPath = URIUtils::GetDirectory(strFileWithoutOptions);
+
+  // the file and the modification time of its folder changed
+  m_statCache.erase(strFileWithoutOptions);
+  m_statCache.erase(strPath);
   URIUtils::RemoveSlashAtEnd(strPath);
+  m_statCache.erase(strPath);
 
   auto i = m_cache.find(strPath);
   if (i != m_cache.end())
@@ -196,6 +210,225 @@ void CDirectoryCache::Clear()
   // this routine clears everything
   std::unique_lock<CCriticalSection> lock(m_cs);
   m_cache.clear();
+  m_statCache.clear();
+}
+
+std::string CDirectoryCache::GetStatKey(const std::string& strPath)
+{
+  // Get rid of any URL options, else the compare may be wrong. A trailing
+  // slash is kept, it tells directory lookups apart from file lookups.
+  return CURL(strPath).GetWithoutOptions();
+}
+
+const CDirectoryCache::CStatCacheTTL* CDirectoryCache::GetStatCacheTTL(
+    const std::string& key) const
+{
+  const size_t protocolEnd = key.find("://");
+  const std::string protocol =
+      protocolEnd == std::string::npos ? std::string() : key.substr(0, protocolEnd);
+
+  const CStatCacheTTL* protocolMatch = nullptr;
+  const CStatCacheTTL* pathMatch = nullptr;
+  for (const auto& rule : m_statCacheTTLs)
+  {
+    if (rule.prefix.find('/') != std::string::npos)
+    {
+      if (StringUtils::StartsWithNoCase(key, rule.prefix) &&
+          (!pathMatch || rule.prefix.size() > pathMatch->prefix.size()))
+        pathMatch = &rule;
+    }
+    else if (!protocol.empty() && StringUtils::EqualsNoCase(protocol, rule.prefix))
+      protocolMatch = &rule;
+  }
+
+  return pathMatch ? pathMatch : protocolMatch;
+}
+
+CDirectoryCache::CStatEntry* CDirectoryCache::FindStatEntry(const std::string& key)
+{
+  auto i = m_statCache.find(key);
+  if (i == m_statCache.end())
+    return nullptr;
+
+  if (i->second.expires <= std::chrono::steady_clock::now())
+  {
+    m_statCache.erase(i);
+    return nullptr;
+  }
+
+  return &i->second;
+}
+
+void CDirectoryCache::StoreStatEntry(const std::string& key, const CStatEntry& entry)
+{
+  if (m_statCache.size() >= MAX_CACHED_STATS)
+  {
+    const auto now = std::chrono::steady_clock::now();
+    for (auto i = m_statCache.begin(); i != m_statCache.end();)
+    {
+      if (i->second.expires <= now)
+        i = m_statCache.erase(i);
+      else
+        ++i;
+    }
+
+    if (m_statCache.size() >= MAX_CACHED_STATS)
+      m_statCache.clear();
+  }
+
+  m_statCache[key] = entry;
+}
+
+void CDirectoryCache::ClearStatEntries(const std::string& prefix)
+{
+  auto i = m_statCache.lower_bound(prefix);
+  while (i != m_statCache.end() && StringUtils::StartsWith(i->first, prefix))
+    i = m_statCache.erase(i);
+}
+
+bool CDirectoryCache::GetCachedExists(const std::string& strPath, bool& exists)
+{
+  std::unique_lock<CCriticalSection> lock(m_cs);
+
+  const CStatEntry* entry = FindStatEntry(GetStatKey(strPath));
+  if (!entry)
+  {
+    m_statStats.misses++;
+    return false;
+  }
+
+  exists = entry->exists;
+  if (exists)
+    m_statStats.hits++;
+  else
+    m_statStats.negativeHits++;
+  return true;
+}
+
+void CDirectoryCache::SetCachedExists(const std::string& strPath, bool exists)
+{
+  std::unique_lock<CCriticalSection> lock(m_cs);
+
+  const std::string key = GetStatKey(strPath);
+  const CStatCacheTTL* rule = GetStatCacheTTL(key);
+  if (!rule)
+    return;
+
+  const std::chrono::seconds ttl = exists ? rule->ttl : rule->negativeTTL;
+  if (ttl.count() <= 0)
+    return;
+
+  // keep what Stat() found out as long as it's still valid
+  const CStatEntry* current = FindStatEntry(key);
+  if (current && current->exists == exists)
+    return;
+
+  CStatEntry entry;
+  entry.expires = std::chrono::steady_clock::now() + ttl;
+  entry.exists = exists;
+  StoreStatEntry(key, entry);
+}
+
+bool CDirectoryCache::GetCachedStat(const std::string& strPath,
+                                    struct __stat64* buffer,
+                                    int& result)
+{
+  std::unique_lock<CCriticalSection> lock(m_cs);
+
+  const CStatEntry* entry = FindStatEntry(GetStatKey(strPath));
+  if (!entry || (entry->exists && !entry->hasStat))
+  {
+    m_statStats.misses++;
+    return false;
+  }
+
+  if (!entry->exists)
+  {
+    m_statStats.negativeHits++;
+    *buffer = {};
+    errno = ENOENT;
+    result = -1;
+    return true;
+  }
+
+  m_statStats.hits++;
+  *buffer = entry->stat;
+  result = 0;
+  return true;
+}
+
+void CDirectoryCache::SetCachedStat(const std::string& strPath,
+                                    int result,
+                                    const struct __stat64* buffer,
+                                    int error)
+{
+  const bool exists = result == 0;
+  if (!exists && error != ENOENT)
+    return;
+
+  std::unique_lock<CCriticalSection> lock(m_cs);
+
+  const std::string key = GetStatKey(strPath);
+  const CStatCacheTTL* rule = GetStatCacheTTL(key);
+  if (!rule)
+    return;
+
+  const std::chrono::seconds ttl = exists ? rule->ttl : rule->negativeTTL;
+  if (ttl.count() <= 0)
+    return;
+
+  CStatEntry entry;
+  entry.expires = std::chrono::steady_clock::now() + ttl;
+  entry.exists = exists;
+  entry.hasStat = exists;
+  if (exists)
+    entry.stat = *buffer;
+  StoreStatEntry(key, entry);
+}
+
+void CDirectoryCache::SetStatCacheTTL(const std::string& prefix,
+                                      std::chrono::seconds ttl,
+                                      std::chrono::seconds negativeTTL)
+{
+  std::unique_lock<CCriticalSection> lock(m_cs);
+
+  auto rule = std::find_if(m_statCacheTTLs.begin(), m_statCacheTTLs.end(),
+                           [&prefix](const CStatCacheTTL& rule) {
+                             return StringUtils::EqualsNoCase(rule.prefix, prefix);
+                           });
+  if (rule != m_statCacheTTLs.end())
+  {
+    rule->ttl = ttl;
+    rule->negativeTTL = negativeTTL;
+  }
+  else
+    m_statCacheTTLs.push_back({prefix, ttl, negativeTTL});
+
+  m_statCache.clear();
+}
+
+void CDirectoryCache::ResetStatCacheTTLs()
+{
+  std::unique_lock<CCriticalSection> lock(m_cs);
+
+  // nothing is cached unless enabled with <statcache> in advancedsettings.xml, other
+  // clients may change the files behind our back
+  m_statCacheTTLs.clear();
+  m_statCache.clear();
+}
+
+void CDirectoryCache::ClearStatCache()
+{
+  std::unique_lock<CCriticalSection> lock(m_cs);
+  m_statCache.clear();
+}
+
+CDirectoryCache::StatCacheStats CDirectoryCache::GetStatCacheStats() const
+{
+  std::unique_lock<CCriticalSection> lock(m_cs);
+  StatCacheStats stats = m_statStats;
+  stats.entries = m_statCache.size();
+  return stats;
 }
 
 void CDirectoryCache::InitCache(const std::set<std::string>& dirs)
@@ -242,12 +475,13 @@ void CDirectoryCache::CheckIfFull()
     m_cache.erase(lastAccessed);
 }
 
-#ifdef _DEBUG
 void CDirectoryCache::PrintStats() const
 {
   std::unique_lock<CCriticalSection> lock(m_cs);
+#ifdef _DEBUG
   CLog::Log(LOGDEBUG, "{} - total of {} cache hits, and {} cache misses", __FUNCTION__, m_cacheHits,
             m_cacheMisses);
+#endif
   // run through and find the oldest and the number of items cached
   unsigned int oldest = UINT_MAX;
   unsigned int numItems = 0;
@@ -261,5 +495,8 @@ void CDirectoryCache::PrintStats() const
   }
   CLog::Log(LOGDEBUG, "{} - {} folders cached, with {} items total.  Oldest is {}, current is {}",
             __FUNCTION__, numDirs, numItems, oldest, m_accessCounter);
+  CLog::Log(LOGDEBUG,
+            "{} - stat cache: {} hits, {} negative hits, {} misses, {} entries cached",
+            __FUNCTION__, m_statStats.hits, m_statStats.negativeHits, m_statStats.misses,
+            m_statCache.size());
 }
-#endif
@@ -9,11 +9,15 @@
 #pragma once
 
 #include "IDirectory.h"
+#include "PlatformDefs.h" // for __stat64
 #include "threads/CriticalSection.h"
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
+#include <vector>
 
 class CFileItem;
 
@@ -39,7 +43,31 @@ namespace XFILE
       CDir& operator=(const CDir&) = delete;
       unsigned int m_lastAccess;
     };
+
+    struct CStatEntry
+    {
+      std::chrono::steady_clock::time_point expires;
+      bool exists = false;
+      bool hasStat = false;
+      struct __stat64 stat = {};
+    };
+
+    struct CStatCacheTTL
+    {
+      std::string prefix; // protocol ("smb") or path ("smb://nas/recordings/")
+      std::chrono::seconds ttl;
+      std::chrono::seconds negativeTTL;
+    };
+
   public:
+    struct StatCacheStats
+    {
+      unsigned int hits = 0; //!< lookups answered with an existing file
+      unsigned int negativeHits = 0; //!< lookups answered with "does not exist"
+      unsigned int misses = 0; //!< lookups that had to go to the filesystem
+      size_t entries = 0;
+    };
+
     CDirectoryCache(void);
     virtual ~CDirectoryCache(void);
     bool GetDirectory(const std::string& strPath, CFileItemList &items, bool retrieveAll = false);
@@ -50,15 +78,67 @@ namespace XFILE
     void Clear();
     void AddFile(const std::string& strFile);
     bool FileExists(const std::string& strPath, bool& bInCache);
-#ifdef _DEBUG
+
+    /*!
+     \brief Look up the result of an earlier Exists() call for a file or, if the path
+     ends with a slash, a directory
+     \return true if a cached result was found and stored in exists
+     */
+    bool GetCachedExists(const std::string& strPath, bool& exists);
+    void SetCachedExists(const std::string& strPath, bool exists);
+
+    /*!
+     \brief Look up the result of an earlier Stat() call
+     \return true if a cached result was found. result is set to the return value of
+     the original call, buffer is filled when it succeeded
+     */
+    bool GetCachedStat(const std::string& strPath, struct __stat64* buffer, int& result);
+
+    /*!
+     \brief Remember the result of a Stat() call
+     \param result return value of the call, buffer has to be filled when it's 0
+     \param error errno set by a failed call. Only ENOENT is cached, other errors like timeouts
+     or lost connections may be gone on the next try
+     */
+    void SetCachedStat(const std::string& strPath,
+                       int result,
+                       const struct __stat64* buffer,
+                       int error);
+
+    /*!
+     \brief Set how long Exists()/Stat() results are cached for a protocol or a path
+     \param prefix protocol name or path prefix, the longest matching path wins over the protocol
+     \param ttl seconds found entries are kept, 0 disables caching
+     \param negativeTTL seconds "does not exist" results are kept, 0 disables caching
+     */
+    void SetStatCacheTTL(const std::string& prefix,
+                         std::chrono::seconds ttl,
+                         std::chrono::seconds negativeTTL);
+    void ResetStatCacheTTLs();
+
+    /*!
+     \brief Forget all cached Exists()/Stat() results, e.g. before comparing modification times
+     */
+    void ClearStatCache();
+
+    StatCacheStats GetStatCacheStats() const;
     void PrintStats() const;
-#endif
+
   protected:
     void InitCache(const std::set<std::string>& dirs);
     void ClearCache(std::set<std::string>& dirs);
     void CheckIfFull();
 
+    static std::string GetStatKey(const std::string& strPath);
+    const CStatCacheTTL* GetStatCacheTTL(const std::string& key) const;
+    CStatEntry* FindStatEntry(const std::string& key);
+    void StoreStatEntry(const std::string& key, const CStatEntry& entry);
+    void ClearStatEntries(const std::string& prefix);
+
     std::map<std::string, CDir> m_cache;
+    std::map<std::string, CStatEntry> m_statCache;
+    std::vector<CStatCacheTTL> m_statCacheTTLs;
+    StatCacheStats m_statStats;
 
     mutable CCriticalSection m_cs;
 
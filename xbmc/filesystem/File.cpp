@@ -443,13 +443,19 @@ bool CFile::Exists(const CURL& file, bool bUseCache /* = true */)
         return true;
       if (bPathInCache)
         return false;
+
+      bool bExists;
+      if (g_directoryCache.GetCachedExists(url.Get(), bExists))
+        return bExists;
     }
 
     std::unique_ptr<IFile> pFile(CFileFactory::CreateLoader(url));
     if (!pFile)
       return false;
 
-    return pFile->Exists(authUrl);
+    const bool bExists = pFile->Exists(authUrl);
+    g_directoryCache.SetCachedExists(url.Get(), bExists);
+    return bExists;
   }
   XBMCCOMMONS_HANDLE_UNCHECKED
   catch (CRedirectException *pRedirectEx)
@@ -526,10 +532,19 @@ int CFile::Stat(const CURL& file, struct __stat64* buffer)
 
   try
   {
+    int result;
+    if (g_directoryCache.GetCachedStat(url.Get(), buffer, result))
+      return result;
+
     std::unique_ptr<IFile> pFile(CFileFactory::CreateLoader(url));
     if (!pFile)
       return -1;
-    return pFile->Stat(authUrl, buffer);
+
+    // not every implementation sets errno, don't mistake a stale value for "not found"
+    errno = 0;
+    result = pFile->Stat(authUrl, buffer);
+    g_directoryCache.SetCachedStat(url.Get(), result, buffer, errno);
+    return result;
   }
   XBMCCOMMONS_HANDLE_UNCHECKED
   catch (CRedirectException *pRedirectEx)
@@ -9,7 +9,10 @@
 #include "FileCache.h"
 
 #include "CircularCache.h"
+#include "MappedFileCache.h"
+#include "SegmentedReader.h"
 #include "ServiceBroker.h"
+#include "SparseRangeCache.h"
 #include "URL.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
@@ -81,6 +84,7 @@ private:
 
 CFileCache::CFileCache(const unsigned int flags)
   : CThread("FileCache"),
+    m_segmented(false),
     m_seekPossible(0),
     m_nSeekResult(0),
     m_seekPos(0),
@@ -190,7 +194,12 @@ bool CFileCache::Open(const CURL& url)
       const size_t back = cacheSize / 4;
       const size_t front = cacheSize - back;
 
-      m_pCache = std::unique_ptr<CCircularCache>(new CCircularCache(front, back)); // C++14 - Replace with std::make_unique
+      if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cacheSparseRanges)
+        m_pCache = std::make_unique<CSparseRangeCache>(front, back);
+      else if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cacheMemoryMapped)
+        m_pCache = std::make_unique<CMappedFileCache>(front, back);
+      else
+        m_pCache = std::unique_ptr<CCircularCache>(new CCircularCache(front, back)); // C++14 - Replace with std::make_unique
       m_forwardCacheSize = front;
     }
 
@@ -209,6 +218,26 @@ bool CFileCache::Open(const CURL& url)
     return false;
   }
 
+  // Fill the cache over several range requests if the source allows it
+  const auto advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  if (advancedSettings->m_cacheSegmentConnections > 1 && m_seekPossible > 0 &&
+      m_fileSize > advancedSettings->m_cacheSegmentSize && CSegmentedReader::IsSupported(url))
+  {
+    m_segmentedReader = std::make_unique<CSegmentedReader>(
+        url, advancedSettings->m_cacheSegmentConnections, advancedSettings->m_cacheSegmentSize,
+        m_fileSize);
+    m_segmented = m_segmentedReader->Start(0);
+
+    if (m_segmented)
+    {
+      // the workers have their own connections, so replace the open ended transfer of the
+      // source with one for its first byte. ReadSource() seeks it again on fallback.
+      int64_t rangeEnd = 0;
+      m_source.IoControl(IOCTRL_SET_RANGE_END, &rangeEnd);
+      m_source.Seek(0, SEEK_SET);
+    }
+  }
+
   m_readPos = 0;
   m_writePos = 0;
   m_writeRate = 1024 * 1024;
@@ -259,7 +288,10 @@ void CFileCache::Process()
       bool sourceSeekFailed = false;
       if (!cacheReachEOF)
       {
-        m_nSeekResult = m_source.Seek(cacheMaxPos, SEEK_SET);
+        if (m_segmented)
+          m_nSeekResult = m_segmentedReader->Start(cacheMaxPos) ? cacheMaxPos : -1;
+        else
+          m_nSeekResult = m_source.Seek(cacheMaxPos, SEEK_SET);
         if (m_nSeekResult != cacheMaxPos)
         {
           CLog::Log(LOGERROR, "CFileCache::{} - <{}> error {} seeking. Seek returned {}",
@@ -328,7 +360,7 @@ void CFileCache::Process()
 
     ssize_t iRead = 0;
     if (maxSourceRead > 0)
-      iRead = m_source.Read(buffer.get(), maxSourceRead);
+      iRead = ReadSource(buffer.get(), maxSourceRead);
     if (iRead <= 0)
     {
       // Check for actual EOF and retry as long as we still have data in our cache
@@ -434,6 +466,27 @@ void CFileCache::Process()
   }
 }
 
+ssize_t CFileCache::ReadSource(char* buffer, size_t size)
+{
+  if (m_segmented)
+  {
+    const ssize_t iRead = m_segmentedReader->Read(buffer, size);
+    if (iRead >= 0 || m_bStop)
+      return iRead;
+
+    CLog::Log(LOGWARNING,
+              "CFileCache::{} - <{}> segmented download failed, falling back to a single connection",
+              __FUNCTION__, m_sourcePath);
+    m_segmented = false;
+    m_segmentedReader->Stop();
+
+    if (m_source.Seek(m_writePos, SEEK_SET) != m_writePos)
+      return -1;
+  }
+
+  return m_source.Read(buffer, size);
+}
+
 void CFileCache::OnExit()
 {
   m_bStop = true;
@@ -573,6 +626,8 @@ void CFileCache::Close()
   if (m_pCache)
     m_pCache->Close();
 
+  m_segmentedReader.reset();
+  m_segmented = false;
   m_source.Close();
 }
 
@@ -591,6 +646,9 @@ void CFileCache::StopThread(bool bWait /*= true*/)
   m_bStop = true;
   //Process could be waiting for seekEvent
   m_seekEvent.Set();
+  //or for a segment to arrive
+  if (m_segmentedReader)
+    m_segmentedReader->Stop();
   CThread::StopThread(bWait);
 }
 
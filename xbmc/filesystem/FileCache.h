@@ -19,6 +19,7 @@
 
 namespace XFILE
 {
+  class CSegmentedReader;
 
   class CFileCache : public IFile, public CThread
   {
@@ -55,7 +56,11 @@ namespace XFILE
     }
 
   private:
+    ssize_t ReadSource(char* buffer, size_t size);
+
     std::unique_ptr<CCacheStrategy> m_pCache;
+    std::unique_ptr<CSegmentedReader> m_segmentedReader;
+    bool m_segmented;
     int m_seekPossible;
     CFile m_source;
     std::string m_sourcePath;
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "MappedFileCache.h"
+
+#include "utils/log.h"
+
+#include <mutex>
+#include <system_error>
+
+#if defined(TARGET_POSIX)
+#include "platform/posix/utils/Mmap.h"
+
+#include <sys/mman.h>
+
+using KODI::UTILS::POSIX::CMmap;
+#endif
+
+using namespace XFILE;
+
+CMappedFileCache::CMappedFileCache(size_t front, size_t back) : CCircularCache(front, back)
+{
+}
+
+CMappedFileCache::~CMappedFileCache()
+{
+  // the base class destructor would free the mapping with delete[]
+  Close();
+}
+
+int CMappedFileCache::Open()
+{
+#if defined(TARGET_POSIX)
+  Close();
+
+  // anonymous pages are only committed once written and go back to the system on Close()
+  try
+  {
+    m_mmap = std::make_unique<CMmap>(nullptr, m_size, PROT_READ | PROT_WRITE,
+                                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  }
+  catch (const std::system_error& e)
+  {
+    CLog::Log(LOGERROR, "CMappedFileCache::{} - Failed to map {} bytes: {}", __FUNCTION__, m_size,
+              e.what());
+    return CACHE_RC_ERROR;
+  }
+
+  // the cache is filled and consumed front to back
+  posix_madvise(m_mmap->Data(), m_size, POSIX_MADV_SEQUENTIAL);
+
+  CLog::Log(LOGDEBUG, "CMappedFileCache::{} - mapped {} bytes", __FUNCTION__, m_size);
+
+  std::unique_lock<CCriticalSection> lock(m_sync);
+  m_buf = static_cast<uint8_t*>(m_mmap->Data());
+  m_beg = 0;
+  m_end = 0;
+  m_cur = 0;
+  return CACHE_RC_OK;
+#else
+  // CCircularCache already uses a pagefile backed mapping
+  return CCircularCache::Open();
+#endif
+}
+
+void CMappedFileCache::Close()
+{
+#if defined(TARGET_POSIX)
+  std::unique_lock<CCriticalSection> lock(m_sync);
+  m_buf = nullptr;
+  m_mmap.reset();
+#else
+  CCircularCache::Close();
+#endif
+}
+
+CCacheStrategy* CMappedFileCache::CreateNew()
+{
+  return new CMappedFileCache(m_size - m_size_back, m_size_back);
+}
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "CircularCache.h"
+
+#include <memory>
+
+#if defined(TARGET_POSIX)
+namespace KODI
+{
+namespace UTILS
+{
+namespace POSIX
+{
+class CMmap;
+}
+} // namespace UTILS
+} // namespace KODI
+#endif
+
+namespace XFILE
+{
+
+/*!
+ * \brief Circular cache whose buffer is a private anonymous memory mapping.
+ *
+ * Behaves like CCircularCache, but a very large read-ahead buffer only commits
+ * the pages that have actually been filled, and the whole buffer is returned to
+ * the system as soon as the cache is closed instead of staying in the heap.
+ */
+class CMappedFileCache : public CCircularCache
+{
+public:
+  CMappedFileCache(size_t front, size_t back);
+  ~CMappedFileCache() override;
+
+  int Open() override;
+  void Close() override;
+
+  CCacheStrategy* CreateNew() override;
+
+#if defined(TARGET_POSIX)
+private:
+  std::unique_ptr<KODI::UTILS::POSIX::CMmap> m_mmap;
+#endif
+};
+
+} // namespace XFILE
@@ -0,0 +1,282 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SegmentedReader.h"
+
+#include "CurlFile.h"
+#include "threads/Thread.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+using namespace XFILE;
+using namespace std::chrono_literals;
+
+class CSegmentedReader::CWorker : public CThread
+{
+public:
+  explicit CWorker(CSegmentedReader& reader) : CThread("SegmentedReader"), m_reader(reader) {}
+  ~CWorker() override { StopThread(); }
+
+  bool IsStopping() const { return m_bStop; }
+
+  CCurlFile m_file;
+  bool m_opened = false;
+
+protected:
+  void Process() override { m_reader.Run(*this); }
+
+private:
+  CSegmentedReader& m_reader;
+};
+
+CSegmentedReader::CSegmentedReader(const CURL& url,
+                                   unsigned int connections,
+                                   unsigned int segmentSize,
+                                   int64_t fileSize)
+  : m_url(url),
+    m_redactedUrl(url.GetRedacted()),
+    m_connections(std::max(connections, 1u)),
+    m_segmentSize(segmentSize),
+    m_maxSegments(2 * m_connections),
+    m_fileSize(fileSize)
+{
+}
+
+CSegmentedReader::~CSegmentedReader()
+{
+  Stop();
+}
+
+bool CSegmentedReader::IsSupported(const CURL& url)
+{
+  return url.IsProtocol("http") || url.IsProtocol("https") || url.IsProtocol("dav") ||
+         url.IsProtocol("davs");
+}
+
+bool CSegmentedReader::Start(int64_t position)
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  if (m_stopped)
+    return false;
+
+  for (const auto& segment : m_segments)
+    segment->cancelled = true;
+  m_segments.clear();
+
+  m_position = position;
+  m_nextStart = position;
+
+  if (m_workers.empty())
+  {
+    CLog::Log(LOGDEBUG, "CSegmentedReader::{} - <{}> using {} connections with {} byte segments",
+              __FUNCTION__, m_redactedUrl, m_connections, m_segmentSize);
+
+    for (unsigned int i = 0; i < m_connections; i++)
+    {
+      m_workers.emplace_back(std::make_unique<CWorker>(*this));
+      m_workers.back()->Create();
+    }
+  }
+
+  m_workCond.notifyAll();
+  return true;
+}
+
+void CSegmentedReader::Stop()
+{
+  std::vector<std::unique_ptr<CWorker>> workers;
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    m_stopped = true;
+    for (const auto& segment : m_segments)
+      segment->cancelled = true;
+    workers.swap(m_workers);
+  }
+
+  m_dataCond.notifyAll();
+  m_workCond.notifyAll();
+
+  for (auto& worker : workers)
+    worker->StopThread();
+}
+
+ssize_t CSegmentedReader::Read(void* lpBuf, size_t uiBufSize)
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+
+  while (true)
+  {
+    if (m_stopped)
+      return -1;
+
+    if (m_position >= m_fileSize)
+      return 0;
+
+    if (!m_segments.empty())
+    {
+      Segment& segment = *m_segments.front();
+      if (segment.filled > segment.consumed)
+      {
+        const size_t size = std::min(uiBufSize, segment.filled - segment.consumed);
+        memcpy(lpBuf, segment.data.data() + segment.consumed, size);
+        segment.consumed += size;
+        m_position += size;
+
+        if (segment.start + static_cast<int64_t>(segment.consumed) == segment.end)
+        {
+          if (m_spareBuffers.size() < m_maxSegments)
+            m_spareBuffers.emplace_back(std::move(segment.data));
+          m_segments.pop_front();
+          m_workCond.notifyAll();
+        }
+        return size;
+      }
+
+      if (segment.failed)
+        return -1;
+    }
+
+    m_dataCond.wait(lock, 100ms);
+  }
+}
+
+std::shared_ptr<CSegmentedReader::Segment> CSegmentedReader::ClaimSegment(size_t& offset)
+{
+  // retry segments a failed worker gave back first, they block the reader
+  for (const auto& segment : m_segments)
+  {
+    if (!segment->assigned && !segment->failed)
+    {
+      segment->assigned = true;
+      offset = segment->filled;
+      return segment;
+    }
+  }
+
+  if (m_segments.size() >= m_maxSegments || m_nextStart >= m_fileSize)
+    return {};
+
+  auto segment = std::make_shared<Segment>();
+  segment->start = m_nextStart;
+  segment->end = std::min(m_nextStart + m_segmentSize, m_fileSize);
+  if (!m_spareBuffers.empty())
+  {
+    segment->data = std::move(m_spareBuffers.back());
+    m_spareBuffers.pop_back();
+  }
+  segment->data.resize(static_cast<size_t>(segment->end - segment->start));
+  segment->assigned = true;
+
+  m_nextStart = segment->end;
+  m_segments.push_back(segment);
+
+  offset = 0;
+  return segment;
+}
+
+void CSegmentedReader::Run(CWorker& worker)
+{
+  while (!worker.IsStopping())
+  {
+    std::shared_ptr<Segment> segment;
+    size_t offset = 0;
+    {
+      std::unique_lock<CCriticalSection> lock(m_section);
+      while (!m_stopped && !worker.IsStopping() && !(segment = ClaimSegment(offset)))
+        m_workCond.wait(lock, 100ms);
+
+      if (!segment)
+        break;
+    }
+
+    const bool success = Fetch(worker, *segment, offset);
+    if (!success)
+    {
+      std::unique_lock<CCriticalSection> lock(m_section);
+      if (!segment->cancelled)
+      {
+        if (++segment->retries > MAX_RETRIES)
+        {
+          CLog::Log(LOGERROR, "CSegmentedReader::{} - <{}> giving up on segment at {}",
+                    __FUNCTION__, m_redactedUrl, segment->start);
+          segment->failed = true;
+        }
+        else
+          segment->assigned = false;
+      }
+    }
+
+    if (!success)
+    {
+      // start over with a fresh connection
+      worker.m_file.Close();
+      worker.m_opened = false;
+
+      m_dataCond.notifyAll();
+      m_workCond.notifyAll();
+    }
+  }
+
+  worker.m_file.Close();
+}
+
+bool CSegmentedReader::Fetch(CWorker& worker, Segment& segment, size_t offset)
+{
+  CCurlFile& file = worker.m_file;
+
+  int64_t pos = segment.start + offset;
+  int64_t rangeEnd = segment.end - 1;
+
+  if (!worker.m_opened)
+  {
+    // the first request of a connection only asks for the segment it was opened for
+    if (!file.OpenRange(m_url, pos, rangeEnd))
+    {
+      CLog::Log(LOGWARNING, "CSegmentedReader::{} - <{}> failed to open connection",
+                __FUNCTION__, m_redactedUrl);
+      return false;
+    }
+    worker.m_opened = true;
+  }
+
+  file.IoControl(IOCTRL_SET_RANGE_END, &rangeEnd);
+
+  if (file.Seek(pos, SEEK_SET) != pos)
+  {
+    CLog::Log(LOGWARNING, "CSegmentedReader::{} - <{}> failed to seek to {}", __FUNCTION__,
+              m_redactedUrl, pos);
+    return false;
+  }
+
+  while (pos < segment.end)
+  {
+    if (segment.cancelled || worker.IsStopping())
+      return true;
+
+    const size_t size = static_cast<size_t>(std::min<int64_t>(FETCH_CHUNK, segment.end - pos));
+    const ssize_t read = file.Read(segment.data.data() + (pos - segment.start), size);
+    if (read <= 0)
+    {
+      CLog::Log(LOGWARNING, "CSegmentedReader::{} - <{}> read at {} returned {}", __FUNCTION__,
+                m_redactedUrl, pos, read);
+      return false;
+    }
+
+    pos += read;
+    {
+      std::unique_lock<CCriticalSection> lock(m_section);
+      segment.filled = static_cast<size_t>(pos - segment.start);
+    }
+    m_dataCond.notifyAll();
+  }
+
+  return true;
+}
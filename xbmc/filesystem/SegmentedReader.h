@@ -0,0 +1,108 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "PlatformDefs.h" // for ssize_t
+#include "URL.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+namespace XFILE
+{
+
+/*!
+ * \brief Downloads a remote file over several connections at once.
+ *
+ * The file is split into fixed size segments which a set of worker threads fetch
+ * with bounded range requests. Read() hands out the data strictly in file order,
+ * so to the caller it looks like a single sequential stream. This keeps the fill
+ * rate up on links where one connection is limited by latency rather than by
+ * bandwidth.
+ */
+class CSegmentedReader
+{
+public:
+  CSegmentedReader(const CURL& url,
+                   unsigned int connections,
+                   unsigned int segmentSize,
+                   int64_t fileSize);
+  ~CSegmentedReader();
+
+  /*!
+   * \brief Whether the protocol of url supports bounded range requests.
+   */
+  static bool IsSupported(const CURL& url);
+
+  /*!
+   * \brief Drop all pending segments and continue fetching at position.
+   * Starts the worker threads on first use.
+   */
+  bool Start(int64_t position);
+
+  /*!
+   * \brief Stop all workers and wake up a blocked Read(). Can't be restarted.
+   */
+  void Stop();
+
+  /*!
+   * \brief Read the next bytes in file order, blocking until they arrived.
+   * \return bytes read, 0 at end of file, -1 if a segment could not be fetched
+   * or the reader was stopped
+   */
+  ssize_t Read(void* lpBuf, size_t uiBufSize);
+
+private:
+  struct Segment
+  {
+    int64_t start = 0;
+    int64_t end = 0; // exclusive
+    std::vector<char> data;
+    size_t filled = 0;
+    size_t consumed = 0;
+    unsigned int retries = 0;
+    bool assigned = false;
+    bool failed = false;
+    std::atomic<bool> cancelled{false};
+  };
+
+  class CWorker;
+  friend class CWorker;
+
+  void Run(CWorker& worker);
+  bool Fetch(CWorker& worker, Segment& segment, size_t offset);
+  std::shared_ptr<Segment> ClaimSegment(size_t& offset);
+
+  static constexpr unsigned int MAX_RETRIES = 3;
+  static constexpr size_t FETCH_CHUNK = 64 * 1024;
+
+  const CURL m_url;
+  const std::string m_redactedUrl;
+  const unsigned int m_connections;
+  const unsigned int m_segmentSize;
+  const size_t m_maxSegments;
+  const int64_t m_fileSize;
+
+  CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_dataCond;
+  XbmcThreads::ConditionVariable m_workCond;
+  std::deque<std::shared_ptr<Segment>> m_segments;
+  std::vector<std::vector<char>> m_spareBuffers;
+  std::vector<std::unique_ptr<CWorker>> m_workers;
+  int64_t m_position = 0;
+  int64_t m_nextStart = 0;
+  bool m_stopped = false;
+};
+
+} // namespace XFILE
@@ -0,0 +1,359 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SparseRangeCache.h"
+
+#include "threads/SystemClock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string.h>
+
+using namespace XFILE;
+using namespace std::chrono_literals;
+
+CSparseRangeCache::CSparseRangeCache(size_t front, size_t back, size_t blockSize)
+  : m_front(front),
+    m_back(back),
+    m_blockSize(blockSize ? blockSize
+                          : std::clamp<size_t>((front + back) / 256, 64 * 1024, 4 * 1024 * 1024)),
+    // a few blocks of slack for the partially filled blocks at both ends of the window
+    m_maxBlocks((front + back + m_blockSize - 1) / m_blockSize + 3)
+{
+}
+
+CSparseRangeCache::~CSparseRangeCache()
+{
+  Close();
+}
+
+int CSparseRangeCache::Open()
+{
+  std::unique_lock<CCriticalSection> lock(m_sync);
+  m_blocks.clear();
+  m_lru.clear();
+  m_cur = 0;
+  m_end = 0;
+  return CACHE_RC_OK;
+}
+
+void CSparseRangeCache::Close()
+{
+  std::unique_lock<CCriticalSection> lock(m_sync);
+  m_blocks.clear();
+  m_lru.clear();
+}
+
+CSparseRangeCache::Block* CSparseRangeCache::FindBlock(int64_t pos)
+{
+  auto it = m_blocks.find(BlockStart(pos));
+  if (it != m_blocks.end() && pos >= it->second.begin && pos <= it->second.end)
+    return &it->second;
+
+  // pos may be the end of the data in the block before
+  if (pos > 0 && pos == BlockStart(pos))
+  {
+    it = m_blocks.find(pos - m_blockSize);
+    if (it != m_blocks.end() && it->second.end == pos && it->second.begin < pos)
+      return &it->second;
+  }
+
+  return nullptr;
+}
+
+bool CSparseRangeCache::IsCached(int64_t pos)
+{
+  return pos == m_end || FindBlock(pos) != nullptr;
+}
+
+int64_t CSparseRangeCache::RangeStart(int64_t pos)
+{
+  const Block* block = FindBlock(pos);
+  if (!block)
+    return pos;
+
+  int64_t start = block->begin;
+  while (start > 0 && start == BlockStart(start))
+  {
+    auto it = m_blocks.find(start - m_blockSize);
+    if (it == m_blocks.end() || it->second.end != start)
+      break;
+    start = it->second.begin;
+  }
+  return start;
+}
+
+int64_t CSparseRangeCache::RangeEnd(int64_t pos)
+{
+  const Block* block = FindBlock(pos);
+  if (!block)
+    return pos;
+
+  int64_t end = block->end;
+  while (end == BlockStart(end))
+  {
+    auto it = m_blocks.find(end);
+    if (it == m_blocks.end() || it->second.begin != end || it->second.end == end)
+      break;
+    end = it->second.end;
+  }
+  return end;
+}
+
+void CSparseRangeCache::Touch(Block& block)
+{
+  m_lru.splice(m_lru.end(), m_lru, block.lru);
+}
+
+CSparseRangeCache::Block* CSparseRangeCache::GetWriteBlock(int64_t pos)
+{
+  const int64_t start = BlockStart(pos);
+  auto it = m_blocks.find(start);
+  if (it != m_blocks.end())
+    return &it->second;
+
+  std::unique_ptr<uint8_t[]> data;
+  if (m_blocks.size() >= m_maxBlocks)
+  {
+    // recycle the least recently used block that is not part of the read window
+    const int64_t protectedStart = BlockStart(std::max<int64_t>(0, m_cur - m_back));
+    for (auto lru = m_lru.begin(); lru != m_lru.end(); ++lru)
+    {
+      if (*lru >= protectedStart && *lru <= start)
+        continue;
+
+      auto victim = m_blocks.find(*lru);
+      data = std::move(victim->second.data);
+      m_blocks.erase(victim);
+      m_lru.erase(lru);
+      break;
+    }
+
+    if (!data)
+      return nullptr;
+  }
+  else
+  {
+    data.reset(new uint8_t[m_blockSize]);
+  }
+
+  Block& block = m_blocks[start];
+  block.data = std::move(data);
+  block.begin = pos;
+  block.end = pos;
+  block.lru = m_lru.insert(m_lru.end(), start);
+  return &block;
+}
+
+size_t CSparseRangeCache::GetMaxWriteSize(const size_t& iRequestSize)
+{
+  std::unique_lock<CCriticalSection> lock(m_sync);
+
+  const size_t front = static_cast<size_t>(m_end - m_cur);
+  if (front >= m_front)
+    return 0;
+
+  return std::min(iRequestSize, m_front - front);
+}
+
+int CSparseRangeCache::WriteToCache(const char* pBuffer, size_t iSize)
+{
+  std::unique_lock<CCriticalSection> lock(m_sync);
+
+  const size_t front = static_cast<size_t>(m_end - m_cur);
+  if (front >= m_front)
+    return 0;
+
+  // limit by max forward size and to the end of the block
+  size_t len = std::min(iSize, m_front - front);
+  len = std::min(len, static_cast<size_t>(BlockStart(m_end) + m_blockSize - m_end));
+  if (len == 0)
+    return 0;
+
+  Block* block = GetWriteBlock(m_end);
+  if (!block)
+    return 0;
+
+  memcpy(block->data.get() + (m_end - BlockStart(m_end)), pBuffer, len);
+
+  const int64_t writeEnd = m_end + static_cast<int64_t>(len);
+  if (m_end >= block->begin && m_end <= block->end)
+  {
+    block->end = std::max(block->end, writeEnd);
+  }
+  else if (m_end < block->begin && writeEnd >= block->begin)
+  {
+    block->begin = m_end;
+    block->end = std::max(block->end, writeEnd);
+  }
+  else
+  {
+    // not adjacent to what the block held, forget the old data
+    block->begin = m_end;
+    block->end = writeEnd;
+  }
+
+  m_end = writeEnd;
+  Touch(*block);
+
+  m_written.Set();
+
+  return static_cast<int>(len);
+}
+
+size_t CSparseRangeCache::GetAvailableRead(const uint8_t** data)
+{
+  if (m_cur >= m_end)
+    return 0;
+
+  auto it = m_blocks.find(BlockStart(m_cur));
+  if (it == m_blocks.end())
+    return 0;
+
+  Block& block = it->second;
+  if (m_cur < block.begin || m_cur >= block.end)
+    return 0;
+
+  Touch(block);
+  *data = block.data.get() + (m_cur - BlockStart(m_cur));
+  return static_cast<size_t>(std::min(block.end, m_end) - m_cur);
+}
+
+int CSparseRangeCache::ReadFromCache(char* pBuffer, size_t iMaxSize)
+{
+  std::unique_lock<CCriticalSection> lock(m_sync);
+
+  const uint8_t* data = nullptr;
+  const size_t avail = GetAvailableRead(&data);
+  if (avail == 0)
+    return IsEndOfInput() ? 0 : CACHE_RC_WOULD_BLOCK;
+
+  const size_t len = std::min(iMaxSize, avail);
+  memcpy(pBuffer, data, len);
+  m_cur += len;
+
+  m_space.Set();
+
+  return static_cast<int>(len);
+}
+
+int64_t CSparseRangeCache::WaitForData(uint32_t iMinAvail, std::chrono::milliseconds timeout)
+{
+  std::unique_lock<CCriticalSection> lock(m_sync);
+  int64_t avail = m_end - m_cur;
+
+  if (timeout == 0ms || IsEndOfInput())
+    return avail;
+
+  if (iMinAvail > m_front)
+    iMinAvail = m_front;
+
+  XbmcThreads::EndTime<> endtime{timeout};
+  while (!IsEndOfInput() && avail < iMinAvail && !endtime.IsTimePast())
+  {
+    lock.unlock();
+    m_written.Wait(50ms);
+    lock.lock();
+    avail = m_end - m_cur;
+  }
+
+  return avail;
+}
+
+int64_t CSparseRangeCache::Seek(int64_t iFilePosition)
+{
+  std::unique_lock<CCriticalSection> lock(m_sync);
+
+  // a bit ahead of the write position, wait for the data rather than seeking the source
+  if (iFilePosition >= m_end && iFilePosition < m_end + 100000)
+  {
+    m_cur = m_end;
+
+    lock.unlock();
+    WaitForData(static_cast<uint32_t>(iFilePosition - m_cur), 5s);
+    lock.lock();
+  }
+
+  // only the range being written is served directly, others need a reset that
+  // moves the write position to their end
+  if (iFilePosition <= m_end && iFilePosition >= RangeStart(m_end))
+  {
+    m_cur = iFilePosition;
+    return iFilePosition;
+  }
+
+  return CACHE_RC_ERROR;
+}
+
+bool CSparseRangeCache::Reset(int64_t iSourcePosition)
+{
+  std::unique_lock<CCriticalSection> lock(m_sync);
+
+  if (IsCached(iSourcePosition))
+  {
+    m_cur = iSourcePosition;
+    m_end = std::max(RangeEnd(iSourcePosition), iSourcePosition);
+    CLog::Log(LOGDEBUG, "CSparseRangeCache::{} - ({}) continuing cached range at {} up to {}",
+              __FUNCTION__, fmt::ptr(this), m_cur, m_end);
+    return false;
+  }
+
+  m_cur = iSourcePosition;
+  m_end = iSourcePosition;
+  return true;
+}
+
+int64_t CSparseRangeCache::CachedDataEndPosIfSeekTo(int64_t iFilePosition)
+{
+  std::unique_lock<CCriticalSection> lock(m_sync);
+  if (IsCached(iFilePosition))
+    return std::max(RangeEnd(iFilePosition), iFilePosition);
+  return iFilePosition;
+}
+
+int64_t CSparseRangeCache::CachedDataStartPos()
+{
+  std::unique_lock<CCriticalSection> lock(m_sync);
+  return RangeStart(m_cur);
+}
+
+int64_t CSparseRangeCache::CachedDataEndPos()
+{
+  std::unique_lock<CCriticalSection> lock(m_sync);
+  return m_end;
+}
+
+bool CSparseRangeCache::IsCachedPosition(int64_t iFilePosition)
+{
+  std::unique_lock<CCriticalSection> lock(m_sync);
+  return IsCached(iFilePosition);
+}
+
+size_t CSparseRangeCache::GetRangeCount()
+{
+  std::unique_lock<CCriticalSection> lock(m_sync);
+
+  size_t count = 0;
+  int64_t previousEnd = -1;
+  for (const auto& it : m_blocks)
+  {
+    const Block& block = it.second;
+    if (block.begin == block.end)
+      continue;
+    if (block.begin != previousEnd)
+      count++;
+    previousEnd = block.end;
+  }
+  return count;
+}
+
+CCacheStrategy* CSparseRangeCache::CreateNew()
+{
+  return new CSparseRangeCache(m_front, m_back, m_blockSize);
+}
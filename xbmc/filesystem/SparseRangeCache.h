@@ -0,0 +1,100 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "CacheStrategy.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+#include <list>
+#include <map>
+#include <memory>
+
+namespace XFILE
+{
+
+/*!
+ * \brief Memory cache that keeps several disjoint ranges of the file.
+ *
+ * The file is cached in fixed size blocks. Seeking away from the current range
+ * keeps what was buffered so far; when memory runs out the least recently used
+ * blocks outside the active read window are dropped. Seeking back into an older
+ * range can be served from memory again, the source only has to continue at the
+ * end of that range.
+ *
+ * Reads and writes behave like CCircularCache: the writer appends at
+ * CachedDataEndPos(), which together with the read position always lies in a
+ * single contiguous range.
+ */
+class CSparseRangeCache : public CCacheStrategy
+{
+public:
+  /*!
+   * \param front max bytes buffered ahead of the read position
+   * \param back bytes behind the read position guaranteed to stay cached
+   * \param blockSize granularity of the cache, 0 to derive it from the total size
+   */
+  CSparseRangeCache(size_t front, size_t back, size_t blockSize = 0);
+  ~CSparseRangeCache() override;
+
+  int Open() override;
+  void Close() override;
+
+  size_t GetMaxWriteSize(const size_t& iRequestSize) override;
+  int WriteToCache(const char* pBuffer, size_t iSize) override;
+  int ReadFromCache(char* pBuffer, size_t iMaxSize) override;
+  int64_t WaitForData(uint32_t iMinAvail, std::chrono::milliseconds timeout) override;
+
+  int64_t Seek(int64_t iFilePosition) override;
+  bool Reset(int64_t iSourcePosition) override;
+
+  int64_t CachedDataEndPosIfSeekTo(int64_t iFilePosition) override;
+  int64_t CachedDataStartPos() override;
+  int64_t CachedDataEndPos() override;
+  bool IsCachedPosition(int64_t iFilePosition) override;
+
+  CCacheStrategy* CreateNew() override;
+
+  /*!
+   * \brief Number of disjoint ranges currently cached.
+   */
+  size_t GetRangeCount();
+
+private:
+  struct Block
+  {
+    std::unique_ptr<uint8_t[]> data;
+    int64_t begin; //!< first valid byte (file position)
+    int64_t end; //!< end of valid bytes (file position)
+    std::list<int64_t>::iterator lru;
+  };
+
+  int64_t BlockStart(int64_t pos) const { return pos - pos % m_blockSize; }
+  Block* FindBlock(int64_t pos);
+  Block* GetWriteBlock(int64_t pos);
+  void Touch(Block& block);
+  int64_t RangeStart(int64_t pos);
+  int64_t RangeEnd(int64_t pos);
+  bool IsCached(int64_t pos);
+  size_t GetAvailableRead(const uint8_t** data);
+
+  const size_t m_front;
+  const size_t m_back;
+  const size_t m_blockSize;
+  const size_t m_maxBlocks;
+
+  std::map<int64_t, Block> m_blocks; //!< keyed by block start
+  std::list<int64_t> m_lru; //!< block starts, least recently used first
+  int64_t m_cur = 0; //!< read position
+  int64_t m_end = 0; //!< write position, end of the range holding m_cur
+  CCriticalSection m_sync;
+  CEvent m_written;
+};
+
+} // namespace XFILE
@@ -0,0 +1,202 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/CircularCache.h"
+#include "filesystem/MappedFileCache.h"
+#include "filesystem/SparseRangeCache.h"
+
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+namespace
+{
+using CacheFactory = std::function<CCacheStrategy*(size_t front, size_t back)>;
+
+std::vector<char> MakeData(size_t size, char first)
+{
+  std::vector<char> data(size);
+  std::iota(data.begin(), data.end(), first);
+  return data;
+}
+
+void FillRange(CCacheStrategy& cache, int64_t pos, size_t size)
+{
+  const std::vector<char> data = MakeData(size, static_cast<char>(pos / 1000));
+  std::vector<char> out(size);
+  cache.Reset(pos);
+  ASSERT_EQ(cache.WriteToCache(data.data(), size), static_cast<int>(size));
+  ASSERT_EQ(cache.ReadFromCache(out.data(), size), static_cast<int>(size));
+}
+} // namespace
+
+class TestCacheStrategy : public ::testing::TestWithParam<CacheFactory>
+{
+protected:
+  void SetUp() override
+  {
+    m_cache.reset(GetParam()(FRONT, BACK));
+    ASSERT_EQ(m_cache->Open(), CACHE_RC_OK);
+  }
+
+  void TearDown() override { m_cache->Close(); }
+
+  static constexpr size_t FRONT = 3000;
+  static constexpr size_t BACK = 1000;
+
+  std::unique_ptr<CCacheStrategy> m_cache;
+};
+
+TEST_P(TestCacheStrategy, WriteAndRead)
+{
+  const std::vector<char> data = MakeData(2000, 0);
+  ASSERT_EQ(m_cache->WriteToCache(data.data(), data.size()), 2000);
+  EXPECT_EQ(m_cache->WaitForData(0, std::chrono::milliseconds(0)), 2000);
+
+  std::vector<char> out(2000);
+  ASSERT_EQ(m_cache->ReadFromCache(out.data(), out.size()), 2000);
+  EXPECT_EQ(out, data);
+  EXPECT_EQ(m_cache->ReadFromCache(out.data(), out.size()), CACHE_RC_WOULD_BLOCK);
+
+  m_cache->EndOfInput();
+  EXPECT_EQ(m_cache->ReadFromCache(out.data(), out.size()), 0);
+}
+
+TEST_P(TestCacheStrategy, KeepsBackBufferWhenFull)
+{
+  const std::vector<char> data = MakeData(FRONT + BACK, 0);
+  ASSERT_EQ(m_cache->WriteToCache(data.data(), data.size()), static_cast<int>(FRONT + BACK));
+  EXPECT_EQ(m_cache->GetMaxWriteSize(100), 0u);
+
+  std::vector<char> out(2000);
+  ASSERT_EQ(m_cache->ReadFromCache(out.data(), out.size()), 2000);
+
+  // only what exceeds the back buffer may be overwritten
+  EXPECT_EQ(m_cache->GetMaxWriteSize(2000), 1000u);
+  EXPECT_TRUE(m_cache->IsCachedPosition(0));
+  EXPECT_EQ(m_cache->Seek(500), 500);
+}
+
+TEST_P(TestCacheStrategy, ReadAcrossWrap)
+{
+  std::vector<char> data = MakeData(FRONT + BACK, 0);
+  ASSERT_EQ(m_cache->WriteToCache(data.data(), data.size()), static_cast<int>(FRONT + BACK));
+
+  std::vector<char> out(3500);
+  ASSERT_EQ(m_cache->ReadFromCache(out.data(), out.size()), 3500);
+
+  // write 500 bytes over the start of the buffer, the data now wraps around
+  data = MakeData(500, 42);
+  ASSERT_EQ(m_cache->WriteToCache(data.data(), data.size()), 500);
+
+  out.resize(1000);
+  ASSERT_EQ(m_cache->ReadFromCache(out.data(), out.size()), 500);
+  EXPECT_EQ(out[0], static_cast<char>(3500 % 256));
+
+  ASSERT_EQ(m_cache->ReadFromCache(out.data(), out.size()), 500);
+  EXPECT_EQ(std::vector<char>(out.begin(), out.begin() + 500), data);
+  EXPECT_EQ(m_cache->ReadFromCache(out.data(), out.size()), CACHE_RC_WOULD_BLOCK);
+}
+
+TEST_P(TestCacheStrategy, ResetOutsideCachedRange)
+{
+  const std::vector<char> data = MakeData(1000, 0);
+  ASSERT_EQ(m_cache->WriteToCache(data.data(), data.size()), 1000);
+
+  EXPECT_FALSE(m_cache->Reset(500));
+  EXPECT_EQ(m_cache->CachedDataEndPos(), 1000);
+
+  EXPECT_TRUE(m_cache->Reset(100000));
+  EXPECT_EQ(m_cache->CachedDataStartPos(), 100000);
+  EXPECT_EQ(m_cache->CachedDataEndPos(), 100000);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    CacheStrategies,
+    TestCacheStrategy,
+    ::testing::Values(
+        [](size_t front, size_t back) -> CCacheStrategy* {
+          return new CCircularCache(front, back);
+        },
+        [](size_t front, size_t back) -> CCacheStrategy* {
+          return new CMappedFileCache(front, back);
+        }));
+
+TEST(TestSparseRangeCache, KeepsEarlierRangeAfterReset)
+{
+  CSparseRangeCache cache(3000, 1000, 1000);
+  ASSERT_EQ(cache.Open(), CACHE_RC_OK);
+
+  std::vector<char> data = MakeData(2500, 0);
+  ASSERT_EQ(cache.WriteToCache(data.data(), 1000), 1000);
+  ASSERT_EQ(cache.WriteToCache(data.data() + 1000, 1500), 1000);
+  ASSERT_EQ(cache.WriteToCache(data.data() + 2000, 500), 500);
+
+  std::vector<char> out(2500);
+  ASSERT_EQ(cache.ReadFromCache(out.data(), 2500), 1000);
+
+  EXPECT_TRUE(cache.Reset(10000));
+  EXPECT_EQ(cache.Seek(500), CACHE_RC_ERROR);
+  FillRange(cache, 10000, 1000);
+  EXPECT_EQ(cache.GetRangeCount(), 2u);
+
+  // going back continues where the first range ended
+  EXPECT_TRUE(cache.IsCachedPosition(1500));
+  EXPECT_EQ(cache.CachedDataEndPosIfSeekTo(1500), 2500);
+  EXPECT_FALSE(cache.Reset(1500));
+  EXPECT_EQ(cache.CachedDataStartPos(), 0);
+  EXPECT_EQ(cache.CachedDataEndPos(), 2500);
+
+  ASSERT_EQ(cache.ReadFromCache(out.data(), 2500), 500);
+  EXPECT_EQ(std::vector<char>(out.begin(), out.begin() + 500),
+            std::vector<char>(data.begin() + 1500, data.begin() + 2000));
+  EXPECT_EQ(cache.Seek(200), 200);
+}
+
+TEST(TestSparseRangeCache, EvictsLeastRecentlyUsedRange)
+{
+  // room for 4 blocks plus slack for 3 more
+  CSparseRangeCache cache(3000, 1000, 1000);
+  ASSERT_EQ(cache.Open(), CACHE_RC_OK);
+
+  for (int64_t pos = 0; pos < 70000; pos += 10000)
+    FillRange(cache, pos, 1000);
+  EXPECT_EQ(cache.GetRangeCount(), 7u);
+
+  // use the oldest range again so the second one becomes least recently used
+  std::vector<char> out(1000);
+  EXPECT_FALSE(cache.Reset(0));
+  ASSERT_EQ(cache.ReadFromCache(out.data(), out.size()), 1000);
+
+  FillRange(cache, 70000, 1000);
+  EXPECT_EQ(cache.GetRangeCount(), 7u);
+  EXPECT_TRUE(cache.IsCachedPosition(500));
+  EXPECT_FALSE(cache.IsCachedPosition(10500));
+  EXPECT_TRUE(cache.IsCachedPosition(20500));
+}
+
+TEST(TestSparseRangeCache, MergesAdjacentRanges)
+{
+  CSparseRangeCache cache(3000, 1000, 1000);
+  ASSERT_EQ(cache.Open(), CACHE_RC_OK);
+
+  FillRange(cache, 0, 1000);
+  FillRange(cache, 2000, 1000);
+  EXPECT_EQ(cache.GetRangeCount(), 2u);
+
+  EXPECT_EQ(cache.CachedDataEndPosIfSeekTo(1000), 1000);
+  FillRange(cache, 1000, 1000);
+  EXPECT_EQ(cache.GetRangeCount(), 1u);
+  EXPECT_EQ(cache.CachedDataEndPosIfSeekTo(0), 3000);
+  EXPECT_EQ(cache.CachedDataStartPos(), 0);
+}
@@ -0,0 +1,166 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/DirectoryCache.h"
+
+#include <errno.h>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+using namespace std::chrono_literals;
+
+TEST(TestDirectoryCache, DisabledByDefault)
+{
+  CDirectoryCache cache;
+  bool exists = false;
+
+  cache.SetCachedExists("smb://server/share/movie.mkv", true);
+  EXPECT_FALSE(cache.GetCachedExists("smb://server/share/movie.mkv", exists));
+  EXPECT_EQ(cache.GetStatCacheStats().entries, 0u);
+}
+
+TEST(TestDirectoryCache, CachesExistsAndMissingFiles)
+{
+  CDirectoryCache cache;
+  bool exists = false;
+  cache.SetStatCacheTTL("smb", 30s, 5s);
+
+  EXPECT_FALSE(cache.GetCachedExists("smb://server/share/movie.mkv", exists));
+  cache.SetCachedExists("smb://server/share/movie.mkv", true);
+  cache.SetCachedExists("smb://server/share/movie.nfo", false);
+
+  ASSERT_TRUE(cache.GetCachedExists("smb://server/share/movie.mkv", exists));
+  EXPECT_TRUE(exists);
+  ASSERT_TRUE(cache.GetCachedExists("smb://server/share/movie.nfo", exists));
+  EXPECT_FALSE(exists);
+
+  // directory lookups are kept apart from file lookups
+  EXPECT_FALSE(cache.GetCachedExists("smb://server/share/movie.mkv/", exists));
+
+  const CDirectoryCache::StatCacheStats stats = cache.GetStatCacheStats();
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.negativeHits, 1u);
+  EXPECT_EQ(stats.misses, 2u);
+  EXPECT_EQ(stats.entries, 2u);
+}
+
+TEST(TestDirectoryCache, CachesStat)
+{
+  CDirectoryCache cache;
+  struct __stat64 buffer = {};
+  int result = 0;
+  cache.SetStatCacheTTL("nfs", 30s, 5s);
+
+  buffer.st_size = 1234;
+  cache.SetCachedStat("nfs://server/export/movie.mkv", 0, &buffer, 0);
+  cache.SetCachedStat("nfs://server/export/missing.mkv", -1, &buffer, ENOENT);
+
+  buffer = {};
+  ASSERT_TRUE(cache.GetCachedStat("nfs://server/export/movie.mkv", &buffer, result));
+  EXPECT_EQ(result, 0);
+  EXPECT_EQ(buffer.st_size, 1234);
+
+  ASSERT_TRUE(cache.GetCachedStat("nfs://server/export/missing.mkv", &buffer, result));
+  EXPECT_EQ(result, -1);
+
+  // a stat result answers Exists() as well, but not the other way round
+  bool exists = false;
+  ASSERT_TRUE(cache.GetCachedExists("nfs://server/export/movie.mkv", exists));
+  EXPECT_TRUE(exists);
+  cache.SetCachedExists("nfs://server/export/other.mkv", true);
+  EXPECT_FALSE(cache.GetCachedStat("nfs://server/export/other.mkv", &buffer, result));
+}
+
+TEST(TestDirectoryCache, SkipsTransientStatErrors)
+{
+  CDirectoryCache cache;
+  struct __stat64 buffer = {};
+  int result = 0;
+  cache.SetStatCacheTTL("smb", 30s, 5s);
+
+  cache.SetCachedStat("smb://server/share/movie.mkv", -1, &buffer, ETIMEDOUT);
+  cache.SetCachedStat("smb://server/share/movie.nfo", -1, &buffer, EACCES);
+  cache.SetCachedStat("smb://server/share/movie.jpg", -1, &buffer, 0);
+  EXPECT_FALSE(cache.GetCachedStat("smb://server/share/movie.mkv", &buffer, result));
+  EXPECT_FALSE(cache.GetCachedStat("smb://server/share/movie.nfo", &buffer, result));
+  EXPECT_FALSE(cache.GetCachedStat("smb://server/share/movie.jpg", &buffer, result));
+  EXPECT_EQ(cache.GetStatCacheStats().entries, 0u);
+
+  // a failed retry doesn't replace what an earlier call found
+  buffer.st_size = 1234;
+  cache.SetCachedStat("smb://server/share/movie.mkv", 0, &buffer, 0);
+  cache.SetCachedStat("smb://server/share/movie.mkv", -1, &buffer, EHOSTDOWN);
+  buffer = {};
+  ASSERT_TRUE(cache.GetCachedStat("smb://server/share/movie.mkv", &buffer, result));
+  EXPECT_EQ(result, 0);
+  EXPECT_EQ(buffer.st_size, 1234);
+}
+
+TEST(TestDirectoryCache, SkipsUncachedProtocols)
+{
+  CDirectoryCache cache;
+  bool exists = false;
+
+  cache.SetCachedExists("/home/user/movie.mkv", true);
+  cache.SetCachedExists("special://home/movie.mkv", true);
+  EXPECT_FALSE(cache.GetCachedExists("/home/user/movie.mkv", exists));
+  EXPECT_FALSE(cache.GetCachedExists("special://home/movie.mkv", exists));
+
+  // a ttl of 0 disables caching for that kind of result
+  cache.SetStatCacheTTL("smb", 30s, 0s);
+  cache.SetCachedExists("smb://server/share/missing.mkv", false);
+  EXPECT_FALSE(cache.GetCachedExists("smb://server/share/missing.mkv", exists));
+}
+
+TEST(TestDirectoryCache, PathRulesOverrideProtocolRules)
+{
+  CDirectoryCache cache;
+  bool exists = false;
+
+  cache.SetStatCacheTTL("smb", 30s, 5s);
+  cache.SetStatCacheTTL("smb://server/volatile/", 0s, 0s);
+  cache.SetStatCacheTTL("sftp", 0s, 0s);
+  cache.SetStatCacheTTL("sftp://server/static/", 60s, 60s);
+
+  cache.SetCachedExists("smb://server/volatile/movie.mkv", true);
+  cache.SetCachedExists("smb://server/share/movie.mkv", true);
+  cache.SetCachedExists("sftp://server/movie.mkv", true);
+  cache.SetCachedExists("sftp://server/static/movie.mkv", true);
+
+  EXPECT_FALSE(cache.GetCachedExists("smb://server/volatile/movie.mkv", exists));
+  EXPECT_TRUE(cache.GetCachedExists("smb://server/share/movie.mkv", exists));
+  EXPECT_FALSE(cache.GetCachedExists("sftp://server/movie.mkv", exists));
+  EXPECT_TRUE(cache.GetCachedExists("sftp://server/static/movie.mkv", exists));
+}
+
+TEST(TestDirectoryCache, InvalidatesOnChanges)
+{
+  CDirectoryCache cache;
+  bool exists = false;
+  cache.SetStatCacheTTL("smb", 30s, 5s);
+
+  cache.SetCachedExists("smb://server/share/dir/a.mkv", false);
+  cache.SetCachedExists("smb://server/share/dir/b.mkv", true);
+  cache.SetCachedExists("smb://server/share/other/c.mkv", true);
+
+  cache.AddFile("smb://server/share/dir/a.mkv");
+  EXPECT_FALSE(cache.GetCachedExists("smb://server/share/dir/a.mkv", exists));
+  EXPECT_TRUE(cache.GetCachedExists("smb://server/share/dir/b.mkv", exists));
+
+  cache.ClearFile("smb://server/share/dir/b.mkv");
+  EXPECT_FALSE(cache.GetCachedExists("smb://server/share/dir/b.mkv", exists));
+  EXPECT_TRUE(cache.GetCachedExists("smb://server/share/other/c.mkv", exists));
+
+  cache.ClearSubPaths("smb://server/share/");
+  EXPECT_FALSE(cache.GetCachedExists("smb://server/share/other/c.mkv", exists));
+
+  cache.SetCachedExists("smb://server/share/other/c.mkv", true);
+  cache.Clear();
+  EXPECT_EQ(cache.GetStatCacheStats().entries, 0u);
+}
@@ -35,6 +35,7 @@ public:
   bool AutosaveEnabled();
   bool RewindEnabled();
   unsigned int MaxRewindTimeSec();
+  unsigned int MaxRewindMemoryMB();
   std::string GetRAUsername() const;
   std::string GetRAToken() const;
 
@@ -11,6 +11,7 @@
 #include "GUIAction.h"
 #include "GUIComponent.h"
 #include "GUIControlProfiler.h"
+#include "GUIFrameProfiler.h"
 #include "GUIInfoManager.h"
 #include "GUIMessage.h"
 #include "GUITexture.h"
@@ -140,7 +141,10 @@ void CGUIControl::DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyreg
     if (m_hasCamera)
       CServiceBroker::GetWinSystem()->GetGfxContext().SetCameraPosition(m_camera);
 
-    Process(currentTime, dirtyregions);
+    {
+      CGUIFrameProfilerControlScope profilerScope("Process", *this);
+      Process(currentTime, dirtyregions);
+    }
     m_bInvalidated = false;
 
     if (dirtyRegion != m_renderRegion)
@@ -192,6 +196,7 @@ void CGUIControl::DoRender()
       CServiceBroker::GetWinSystem()->GetGfxContext().SetStereoFactor(m_stereo);
 
     GUIPROFILER_RENDER_BEGIN(this);
+    CGUIFrameProfilerControlScope profilerScope("Render", *this);
 
     if (m_hitColor != 0xffffffff)
     {
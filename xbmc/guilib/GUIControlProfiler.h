@@ -50,6 +50,7 @@ class CGUIControlProfiler
 public:
   static CGUIControlProfiler &Instance(void);
   static bool IsRunning(void);
+  static const char *GetControlTypeName(CGUIControl::GUICONTROLTYPES type);
 
   void Start(void);
   void EndFrame(void);
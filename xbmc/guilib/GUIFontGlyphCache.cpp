@@ -0,0 +1,314 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIFontGlyphCache.h"
+
+#include "ServiceBroker.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/Crc32.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+#include <cstring>
+#include <mutex>
+
+namespace
+{
+constexpr size_t MAX_FACE_BYTES = 8 * 1024 * 1024; // glyph pixels kept per face
+constexpr size_t MAX_TOTAL_BYTES = 32 * 1024 * 1024; // glyph pixels kept of all faces
+constexpr uint32_t CACHE_FILE_MAGIC = 0x4B474C43; // "KGLC"
+constexpr uint32_t CACHE_FILE_VERSION = 1;
+constexpr const char* CACHE_FILE_PATH = "special://temp/fontcache/";
+
+template<typename T>
+void Write(std::vector<uint8_t>& buffer, T value)
+{
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(&value);
+  buffer.insert(buffer.end(), data, data + sizeof(T));
+}
+
+class CReader
+{
+public:
+  explicit CReader(const std::vector<uint8_t>& buffer) : m_buffer(buffer) {}
+
+  template<typename T>
+  bool Read(T& value)
+  {
+    if (m_pos + sizeof(T) > m_buffer.size())
+      return false;
+    std::memcpy(&value, m_buffer.data() + m_pos, sizeof(T));
+    m_pos += sizeof(T);
+    return true;
+  }
+
+  bool Read(std::vector<uint8_t>& data, size_t size)
+  {
+    if (m_pos + size > m_buffer.size())
+      return false;
+    data.assign(m_buffer.begin() + m_pos, m_buffer.begin() + m_pos + size);
+    m_pos += size;
+    return true;
+  }
+
+  bool Read(std::string& str)
+  {
+    uint32_t size;
+    if (!Read(size) || m_pos + size > m_buffer.size())
+      return false;
+    str.assign(reinterpret_cast<const char*>(m_buffer.data()) + m_pos, size);
+    m_pos += size;
+    return true;
+  }
+
+private:
+  const std::vector<uint8_t>& m_buffer;
+  size_t m_pos{0};
+};
+} // namespace
+
+CGUIFontGlyphCache::CFace::~CFace()
+{
+  if (m_totalBytes)
+    *m_totalBytes -= m_bytes;
+}
+
+const CGUIFontGlyphCache::CachedGlyph* CGUIFontGlyphCache::CFace::Get(uint32_t glyphAndStyle) const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  const auto it = m_glyphs.find(glyphAndStyle);
+  return it != m_glyphs.end() ? &it->second : nullptr;
+}
+
+const CGUIFontGlyphCache::CachedGlyph* CGUIFontGlyphCache::CFace::Add(uint32_t glyphAndStyle,
+                                                                      CachedGlyph&& glyph)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  const auto it = m_glyphs.find(glyphAndStyle);
+  if (it != m_glyphs.end())
+    return &it->second;
+
+  const size_t size = glyph.m_pixels.size();
+  if (m_bytes + size > MAX_FACE_BYTES)
+    return nullptr;
+
+  if (m_totalBytes->fetch_add(size) + size > MAX_TOTAL_BYTES)
+  {
+    *m_totalBytes -= size;
+    return nullptr;
+  }
+
+  m_bytes += size;
+  m_dirty = true;
+  return &m_glyphs.emplace(glyphAndStyle, std::move(glyph)).first->second;
+}
+
+bool CGUIFontGlyphCache::CFace::Load(const std::string& cacheFile)
+{
+  std::vector<uint8_t> buffer;
+  XFILE::CFile file;
+  if (!XFILE::CFile::Exists(cacheFile) || file.LoadFile(cacheFile, buffer) <= 0)
+    return false;
+
+  CReader reader(buffer);
+  uint32_t magic, version, count;
+  std::string fontIdent;
+  int64_t fontFileSize, fontFileTime;
+  if (!reader.Read(magic) || magic != CACHE_FILE_MAGIC || !reader.Read(version) ||
+      version != CACHE_FILE_VERSION || !reader.Read(fontIdent) || fontIdent != m_fontIdent ||
+      !reader.Read(fontFileSize) || fontFileSize != m_fontFileSize ||
+      !reader.Read(fontFileTime) || fontFileTime != m_fontFileTime || !reader.Read(count))
+  {
+    CLog::Log(LOGDEBUG, "CGUIFontGlyphCache::{}: ignoring outdated glyph cache {}", __func__,
+              cacheFile);
+    return false;
+  }
+
+  std::unordered_map<uint32_t, CachedGlyph> glyphs;
+  size_t bytes = 0;
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    uint32_t glyphAndStyle;
+    CachedGlyph glyph;
+    if (!reader.Read(glyphAndStyle) || !reader.Read(glyph.m_left) || !reader.Read(glyph.m_top) ||
+        !reader.Read(glyph.m_advance) || !reader.Read(glyph.m_width) ||
+        !reader.Read(glyph.m_rows) ||
+        !reader.Read(glyph.m_pixels, static_cast<size_t>(glyph.m_width) * glyph.m_rows))
+    {
+      CLog::Log(LOGWARNING, "CGUIFontGlyphCache::{}: glyph cache {} is truncated", __func__,
+                cacheFile);
+      return false;
+    }
+    if (bytes + glyph.m_pixels.size() > MAX_FACE_BYTES ||
+        *m_totalBytes + bytes + glyph.m_pixels.size() > MAX_TOTAL_BYTES)
+      break;
+    bytes += glyph.m_pixels.size();
+    glyphs.emplace(glyphAndStyle, std::move(glyph));
+  }
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_glyphs = std::move(glyphs);
+  *m_totalBytes += bytes;
+  *m_totalBytes -= m_bytes;
+  m_bytes = bytes;
+  m_dirty = false;
+
+  CLog::Log(LOGDEBUG, "CGUIFontGlyphCache::{}: loaded {} glyphs of {}", __func__,
+            m_glyphs.size(), m_fontIdent);
+  return true;
+}
+
+bool CGUIFontGlyphCache::CFace::Save(const std::string& cacheFile)
+{
+  std::vector<uint8_t> buffer;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    if (!m_dirty)
+      return true;
+
+    buffer.reserve(m_bytes + m_glyphs.size() * 16 + m_fontIdent.size() + 32);
+    Write(buffer, CACHE_FILE_MAGIC);
+    Write(buffer, CACHE_FILE_VERSION);
+    Write(buffer, static_cast<uint32_t>(m_fontIdent.size()));
+    buffer.insert(buffer.end(), m_fontIdent.begin(), m_fontIdent.end());
+    Write(buffer, m_fontFileSize);
+    Write(buffer, m_fontFileTime);
+    Write(buffer, static_cast<uint32_t>(m_glyphs.size()));
+    for (const auto& it : m_glyphs)
+    {
+      const CachedGlyph& glyph = it.second;
+      Write(buffer, it.first);
+      Write(buffer, glyph.m_left);
+      Write(buffer, glyph.m_top);
+      Write(buffer, glyph.m_advance);
+      Write(buffer, glyph.m_width);
+      Write(buffer, glyph.m_rows);
+      buffer.insert(buffer.end(), glyph.m_pixels.begin(), glyph.m_pixels.end());
+    }
+    m_dirty = false;
+  }
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(cacheFile, true) ||
+      file.Write(buffer.data(), buffer.size()) != static_cast<ssize_t>(buffer.size()))
+  {
+    CLog::Log(LOGERROR, "CGUIFontGlyphCache::{}: unable to write glyph cache {}", __func__,
+              cacheFile);
+    return false;
+  }
+
+  return true;
+}
+
+std::shared_ptr<CGUIFontGlyphCache::CFace> CGUIFontGlyphCache::GetFace(
+    const std::string& fontIdent, const std::string& fontFile)
+{
+  struct __stat64 stat = {};
+  XFILE::CFile::Stat(fontFile, &stat);
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  const auto it = m_faces.find(fontIdent);
+  if (it != m_faces.end())
+  {
+    const std::shared_ptr<CFace>& face = it->second;
+    if (face->m_fontFileSize == static_cast<int64_t>(stat.st_size) &&
+        face->m_fontFileTime == static_cast<int64_t>(stat.st_mtime))
+    {
+      face->m_lastUse = ++m_useCounter;
+      return face;
+    }
+
+    // the font file changed underneath us, fonts still using the old face keep it
+    m_faces.erase(it);
+  }
+
+  const bool persistent = IsPersistent();
+  Trim(persistent);
+
+  auto face = std::make_shared<CFace>();
+  face->m_fontIdent = fontIdent;
+  face->m_fontFileSize = static_cast<int64_t>(stat.st_size);
+  face->m_fontFileTime = static_cast<int64_t>(stat.st_mtime);
+  face->m_totalBytes = m_totalBytes;
+  face->m_lastUse = ++m_useCounter;
+
+  if (persistent)
+    face->Load(GetCacheFile(fontIdent));
+
+  m_faces.emplace(fontIdent, face);
+  return face;
+}
+
+void CGUIFontGlyphCache::Trim(bool persistent)
+{
+  // make room for a new face to grow to its own budget
+  while (*m_totalBytes + MAX_FACE_BYTES > MAX_TOTAL_BYTES)
+  {
+    // dropping a face that a font still uses wouldn't free anything
+    auto oldest = m_faces.end();
+    for (auto it = m_faces.begin(); it != m_faces.end(); ++it)
+    {
+      if (it->second.use_count() == 1 &&
+          (oldest == m_faces.end() || it->second->m_lastUse < oldest->second->m_lastUse))
+        oldest = it;
+    }
+    if (oldest == m_faces.end())
+      break;
+
+    CLog::Log(LOGDEBUG, "CGUIFontGlyphCache::{}: dropping {} glyphs of {}", __func__,
+              oldest->second->m_glyphs.size(), oldest->first);
+
+    if (persistent && CreateCachePath())
+      oldest->second->Save(GetCacheFile(oldest->first));
+    m_faces.erase(oldest);
+  }
+}
+
+void CGUIFontGlyphCache::Save()
+{
+  if (!IsPersistent())
+    return;
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (m_faces.empty())
+    return;
+
+  if (!CreateCachePath())
+    return;
+
+  for (const auto& it : m_faces)
+    it.second->Save(GetCacheFile(it.first));
+}
+
+bool CGUIFontGlyphCache::CreateCachePath()
+{
+  if (XFILE::CDirectory::Exists(CACHE_FILE_PATH) || XFILE::CDirectory::Create(CACHE_FILE_PATH))
+    return true;
+
+  CLog::Log(LOGERROR, "CGUIFontGlyphCache::{}: unable to create {}", __func__, CACHE_FILE_PATH);
+  return false;
+}
+
+std::string CGUIFontGlyphCache::GetCacheFile(const std::string& fontIdent)
+{
+  return StringUtils::Format("{}{:08x}.glyphs", CACHE_FILE_PATH, Crc32::Compute(fontIdent));
+}
+
+bool CGUIFontGlyphCache::IsPersistent()
+{
+  const auto settingsComponent = CServiceBroker::GetSettingsComponent();
+  if (!settingsComponent)
+    return false;
+
+  const auto advancedSettings = settingsComponent->GetAdvancedSettings();
+  return advancedSettings && advancedSettings->m_guiPersistFontGlyphs;
+}
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+/*!
+\file GUIFontGlyphCache.h
+\brief
+*/
+
+#include "threads/CriticalSection.h"
+
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*!
+ \ingroup textures
+ \brief Rendered glyph bitmaps shared by all CGUIFontTTF instances of the same face
+
+ Rendering a glyph with FreeType is the expensive part of caching a character, which shows most
+ with CJK and Arabic fonts that use thousands of glyphs. A face is identified by the font ident
+ of CGUIFontTTF (file, size, aspect and border), glyphs within a face by glyph index and style.
+ The bitmaps outlive the font instances that rendered them, so a skin reload doesn't render them
+ again, and can be written to special://temp/ to be reused by the next start. All faces share one
+ memory budget, faces no font uses any more are dropped least recently used first to stay in it.
+ */
+class CGUIFontGlyphCache
+{
+public:
+  struct CachedGlyph
+  {
+    int16_t m_left{0}; ///< horizontal bearing of the bitmap, FT_BitmapGlyph::left
+    int16_t m_top{0}; ///< vertical bearing of the bitmap, FT_BitmapGlyph::top
+    float m_advance{0.0f}; ///< rounded advance in pixels
+    uint16_t m_width{0};
+    uint16_t m_rows{0};
+    std::vector<uint8_t> m_pixels; ///< 8 bit alpha, m_width bytes per row
+  };
+
+  class CFace
+  {
+  public:
+    ~CFace();
+
+    /*!
+     \brief Look up a glyph
+     \param glyphAndStyle the glyph index in the lower 16 bits, the font style above
+     \return the glyph, which stays valid as long as the face exists, or nullptr
+     */
+    const CachedGlyph* Get(uint32_t glyphAndStyle) const;
+
+    /*!
+     \brief Store a rendered glyph
+     \return the stored glyph, or nullptr if the face or the cache is over its memory budget.
+     The passed glyph is only moved from if it was stored. If the face already has the glyph, the
+     stored one is returned.
+     */
+    const CachedGlyph* Add(uint32_t glyphAndStyle, CachedGlyph&& glyph);
+
+  private:
+    friend class CGUIFontGlyphCache;
+
+    bool Load(const std::string& cacheFile);
+    bool Save(const std::string& cacheFile);
+
+    mutable CCriticalSection m_critSection;
+    std::string m_fontIdent;
+    int64_t m_fontFileSize{0};
+    int64_t m_fontFileTime{0};
+    std::unordered_map<uint32_t, CachedGlyph> m_glyphs;
+    size_t m_bytes{0};
+    bool m_dirty{false};
+    uint64_t m_lastUse{0}; ///< protected by the lock of the cache
+    std::shared_ptr<std::atomic<size_t>> m_totalBytes; ///< glyph pixels of all faces
+  };
+
+  CGUIFontGlyphCache() = default;
+
+  /*!
+   \brief Get the glyphs of a face, creating the face if needed
+   \param fontIdent the ident of the CGUIFontTTF asking
+   \param fontFile the font file the face was loaded from, used to notice when it changes
+   */
+  std::shared_ptr<CFace> GetFace(const std::string& fontIdent, const std::string& fontFile);
+
+  /*!
+   \brief Write the faces that got new glyphs to disk, if persisting is enabled
+   */
+  void Save();
+
+private:
+  void Trim(bool persistent);
+  static bool CreateCachePath();
+  static std::string GetCacheFile(const std::string& fontIdent);
+  static bool IsPersistent();
+
+  CCriticalSection m_critSection;
+  std::unordered_map<std::string, std::shared_ptr<CFace>> m_faces;
+  std::shared_ptr<std::atomic<size_t>> m_totalBytes{std::make_shared<std::atomic<size_t>>(0)};
+  uint64_t m_useCounter{0};
+};
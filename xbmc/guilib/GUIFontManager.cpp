@@ -411,6 +411,9 @@ void GUIFontManager::Clear()
   m_vecFontFiles.clear();
   m_vecFontInfo.clear();
 
+  // the skin is going away, keep what its fonts rendered for the next start
+  m_glyphCache.Save();
+
 #if defined(HAS_GL)
   CGUIFontTTFGL::DestroyStaticVertexBuffers();
 #endif
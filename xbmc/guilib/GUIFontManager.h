@@ -13,6 +13,7 @@
 \brief
 */
 
+#include "GUIFontGlyphCache.h"
 #include "IMsgTargetCallback.h"
 #include "threads/CriticalSection.h"
 #include "threads/SingleLock.h"
@@ -97,6 +98,11 @@ public:
   void Clear();
   void FreeFontFile(CGUIFontTTF* pFont);
 
+  /*!
+   * \brief Get the rendered glyphs shared between font files of the same face
+   */
+  CGUIFontGlyphCache& GetGlyphCache() { return m_glyphCache; }
+
   static void SettingOptionsFontsFiller(const std::shared_ptr<const CSetting>& setting,
                                         std::vector<StringSettingOption>& list,
                                         std::string& current,
@@ -130,6 +136,7 @@ private:
 
   mutable CCriticalSection m_critSection;
   std::vector<FontMetadata> m_userFontsCache;
+  CGUIFontGlyphCache m_glyphCache;
 };
 
 /*!
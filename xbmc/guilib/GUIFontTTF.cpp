@@ -21,6 +21,7 @@
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
 
+#include <cstring>
 #include <math.h>
 #include <memory>
 #include <queue>
@@ -59,6 +60,7 @@ constexpr int CHAR_CHUNK = 64; // 64 chars allocated at a time (2048 bytes)
 constexpr int GLYPH_STRENGTH_BOLD = 24;
 constexpr int GLYPH_STRENGTH_LIGHT = -48;
 constexpr int TAB_SPACE_LENGTH = 4;
+constexpr size_t MAX_SHAPED_TEXTS = 512; // number of shaped strings cached per font
 } /* namespace */
 
 class CFreeTypeLibrary
@@ -226,6 +228,10 @@ void CGUIFontTTF::Clear()
   m_vertexTrans.clear();
   m_vertex.clear();
 
+  m_shapingCacheIndex.clear();
+  m_shapingCache.clear();
+  m_glyphCache.reset();
+
   m_fontFileInMemory.clear();
 }
 
@@ -241,6 +247,8 @@ bool CGUIFontTTF::Load(
   m_hbFont = hb_ft_font_create(m_face, 0);
   if (!m_hbFont)
     return false;
+
+  m_glyphCache = g_fontManager.GetGlyphCache().GetFace(m_fontIdent, strFilename);
   /*
    the values used are described below
 
@@ -718,12 +726,39 @@ unsigned int CGUIFontTTF::GetMaxFontHeight() const
 
 std::vector<CGUIFontTTF::Glyph> CGUIFontTTF::GetHarfBuzzShapedGlyphs(const vecText& text)
 {
-  std::vector<Glyph> glyphs;
   if (text.empty())
+    return {};
+
+  // shaping only looks at the characters, so strings differing in style or color share an entry
+  std::u16string key;
+  key.reserve(text.size());
+  for (const auto& character : text)
+    key.push_back(static_cast<char16_t>(0xffff & character));
+
+  const auto it = m_shapingCacheIndex.find(key);
+  if (it != m_shapingCacheIndex.end())
   {
-    return glyphs;
+    m_shapingCache.splice(m_shapingCache.begin(), m_shapingCache, it->second);
+    return it->second->second;
   }
 
+  std::vector<Glyph> glyphs = ShapeText(text);
+
+  m_shapingCache.emplace_front(std::move(key), glyphs);
+  m_shapingCacheIndex.emplace(m_shapingCache.front().first, m_shapingCache.begin());
+  if (m_shapingCache.size() > MAX_SHAPED_TEXTS)
+  {
+    m_shapingCacheIndex.erase(m_shapingCache.back().first);
+    m_shapingCache.pop_back();
+  }
+
+  return glyphs;
+}
+
+std::vector<CGUIFontTTF::Glyph> CGUIFontTTF::ShapeText(const vecText& text)
+{
+  std::vector<Glyph> glyphs;
+
   std::vector<hb_script_t> scripts;
   std::vector<RunInfo> runs;
   hb_unicode_funcs_t* ufuncs = hb_unicode_funcs_get_default();
@@ -909,55 +944,37 @@ CGUIFontTTF::Character* CGUIFontTTF::GetCharacter(character_t chr, FT_UInt glyph
 
 bool CGUIFontTTF::CacheCharacter(FT_UInt glyphIndex, uint32_t style, Character* ch)
 {
-  FT_Glyph glyph = nullptr;
-  if (FT_Load_Glyph(m_face, glyphIndex, FT_LOAD_TARGET_LIGHT))
-  {
-    CLog::LogF(LOGDEBUG, "Failed to load glyph {:x}", glyphIndex);
-    return false;
-  }
+  const character_t glyphAndStyle = (style << 16) | glyphIndex;
 
-  // make bold if applicable
-  if (style & FONT_STYLE_BOLD)
-    SetGlyphStrength(m_face->glyph, GLYPH_STRENGTH_BOLD);
-  // and italics if applicable
-  if (style & FONT_STYLE_ITALICS)
-    ObliqueGlyph(m_face->glyph);
-  // and light if applicable
-  if (style & FONT_STYLE_LIGHT)
-    SetGlyphStrength(m_face->glyph, GLYPH_STRENGTH_LIGHT);
-  // grab the glyph
-  if (FT_Get_Glyph(m_face->glyph, &glyph))
-  {
-    CLog::LogF(LOGDEBUG, "Failed to get glyph {:x}", glyphIndex);
-    return false;
-  }
-  if (m_stroker)
-    FT_Glyph_StrokeBorder(&glyph, m_stroker, 0, 1);
-  // render the glyph
-  if (FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, nullptr, 1))
+  // reuse the bitmap if this face rendered the glyph before, in this or an earlier run
+  const CGUIFontGlyphCache::CachedGlyph* glyph =
+      m_glyphCache ? m_glyphCache->Get(glyphAndStyle) : nullptr;
+  CGUIFontGlyphCache::CachedGlyph rendered;
+  if (!glyph)
   {
-    CLog::LogF(LOGDEBUG, "Failed to render glyph {:x} to a bitmap", glyphIndex);
-    return false;
+    if (!RenderGlyph(glyphIndex, style, rendered))
+      return false;
+
+    glyph = m_glyphCache ? m_glyphCache->Add(glyphAndStyle, std::move(rendered)) : nullptr;
+    if (!glyph)
+      glyph = &rendered;
   }
 
-  FT_BitmapGlyph bitGlyph = (FT_BitmapGlyph)glyph;
-  FT_Bitmap bitmap = bitGlyph->bitmap;
-  bool isEmptyGlyph = (bitmap.width == 0 || bitmap.rows == 0);
+  bool isEmptyGlyph = (glyph->m_width == 0 || glyph->m_rows == 0);
 
   if (!isEmptyGlyph)
   {
-    if (bitGlyph->left < 0)
-      m_posX += -bitGlyph->left;
+    if (glyph->m_left < 0)
+      m_posX += -glyph->m_left;
 
     // check we have enough room for the character.
-    // cast-fest is here to avoid warnings due to freeetype version differences (signedness of width).
-    if (static_cast<int>(m_posX + bitGlyph->left + bitmap.width +
+    if (static_cast<int>(m_posX + glyph->m_left + glyph->m_width +
                          SPACING_BETWEEN_CHARACTERS_IN_TEXTURE) > static_cast<int>(m_textureWidth))
     { // no space - gotta drop to the next line (which means creating a new texture and copying it across)
       m_posX = 1;
       m_posY += GetTextureLineHeight();
-      if (bitGlyph->left < 0)
-        m_posX += -bitGlyph->left;
+      if (glyph->m_left < 0)
+        m_posX += -glyph->m_left;
 
       if (m_posY + GetTextureLineHeight() >= m_textureHeight)
       {
@@ -968,14 +985,12 @@ bool CGUIFontTTF::CacheCharacter(FT_UInt glyphIndex, uint32_t style, Character*
         {
           CLog::LogF(LOGDEBUG, "New cache texture is too large ({} > {} pixels long)", newHeight,
                      m_renderSystem->GetMaxTextureSize());
-          FT_Done_Glyph(glyph);
           return false;
         }
 
         std::unique_ptr<CTexture> newTexture = ReallocTexture(newHeight);
         if (!newTexture)
         {
-          FT_Done_Glyph(glyph);
           CLog::LogF(LOGDEBUG, "Failed to allocate new texture of height {}", newHeight);
           return false;
         }
@@ -986,23 +1001,21 @@ bool CGUIFontTTF::CacheCharacter(FT_UInt glyphIndex, uint32_t style, Character*
 
     if (!m_texture)
     {
-      FT_Done_Glyph(glyph);
       CLog::LogF(LOGDEBUG, "no texture to cache character to");
       return false;
     }
   }
 
   // set the character in our table
-  ch->m_glyphAndStyle = (style << 16) | glyphIndex;
+  ch->m_glyphAndStyle = glyphAndStyle;
   ch->m_glyphIndex = glyphIndex;
-  ch->m_offsetX = static_cast<short>(bitGlyph->left);
-  ch->m_offsetY = static_cast<short>(m_cellBaseLine - bitGlyph->top);
+  ch->m_offsetX = glyph->m_left;
+  ch->m_offsetY = static_cast<short>(m_cellBaseLine - glyph->m_top);
   ch->m_left = isEmptyGlyph ? 0.0f : (static_cast<float>(m_posX));
   ch->m_top = isEmptyGlyph ? 0.0f : (static_cast<float>(m_posY));
-  ch->m_right = ch->m_left + bitmap.width;
-  ch->m_bottom = ch->m_top + bitmap.rows;
-  ch->m_advance =
-      static_cast<float>(MathUtils::round_int(static_cast<double>(m_face->glyph->advance.x) / 64));
+  ch->m_right = ch->m_left + glyph->m_width;
+  ch->m_bottom = ch->m_top + glyph->m_rows;
+  ch->m_advance = glyph->m_advance;
 
   // we need only render if we actually have some pixels
   if (!isEmptyGlyph)
@@ -1010,15 +1023,84 @@ bool CGUIFontTTF::CacheCharacter(FT_UInt glyphIndex, uint32_t style, Character*
     // ensure our rect will stay inside the texture (it *should* but we need to be certain)
     unsigned int x1 = std::max(m_posX, 0);
     unsigned int y1 = std::max(m_posY, 0);
-    unsigned int x2 = std::min(x1 + bitmap.width, m_textureWidth);
-    unsigned int y2 = std::min(y1 + bitmap.rows, m_textureHeight);
+    unsigned int x2 = std::min(x1 + glyph->m_width, m_textureWidth);
+    unsigned int y2 = std::min(y1 + glyph->m_rows, m_textureHeight);
     m_maxFontHeight = std::max(m_maxFontHeight, y2);
-    CopyCharToTexture(bitGlyph, x1, y1, x2, y2);
+
+    // the texture implementations copy from a freetype bitmap, so describe the cached one as such
+    FT_BitmapGlyphRec bitGlyph{};
+    bitGlyph.left = glyph->m_left;
+    bitGlyph.top = glyph->m_top;
+    bitGlyph.bitmap.width = glyph->m_width;
+    bitGlyph.bitmap.rows = glyph->m_rows;
+    bitGlyph.bitmap.pitch = glyph->m_width;
+    bitGlyph.bitmap.buffer = const_cast<unsigned char*>(glyph->m_pixels.data());
+    bitGlyph.bitmap.num_grays = 256;
+    bitGlyph.bitmap.pixel_mode = FT_PIXEL_MODE_GRAY;
+    CopyCharToTexture(&bitGlyph, x1, y1, x2, y2);
 
     m_posX += SPACING_BETWEEN_CHARACTERS_IN_TEXTURE +
               static_cast<unsigned short>(ch->m_right - ch->m_left);
   }
 
+  return true;
+}
+
+bool CGUIFontTTF::RenderGlyph(FT_UInt glyphIndex,
+                              uint32_t style,
+                              CGUIFontGlyphCache::CachedGlyph& cachedGlyph)
+{
+  FT_Glyph glyph = nullptr;
+  if (FT_Load_Glyph(m_face, glyphIndex, FT_LOAD_TARGET_LIGHT))
+  {
+    CLog::LogF(LOGDEBUG, "Failed to load glyph {:x}", glyphIndex);
+    return false;
+  }
+
+  // make bold if applicable
+  if (style & FONT_STYLE_BOLD)
+    SetGlyphStrength(m_face->glyph, GLYPH_STRENGTH_BOLD);
+  // and italics if applicable
+  if (style & FONT_STYLE_ITALICS)
+    ObliqueGlyph(m_face->glyph);
+  // and light if applicable
+  if (style & FONT_STYLE_LIGHT)
+    SetGlyphStrength(m_face->glyph, GLYPH_STRENGTH_LIGHT);
+  // grab the glyph
+  if (FT_Get_Glyph(m_face->glyph, &glyph))
+  {
+    CLog::LogF(LOGDEBUG, "Failed to get glyph {:x}", glyphIndex);
+    return false;
+  }
+  if (m_stroker)
+    FT_Glyph_StrokeBorder(&glyph, m_stroker, 0, 1);
+  // render the glyph
+  if (FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, nullptr, 1))
+  {
+    CLog::LogF(LOGDEBUG, "Failed to render glyph {:x} to a bitmap", glyphIndex);
+    FT_Done_Glyph(glyph);
+    return false;
+  }
+
+  FT_BitmapGlyph bitGlyph = (FT_BitmapGlyph)glyph;
+  const FT_Bitmap& bitmap = bitGlyph->bitmap;
+
+  cachedGlyph.m_left = static_cast<int16_t>(bitGlyph->left);
+  cachedGlyph.m_top = static_cast<int16_t>(bitGlyph->top);
+  cachedGlyph.m_advance =
+      static_cast<float>(MathUtils::round_int(static_cast<double>(m_face->glyph->advance.x) / 64));
+  cachedGlyph.m_width = static_cast<uint16_t>(bitmap.width);
+  cachedGlyph.m_rows = static_cast<uint16_t>(bitmap.rows);
+
+  // keep the rows tightly packed, freetype may pad them
+  cachedGlyph.m_pixels.resize(static_cast<size_t>(bitmap.width) * bitmap.rows);
+  const unsigned char* source = bitmap.buffer;
+  for (unsigned int y = 0; y < bitmap.rows; y++)
+  {
+    std::memcpy(cachedGlyph.m_pixels.data() + y * bitmap.width, source, bitmap.width);
+    source += bitmap.pitch;
+  }
+
   // free the glyph
   FT_Done_Glyph(glyph);
 
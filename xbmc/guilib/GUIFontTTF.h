@@ -9,12 +9,16 @@
 #pragma once
 
 #include "GUIFont.h"
+#include "GUIFontGlyphCache.h"
 #include "utils/ColorUtils.h"
 #include "utils/Geometry.h"
 
+#include <list>
 #include <memory>
 #include <stdint.h>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include <ft2build.h>
@@ -148,6 +152,7 @@ protected:
   void RemoveReference();
 
   std::vector<Glyph> GetHarfBuzzShapedGlyphs(const vecText& text);
+  std::vector<Glyph> ShapeText(const vecText& text);
 
   float GetTextWidthInternal(const vecText& text);
   float GetTextWidthInternal(const vecText& text, const std::vector<Glyph>& glyph);
@@ -171,6 +176,7 @@ protected:
   // Stuff for pre-rendering for speed
   Character* GetCharacter(character_t letter, FT_UInt glyphIndex);
   bool CacheCharacter(FT_UInt glyphIndex, uint32_t style, Character* ch);
+  bool RenderGlyph(FT_UInt glyphIndex, uint32_t style, CGUIFontGlyphCache::CachedGlyph& glyph);
   void RenderCharacter(CGraphicContext& context,
                        float posX,
                        float posY,
@@ -266,6 +272,14 @@ protected:
   CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue> m_staticCache;
   CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue> m_dynamicCache;
 
+  // rendered glyphs, shared with every other instance of this face
+  std::shared_ptr<CGUIFontGlyphCache::CFace> m_glyphCache;
+
+  // most recently shaped strings first, keyed by their characters without style and color
+  using ShapingCacheList = std::list<std::pair<std::u16string, std::vector<Glyph>>>;
+  ShapingCacheList m_shapingCache;
+  std::unordered_map<std::u16string_view, ShapingCacheList::iterator> m_shapingCacheIndex;
+
   CRenderSystemBase* m_renderSystem;
 
 private:
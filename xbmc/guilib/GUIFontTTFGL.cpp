@@ -168,6 +168,7 @@ void CGUIFontTTFGL::LastEnd()
                           reinterpret_cast<const GLvoid*>(offsetof(SVertex, u)));
 
     glDrawArrays(GL_TRIANGLES, 0, vecVertices.size());
+    renderSystem->CountGUIDrawCall(m_vertex.size() / 4);
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glDeleteBuffers(1, &VertexVBO);
@@ -232,6 +233,7 @@ void CGUIFontTTFGL::LastEnd()
             reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, u)));
 
         glDrawElements(GL_TRIANGLES, 6 * count, GL_UNSIGNED_SHORT, 0);
+        renderSystem->CountGUIDrawCall(count);
       }
 
       glMatrixModview.Pop();
@@ -0,0 +1,392 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIFrameProfiler.h"
+
+#include "CompileInfo.h"
+#include "GUIControl.h"
+#include "GUIControlProfiler.h"
+#include "ServiceBroker.h"
+#include "filesystem/File.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+#include "utils/Variant.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+
+namespace
+{
+constexpr size_t MAX_EVENTS = 64 * 1024;
+constexpr size_t MAX_FRAMES = 4 * 1024;
+constexpr const char* DEFAULT_OUTPUT_FILE = "special://home/guiframeprofile.json";
+constexpr int TRACE_PID = 1;
+
+thread_local int threadId = 0;
+thread_local int infoDepth = 0;
+
+std::atomic<int> nextThreadId{0};
+
+const char* GetCategoryName(CGUIFrameProfiler::Category category)
+{
+  switch (category)
+  {
+    case CGUIFrameProfiler::Category::FRAME:
+      return "frame";
+    case CGUIFrameProfiler::Category::WINDOW_MANAGER:
+      return "windowmanager";
+    case CGUIFrameProfiler::Category::CONTROL:
+      return "control";
+    case CGUIFrameProfiler::Category::INFO:
+      return "info";
+    case CGUIFrameProfiler::Category::TEXTURE:
+      return "texture";
+  }
+  return "";
+}
+} // namespace
+
+std::atomic<bool> CGUIFrameProfiler::m_bIsRunning{false};
+
+CGUIFrameProfiler::CGUIFrameProfiler() : m_frequency(CurrentHostFrequency())
+{
+}
+
+CGUIFrameProfiler& CGUIFrameProfiler::Instance()
+{
+  static CGUIFrameProfiler instance;
+  return instance;
+}
+
+void CGUIFrameProfiler::Start()
+{
+  const auto advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  m_frameBudgetMs = advancedSettings->m_guiFrameBudget;
+  m_budget = m_frequency * m_frameBudgetMs / 1000;
+  m_threshold = m_frequency * advancedSettings->m_guiFrameProfilerThreshold / 1000000;
+
+  m_events.assign(MAX_EVENTS, Event());
+  m_nextEvent = 0;
+  m_eventCount = 0;
+  m_frames.assign(MAX_FRAMES, Frame());
+  m_nextFrame = 0;
+  m_frameCount = 0;
+  m_framesOverBudget = 0;
+
+  m_frameStart = 0;
+  m_frameWork = 0;
+  m_frameInfoTime = 0;
+  m_frameInfoCount = 0;
+  m_frameTextureUploads = 0;
+
+  m_bIsRunning = true;
+
+  CLog::Log(LOGINFO, "CGUIFrameProfiler::{}: recording with a budget of {} ms per frame", __func__,
+            m_frameBudgetMs);
+}
+
+void CGUIFrameProfiler::Stop()
+{
+  m_bIsRunning = false;
+}
+
+int CGUIFrameProfiler::GetThreadId()
+{
+  if (threadId == 0)
+    threadId = ++nextThreadId;
+  return threadId;
+}
+
+CGUIFrameProfiler::Event& CGUIFrameProfiler::NextEvent()
+{
+  Event& event = m_events[m_nextEvent];
+  m_nextEvent = (m_nextEvent + 1) % m_events.size();
+  if (m_eventCount < m_events.size())
+    m_eventCount++;
+  return event;
+}
+
+void CGUIFrameProfiler::AddEvent(
+    Category category, const char* name, int64_t start, int64_t end, const std::string* detail)
+{
+  const int64_t duration = end - start;
+  switch (category)
+  {
+    case Category::WINDOW_MANAGER:
+    {
+      int64_t frameStart = 0;
+      m_frameStart.compare_exchange_strong(frameStart, start);
+      m_frameWork += duration;
+      break;
+    }
+    case Category::INFO:
+      m_frameInfoTime += duration;
+      m_frameInfoCount++;
+      if (!IsRecorded(duration))
+        return;
+      break;
+    case Category::TEXTURE:
+      m_frameTextureUploads++;
+      break;
+    default:
+      if (!IsRecorded(duration))
+        return;
+      break;
+  }
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (!IsRunning())
+    return;
+
+  Event& event = NextEvent();
+  event.m_category = category;
+  event.m_name = name;
+  event.m_start = start;
+  event.m_end = end;
+  event.m_threadId = GetThreadId();
+  event.m_controlType = 0;
+  event.m_controlId = 0;
+  event.m_windowId = 0;
+  if (detail)
+    event.m_detail = *detail;
+  else
+    event.m_detail.clear();
+}
+
+void CGUIFrameProfiler::AddControlEvent(const char* name,
+                                        const CGUIControl& control,
+                                        int64_t start,
+                                        int64_t end)
+{
+  if (!IsRecorded(end - start))
+    return;
+
+  std::string description = control.GetDescription();
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (!IsRunning())
+    return;
+
+  Event& event = NextEvent();
+  event.m_category = Category::CONTROL;
+  event.m_name = name;
+  event.m_start = start;
+  event.m_end = end;
+  event.m_threadId = GetThreadId();
+  event.m_controlType = control.GetControlType();
+  event.m_controlId = control.GetID();
+  event.m_windowId = control.GetParentID();
+  event.m_detail = std::move(description);
+}
+
+void CGUIFrameProfiler::EndFrame()
+{
+  if (!IsRunning())
+    return;
+
+  Frame frame;
+  frame.m_end = CurrentHostCounter();
+  frame.m_start = m_frameStart.exchange(0);
+  frame.m_work = m_frameWork.exchange(0);
+  frame.m_infoTime = m_frameInfoTime.exchange(0);
+  frame.m_infoCount = m_frameInfoCount.exchange(0);
+  frame.m_textureUploads = m_frameTextureUploads.exchange(0);
+
+  // the window manager did nothing this frame
+  if (frame.m_start == 0)
+    return;
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (!IsRunning())
+    return;
+
+  m_guiThreadId = GetThreadId();
+  m_frameCount++;
+  if (frame.m_work > m_budget)
+    m_framesOverBudget++;
+
+  m_frames[m_nextFrame] = frame;
+  m_nextFrame = (m_nextFrame + 1) % m_frames.size();
+}
+
+bool CGUIFrameProfiler::Save(const std::string& file /* = "" */)
+{
+  std::vector<Event> events;
+  std::vector<Frame> frames;
+  int64_t budget;
+  unsigned int frameCount, framesOverBudget;
+  int guiThreadId;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    events.reserve(m_eventCount);
+    for (size_t i = m_events.size() + m_nextEvent - m_eventCount; events.size() < m_eventCount; ++i)
+      events.emplace_back(m_events[i % m_events.size()]);
+
+    const size_t count = std::min<size_t>(m_frameCount, m_frames.size());
+    frames.reserve(count);
+    for (size_t i = m_frames.size() + m_nextFrame - count; frames.size() < count; ++i)
+      frames.emplace_back(m_frames[i % m_frames.size()]);
+
+    budget = m_budget;
+    frameCount = m_frameCount;
+    framesOverBudget = m_framesOverBudget;
+    guiThreadId = m_guiThreadId;
+  }
+
+  if (events.empty() && frames.empty())
+  {
+    CLog::Log(LOGWARNING, "CGUIFrameProfiler::{}: nothing recorded", __func__);
+    return false;
+  }
+
+  // timestamps are microseconds since the oldest event
+  int64_t base = std::numeric_limits<int64_t>::max();
+  for (const auto& event : events)
+    base = std::min(base, event.m_start);
+  for (const auto& frame : frames)
+    base = std::min(base, frame.m_start);
+  const double scale = 1000000.0 / m_frequency;
+  const auto toMicroseconds = [base, scale](int64_t ticks)
+  { return static_cast<double>(ticks - base) * scale; };
+
+  CVariant traceEvents(CVariant::VariantTypeArray);
+
+  CVariant process(CVariant::VariantTypeObject);
+  process["name"] = "process_name";
+  process["ph"] = "M";
+  process["pid"] = TRACE_PID;
+  process["args"]["name"] = CCompileInfo::GetAppName();
+  traceEvents.push_back(std::move(process));
+
+  if (guiThreadId)
+  {
+    CVariant thread(CVariant::VariantTypeObject);
+    thread["name"] = "thread_name";
+    thread["ph"] = "M";
+    thread["pid"] = TRACE_PID;
+    thread["tid"] = guiThreadId;
+    thread["args"]["name"] = "GUI";
+    traceEvents.push_back(std::move(thread));
+  }
+
+  for (const auto& frame : frames)
+  {
+    const bool overBudget = frame.m_work > budget;
+
+    CVariant event(CVariant::VariantTypeObject);
+    event["name"] = overBudget ? "Frame over budget" : "Frame";
+    event["cat"] = GetCategoryName(Category::FRAME);
+    event["ph"] = "X";
+    event["ts"] = toMicroseconds(frame.m_start);
+    event["dur"] = static_cast<double>(frame.m_end - frame.m_start) * scale;
+    event["pid"] = TRACE_PID;
+    event["tid"] = guiThreadId;
+    event["args"]["work_ms"] = static_cast<double>(frame.m_work) * scale / 1000.0;
+    event["args"]["info_ms"] = static_cast<double>(frame.m_infoTime) * scale / 1000.0;
+    event["args"]["info_evaluations"] = frame.m_infoCount;
+    event["args"]["texture_uploads"] = frame.m_textureUploads;
+    traceEvents.push_back(std::move(event));
+
+    CVariant counter(CVariant::VariantTypeObject);
+    counter["name"] = "GUI frame";
+    counter["ph"] = "C";
+    counter["ts"] = toMicroseconds(frame.m_start);
+    counter["pid"] = TRACE_PID;
+    counter["args"]["work_ms"] = static_cast<double>(frame.m_work) * scale / 1000.0;
+    counter["args"]["info_ms"] = static_cast<double>(frame.m_infoTime) * scale / 1000.0;
+    traceEvents.push_back(std::move(counter));
+  }
+
+  for (const auto& it : events)
+  {
+    CVariant event(CVariant::VariantTypeObject);
+    if (it.m_category == Category::CONTROL)
+    {
+      const char* type = CGUIControlProfiler::GetControlTypeName(
+          static_cast<CGUIControl::GUICONTROLTYPES>(it.m_controlType));
+      std::string name = StringUtils::Format("{} {}", it.m_name, type ? type : "control");
+      if (it.m_controlId != 0)
+        name += StringUtils::Format(" {}", it.m_controlId);
+      event["name"] = name;
+      event["args"]["id"] = it.m_controlId;
+      event["args"]["window"] = it.m_windowId;
+    }
+    else
+      event["name"] = it.m_name;
+    if (!it.m_detail.empty())
+      event["args"]["detail"] = it.m_detail;
+    event["cat"] = GetCategoryName(it.m_category);
+    event["ph"] = "X";
+    event["ts"] = toMicroseconds(it.m_start);
+    event["dur"] = static_cast<double>(it.m_end - it.m_start) * scale;
+    event["pid"] = TRACE_PID;
+    event["tid"] = it.m_threadId;
+    traceEvents.push_back(std::move(event));
+  }
+
+  CVariant trace(CVariant::VariantTypeObject);
+  trace["traceEvents"] = std::move(traceEvents);
+  trace["displayTimeUnit"] = "ms";
+  trace["otherData"]["budget_ms"] = static_cast<double>(budget) * scale / 1000.0;
+  trace["otherData"]["frames"] = frameCount;
+  trace["otherData"]["frames_over_budget"] = framesOverBudget;
+
+  const std::string& path = file.empty() ? DEFAULT_OUTPUT_FILE : file;
+  std::string json;
+  XFILE::CFile output;
+  if (!CJSONVariantWriter::Write(trace, json, true) || !output.OpenForWrite(path, true) ||
+      output.Write(json.c_str(), json.size()) != static_cast<ssize_t>(json.size()))
+  {
+    CLog::Log(LOGERROR, "CGUIFrameProfiler::{}: unable to write {}", __func__, path);
+    return false;
+  }
+
+  CLog::Log(LOGINFO, "CGUIFrameProfiler::{}: wrote {} events, {} of {} frames over budget to {}",
+            __func__, events.size(), framesOverBudget, frameCount, path);
+  return true;
+}
+
+void CGUIFrameProfilerScope::Begin()
+{
+  if (m_category == CGUIFrameProfiler::Category::INFO)
+  {
+    if (infoDepth > 0)
+      return;
+    infoDepth++;
+  }
+
+  m_start = CurrentHostCounter();
+}
+
+void CGUIFrameProfilerScope::End()
+{
+  const int64_t end = CurrentHostCounter();
+  if (m_category == CGUIFrameProfiler::Category::INFO)
+    infoDepth--;
+
+  CGUIFrameProfiler::Instance().AddEvent(m_category, m_name, m_start, end,
+                                         m_ownDetail.empty() ? m_detail : &m_ownDetail);
+}
+
+void CGUIFrameProfilerControlScope::Begin()
+{
+  m_start = CurrentHostCounter();
+}
+
+void CGUIFrameProfilerControlScope::End()
+{
+  CGUIFrameProfiler::Instance().AddControlEvent(m_name, m_control, m_start, CurrentHostCounter());
+}
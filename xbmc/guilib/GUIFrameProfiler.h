@@ -0,0 +1,203 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <atomic>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class CGUIControl;
+
+/*!
+ \ingroup guilib
+ \brief Continuous timeline of the GUI frame loop, written as Chrome trace JSON
+
+ Where CGUIControlProfiler sums up the time of every control over a fixed number of frames, the
+ frame profiler keeps running and remembers the most recent events in a ring buffer. It covers
+ CGUIWindowManager::Process(), FrameMove() and Render(), processing and rendering of single
+ controls, evaluation of info conditions and labels, and texture uploads. The saved file opens
+ in chrome://tracing or https://ui.perfetto.dev.
+
+ Control and info events shorter than the recording threshold are not stored, their time still
+ shows up in the per frame counters. Every frame whose Process, FrameMove and Render together
+ take longer than the frame budget is counted and flagged in the trace.
+ */
+class CGUIFrameProfiler
+{
+public:
+  enum class Category
+  {
+    FRAME,
+    WINDOW_MANAGER,
+    CONTROL,
+    INFO,
+    TEXTURE,
+  };
+
+  struct Event
+  {
+    Category m_category{Category::FRAME};
+    const char* m_name{nullptr}; ///< static string
+    int64_t m_start{0}; ///< host counter
+    int64_t m_end{0}; ///< host counter
+    int m_threadId{0};
+    int m_controlType{0};
+    int m_controlId{0};
+    int m_windowId{0};
+    std::string m_detail;
+  };
+
+  static CGUIFrameProfiler& Instance();
+  static bool IsRunning() { return m_bIsRunning.load(std::memory_order_relaxed); }
+
+  /*!
+   \brief Start recording, dropping events of a previous run
+   Budget and recording threshold are taken from advancedsettings.xml
+   */
+  void Start();
+  void Stop();
+
+  /*!
+   \brief Write the recorded events as Chrome trace JSON
+   \param file path to write to, defaults to special://home/guiframeprofile.json
+   */
+  bool Save(const std::string& file = "");
+
+  /*!
+   \brief Close the current frame, called once per CApplication::Render()
+   */
+  void EndFrame();
+
+  void AddEvent(Category category,
+                const char* name,
+                int64_t start,
+                int64_t end,
+                const std::string* detail = nullptr);
+  void AddControlEvent(const char* name, const CGUIControl& control, int64_t start, int64_t end);
+
+  unsigned int GetFrameCount() const { return m_frameCount; }
+  unsigned int GetFramesOverBudget() const { return m_framesOverBudget; }
+  unsigned int GetFrameBudget() const { return m_frameBudgetMs; }
+
+private:
+  struct Frame
+  {
+    int64_t m_start{0}; ///< start of the first window manager call
+    int64_t m_end{0};
+    int64_t m_work{0}; ///< time spent in window manager calls
+    int64_t m_infoTime{0};
+    unsigned int m_infoCount{0};
+    unsigned int m_textureUploads{0};
+  };
+
+  CGUIFrameProfiler();
+  ~CGUIFrameProfiler() = default;
+  CGUIFrameProfiler(const CGUIFrameProfiler&) = delete;
+  CGUIFrameProfiler& operator=(const CGUIFrameProfiler&) = delete;
+
+  bool IsRecorded(int64_t duration) const { return duration >= m_threshold; }
+  Event& NextEvent();
+  static int GetThreadId();
+
+  static std::atomic<bool> m_bIsRunning;
+
+  CCriticalSection m_critSection;
+  std::vector<Event> m_events; ///< ring buffer
+  size_t m_nextEvent{0};
+  size_t m_eventCount{0};
+  std::vector<Frame> m_frames; ///< ring buffer
+  size_t m_nextFrame{0};
+
+  const int64_t m_frequency;
+  int64_t m_threshold{0}; ///< in host counter ticks
+  int64_t m_budget{0}; ///< in host counter ticks
+  unsigned int m_frameBudgetMs{16};
+
+  // per frame counters, written from any thread
+  std::atomic<int64_t> m_frameStart{0};
+  std::atomic<int64_t> m_frameWork{0};
+  std::atomic<int64_t> m_frameInfoTime{0};
+  std::atomic<unsigned int> m_frameInfoCount{0};
+  std::atomic<unsigned int> m_frameTextureUploads{0};
+
+  unsigned int m_frameCount{0};
+  unsigned int m_framesOverBudget{0};
+  int m_guiThreadId{0};
+};
+
+/*!
+ \brief Times the enclosing scope for CGUIFrameProfiler
+
+ Costs a single relaxed load while the profiler isn't running. Nested info scopes on the same
+ thread are ignored so that conditions referring to other conditions aren't counted twice.
+ */
+class CGUIFrameProfilerScope
+{
+public:
+  CGUIFrameProfilerScope(CGUIFrameProfiler::Category category,
+                         const char* name,
+                         const std::string* detail = nullptr)
+    : m_category(category), m_name(name), m_detail(detail)
+  {
+    if (CGUIFrameProfiler::IsRunning())
+      Begin();
+  }
+  ~CGUIFrameProfilerScope()
+  {
+    if (m_start)
+      End();
+  }
+
+  bool IsActive() const { return m_start != 0; }
+
+  /*!
+   \brief Set the detail shown with the event, only worth formatting if IsActive()
+   */
+  void SetDetail(std::string detail) { m_ownDetail = std::move(detail); }
+
+private:
+  void Begin();
+  void End();
+
+  const CGUIFrameProfiler::Category m_category;
+  const char* m_name;
+  const std::string* m_detail;
+  std::string m_ownDetail;
+  int64_t m_start{0};
+};
+
+/*!
+ \brief Times processing or rendering of a control for CGUIFrameProfiler
+ */
+class CGUIFrameProfilerControlScope
+{
+public:
+  CGUIFrameProfilerControlScope(const char* name, const CGUIControl& control)
+    : m_name(name), m_control(control)
+  {
+    if (CGUIFrameProfiler::IsRunning())
+      Begin();
+  }
+  ~CGUIFrameProfilerControlScope()
+  {
+    if (m_start)
+      End();
+  }
+
+private:
+  void Begin();
+  void End();
+
+  const char* m_name;
+  const CGUIControl& m_control;
+  int64_t m_start{0};
+};
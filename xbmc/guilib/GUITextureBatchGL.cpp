@@ -0,0 +1,171 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUITextureBatchGL.h"
+
+#include "Texture.h"
+#include "rendering/gl/RenderSystemGL.h"
+
+#include <cstddef>
+#include <limits>
+
+CGUITextureBatchGL::CGUITextureBatchGL(CRenderSystemGL& renderSystem)
+  : m_renderSystem(renderSystem), m_method(ShaderMethodGL::SM_DEFAULT)
+{
+}
+
+void CGUITextureBatchGL::BeginScope()
+{
+  m_depth++;
+}
+
+void CGUITextureBatchGL::EndScope()
+{
+  if (m_depth == 0)
+    return;
+
+  if (--m_depth == 0)
+    Flush();
+}
+
+void CGUITextureBatchGL::SetState(const std::shared_ptr<CTexture>& texture,
+                                  const std::shared_ptr<CTexture>& diffuse,
+                                  ShaderMethodGL method,
+                                  const std::array<GLubyte, 4>& color,
+                                  bool blend)
+{
+  m_renderSystem.CountGUITexture();
+
+  if (!m_packedVertices.empty() && texture == m_texture && diffuse == m_diffuse &&
+      method == m_method && color == m_col && blend == m_blend)
+    return;
+
+  Flush();
+
+  m_texture = texture;
+  m_diffuse = diffuse;
+  m_method = method;
+  m_col = color;
+  m_blend = blend;
+}
+
+void CGUITextureBatchGL::AddQuad(const PackedVertex (&vertices)[4])
+{
+  // indices are 16 bit, so a batch can't address more vertices than that
+  if (m_packedVertices.size() + 4 > std::numeric_limits<GLushort>::max() + 1u)
+    Flush();
+
+  const size_t i = m_packedVertices.size();
+  m_packedVertices.insert(m_packedVertices.end(), std::begin(vertices), std::end(vertices));
+
+  m_idx.push_back(i + 0);
+  m_idx.push_back(i + 1);
+  m_idx.push_back(i + 2);
+  m_idx.push_back(i + 2);
+  m_idx.push_back(i + 3);
+  m_idx.push_back(i + 0);
+}
+
+void CGUITextureBatchGL::Flush()
+{
+  // enabling the shader below calls back into us through the render system
+  if (m_flushing || m_packedVertices.empty())
+    return;
+
+  m_flushing = true;
+
+  m_texture->BindToUnit(0);
+  if (m_diffuse)
+    m_diffuse->BindToUnit(1);
+
+  m_renderSystem.EnableShader(m_method);
+
+  if (m_blend)
+  {
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
+    glEnable(GL_BLEND);
+  }
+  else
+  {
+    glDisable(GL_BLEND);
+  }
+
+  GLint posLoc = m_renderSystem.ShaderGetPos();
+  GLint tex0Loc = m_renderSystem.ShaderGetCoord0();
+  GLint tex1Loc = m_renderSystem.ShaderGetCoord1();
+  GLint uniColLoc = m_renderSystem.ShaderGetUniCol();
+
+  GLuint VertexVBO;
+  GLuint IndexVBO;
+
+  glGenBuffers(1, &VertexVBO);
+  glBindBuffer(GL_ARRAY_BUFFER, VertexVBO);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(PackedVertex) * m_packedVertices.size(),
+               m_packedVertices.data(), GL_STREAM_DRAW);
+
+  if (uniColLoc >= 0)
+  {
+    glUniform4f(uniColLoc, (m_col[0] / 255.0f), (m_col[1] / 255.0f), (m_col[2] / 255.0f),
+                (m_col[3] / 255.0f));
+  }
+
+  if (m_diffuse)
+  {
+    glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex),
+                          reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, u2)));
+    glEnableVertexAttribArray(tex1Loc);
+  }
+
+  glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex),
+                        reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, x)));
+  glEnableVertexAttribArray(posLoc);
+  glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex),
+                        reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, u1)));
+  glEnableVertexAttribArray(tex0Loc);
+
+  glGenBuffers(1, &IndexVBO);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IndexVBO);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * m_idx.size(), m_idx.data(),
+               GL_STREAM_DRAW);
+
+  glDrawElements(GL_TRIANGLES, m_idx.size(), GL_UNSIGNED_SHORT, 0);
+  m_renderSystem.CountGUIDrawCall(m_packedVertices.size() / 4);
+
+  if (m_diffuse)
+    glDisableVertexAttribArray(tex1Loc);
+
+  glDisableVertexAttribArray(posLoc);
+  glDisableVertexAttribArray(tex0Loc);
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  glDeleteBuffers(1, &VertexVBO);
+  glDeleteBuffers(1, &IndexVBO);
+
+  if (m_diffuse)
+    glActiveTexture(GL_TEXTURE0);
+  glEnable(GL_BLEND);
+
+  m_renderSystem.DisableShader();
+
+  m_packedVertices.clear();
+  m_idx.clear();
+  m_texture.reset();
+  m_diffuse.reset();
+
+  m_flushing = false;
+}
+
+void CGUITextureBatchGL::Reset()
+{
+  m_packedVertices.clear();
+  m_idx.clear();
+  m_texture.reset();
+  m_diffuse.reset();
+  m_depth = 0;
+}
@@ -0,0 +1,80 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "system_gl.h"
+
+class CRenderSystemGL;
+class CTexture;
+enum class ShaderMethodGL;
+
+/*!
+ * \brief Collects the quads of consecutive GUI texture draws that share the same GL state
+ *
+ * CGUITextureGL hands its quads to the batch instead of drawing them itself. As long as
+ * texture, diffuse texture, shader, color and blending stay the same the quads are appended
+ * to a single vertex buffer, so a list of identical item backgrounds ends up as one draw call.
+ * Drawing order is never changed: any state change draws the pending quads first.
+ *
+ * Outside of a batching scope (see CRenderSystemGL::BeginGUIBatch) every texture is drawn
+ * right away, which is the behaviour CGUITextureGL always had.
+ */
+class CGUITextureBatchGL
+{
+public:
+  struct PackedVertex
+  {
+    float x, y, z;
+    float u1, v1;
+    float u2, v2;
+  };
+
+  explicit CGUITextureBatchGL(CRenderSystemGL& renderSystem);
+  ~CGUITextureBatchGL() = default;
+
+  void BeginScope();
+  void EndScope();
+  bool IsActive() const { return m_depth > 0; }
+
+  /*!
+   * \brief Select the state for the following quads, drawing pending quads if it differs
+   */
+  void SetState(const std::shared_ptr<CTexture>& texture,
+                const std::shared_ptr<CTexture>& diffuse,
+                ShaderMethodGL method,
+                const std::array<GLubyte, 4>& color,
+                bool blend);
+  void AddQuad(const PackedVertex (&vertices)[4]);
+
+  void Flush();
+
+  /*!
+   * \brief Drop pending quads without drawing them, e.g. when the GL context goes away
+   */
+  void Reset();
+
+private:
+  CRenderSystemGL& m_renderSystem;
+
+  std::shared_ptr<CTexture> m_texture;
+  std::shared_ptr<CTexture> m_diffuse;
+  ShaderMethodGL m_method;
+  std::array<GLubyte, 4> m_col = {};
+  bool m_blend = false;
+
+  std::vector<PackedVertex> m_packedVertices;
+  std::vector<GLushort> m_idx;
+
+  unsigned int m_depth = 0;
+  bool m_flushing = false;
+};
@@ -15,6 +15,7 @@
 #include "application/ApplicationPlayer.h"
 #include "application/ApplicationPowerHandling.h"
 #include "input/Key.h"
+#include "rendering/RenderSystem.h"
 #include "utils/ColorUtils.h"
 
 CGUIVideoControl::CGUIVideoControl(int parentID, int controlID, float posX, float posY, float width, float height)
@@ -42,6 +43,9 @@ void CGUIVideoControl::Render()
   const auto appPlayer = components.GetComponent<CApplicationPlayer>();
   if (appPlayer->IsRenderingVideo())
   {
+    // the video renderer draws with its own shaders
+    CServiceBroker::GetRenderSystem()->FlushGUIBatch();
+
     if (!appPlayer->IsPausedPlayback())
     {
       auto& appComponents = CServiceBroker::GetAppComponents();
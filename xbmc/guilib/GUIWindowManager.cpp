@@ -10,6 +10,7 @@
 
 #include "GUIAudioManager.h"
 #include "GUIDialog.h"
+#include "GUIFrameProfiler.h"
 #include "GUIInfoManager.h"
 #include "GUIPassword.h"
 #include "GUITexture.h"
@@ -173,6 +174,9 @@ void CGUIWindowManager::Initialize()
 {
   m_tracker.SelectAlgorithm();
 
+  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiFrameProfiler)
+    CGUIFrameProfiler::Instance().Start();
+
   m_initialized = true;
 
   LoadNotOnDemandWindows();
@@ -1198,6 +1202,7 @@ void CGUIWindowManager::Process(unsigned int currentTime)
 {
   assert(CServiceBroker::GetAppMessenger()->IsProcessThread());
   std::unique_lock<CCriticalSection> lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  CGUIFrameProfilerScope profilerScope(CGUIFrameProfiler::Category::WINDOW_MANAGER, "Process");
 
   m_dirtyregions.clear();
 
@@ -1279,6 +1284,7 @@ bool CGUIWindowManager::Render()
 {
   assert(CServiceBroker::GetAppMessenger()->IsProcessThread());
   CSingleExit lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  CGUIFrameProfilerScope profilerScope(CGUIFrameProfiler::Category::WINDOW_MANAGER, "Render");
 
   CDirtyRegionList dirtyRegions = m_tracker.GetDirtyRegions();
 
@@ -1350,6 +1356,7 @@ void CGUIWindowManager::FrameMove()
 {
   assert(CServiceBroker::GetAppMessenger()->IsProcessThread());
   std::unique_lock<CCriticalSection> lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  CGUIFrameProfilerScope profilerScope(CGUIFrameProfiler::Category::WINDOW_MANAGER, "FrameMove");
 
   if(m_iNested == 0)
   {
@@ -1427,6 +1434,12 @@ void CGUIWindowManager::DeInitialize()
 {
   std::unique_lock<CCriticalSection> lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
+  if (CGUIFrameProfiler::IsRunning())
+  {
+    CGUIFrameProfiler::Instance().Stop();
+    CGUIFrameProfiler::Instance().Save();
+  }
+
   // Need a copy because addon-dialogs removes itself on Close()
   std::unordered_map<int, CGUIWindow*> closeMap(m_mapWindows);
   for (const auto& entry : closeMap)
@@ -8,7 +8,9 @@
 
 #include "TextureDX.h"
 
+#include "GUIFrameProfiler.h"
 #include "utils/MemUtils.h"
+#include "utils/StringUtils.h"
 #include "utils/log.h"
 
 #include <memory>
@@ -76,6 +78,10 @@ void CDXTexture::LoadToGPU()
     return;
   }
 
+  CGUIFrameProfilerScope profilerScope(CGUIFrameProfiler::Category::TEXTURE, "Upload");
+  if (profilerScope.IsActive())
+    profilerScope.SetDetail(StringUtils::Format("{}x{}", m_textureWidth, m_textureHeight));
+
   bool needUpdate = true;
   D3D11_USAGE usage = D3D11_USAGE_DEFAULT;
   if (m_format == XB_FMT_RGB8)
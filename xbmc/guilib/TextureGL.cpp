@@ -9,11 +9,13 @@
 #include "TextureGL.h"
 
 #include "ServiceBroker.h"
+#include "guilib/GUIFrameProfiler.h"
 #include "guilib/TextureManager.h"
 #include "rendering/RenderSystem.h"
 #include "settings/AdvancedSettings.h"
 #include "utils/GLUtils.h"
 #include "utils/MemUtils.h"
+#include "utils/StringUtils.h"
 #include "utils/log.h"
 
 #include <memory>
@@ -57,6 +59,10 @@ void CGLTexture::LoadToGPU()
     // nothing to load - probably same image (no change)
     return;
   }
+
+  CGUIFrameProfilerScope profilerScope(CGUIFrameProfiler::Category::TEXTURE, "Upload");
+  if (profilerScope.IsActive())
+    profilerScope.SetDetail(StringUtils::Format("{}x{}", m_textureWidth, m_textureHeight));
   if (m_texture == 0)
   {
     // Have OpenGL generate a texture object handle for us
@@ -726,6 +726,7 @@
 #define PLAYER_PROCESS_AUDIOSAMPLERATE (PLAYER_PROCESS + 10)
 #define PLAYER_PROCESS_AUDIOBITSPERSAMPLE (PLAYER_PROCESS + 11)
 #define PLAYER_PROCESS_VIDEOSCANTYPE (PLAYER_PROCESS + 12)
+#define PLAYER_PROCESS_VIDEODECODERTHREADS (PLAYER_PROCESS + 13)
 
 #define ADDON_INFOS                 1600
 #define ADDON_SETTING_STRING        (ADDON_INFOS)
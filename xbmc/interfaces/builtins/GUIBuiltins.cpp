@@ -16,6 +16,7 @@
 #include "dialogs/GUIDialogNumeric.h"
 #include "filesystem/Directory.h"
 #include "guilib/GUIComponent.h"
+#include "guilib/GUIFrameProfiler.h"
 #include "guilib/GUIWindowManager.h"
 #include "guilib/LocalizeStrings.h"
 #include "guilib/StereoscopicsManager.h"
@@ -394,6 +395,26 @@ static int ToggleDirty(const std::vector<std::string>&)
   return 0;
 }
 
+/*! \brief Control the GUI frame profiler.
+ *  \param params The parameters.
+ *  \details params[0] = "start", "stop" or "save".
+ *           params[1] = File to save the trace to (optional).
+ */
+static int FrameProfiler(const std::vector<std::string>& params)
+{
+  CGUIFrameProfiler& profiler = CGUIFrameProfiler::Instance();
+  if (StringUtils::EqualsNoCase(params[0], "start"))
+    profiler.Start();
+  else if (StringUtils::EqualsNoCase(params[0], "stop"))
+    profiler.Stop();
+  else if (StringUtils::EqualsNoCase(params[0], "save"))
+    profiler.Save(params.size() > 1 ? params[1] : "");
+  else
+    CLog::Log(LOGERROR, "GUIFrameProfiler called with unknown parameter {}", params[0]);
+
+  return 0;
+}
+
 // Note: For new Texts with comma add a "\" before!!! Is used for table text.
 //
 /// \page page_List_of_built_in_functions
@@ -493,6 +514,14 @@ static int ToggleDirty(const std::vector<std::string>&)
 ///     @param[in] force                 Send "true" to force close (skip animations) (optional).
 ///   }
 ///   \table_row2_l{
+///     <b>`GUIFrameProfiler(command[\,file])`</b>
+///     ,
+///     Starts or stops the GUI frame profiler\, or saves what it recorded as Chrome trace JSON
+///     that can be opened in chrome://tracing or ui.perfetto.dev.
+///     @param[in] command               Send "start"\, "stop" or "save".
+///     @param[in] file                  File to save to\, defaults to special://home/guiframeprofile.json (optional).
+///   }
+///   \table_row2_l{
 ///     <b>`Notification(header\,message[\,time\,image])`</b>
 ///     ,
 ///     Will display a notification dialog with the specified header and message\,
@@ -588,6 +617,7 @@ CBuiltins::CommandMap CGUIBuiltins::GetOperations() const
            {"activatewindowandfocus",         {"Activate the specified window and sets focus to the specified id", 1, ActivateAndFocus<false>}},
            {"clearproperty",                  {"Clears a window property for the current focused window/dialog (key,value)", 1, ClearProperty}},
            {"dialog.close",                   {"Close a dialog", 1, CloseDialog}},
+           {"guiframeprofiler",               {"Start, stop or save the GUI frame profiler", 1, FrameProfiler}},
            {"notification",                   {"Shows a notification on screen, specify header, then message, and optionally time in milliseconds and a icon.", 2, Notification}},
            {"refreshrss",                     {"Reload RSS feeds from RSSFeeds.xml", 0, RefreshRSS}},
            {"replacewindow",                  {"Replaces the current window with the new one", 1, ActivateWindow<true>}},
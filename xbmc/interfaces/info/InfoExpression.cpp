@@ -11,6 +11,7 @@
 #include "GUIInfoManager.h"
 #include "ServiceBroker.h"
 #include "guilib/GUIComponent.h"
+#include "guilib/GUIFrameProfiler.h"
 #include "utils/log.h"
 
 #include <list>
@@ -26,6 +27,9 @@ void InfoSingle::Initialize()
 
 void InfoSingle::Update(int contextWindow, const CGUIListItem* item)
 {
+  CGUIFrameProfilerScope profilerScope(CGUIFrameProfiler::Category::INFO, "Condition",
+                                       &m_expression);
+
   // use propagated context in case this info has the default context (i.e. if not tied to a specific window)
   // its value might depend on the context in which the evaluation was called
   int context = m_context == DEFAULT_CONTEXT ? contextWindow : m_context;
@@ -43,6 +47,9 @@ void InfoExpression::Initialize()
 
 void InfoExpression::Update(int contextWindow, const CGUIListItem* item)
 {
+  CGUIFrameProfilerScope profilerScope(CGUIFrameProfiler::Category::INFO, "Condition",
+                                       &m_expression);
+
   // use propagated context in case this info expression has the default context (i.e. if not tied to a specific window)
   // its value might depend on the context in which the evaluation was called
   int context = m_context == DEFAULT_CONTEXT ? contextWindow : m_context;
@@ -8,6 +8,8 @@
 
 #include "AudioLibrary.h"
 
+#include "JSONRPCResponse.h"
+
 #include "FileItem.h"
 #include "ServiceBroker.h"
 #include "TextureDatabase.h"
@@ -33,6 +35,93 @@ using namespace MUSIC_INFO;
 using namespace JSONRPC;
 using namespace XFILE;
 
+namespace
+{
+void FillSongArt(CVariant& song, CThumbLoader& thumbLoader, bool art, bool fanart, bool thumb)
+{
+  CFileItem item;
+  // Only needs song and album id (if we have it) set to get art
+  // Getting art is quicker if "albumid" has been fetched
+  item.GetMusicInfoTag()->SetDatabaseId(song["songid"].asInteger32(), MediaTypeSong);
+  if (song.isMember("albumid"))
+    item.GetMusicInfoTag()->SetAlbumId(song["albumid"].asInteger32());
+  else
+    item.GetMusicInfoTag()->SetAlbumId(-1);
+
+  // Could use FillDetails, but it does unnecessary serialization of empty MusiInfoTag
+  thumbLoader.FillLibraryArt(item);
+
+  if (thumb)
+  {
+    if (item.HasArt("thumb"))
+      song["thumbnail"] = CTextureUtils::GetWrappedImageURL(item.GetArt("thumb"));
+    else
+      song["thumbnail"] = "";
+  }
+  if (fanart)
+  {
+    if (item.HasArt("fanart"))
+      song["fanart"] = CTextureUtils::GetWrappedImageURL(item.GetArt("fanart"));
+    else
+      song["fanart"] = "";
+  }
+  if (art)
+  {
+    CGUIListItem::ArtMap artMap = item.GetArt();
+    CVariant artObj(CVariant::VariantTypeObject);
+    for (const auto& artIt : artMap)
+    {
+      if (!artIt.second.empty())
+        artObj[artIt.first] = CTextureUtils::GetWrappedImageURL(artIt.second);
+    }
+    song["art"] = artObj;
+  }
+}
+
+/*!
+ \brief Songs of a streamed AudioLibrary.GetSongs response, read from the open query result and
+ filling in the art while sending
+ */
+class CSongStreamedList : public IStreamedList
+{
+public:
+  CSongStreamedList(std::unique_ptr<CMusicDatabase> database,
+                    std::unique_ptr<CMusicDatabase::CSongJSONRows> rows,
+                    bool art,
+                    bool fanart,
+                    bool thumb)
+    : m_database(std::move(database)),
+      m_rows(std::move(rows)),
+      m_art(art),
+      m_fanart(fanart),
+      m_thumb(thumb)
+  {
+    if (m_art || m_fanart || m_thumb)
+      m_thumbLoader.OnLoaderStart();
+  }
+
+  bool GetNextItem(CVariant& item) override
+  {
+    if (!m_rows->GetNext(item))
+      return false;
+
+    if (m_art || m_fanart || m_thumb)
+      FillSongArt(item, m_thumbLoader, m_art, m_fanart, m_thumb);
+
+    return true;
+  }
+
+private:
+  // the rows are read through the connection of the database
+  std::unique_ptr<CMusicDatabase> m_database;
+  std::unique_ptr<CMusicDatabase::CSongJSONRows> m_rows;
+  const bool m_art;
+  const bool m_fanart;
+  const bool m_thumb;
+  CMusicThumbLoader m_thumbLoader;
+};
+} // namespace
+
 JSONRPC_STATUS CAudioLibrary::GetProperties(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
 {
   CVariant properties = CVariant(CVariant::VariantTypeObject);
@@ -163,6 +252,8 @@ JSONRPC_STATUS CAudioLibrary::GetArtists(const std::string &method, ITransportLa
   int start, end;
   HandleLimits(parameterObject, result, total, start, end);
 
+  CJSONRPCResponse::StreamList(result, "artists");
+
   return OK;
 }
 
@@ -313,6 +404,8 @@ JSONRPC_STATUS CAudioLibrary::GetAlbums(const std::string &method, ITransportLay
   int start, end;
   HandleLimits(parameterObject, result, total, start, end);
 
+  CJSONRPCResponse::StreamList(result, "albums");
+
   return OK;
 }
 
@@ -346,8 +439,8 @@ JSONRPC_STATUS CAudioLibrary::GetAlbumDetails(const std::string &method, ITransp
 
 JSONRPC_STATUS CAudioLibrary::GetSongs(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
 {
-  CMusicDatabase musicdatabase;
-  if (!musicdatabase.Open())
+  auto musicdatabase = std::make_unique<CMusicDatabase>();
+  if (!musicdatabase->Open())
     return InternalError;
 
   CMusicDbUrl musicUrl;
@@ -407,73 +500,40 @@ JSONRPC_STATUS CAudioLibrary::GetSongs(const std::string &method, ITransportLaye
       fields.insert(field->asString());
   }
 
-  if (!musicdatabase.GetSongsByWhereJSON(fields, musicUrl.ToString(), result, total, sorting))
-    return InternalError;
+  const bool bFetchArt = fields.find("art") != fields.end();
+  const bool bFetchFanart = fields.find("fanart") != fields.end();
+  const bool bFetchThumb = fields.find("thumbnail") != fields.end();
 
-  if (!result.isNull())
+  if (CJSONRPCResponse::CanStream(result))
   {
-    bool bFetchArt = fields.find("art") != fields.end();
-    bool bFetchFanart = fields.find("fanart") != fields.end();
-    bool bFetchThumb = fields.find("thumbnail") != fields.end();
-    if (bFetchArt || bFetchFanart || bFetchThumb)
-    {
-      CThumbLoader* thumbLoader = new CMusicThumbLoader();
-      thumbLoader->OnLoaderStart();
+    // every song is only created from the query result, and its art looked up, once it's
+    // being sent
+    std::unique_ptr<CMusicDatabase::CSongJSONRows> rows;
+    if (!musicdatabase->GetSongsByWhereJSON(fields, musicUrl.ToString(), rows, total, sorting))
+      return InternalError;
 
-      std::set<std::string> artfields;
-      if (bFetchArt)
-        artfields.insert("art");
-      if (bFetchFanart)
-        artfields.insert("fanart");
-      if (bFetchThumb)
-        artfields.insert("thumbnail");
+    int start, end;
+    HandleLimits(parameterObject, result, total, start, end);
 
-      for (unsigned int index = 0; index < result["songs"].size(); index++)
-      {
-        CFileItem item;
-        // Only needs song and album id (if we have it) set to get art
-        // Getting art is quicker if "albumid" has been fetched
-        item.GetMusicInfoTag()->SetDatabaseId(result["songs"][index]["songid"].asInteger32(), MediaTypeSong);
-        if (result["songs"][index].isMember("albumid"))
-          item.GetMusicInfoTag()->SetAlbumId(result["songs"][index]["albumid"].asInteger32());
-        else
-          item.GetMusicInfoTag()->SetAlbumId(-1);
+    if (rows)
+      CJSONRPCResponse::SetStreamedList(
+          result, "songs",
+          std::make_unique<CSongStreamedList>(std::move(musicdatabase), std::move(rows), bFetchArt,
+                                              bFetchFanart, bFetchThumb));
 
-        // Could use FillDetails, but it does unnecessary serialization of empty MusiInfoTag
-        // CFileItemPtr itemptr(new CFileItem(item));
-        // FillDetails(item.GetMusicInfoTag(), itemptr, artfields, result["songs"][index], thumbLoader);
+    return OK;
+  }
 
-        thumbLoader->FillLibraryArt(item);
+  if (!musicdatabase->GetSongsByWhereJSON(fields, musicUrl.ToString(), result, total, sorting))
+    return InternalError;
 
-        if (bFetchThumb)
-        {
-          if (item.HasArt("thumb"))
-            result["songs"][index]["thumbnail"] = CTextureUtils::GetWrappedImageURL(item.GetArt("thumb"));
-          else
-            result["songs"][index]["thumbnail"] = "";
-        }
-        if (bFetchFanart)
-        {
-          if (item.HasArt("fanart"))
-            result["songs"][index]["fanart"] = CTextureUtils::GetWrappedImageURL(item.GetArt("fanart"));
-          else
-            result["songs"][index]["fanart"] = "";
-        }
-        if (bFetchArt)
-        {
-          CGUIListItem::ArtMap artMap = item.GetArt();
-          CVariant artObj(CVariant::VariantTypeObject);
-          for (const auto& artIt : artMap)
-          {
-            if (!artIt.second.empty())
-              artObj[artIt.first] = CTextureUtils::GetWrappedImageURL(artIt.second);
-          }
-          result["songs"][index]["art"] = artObj;
-        }
-      }
+  if (!result.isNull() && (bFetchArt || bFetchFanart || bFetchThumb))
+  {
+    CMusicThumbLoader thumbLoader;
+    thumbLoader.OnLoaderStart();
 
-      delete thumbLoader;
-    }
+    for (unsigned int index = 0; index < result["songs"].size(); index++)
+      FillSongArt(result["songs"][index], thumbLoader, bFetchArt, bFetchFanart, bFetchThumb);
   }
 
   int start, end;
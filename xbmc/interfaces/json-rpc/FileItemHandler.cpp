@@ -10,6 +10,7 @@
 
 #include "AudioLibrary.h"
 #include "FileOperations.h"
+#include "JSONRPCResponse.h"
 #include "ServiceBroker.h"
 #include "TextureDatabase.h"
 #include "Util.h"
@@ -38,13 +39,82 @@
 
 #include <map>
 #include <string.h>
+#include <utility>
+#include <vector>
 
 using namespace MUSIC_INFO;
 using namespace JSONRPC;
 using namespace XFILE;
 
+namespace
+{
+std::set<std::string> GetFields(const CVariant& parameterObject)
+{
+  std::set<std::string> fields;
+  if (parameterObject.isMember("properties") && parameterObject["properties"].isArray())
+  {
+    for (CVariant::const_iterator_array field = parameterObject["properties"].begin_array();
+         field != parameterObject["properties"].end_array(); ++field)
+      fields.insert(field->asString());
+  }
+
+  return fields;
+}
+
+std::unique_ptr<CThumbLoader> CreateThumbLoader(const CFileItem& item)
+{
+  std::unique_ptr<CThumbLoader> thumbLoader;
+  if (item.HasVideoInfoTag())
+    thumbLoader = std::make_unique<CVideoThumbLoader>();
+  else if (item.HasMusicInfoTag())
+    thumbLoader = std::make_unique<CMusicThumbLoader>();
+
+  if (thumbLoader)
+    thumbLoader->OnLoaderStart();
+
+  return thumbLoader;
+}
+} // namespace
+
+class CFileItemHandler::CStreamedFileItemList : public IStreamedList
+{
+public:
+  CStreamedFileItemList(const char* ID,
+                        bool allowFile,
+                        std::set<std::string> fields,
+                        std::vector<std::shared_ptr<CFileItem>> items,
+                        std::unique_ptr<CThumbLoader> thumbLoader)
+    : m_ID(ID != nullptr ? ID : ""),
+      m_allowFile(allowFile),
+      m_fields(std::move(fields)),
+      m_items(std::move(items)),
+      m_thumbLoader(std::move(thumbLoader))
+  {
+  }
+
+  bool GetNextItem(CVariant& item) override
+  {
+    if (m_index >= m_items.size())
+      return false;
+
+    // the file item isn't needed anymore once it has been serialized
+    const std::shared_ptr<CFileItem> fileItem = std::move(m_items[m_index++]);
+    FillFileItem(m_ID.empty() ? nullptr : m_ID.c_str(), m_allowFile, fileItem, m_fields, item,
+                 m_thumbLoader.get());
+    return true;
+  }
+
+private:
+  const std::string m_ID;
+  const bool m_allowFile;
+  const std::set<std::string> m_fields;
+  std::vector<std::shared_ptr<CFileItem>> m_items;
+  size_t m_index = 0;
+  std::unique_ptr<CThumbLoader> m_thumbLoader;
+};
+
 bool CFileItemHandler::GetField(const std::string& field,
-                                const CVariant& info,
+                                CVariant& info,
                                 const std::shared_ptr<CFileItem>& item,
                                 CVariant& result,
                                 bool& fetchedArt,
@@ -69,8 +139,8 @@ bool CFileItemHandler::GetField(const std::string& field,
       if (field == "cast")
       {
         // string -> Video.Cast
-        const std::vector<std::string> actors =
-            StringUtils::Split(info[field].asString(), EPG_STRING_TOKEN_SEPARATOR);
+        const std::vector<std::string> actors = StringUtils::Split(
+            std::as_const(info)[field].asString(), EPG_STRING_TOKEN_SEPARATOR);
 
         result[field] = CVariant(CVariant::VariantTypeArray);
         for (const auto& actor : actors)
@@ -84,7 +154,8 @@ bool CFileItemHandler::GetField(const std::string& field,
       else if (field == "director" || field == "writer")
       {
         // string -> Array.String
-        result[field] = StringUtils::Split(info[field].asString(), EPG_STRING_TOKEN_SEPARATOR);
+        result[field] =
+            StringUtils::Split(std::as_const(info)[field].asString(), EPG_STRING_TOKEN_SEPARATOR);
         return true;
       }
       else if (field == "isrecording")
@@ -138,9 +209,10 @@ bool CFileItemHandler::GetField(const std::string& field,
   }
 
   // check for serialized values
-  if (info.isMember(field) && !info[field].isNull())
+  if (info.isMember(field) && !std::as_const(info)[field].isNull())
   {
-    result[field] = info[field];
+    // every field is only asked for once, so the serialized value can be taken over
+    result[field] = std::move(info[field]);
     return true;
   }
 
@@ -301,34 +373,58 @@ void CFileItemHandler::HandleFileItemList(const char *ID, bool allowFile, const
     end = items.Size();
   }
 
-  CThumbLoader *thumbLoader = NULL;
+  std::unique_ptr<CThumbLoader> thumbLoader;
   if (end - start > 0)
-  {
-    if (items.Get(start)->HasVideoInfoTag())
-      thumbLoader = new CVideoThumbLoader();
-    else if (items.Get(start)->HasMusicInfoTag())
-      thumbLoader = new CMusicThumbLoader();
+    thumbLoader = CreateThumbLoader(*items.Get(start));
 
-    if (thumbLoader != NULL)
-      thumbLoader->OnLoaderStart();
+  const std::set<std::string> fields = GetFields(parameterObject);
+
+  result[resultname].reserve(static_cast<size_t>(end - start));
+  for (int i = start; i < end; i++)
+  {
+    CFileItemPtr item = items.Get(i);
+    HandleFileItem(ID, allowFile, resultname, item, parameterObject, fields, result, true, thumbLoader.get());
   }
+}
 
-  std::set<std::string> fields;
-  if (parameterObject.isMember("properties") && parameterObject["properties"].isArray())
+void CFileItemHandler::StreamFileItemList(const char* ID,
+                                          bool allowFile,
+                                          const char* resultname,
+                                          CFileItemList& items,
+                                          const CVariant& parameterObject,
+                                          CVariant& result,
+                                          int size,
+                                          bool sortLimit /* = true */)
+{
+  if (!CJSONRPCResponse::CanStream(result))
   {
-    for (CVariant::const_iterator_array field = parameterObject["properties"].begin_array();
-         field != parameterObject["properties"].end_array(); ++field)
-      fields.insert(field->asString());
+    HandleFileItemList(ID, allowFile, resultname, items, parameterObject, result, size, sortLimit);
+    return;
   }
 
-  result[resultname].reserve(static_cast<size_t>(end - start));
-  for (int i = start; i < end; i++)
+  int start, end;
+  HandleLimits(parameterObject, result, size, start, end);
+
+  if (sortLimit)
+    Sort(items, parameterObject);
+  else
   {
-    CFileItemPtr item = items.Get(i);
-    HandleFileItem(ID, allowFile, resultname, item, parameterObject, fields, result, true, thumbLoader);
+    start = 0;
+    end = items.Size();
   }
 
-  delete thumbLoader;
+  std::vector<std::shared_ptr<CFileItem>> fileItems;
+  for (int i = start; i < end; i++)
+    fileItems.push_back(items.Get(i));
+
+  std::unique_ptr<CThumbLoader> thumbLoader;
+  if (!fileItems.empty())
+    thumbLoader = CreateThumbLoader(*fileItems.front());
+
+  CJSONRPCResponse::SetStreamedList(
+      result, resultname,
+      std::make_unique<CStreamedFileItemList>(ID, allowFile, GetFields(parameterObject),
+                                              std::move(fileItems), std::move(thumbLoader)));
 }
 
 void CFileItemHandler::HandleFileItem(const char* ID,
@@ -341,15 +437,8 @@ void CFileItemHandler::HandleFileItem(const char* ID,
                                       bool append /* = true */,
                                       CThumbLoader* thumbLoader /* = NULL */)
 {
-  std::set<std::string> fields;
-  if (parameterObject.isMember("properties") && parameterObject["properties"].isArray())
-  {
-    for (CVariant::const_iterator_array field = parameterObject["properties"].begin_array();
-         field != parameterObject["properties"].end_array(); ++field)
-      fields.insert(field->asString());
-  }
-
-  HandleFileItem(ID, allowFile, resultname, item, parameterObject, fields, result, append, thumbLoader);
+  HandleFileItem(ID, allowFile, resultname, item, parameterObject, GetFields(parameterObject), result,
+                 append, thumbLoader);
 }
 
 void CFileItemHandler::HandleFileItem(const char* ID,
@@ -363,6 +452,24 @@ void CFileItemHandler::HandleFileItem(const char* ID,
                                       CThumbLoader* thumbLoader /* = NULL */)
 {
   CVariant object;
+  FillFileItem(ID, allowFile, item, validFields, object, thumbLoader);
+
+  if (resultname)
+  {
+    if (append)
+      result[resultname].append(std::move(object));
+    else
+      result[resultname] = std::move(object);
+  }
+}
+
+void CFileItemHandler::FillFileItem(const char* ID,
+                                    bool allowFile,
+                                    const std::shared_ptr<CFileItem>& item,
+                                    const std::set<std::string>& validFields,
+                                    CVariant& object,
+                                    CThumbLoader* thumbLoader)
+{
   std::set<std::string> fields(validFields.begin(), validFields.end());
 
   if (item.get())
@@ -491,14 +598,6 @@ void CFileItemHandler::HandleFileItem(const char* ID,
   }
   else
     object = CVariant(CVariant::VariantTypeNull);
-
-  if (resultname)
-  {
-    if (append)
-      result[resultname].append(object);
-    else
-      result[resultname] = object;
-  }
 }
 
 bool CFileItemHandler::FillFileItemList(const CVariant &parameterObject, CFileItemList &list)
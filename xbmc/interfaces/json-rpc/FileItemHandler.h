@@ -32,6 +32,20 @@ namespace JSONRPC
                             CThumbLoader* thumbLoader = nullptr);
     static void HandleFileItemList(const char *ID, bool allowFile, const char *resultname, CFileItemList &items, const CVariant &parameterObject, CVariant &result, bool sortLimit = true);
     static void HandleFileItemList(const char *ID, bool allowFile, const char *resultname, CFileItemList &items, const CVariant &parameterObject, CVariant &result, int size, bool sortLimit = true);
+    /*!
+     \brief Same as HandleFileItemList(), but if result is streamed the items are only
+     serialized while the response is sent
+
+     The list must not be accessed through result afterwards, it won't be part of it.
+     */
+    static void StreamFileItemList(const char* ID,
+                                   bool allowFile,
+                                   const char* resultname,
+                                   CFileItemList& items,
+                                   const CVariant& parameterObject,
+                                   CVariant& result,
+                                   int size,
+                                   bool sortLimit = true);
     static void HandleFileItem(const char* ID,
                                bool allowFile,
                                const char* resultname,
@@ -53,9 +67,17 @@ namespace JSONRPC
 
     static bool FillFileItemList(const CVariant &parameterObject, CFileItemList &list);
   private:
+    class CStreamedFileItemList;
+
     static void Sort(CFileItemList &items, const CVariant& parameterObject);
+    static void FillFileItem(const char* ID,
+                             bool allowFile,
+                             const std::shared_ptr<CFileItem>& item,
+                             const std::set<std::string>& validFields,
+                             CVariant& object,
+                             CThumbLoader* thumbLoader);
     static bool GetField(const std::string& field,
-                         const CVariant& info,
+                         CVariant& info,
                          const std::shared_ptr<CFileItem>& item,
                          CVariant& result,
                          bool& fetchedArt,
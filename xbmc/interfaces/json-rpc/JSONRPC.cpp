@@ -10,6 +10,7 @@
 
 #include "FileItem.h"
 #include "GUIUserMessages.h"
+#include "JSONRPCResponse.h"
 #include "ServiceBroker.h"
 #include "ServiceDescription.h"
 #include "TextureDatabase.h"
@@ -240,12 +241,14 @@ JSONRPC_STATUS CJSONRPC::NotifyAll(const std::string &method, ITransportLayer *t
 
 std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer *transport, IClient *client)
 {
+  // the request only lives for the duration of the call, so its nodes come from a single arena
+  CVariantArena arena;
   CVariant inputroot, outputroot, result;
   bool hasResponse = false;
 
   CLog::Log(LOGDEBUG, LOGJSONRPC, "JSONRPC: Incoming request: {}", inputString);
 
-  if (CJSONVariantParser::Parse(inputString, inputroot) && !inputroot.isNull())
+  if (CJSONVariantParser::Parse(inputString, inputroot, arena) && !inputroot.isNull())
   {
     if (inputroot.isArray())
     {
@@ -263,7 +266,7 @@ std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer
           CVariant response;
           if (HandleMethodCall(*itr, response, transport, client))
           {
-            outputroot.append(response);
+            outputroot.append(std::move(response));
             hasResponse = true;
           }
         }
@@ -286,11 +289,71 @@ std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer
   return str;
 }
 
-bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITransportLayer *transport, IClient *client)
+void CJSONRPC::MethodCall(const std::string& inputString,
+                          ITransportLayer* transport,
+                          IClient* client,
+                          CJSONRPCResponse& response)
+{
+  // lists are only streamed in compact form
+  if (!CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact)
+  {
+    response.SetOutput(MethodCall(inputString, transport, client));
+    return;
+  }
+
+  CVariantArena arena;
+  CVariant inputroot;
+
+  CLog::Log(LOGDEBUG, LOGJSONRPC, "JSONRPC: Incoming request: {}", inputString);
+
+  if (CJSONVariantParser::Parse(inputString, inputroot, arena) && !inputroot.isNull())
+  {
+    if (inputroot.isArray())
+    {
+      if (inputroot.size() <= 0)
+      {
+        CLog::Log(LOGERROR, "JSONRPC: Empty batch call");
+        CVariant outputroot;
+        BuildResponse(inputroot, InvalidRequest, CVariant(), outputroot);
+        response.AddResponse(outputroot);
+      }
+      else
+      {
+        response.SetBatch();
+        for (CVariant::const_iterator_array itr = inputroot.begin_array();
+             itr != inputroot.end_array(); ++itr)
+        {
+          CVariant outputroot;
+          HandleMethodCall(*itr, outputroot, transport, client, &response);
+        }
+      }
+    }
+    else
+    {
+      CVariant outputroot;
+      HandleMethodCall(inputroot, outputroot, transport, client, &response);
+    }
+  }
+  else
+  {
+    CLog::Log(LOGERROR, "JSONRPC: Failed to parse '{}'", inputString);
+    CVariant outputroot;
+    BuildResponse(inputroot, ParseError, CVariant(), outputroot);
+    response.AddResponse(outputroot);
+  }
+}
+
+bool CJSONRPC::HandleMethodCall(const CVariant& request,
+                                CVariant& response,
+                                ITransportLayer* transport,
+                                IClient* client,
+                                CJSONRPCResponse* streamedResponse /* = nullptr */)
 {
   JSONRPC_STATUS errorCode = OK;
   CVariant result;
   bool isNotification = false;
+  std::string streamedKey;
+  std::unique_ptr<IStreamedList> streamedList;
 
   if (IsProperJSONRPC(request))
   {
@@ -303,7 +366,17 @@ bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITr
     CVariant params;
 
     if ((errorCode = CJSONServiceDescription::CheckCall(methodName.c_str(), request["params"], transport, client, isNotification, method, params)) == OK)
-      errorCode = method(methodName, transport, client, params, result);
+    {
+      if (streamedResponse != nullptr && !isNotification)
+      {
+        CJSONRPCResponse::CMethodScope scope(result);
+        errorCode = method(methodName, transport, client, params, result);
+        streamedKey = std::move(scope.m_key);
+        streamedList = std::move(scope.m_list);
+      }
+      else
+        errorCode = method(methodName, transport, client, params, result);
+    }
     else
       result = params;
   }
@@ -316,7 +389,16 @@ bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITr
     errorCode = InvalidRequest;
   }
 
-  BuildResponse(request, errorCode, result, response);
+  BuildResponse(request, errorCode, std::move(result), response);
+
+  if (streamedResponse != nullptr && !isNotification)
+  {
+    // the list is part of the result, which is only sent on success
+    if (streamedList && errorCode == OK)
+      streamedResponse->AddResponse(std::move(response), streamedKey, std::move(streamedList));
+    else
+      streamedResponse->AddResponse(response);
+  }
 
   return !isNotification;
 }
@@ -326,7 +408,7 @@ inline bool CJSONRPC::IsProperJSONRPC(const CVariant& inputroot)
   return inputroot.isMember("jsonrpc") && inputroot["jsonrpc"].isString() && inputroot["jsonrpc"] == CVariant("2.0") && inputroot.isMember("method") && inputroot["method"].isString() && (!inputroot.isMember("params") || inputroot["params"].isArray() || inputroot["params"].isObject());
 }
 
-inline void CJSONRPC::BuildResponse(const CVariant& request, JSONRPC_STATUS code, const CVariant& result, CVariant& response)
+inline void CJSONRPC::BuildResponse(const CVariant& request, JSONRPC_STATUS code, CVariant result, CVariant& response)
 {
   response["jsonrpc"] = "2.0";
   response["id"] = request.isMember("id") ? request["id"] : CVariant();
@@ -334,7 +416,7 @@ inline void CJSONRPC::BuildResponse(const CVariant& request, JSONRPC_STATUS code
   switch (code)
   {
     case OK:
-      response["result"] = result;
+      response["result"] = std::move(result);
       break;
     case ACK:
       response["result"] = "OK";
@@ -347,7 +429,7 @@ inline void CJSONRPC::BuildResponse(const CVariant& request, JSONRPC_STATUS code
       response["error"]["code"] = InvalidParams;
       response["error"]["message"] = "Invalid params.";
       if (!result.isNull())
-        response["error"]["data"] = result;
+        response["error"]["data"] = std::move(result);
       break;
     case MethodNotFound:
       response["error"]["code"] = MethodNotFound;
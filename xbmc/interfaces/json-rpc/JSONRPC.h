@@ -20,6 +20,8 @@ class CVariant;
 
 namespace JSONRPC
 {
+  class CJSONRPCResponse;
+
   /*!
    \ingroup jsonrpc
    \brief JSON RPC handler
@@ -53,6 +55,22 @@ namespace JSONRPC
      */
     static std::string MethodCall(const std::string &inputString, ITransportLayer *transport, IClient *client);
 
+    /*
+     \brief Handles an incoming JSON-RPC request with a response written piece by piece
+     \param inputString received JSON-RPC request
+     \param transport Transport protocol on which the request arrived
+     \param client Client which sent the request
+     \param response JSON-RPC response to be read by the transport
+
+     Same as MethodCall() above, but methods returning large lists can hand
+     them over to the response instead of adding them to their result. Their
+     items are then only serialized while the transport reads the response.
+     */
+    static void MethodCall(const std::string& inputString,
+                           ITransportLayer* transport,
+                           IClient* client,
+                           CJSONRPCResponse& response);
+
     static JSONRPC_STATUS Introspect(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
     static JSONRPC_STATUS Version(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
     static JSONRPC_STATUS Permission(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
@@ -62,10 +80,14 @@ namespace JSONRPC
     static JSONRPC_STATUS NotifyAll(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
 
   private:
-    static bool HandleMethodCall(const CVariant& request, CVariant& response, ITransportLayer *transport, IClient *client);
+    static bool HandleMethodCall(const CVariant& request,
+                                 CVariant& response,
+                                 ITransportLayer* transport,
+                                 IClient* client,
+                                 CJSONRPCResponse* streamedResponse = nullptr);
     static inline bool IsProperJSONRPC(const CVariant& inputroot);
 
-    inline static void BuildResponse(const CVariant& request, JSONRPC_STATUS code, const CVariant& result, CVariant& response);
+    inline static void BuildResponse(const CVariant& request, JSONRPC_STATUS code, CVariant result, CVariant& response);
 
     static bool m_initialized;
   };
@@ -0,0 +1,188 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "JSONRPCResponse.h"
+
+#include "utils/JSONVariantWriter.h"
+
+#include <cassert>
+
+using namespace JSONRPC;
+
+thread_local CJSONRPCResponse::CMethodScope* CJSONRPCResponse::m_currentScope = nullptr;
+
+namespace
+{
+void AppendJSON(const CVariant& value, std::string& output)
+{
+  std::string json;
+  if (!CJSONVariantWriter::Write(value, json, true))
+    json = "null";
+  output += json;
+}
+} // namespace
+
+bool CVariantStreamedList::GetNextItem(CVariant& item)
+{
+  if (m_index >= m_items.size())
+    return false;
+
+  item = std::move(m_items[m_index++]);
+  return true;
+}
+
+CJSONRPCResponse::CMethodScope::CMethodScope(const CVariant& result)
+  : m_result(result), m_previous(m_currentScope)
+{
+  m_currentScope = this;
+}
+
+CJSONRPCResponse::CMethodScope::~CMethodScope()
+{
+  m_currentScope = m_previous;
+}
+
+bool CJSONRPCResponse::IsStreamed() const
+{
+  for (const auto& response : m_responses)
+  {
+    if (response.list)
+      return true;
+  }
+
+  return false;
+}
+
+bool CJSONRPCResponse::Read(std::string& output, size_t size)
+{
+  const size_t start = output.size();
+  while (output.size() - start < size && ReadResponse(output))
+    ;
+
+  return output.size() > start;
+}
+
+bool CJSONRPCResponse::CanStream(const CVariant& result)
+{
+  return m_currentScope != nullptr && &m_currentScope->m_result == &result && !m_currentScope->m_list;
+}
+
+void CJSONRPCResponse::SetStreamedList(const CVariant& result,
+                                       const std::string& key,
+                                       std::unique_ptr<IStreamedList> list)
+{
+  assert(CanStream(result));
+
+  m_currentScope->m_key = key;
+  m_currentScope->m_list = std::move(list);
+}
+
+void CJSONRPCResponse::StreamList(CVariant& result, const std::string& key)
+{
+  if (!result.isMember(key) || !result[key].isArray() || !CanStream(result))
+    return;
+
+  CVariant list;
+  list.swap(result[key]);
+  result.erase(key);
+  SetStreamedList(result, key, std::make_unique<CVariantStreamedList>(std::move(list)));
+}
+
+void CJSONRPCResponse::AddResponse(const CVariant& response)
+{
+  std::string json;
+  AppendJSON(response, json);
+  m_responses.push_back({std::move(json), nullptr, {}});
+}
+
+void CJSONRPCResponse::AddResponse(CVariant response,
+                                   const std::string& key,
+                                   std::unique_ptr<IStreamedList> list)
+{
+  // write the response with a marker in place of the list, so the items end up exactly
+  // where the writer would have put the list
+  const CVariant marker("\x1fstreamed list\x1f");
+  response["result"][key] = marker;
+
+  std::string json;
+  AppendJSON(response, json);
+  std::string markerJson;
+  AppendJSON(marker, markerJson);
+
+  const size_t pos = json.find(markerJson);
+  assert(pos != std::string::npos);
+
+  std::string tail = "]" + json.substr(pos + markerJson.size());
+  json.erase(pos);
+  json += '[';
+
+  m_responses.push_back({std::move(json), std::move(list), std::move(tail)});
+}
+
+void CJSONRPCResponse::SetOutput(std::string output)
+{
+  m_responses.clear();
+  m_batch = false;
+
+  if (!output.empty())
+    m_responses.push_back({std::move(output), nullptr, {}});
+}
+
+bool CJSONRPCResponse::ReadResponse(std::string& output)
+{
+  if (m_finished)
+    return false;
+
+  if (m_index >= m_responses.size())
+  {
+    m_finished = true;
+    if (!m_batch || m_responses.empty())
+      return false;
+
+    output += ']';
+    return true;
+  }
+
+  Response& response = m_responses[m_index];
+  if (!m_inList)
+  {
+    if (m_batch)
+      output += m_index == 0 ? '[' : ',';
+    output += response.json;
+    std::string().swap(response.json);
+
+    if (response.list)
+    {
+      m_inList = true;
+      m_firstItem = true;
+    }
+    else
+      m_index++;
+
+    return true;
+  }
+
+  CVariant item;
+  if (response.list->GetNextItem(item))
+  {
+    if (!m_firstItem)
+      output += ',';
+    m_firstItem = false;
+
+    AppendJSON(item, output);
+    return true;
+  }
+
+  output += response.tail;
+  std::string().swap(response.tail);
+  response.list.reset();
+  m_inList = false;
+  m_index++;
+
+  return true;
+}
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "utils/Variant.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace JSONRPC
+{
+  /*!
+   \ingroup jsonrpc
+   \brief List in the result of a JSON-RPC method whose items are only
+   created while the response is being sent
+   */
+  class IStreamedList
+  {
+  public:
+    virtual ~IStreamedList() = default;
+
+    /*!
+     \brief Get the next item of the list
+     \param item Receives the item
+     \return False if there are no more items
+     */
+    virtual bool GetNextItem(CVariant& item) = 0;
+  };
+
+  /*!
+   \ingroup jsonrpc
+   \brief Streamed list handing out the items of a CVariant array
+
+   Every item is moved out of the array once it's asked for, so its memory
+   is released as soon as it has been written.
+   */
+  class CVariantStreamedList : public IStreamedList
+  {
+  public:
+    explicit CVariantStreamedList(CVariant&& items) : m_items(std::move(items)) {}
+
+    bool GetNextItem(CVariant& item) override;
+
+  private:
+    CVariant m_items;
+    unsigned int m_index = 0;
+  };
+
+  /*!
+   \ingroup jsonrpc
+   \brief JSON-RPC response which is written piece by piece
+
+   Holds the responses to a single or a batch request. While a method is
+   called for a streamed response it can hand over a list of its result with
+   SetStreamedList() instead of adding all items to the result. The items of
+   that list are only created and serialized when the transport reads the
+   part of the response they belong to, so a large response never exists as a
+   whole, neither as CVariant nor as string.
+
+   Streamed responses are always written in compact form.
+   */
+  class CJSONRPCResponse
+  {
+  public:
+    CJSONRPCResponse() = default;
+    ~CJSONRPCResponse() = default;
+    CJSONRPCResponse(const CJSONRPCResponse&) = delete;
+    CJSONRPCResponse& operator=(const CJSONRPCResponse&) = delete;
+
+    /*!
+     \brief Whether any of the responses contains a streamed list
+     */
+    bool IsStreamed() const;
+
+    /*!
+     \brief Appends the next part of the response
+     \param output String to append to
+     \param size Number of bytes to append at least, unless the response ends
+     \return False if nothing was left to append
+     */
+    bool Read(std::string& output, size_t size);
+
+    /*!
+     \brief Whether a list of the given result can be streamed
+
+     This is only the case while a method is called for a streamed response
+     and result is the result object of that method.
+     */
+    static bool CanStream(const CVariant& result);
+
+    /*!
+     \brief Hands over a list of the result of the method being called
+     \param result Result object of the method being called
+     \param key Key of the list in the result object
+     \param list List producing the items
+
+     The result must not contain the key itself. Must only be called if
+     CanStream() returned true for the result.
+     */
+    static void SetStreamedList(const CVariant& result,
+                                const std::string& key,
+                                std::unique_ptr<IStreamedList> list);
+
+    /*!
+     \brief Moves a list of the result into a streamed list if the result can be streamed
+     \param result Result object of the method being called
+     \param key Key of the list in the result object
+
+     This doesn't save building the list, but the response is never written
+     as a whole and the items are released once they were sent.
+     */
+    static void StreamList(CVariant& result, const std::string& key);
+
+  private:
+    friend class CJSONRPC;
+
+    /*!
+     \brief Enables SetStreamedList() for the result of a method while it's
+     being called
+     */
+    class CMethodScope
+    {
+    public:
+      explicit CMethodScope(const CVariant& result);
+      ~CMethodScope();
+
+      const CVariant& m_result;
+      std::string m_key;
+      std::unique_ptr<IStreamedList> m_list;
+
+    private:
+      CMethodScope* m_previous;
+    };
+
+    void SetBatch() { m_batch = true; }
+    void AddResponse(const CVariant& response);
+    void AddResponse(CVariant response,
+                     const std::string& key,
+                     std::unique_ptr<IStreamedList> list);
+    void SetOutput(std::string output);
+
+    struct Response
+    {
+      std::string json; ///< whole response, or everything up to the streamed list
+      std::unique_ptr<IStreamedList> list;
+      std::string tail; ///< everything after the streamed list
+    };
+
+    bool ReadResponse(std::string& output);
+
+    static thread_local CMethodScope* m_currentScope;
+
+    std::vector<Response> m_responses;
+    bool m_batch = false;
+    size_t m_index = 0;
+    bool m_inList = false;
+    bool m_firstItem = true;
+    bool m_finished = false;
+  };
+}
@@ -437,6 +437,31 @@ JSONRPC_STATUS CPlayerOperations::SetAudioDelay(const std::string& method,
   }
 }
 
+JSONRPC_STATUS CPlayerOperations::GetRenderPacing(const std::string& method,
+                                                  ITransportLayer* transport,
+                                                  IClient* client,
+                                                  const CVariant& parameterObject,
+                                                  CVariant& result)
+{
+  switch (GetPlayer(parameterObject["playerid"]))
+  {
+    case Video:
+    {
+      auto& components = CServiceBroker::GetAppComponents();
+      const auto appPlayer = components.GetComponent<CApplicationPlayer>();
+      if (!appPlayer->GetRenderPacingStats(result, parameterObject["records"].asBoolean(),
+                                           parameterObject["reset"].asBoolean()))
+        return FailedToExecute;
+      return OK;
+    }
+    case Audio:
+    case Picture:
+    case None:
+    default:
+      return FailedToExecute;
+  }
+}
+
 JSONRPC_STATUS CPlayerOperations::SetSpeed(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
 {
   switch (GetPlayer(parameterObject["playerid"]))
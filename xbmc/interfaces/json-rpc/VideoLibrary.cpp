@@ -9,6 +9,7 @@
 #include "VideoLibrary.h"
 
 #include "FileItem.h"
+#include "JSONRPCResponse.h"
 #include "PVROperations.h"
 #include "ServiceBroker.h"
 #include "TextureDatabase.h"
@@ -24,10 +25,33 @@
 
 using namespace JSONRPC;
 
+namespace
+{
+/*!
+ \brief Movies of a streamed VideoLibrary.GetMovies response, read from the open query result
+ */
+class CMovieStreamedList : public IStreamedList
+{
+public:
+  CMovieStreamedList(std::unique_ptr<CVideoDatabase> database,
+                     std::unique_ptr<CVideoDatabase::CMovieJSONRows> rows)
+    : m_database(std::move(database)), m_rows(std::move(rows))
+  {
+  }
+
+  bool GetNextItem(CVariant& item) override { return m_rows->GetNext(item); }
+
+private:
+  // the rows are read through the connection of the database
+  std::unique_ptr<CVideoDatabase> m_database;
+  std::unique_ptr<CVideoDatabase::CMovieJSONRows> m_rows;
+};
+} // namespace
+
 JSONRPC_STATUS CVideoLibrary::GetMovies(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
 {
-  CVideoDatabase videodatabase;
-  if (!videodatabase.Open())
+  auto videodatabase = std::make_unique<CVideoDatabase>();
+  if (!videodatabase->Open())
     return InternalError;
 
   SortDescription sorting;
@@ -74,8 +98,56 @@ JSONRPC_STATUS CVideoLibrary::GetMovies(const std::string &method, ITransportLay
   if (setID < 0)
     setID = 0;
 
+  // fetch plain movie properties straight from the database without creating file items
+  std::set<std::string> fields;
+  if (parameterObject["properties"].isArray())
+  {
+    for (CVariant::const_iterator_array field = parameterObject["properties"].begin_array();
+         field != parameterObject["properties"].end_array(); ++field)
+      fields.insert(field->asString());
+  }
+
+  if (CVideoDatabase::CanGetMoviesByWhereJSON(fields))
+  {
+    if (genreID > 0)
+      videoUrl.AddOption("genreid", genreID);
+    else if (year > 0)
+      videoUrl.AddOption("year", year);
+    else if (setID > 0)
+      videoUrl.AddOption("setid", setID);
+
+    int total;
+    if (CJSONRPCResponse::CanStream(result))
+    {
+      // every movie is only created from the query result once it's being sent
+      std::unique_ptr<CVideoDatabase::CMovieJSONRows> rows;
+      if (!videodatabase->GetMoviesByWhereJSON(fields, videoUrl.ToString(), rows, total, sorting))
+        return InvalidParams;
+
+      int start, end;
+      HandleLimits(parameterObject, result, total, start, end);
+
+      if (rows)
+        CJSONRPCResponse::SetStreamedList(
+            result, "movies",
+            std::make_unique<CMovieStreamedList>(std::move(videodatabase), std::move(rows)));
+      else
+        result["movies"] = CVariant(CVariant::VariantTypeArray);
+
+      return OK;
+    }
+
+    if (!videodatabase->GetMoviesByWhereJSON(fields, videoUrl.ToString(), result, total, sorting))
+      return InvalidParams;
+
+    int start, end;
+    HandleLimits(parameterObject, result, total, start, end);
+
+    return OK;
+  }
+
   CFileItemList items;
-  if (!videodatabase.GetMoviesNav(videoUrl.ToString(), items, genreID, year, -1, -1, -1, -1, setID, -1, sorting, RequiresAdditionalDetails(MediaTypeMovie, parameterObject)))
+  if (!videodatabase->GetMoviesNav(videoUrl.ToString(), items, genreID, year, -1, -1, -1, -1, setID, -1, sorting, RequiresAdditionalDetails(MediaTypeMovie, parameterObject)))
     return InvalidParams;
 
   return HandleItems("movieid", "movies", items, parameterObject, result, false);
@@ -1138,7 +1210,7 @@ JSONRPC_STATUS CVideoLibrary::HandleItems(const char *idProperty, const char *re
   int size = items.Size();
   if (!limit && items.HasProperty("total") && items.GetProperty("total").asInteger() > size)
     size = (int)items.GetProperty("total").asInteger();
-  HandleFileItemList(idProperty, true, resultName, items, parameterObject, result, size, limit);
+  StreamFileItemList(idProperty, true, resultName, items, parameterObject, result, size, limit);
 
   return OK;
 }
@@ -0,0 +1,183 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "interfaces/json-rpc/IClient.h"
+#include "interfaces/json-rpc/ITransportLayer.h"
+#include "interfaces/json-rpc/JSONRPC.h"
+#include "interfaces/json-rpc/JSONRPCResponse.h"
+#include "interfaces/json-rpc/JSONServiceDescription.h"
+#include "utils/Variant.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace JSONRPC;
+
+namespace
+{
+class CTestTransportLayer : public ITransportLayer
+{
+public:
+  bool PrepareDownload(const char* path, CVariant& details, std::string& protocol) override
+  {
+    return false;
+  }
+  bool Download(const char* path, CVariant& result) override { return false; }
+  int GetCapabilities() override { return TRANSPORT_LAYER_CAPABILITY_ALL; }
+};
+
+class CTestClient : public IClient
+{
+public:
+  int GetPermissionFlags() override { return OPERATION_PERMISSION_ALL; }
+  int GetAnnouncementFlags() override { return 0; }
+  bool SetAnnouncementFlags(int flags) override { return false; }
+};
+
+// Returns "count" items next to other members, sorting before and after "items"
+JSONRPC_STATUS GetItems(const std::string& method,
+                        ITransportLayer* transport,
+                        IClient* client,
+                        const CVariant& parameterObject,
+                        CVariant& result)
+{
+  const int count = static_cast<int>(parameterObject["count"].asInteger());
+
+  result["comment"] = "before the items";
+  result["items"] = CVariant(CVariant::VariantTypeArray);
+  for (int i = 0; i < count; i++)
+  {
+    CVariant item;
+    item["id"] = i;
+    item["label"] = "item \"" + std::to_string(i) + "\"";
+    item["tags"].push_back("tag");
+    item["watched"] = i % 2 == 0;
+    result["items"].push_back(item);
+  }
+  result["limits"]["start"] = 0;
+  result["limits"]["end"] = count;
+  result["limits"]["total"] = count;
+
+  CJSONRPCResponse::StreamList(result, "items");
+
+  return OK;
+}
+
+const char* TestMethod = "\"Test.GetItems\": {"
+                         "\"type\": \"method\","
+                         "\"description\": \"Items for testing streamed responses\","
+                         "\"transport\": \"Response\","
+                         "\"permission\": \"ReadData\","
+                         "\"params\": ["
+                         "{ \"name\": \"count\", \"type\": \"integer\", \"default\": 3 }"
+                         "],"
+                         "\"returns\": { \"type\": \"object\" }"
+                         "}";
+} // namespace
+
+class TestJSONRPCResponse : public testing::Test
+{
+protected:
+  TestJSONRPCResponse()
+  {
+    CJSONRPC::Initialize();
+    CJSONServiceDescription::AddMethod(TestMethod, GetItems);
+  }
+
+  ~TestJSONRPCResponse() override { CJSONRPC::Cleanup(); }
+
+  std::string Call(const std::string& request)
+  {
+    return CJSONRPC::MethodCall(request, &m_transport, &m_client);
+  }
+
+  std::string CallStreamed(const std::string& request, size_t readSize, bool& streamed)
+  {
+    CJSONRPCResponse response;
+    CJSONRPC::MethodCall(request, &m_transport, &m_client, response);
+    streamed = response.IsStreamed();
+
+    std::string output;
+    while (response.Read(output, readSize))
+      ;
+
+    // nothing is left once the response has been read
+    EXPECT_FALSE(response.Read(output, readSize));
+    return output;
+  }
+
+  CTestTransportLayer m_transport;
+  CTestClient m_client;
+};
+
+TEST_F(TestJSONRPCResponse, SingleResponse)
+{
+  const std::string request =
+      R"({ "jsonrpc": "2.0", "method": "Test.GetItems", "params": { "count": 5 }, "id": 1 })";
+
+  bool streamed = false;
+  const std::string output = CallStreamed(request, std::string::npos, streamed);
+  EXPECT_TRUE(streamed);
+  EXPECT_EQ(Call(request), output);
+  EXPECT_NE(std::string::npos, output.find(R"("items":[{"id":0,)"));
+}
+
+TEST_F(TestJSONRPCResponse, EmptyList)
+{
+  const std::string request =
+      R"({ "jsonrpc": "2.0", "method": "Test.GetItems", "params": { "count": 0 }, "id": 1 })";
+
+  bool streamed = false;
+  const std::string output = CallStreamed(request, std::string::npos, streamed);
+  EXPECT_TRUE(streamed);
+  EXPECT_EQ(Call(request), output);
+  EXPECT_NE(std::string::npos, output.find(R"("items":[])"));
+}
+
+TEST_F(TestJSONRPCResponse, MixedBatch)
+{
+  // streamed and plain responses, a notification and an error
+  const std::string request =
+      R"([{ "jsonrpc": "2.0", "method": "Test.GetItems", "params": { "count": 2 }, "id": 1 },)"
+      R"({ "jsonrpc": "2.0", "method": "JSONRPC.Ping", "id": 2 },)"
+      R"({ "jsonrpc": "2.0", "method": "JSONRPC.Ping" },)"
+      R"({ "jsonrpc": "2.0", "method": "Test.Unknown", "id": 3 },)"
+      R"({ "jsonrpc": "2.0", "method": "Test.GetItems", "id": "four" }])";
+
+  bool streamed = false;
+  const std::string output = CallStreamed(request, std::string::npos, streamed);
+  EXPECT_TRUE(streamed);
+  EXPECT_EQ(Call(request), output);
+}
+
+TEST_F(TestJSONRPCResponse, NotificationsOnlyBatch)
+{
+  const std::string request = R"([{ "jsonrpc": "2.0", "method": "JSONRPC.Ping" },)"
+                              R"({ "jsonrpc": "2.0", "method": "Test.GetItems" }])";
+
+  bool streamed = true;
+  EXPECT_TRUE(CallStreamed(request, std::string::npos, streamed).empty());
+  EXPECT_FALSE(streamed);
+  EXPECT_TRUE(Call(request).empty());
+}
+
+TEST_F(TestJSONRPCResponse, SmallReads)
+{
+  const std::string request =
+      R"([{ "jsonrpc": "2.0", "method": "Test.GetItems", "params": { "count": 20 }, "id": 1 },)"
+      R"({ "jsonrpc": "2.0", "method": "JSONRPC.Ping", "id": 2 }])";
+  const std::string expected = Call(request);
+
+  for (size_t readSize : {1, 7, 64})
+  {
+    bool streamed = false;
+    EXPECT_EQ(expected, CallStreamed(request, readSize, streamed)) << "read size " << readSize;
+    EXPECT_TRUE(streamed);
+  }
+}
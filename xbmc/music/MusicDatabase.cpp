@@ -61,6 +61,7 @@
 #include "utils/XMLUtils.h"
 #include "utils/log.h"
 
+#include <cmath>
 #include <inttypes.h>
 
 using namespace XFILE;
@@ -1040,17 +1041,26 @@ int CMusicDatabase::AddSong(const int idSong,
 
     if (idSong <= 1)
     {
+      // Run for every scanned song, keep the statements prepared
+      bool found;
       if (!strMusicBrainzTrackID.empty())
-        strSQL = PrepareSQL("SELECT idSong FROM song WHERE "
-                            "idAlbum = %i AND iTrack=%i AND strMusicBrainzTrackID = '%s'",
-                            idAlbum, iTrack, strMusicBrainzTrackID.c_str());
+      {
+        strSQL = "SELECT idSong FROM song WHERE "
+                 "idAlbum = ? AND iTrack = ? AND strMusicBrainzTrackID = ?";
+        found = m_pDS->query(strSQL, {dbiplus::field_value(idAlbum), dbiplus::field_value(iTrack),
+                                      dbiplus::field_value(strMusicBrainzTrackID)});
+      }
       else
-        strSQL = PrepareSQL("SELECT idSong FROM song WHERE "
-                            "idAlbum=%i AND strFileName='%s' AND strTitle='%s' AND iTrack=%i "
-                            "AND strMusicBrainzTrackID IS NULL",
-                            idAlbum, strFileName.c_str(), strTitle.c_str(), iTrack);
+      {
+        strSQL = "SELECT idSong FROM song WHERE "
+                 "idAlbum = ? AND strFileName = ? AND strTitle = ? AND iTrack = ? "
+                 "AND strMusicBrainzTrackID IS NULL";
+        found = m_pDS->query(strSQL, {dbiplus::field_value(idAlbum),
+                                      dbiplus::field_value(strFileName),
+                                      dbiplus::field_value(strTitle), dbiplus::field_value(iTrack)});
+      }
 
-      if (!m_pDS->query(strSQL))
+      if (!found)
         return -1;
     }
     if (m_pDS->num_rows() == 0)
@@ -1081,42 +1091,66 @@ int CMusicDatabase::AddSong(const int idSong,
                "strDiscSubtitle, strFileName, dateAdded,  "
                "strMusicBrainzTrackID, strArtistSort, "
                "iTimesPlayed, iStartOffset, iEndOffset, "
-               "lastplayed, rating, userrating, votes, comment, mood, strReplayGain) ";
+               "lastplayed, rating, userrating, votes, comment, mood, strReplayGain) "
+               "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
+               "?, ?, ?, ?, ?)";
 
+      dbiplus::BindParams params;
+      params.reserve(29);
       if (idSong <= 0)
+      {
         // Song ID is autoincremented and dateNew set by trigger
-        strSQL += PrepareSQL("VALUES (NULL, NULL, ");
+        params.emplace_back(dbiplus::null_value());
+        params.emplace_back(dbiplus::null_value());
+      }
       else
+      {
         //Reuse song Id and original date when the Id added
-        strSQL += PrepareSQL("VALUES (%i, '%s', ", idSong, dtDateNew.GetAsDBDateTime().c_str());
-
-      strSQL +=
-          PrepareSQL("%i, %i, '%s', '%s', %i, %i, '%s', '%s', %i, %i, %i, %i,'%s', '%s', '%s' ",
-                     idAlbum, idPath, artistDisp.c_str(), strTitle.c_str(), iTrack, iDuration,
-                     strRelease.c_str(), strOriginal.c_str(), iBPM, iBitRate, iSampleRate,
-                     iChannels, strDiscSubtitle.c_str(), strFileName.c_str(), strDateMedia.c_str());
+        params.emplace_back(idSong);
+        params.emplace_back(dtDateNew.GetAsDBDateTime());
+      }
+
+      params.emplace_back(idAlbum);
+      params.emplace_back(idPath);
+      params.emplace_back(artistDisp);
+      params.emplace_back(strTitle);
+      params.emplace_back(iTrack);
+      params.emplace_back(iDuration);
+      params.emplace_back(strRelease);
+      params.emplace_back(strOriginal);
+      params.emplace_back(iBPM);
+      params.emplace_back(iBitRate);
+      params.emplace_back(iSampleRate);
+      params.emplace_back(iChannels);
+      params.emplace_back(strDiscSubtitle);
+      params.emplace_back(strFileName);
+      params.emplace_back(strDateMedia);
 
       if (strMusicBrainzTrackID.empty())
-        strSQL += PrepareSQL(",NULL");
+        params.emplace_back(dbiplus::null_value());
       else
-        strSQL += PrepareSQL(",'%s'", strMusicBrainzTrackID.c_str());
+        params.emplace_back(strMusicBrainzTrackID);
       if (artistSort.empty() || artistSort.compare(artistDisp) == 0)
-        strSQL += PrepareSQL(",NULL");
+        params.emplace_back(dbiplus::null_value());
       else
-        strSQL += PrepareSQL(",'%s'", artistSort.c_str());
+        params.emplace_back(artistSort);
 
+      params.emplace_back(iTimesPlayed);
+      params.emplace_back(iStartOffset);
+      params.emplace_back(iEndOffset);
       if (dtLastPlayed.IsValid())
-        strSQL += PrepareSQL(",%i,%i,%i,'%s', %.1f, %i, %i, '%s','%s', '%s')", //
-                             iTimesPlayed, iStartOffset, iEndOffset,
-                             dtLastPlayed.GetAsDBDateTime().c_str(), //
-                             static_cast<double>(rating), userrating, votes, //
-                             strComment.c_str(), strMood.c_str(), replayGain.Get().c_str());
+        params.emplace_back(dtLastPlayed.GetAsDBDateTime());
       else
-        strSQL += PrepareSQL(",%i,%i,%i,NULL, %.1f, %i, %i,'%s', '%s', '%s')", //
-                             iTimesPlayed, iStartOffset, iEndOffset, //
-                             static_cast<double>(rating), userrating, votes, //
-                             strComment.c_str(), strMood.c_str(), replayGain.Get().c_str());
-      m_pDS->exec(strSQL);
+        params.emplace_back(dbiplus::null_value());
+      // Stored with one decimal like the formatted statements do
+      params.emplace_back(std::round(static_cast<double>(rating) * 10.0) / 10.0);
+      params.emplace_back(userrating);
+      params.emplace_back(votes);
+      params.emplace_back(strComment);
+      params.emplace_back(strMood);
+      params.emplace_back(replayGain.Get());
+
+      m_pDS->exec(strSQL, params);
       if (idSong <= 0)
         idNew = (int)m_pDS->lastinsertid();
       else
@@ -2356,11 +2390,11 @@ bool CMusicDatabase::AddSongArtist(
 bool CMusicDatabase::AddSongArtist(
     int idArtist, int idSong, int idRole, const std::string& strArtist, int iOrder)
 {
-  std::string strSQL;
-  strSQL = PrepareSQL("REPLACE INTO song_artist (idArtist, idSong, idRole, strArtist, iOrder) "
-                      "VALUES(%i, %i, %i,'%s', %i)",
-                      idArtist, idSong, idRole, strArtist.c_str(), iOrder);
-  return ExecuteQuery(strSQL);
+  return ExecuteQuery("REPLACE INTO song_artist (idArtist, idSong, idRole, strArtist, iOrder) "
+                      "VALUES(?, ?, ?, ?, ?)",
+                      {dbiplus::field_value(idArtist), dbiplus::field_value(idSong),
+                       dbiplus::field_value(idRole), dbiplus::field_value(strArtist),
+                       dbiplus::field_value(iOrder)});
 }
 
 int CMusicDatabase::AddSongContributor(int idSong,
@@ -2542,9 +2576,9 @@ bool CMusicDatabase::AddSongGenres(int idSong, const std::vector<std::string>& g
     for (auto& strGenre : modgenres)
     {
       int idGenre = AddGenre(strGenre); // Genre string trimmed and matched case-insensitively
-      strSQL = PrepareSQL("INSERT INTO song_genre (idGenre, idSong, iOrder) VALUES(%i,%i,%i)",
-                          idGenre, idSong, index++);
-      if (!ExecuteQuery(strSQL))
+      strSQL = "INSERT INTO song_genre (idGenre, idSong, iOrder) VALUES(?, ?, ?)";
+      if (!ExecuteQuery(strSQL, {dbiplus::field_value(idGenre), dbiplus::field_value(idSong),
+                                 dbiplus::field_value(index++)}))
         return false;
     }
     // Update concatenated genre string from the standardised genre values
@@ -2912,16 +2946,14 @@ int CMusicDatabase::AddPath(const std::string& strPath1)
     if (it != m_pathCache.end())
       return it->second;
 
-    strSQL = PrepareSQL("SELECT * FROM path WHERE strPath='%s'", strPath.c_str());
-    m_pDS->query(strSQL);
+    strSQL = "SELECT * FROM path WHERE strPath = ?";
+    m_pDS->query(strSQL, {dbiplus::field_value(strPath)});
     if (m_pDS->num_rows() == 0)
     {
       m_pDS->close();
       // doesn't exists, add it
-      strSQL = PrepareSQL("INSERT INTO path (idPath, strPath) "
-                          "VALUES(NULL, '%s')",
-                          strPath.c_str());
-      m_pDS->exec(strSQL);
+      strSQL = "INSERT INTO path (idPath, strPath) VALUES(NULL, ?)";
+      m_pDS->exec(strSQL, {dbiplus::field_value(strPath)});
 
       int idPath = (int)m_pDS->lastinsertid();
       m_pathCache.insert(std::pair<std::string, int>(strPath, idPath));
@@ -7630,10 +7662,11 @@ static const size_t NUM_SONG_FIELDS = sizeof(JSONtoDBSong) / sizeof(translateJSO
 bool CMusicDatabase::GetSongsByWhereJSON(
     const std::set<std::string>& fields,
     const std::string& baseDir,
-    CVariant& result,
+    std::unique_ptr<CSongJSONRows>& rows,
     int& total,
     const SortDescription& sortDescription /* = SortDescription() */)
 {
+  rows.reset();
 
   if (nullptr == m_pDB)
     return false;
@@ -7982,7 +8015,9 @@ bool CMusicDatabase::GetSongsByWhereJSON(
     // Run query
     auto start = std::chrono::steady_clock::now();
 
-    if (!m_pDS->query(strSQL))
+    // the rows are read while the songs are handed out, so they need their own dataset
+    std::unique_ptr<dbiplus::Dataset> pDS(m_pDB->CreateDataset());
+    if (!pDS->query(strSQL))
       return false;
 
     auto end = std::chrono::steady_clock::now();
@@ -7990,231 +8025,283 @@ bool CMusicDatabase::GetSongsByWhereJSON(
 
     CLog::Log(LOGDEBUG, "{} - query took {} ms", __FUNCTION__, duration.count());
 
-    int iRowsFound = m_pDS->num_rows();
-    if (iRowsFound <= 0)
-    {
-      m_pDS->close();
+    if (pDS->num_rows() <= 0)
       return true;
+
+    rows.reset(new CSongJSONRows(std::move(pDS), std::move(joinLayout)));
+    rows->m_dbfieldindex = std::move(dbfieldindex);
+    rows->m_rolefieldlist = std::move(rolefieldlist);
+    rows->m_roleidlist = std::move(roleidlist);
+    rows->m_joinAlbumArtist = bJoinAlbumArtist;
+    rows->m_joinSongArtist = bJoinSongArtist;
+    rows->m_joinRole = bJoinRole;
+    rows->m_resultCount = resultcount;
+
+    // Ensure random order of output when results set is sorted to process multi-value joins
+    if (sortDescription.sortBy == SortByRandom && rows->m_joinLayout.HasFilterFields())
+    {
+      std::vector<CVariant> songs;
+      songs.reserve(resultcount);
+      CVariant song;
+      while (rows->GetNext(song))
+        songs.push_back(std::move(song));
+      if (rows->m_failed)
+        return false;
+
+      KODI::UTILS::RandomShuffle(songs.begin(), songs.end());
+      rows->m_pDS->close();
+      rows->m_shuffled = std::move(songs);
+      rows->m_isShuffled = true;
     }
 
+    return true;
+  }
+  catch (...)
+  {
+    rows.reset();
+    CLog::Log(LOGERROR, "{} failed", __FUNCTION__);
+  }
+  return false;
+}
+
+bool CMusicDatabase::GetSongsByWhereJSON(
+    const std::set<std::string>& fields,
+    const std::string& baseDir,
+    CVariant& result,
+    int& total,
+    const SortDescription& sortDescription /* = SortDescription() */)
+{
+  std::unique_ptr<CSongJSONRows> rows;
+  if (!GetSongsByWhereJSON(fields, baseDir, rows, total, sortDescription))
+    return false;
+
+  if (!rows)
+    return true;
+
+  CVariant& songs = result["songs"];
+  songs.reserve(rows->m_resultCount);
+  CVariant song;
+  while (rows->GetNext(song))
+    songs.push_back(std::move(song));
+
+  return !rows->m_failed;
+}
+
+CMusicDatabase::CSongJSONRows::CSongJSONRows(std::unique_ptr<dbiplus::Dataset> pDS,
+                                             DatasetLayout joinLayout)
+  : m_pDS(std::move(pDS)), m_joinLayout(std::move(joinLayout))
+{
+}
+
+CMusicDatabase::CSongJSONRows::~CSongJSONRows()
+{
+  m_pDS->close();
+}
+
+bool CMusicDatabase::CSongJSONRows::GetNext(CVariant& songObj)
+{
+  if (m_isShuffled)
+  {
+    if (m_next >= m_shuffled.size())
+      return false;
+
+    songObj = std::move(m_shuffled[m_next++]);
+    return true;
+  }
+
+  if (m_failed || m_pDS->eof())
+    return false;
+
+  try
+  {
     // Get song from returned rows. Joins mean there can be many rows per song
-    int songId = -1;
+    const dbiplus::sql_record* record = m_pDS->get_sql_record();
+    const int songId = record->at(0).get_asInt();
     int albumartistId = -1;
     int artistId = -1;
     int roleId = -1;
     bool bSongGenreDone(false);
     bool bSongArtistDone(false);
-    bool bHaveSong(false);
-    CVariant songObj;
-    result["songs"].reserve(resultcount);
-    while (!m_pDS->eof() || bHaveSong)
-    {
-      const dbiplus::sql_record* const record = m_pDS->get_sql_record();
 
-      if (m_pDS->eof() || songId != record->at(0).get_asInt())
-      {
-        // Store previous or last song
-        if (bHaveSong)
-        {
-          // Check empty role fields get returned, and format
-          if (!rolefieldlist.empty())
-          {
-            for (const auto& displayXXX : rolefieldlist)
-            {
-              if (!StringUtils::StartsWith(displayXXX, "display"))
-              {
-                // "contributors"
-                if (!songObj.isMember(displayXXX))
-                  songObj[displayXXX] = CVariant(CVariant::VariantTypeArray);
-              }
-              else if (songObj.isMember(displayXXX) && songObj[displayXXX].isArray())
-              {
-                // Convert "displaycomposer", "displayconductor", "displayorchestra",
-                // and "displaylyricist" arrays into strings
-                std::vector<std::string> names;
-                for (CVariant::const_iterator_array field = songObj[displayXXX].begin_array();
-                     field != songObj[displayXXX].end_array(); ++field)
-                  names.emplace_back(field->asString());
-
-                std::string role = StringUtils::Join(names, CServiceBroker::GetSettingsComponent()
-                                                                ->GetAdvancedSettings()
-                                                                ->m_musicItemSeparator);
-                songObj[displayXXX] = role;
-              }
-              else
-                songObj[displayXXX] = "";
-            }
-          }
-          result["songs"].append(songObj);
-          bHaveSong = false;
-          songObj.clear();
-        }
-        if (songObj.empty())
-        {
-          // Initialise fields, ensure those with possible null values are set to correct empty variant type
-          if (joinLayout.GetOutput(joinToSongs_idGenre))
-            songObj["genreid"] =
-                CVariant(CVariant::VariantTypeArray); //"genre" set [] by split of array
+    // Initialise fields, ensure those with possible null values are set to correct empty variant type
+    songObj = CVariant(CVariant::VariantTypeObject);
+    if (m_joinLayout.GetOutput(joinToSongs_idGenre))
+      songObj["genreid"] = CVariant(CVariant::VariantTypeArray); //"genre" set [] by split of array
 
-          albumartistId = -1;
-          artistId = -1;
-          roleId = -1;
-          bSongGenreDone = false;
-          bSongArtistDone = false;
-        }
-        if (m_pDS->eof())
-          continue; // Having saved the last song stop
+    songObj["songid"] = songId;
+    songObj["label"] = record->at(1).get_asString();
+    for (size_t i = 0; i < m_dbfieldindex.size(); i++)
+      if (m_dbfieldindex[i] > -1)
+      {
+        if (JSONtoDBSong[m_dbfieldindex[i]].formatJSON == "integer")
+          songObj[JSONtoDBSong[m_dbfieldindex[i]].fieldJSON] = record->at(1 + i).get_asInt();
+        else if (JSONtoDBSong[m_dbfieldindex[i]].formatJSON == "unsigned")
+          songObj[JSONtoDBSong[m_dbfieldindex[i]].fieldJSON] =
+              std::max(record->at(1 + i).get_asInt(), 0);
+        else if (JSONtoDBSong[m_dbfieldindex[i]].formatJSON == "float")
+          songObj[JSONtoDBSong[m_dbfieldindex[i]].fieldJSON] =
+              std::max(record->at(1 + i).get_asFloat(), 0.f);
+        else if (JSONtoDBSong[m_dbfieldindex[i]].formatJSON == "array")
+          songObj[JSONtoDBSong[m_dbfieldindex[i]].fieldJSON] = StringUtils::Split(
+              record->at(1 + i).get_asString(), CServiceBroker::GetSettingsComponent()
+                                                    ->GetAdvancedSettings()
+                                                    ->m_musicItemSeparator);
+        else if (JSONtoDBSong[m_dbfieldindex[i]].formatJSON == "boolean")
+          songObj[JSONtoDBSong[m_dbfieldindex[i]].fieldJSON] = record->at(1 + i).get_asBool();
+        else
+          songObj[JSONtoDBSong[m_dbfieldindex[i]].fieldJSON] = record->at(1 + i).get_asString();
+      }
 
-        // New song
-        songId = record->at(0).get_asInt();
-        bHaveSong = true;
-        songObj["songid"] = songId;
-        songObj["label"] = record->at(1).get_asString();
-        for (size_t i = 0; i < dbfieldindex.size(); i++)
-          if (dbfieldindex[i] > -1)
-          {
-            if (JSONtoDBSong[dbfieldindex[i]].formatJSON == "integer")
-              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] = record->at(1 + i).get_asInt();
-            else if (JSONtoDBSong[dbfieldindex[i]].formatJSON == "unsigned")
-              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] =
-                  std::max(record->at(1 + i).get_asInt(), 0);
-            else if (JSONtoDBSong[dbfieldindex[i]].formatJSON == "float")
-              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] =
-                  std::max(record->at(1 + i).get_asFloat(), 0.f);
-            else if (JSONtoDBSong[dbfieldindex[i]].formatJSON == "array")
-              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] = StringUtils::Split(
-                  record->at(1 + i).get_asString(), CServiceBroker::GetSettingsComponent()
-                                                        ->GetAdvancedSettings()
-                                                        ->m_musicItemSeparator);
-            else if (JSONtoDBSong[dbfieldindex[i]].formatJSON == "boolean")
-              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] = record->at(1 + i).get_asBool();
-            else
-              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] = record->at(1 + i).get_asString();
-          }
+    // Split sources string into int array
+    if (songObj.isMember("sourceid"))
+    {
+      std::vector<std::string> sources = StringUtils::Split(songObj["sourceid"].asString(), ";");
+      songObj["sourceid"] = CVariant(CVariant::VariantTypeArray);
+      for (size_t i = 0; i < sources.size(); i++)
+        songObj["sourceid"].append(atoi(sources[i].c_str()));
+    }
 
-        // Split sources string into int array
-        if (songObj.isMember("sourceid"))
-        {
-          std::vector<std::string> sources =
-              StringUtils::Split(songObj["sourceid"].asString(), ";");
-          songObj["sourceid"] = CVariant(CVariant::VariantTypeArray);
-          for (size_t i = 0; i < sources.size(); i++)
-            songObj["sourceid"].append(atoi(sources[i].c_str()));
-        }
-      }
+    while (!m_pDS->eof())
+    {
+      record = m_pDS->get_sql_record();
+      if (record->at(0).get_asInt() != songId)
+        break;
 
-      if (bJoinAlbumArtist)
+      if (m_joinAlbumArtist)
       {
-        if (albumartistId != record->at(joinLayout.GetRecNo(joinToSongs_idAlbumArtist)).get_asInt())
+        if (albumartistId != record->at(m_joinLayout.GetRecNo(joinToSongs_idAlbumArtist)).get_asInt())
         {
           bSongGenreDone =
               bSongGenreDone || (albumartistId > 0); // Not first album artist, skip genre
           bSongArtistDone =
               bSongArtistDone || (albumartistId > 0); // Not first album artist, skip song artists
-          albumartistId = record->at(joinLayout.GetRecNo(joinToSongs_idAlbumArtist)).get_asInt();
-          if (joinLayout.GetOutput(joinToSongs_idAlbumArtist))
+          albumartistId = record->at(m_joinLayout.GetRecNo(joinToSongs_idAlbumArtist)).get_asInt();
+          if (m_joinLayout.GetOutput(joinToSongs_idAlbumArtist))
             songObj["albumartistid"].append(albumartistId);
           if (albumartistId == BLANKARTIST_ID)
           {
-            if (joinLayout.GetOutput(joinToSongs_strAlbumArtist))
+            if (m_joinLayout.GetOutput(joinToSongs_strAlbumArtist))
               songObj["albumartist"].append(StringUtils::Empty);
-            if (joinLayout.GetOutput(joinToSongs_strAlbumArtistMBID))
+            if (m_joinLayout.GetOutput(joinToSongs_strAlbumArtistMBID))
               songObj["musicbrainzalbumartistid"].append(StringUtils::Empty);
           }
           else
           {
-            if (joinLayout.GetOutput(joinToSongs_idAlbumArtist))
+            if (m_joinLayout.GetOutput(joinToSongs_idAlbumArtist))
               songObj["albumartistid"].append(albumartistId);
-            if (joinLayout.GetOutput(joinToSongs_strAlbumArtist))
+            if (m_joinLayout.GetOutput(joinToSongs_strAlbumArtist))
               songObj["albumartist"].append(
-                  record->at(joinLayout.GetRecNo(joinToSongs_strAlbumArtist)).get_asString());
-            if (joinLayout.GetOutput(joinToSongs_strAlbumArtistMBID))
+                  record->at(m_joinLayout.GetRecNo(joinToSongs_strAlbumArtist)).get_asString());
+            if (m_joinLayout.GetOutput(joinToSongs_strAlbumArtistMBID))
               songObj["musicbrainzalbumartistid"].append(
-                  record->at(joinLayout.GetRecNo(joinToSongs_strAlbumArtistMBID)).get_asString());
+                  record->at(m_joinLayout.GetRecNo(joinToSongs_strAlbumArtistMBID)).get_asString());
           }
         }
       }
-      if (bJoinSongArtist && !bSongArtistDone)
+      if (m_joinSongArtist && !bSongArtistDone)
       {
-        if (artistId != record->at(joinLayout.GetRecNo(joinToSongs_idArtist)).get_asInt())
+        if (artistId != record->at(m_joinLayout.GetRecNo(joinToSongs_idArtist)).get_asInt())
         {
           bSongGenreDone = bSongGenreDone || (artistId > 0); // Not first artist, skip genre
           roleId = -1; // Allow for many artists same role
-          artistId = record->at(joinLayout.GetRecNo(joinToSongs_idArtist)).get_asInt();
-          if (joinLayout.GetRecNo(joinToSongs_idRole) < 0 ||
-              record->at(joinLayout.GetRecNo(joinToSongs_idRole)).get_asInt() == 1)
+          artistId = record->at(m_joinLayout.GetRecNo(joinToSongs_idArtist)).get_asInt();
+          if (m_joinLayout.GetRecNo(joinToSongs_idRole) < 0 ||
+              record->at(m_joinLayout.GetRecNo(joinToSongs_idRole)).get_asInt() == 1)
           {
-            if (joinLayout.GetOutput(joinToSongs_idArtist))
+            if (m_joinLayout.GetOutput(joinToSongs_idArtist))
               songObj["artistid"].append(artistId);
             if (artistId == BLANKARTIST_ID)
             {
-              if (joinLayout.GetOutput(joinToSongs_strArtist))
+              if (m_joinLayout.GetOutput(joinToSongs_strArtist))
                 songObj["artist"].append(StringUtils::Empty);
-              if (joinLayout.GetOutput(joinToSongs_strArtistMBID))
+              if (m_joinLayout.GetOutput(joinToSongs_strArtistMBID))
                 songObj["musicbrainzartistid"].append(StringUtils::Empty);
             }
             else
             {
-              if (joinLayout.GetOutput(joinToSongs_strArtist))
+              if (m_joinLayout.GetOutput(joinToSongs_strArtist))
                 songObj["artist"].append(
-                    record->at(joinLayout.GetRecNo(joinToSongs_strArtist)).get_asString());
-              if (joinLayout.GetOutput(joinToSongs_strArtistMBID))
+                    record->at(m_joinLayout.GetRecNo(joinToSongs_strArtist)).get_asString());
+              if (m_joinLayout.GetOutput(joinToSongs_strArtistMBID))
                 songObj["musicbrainzartistid"].append(
-                    record->at(joinLayout.GetRecNo(joinToSongs_strArtistMBID)).get_asString());
+                    record->at(m_joinLayout.GetRecNo(joinToSongs_strArtistMBID)).get_asString());
             }
           }
         }
-        if (joinLayout.GetRecNo(joinToSongs_idRole) > 0 &&
-            roleId != record->at(joinLayout.GetRecNo(joinToSongs_idRole)).get_asInt())
+        if (m_joinLayout.GetRecNo(joinToSongs_idRole) > 0 &&
+            roleId != record->at(m_joinLayout.GetRecNo(joinToSongs_idRole)).get_asInt())
         {
           bSongGenreDone = bSongGenreDone || (roleId > 0); // Not first role, skip genre
-          roleId = record->at(joinLayout.GetRecNo(joinToSongs_idRole)).get_asInt();
+          roleId = record->at(m_joinLayout.GetRecNo(joinToSongs_idRole)).get_asInt();
           if (roleId > 1)
           {
-            if (bJoinRole)
+            if (m_joinRole)
             { //Contributors
               CVariant contributor;
               contributor["name"] =
-                  record->at(joinLayout.GetRecNo(joinToSongs_strArtist)).get_asString();
+                  record->at(m_joinLayout.GetRecNo(joinToSongs_strArtist)).get_asString();
               contributor["role"] =
-                  record->at(joinLayout.GetRecNo(joinToSongs_strRole)).get_asString();
+                  record->at(m_joinLayout.GetRecNo(joinToSongs_strRole)).get_asString();
               contributor["roleid"] = roleId;
               contributor["artistid"] =
-                  record->at(joinLayout.GetRecNo(joinToSongs_idArtist)).get_asInt();
+                  record->at(m_joinLayout.GetRecNo(joinToSongs_idArtist)).get_asInt();
               songObj["contributors"].append(contributor);
             }
             // "displaycomposer", "displayconductor" etc.
-            for (size_t i = 0; i < roleidlist.size(); i++)
+            for (size_t i = 0; i < m_roleidlist.size(); i++)
             {
-              if (roleidlist[i] == roleId)
+              if (m_roleidlist[i] == roleId)
               {
-                songObj[rolefieldlist[i]].append(
-                    record->at(joinLayout.GetRecNo(joinToSongs_strArtist)).get_asString());
+                songObj[m_rolefieldlist[i]].append(
+                    record->at(m_joinLayout.GetRecNo(joinToSongs_strArtist)).get_asString());
                 continue;
               }
             }
           }
         }
       }
-      if (!bSongGenreDone && joinLayout.GetRecNo(joinToSongs_idGenre) > -1 &&
-          !record->at(joinLayout.GetRecNo(joinToSongs_idGenre)).get_isNull())
+      if (!bSongGenreDone && m_joinLayout.GetRecNo(joinToSongs_idGenre) > -1 &&
+          !record->at(m_joinLayout.GetRecNo(joinToSongs_idGenre)).get_isNull())
       {
-        songObj["genreid"].append(record->at(joinLayout.GetRecNo(joinToSongs_idGenre)).get_asInt());
+        songObj["genreid"].append(record->at(m_joinLayout.GetRecNo(joinToSongs_idGenre)).get_asInt());
       }
       m_pDS->next();
     }
-    m_pDS->close(); // cleanup recordset data
 
-    // Ensure random order of output when results set is sorted to process multi-value joins
-    if (sortDescription.sortBy == SortByRandom && joinLayout.HasFilterFields())
-      KODI::UTILS::RandomShuffle(result["songs"].begin_array(), result["songs"].end_array());
+    // Check empty role fields get returned, and format
+    for (const auto& displayXXX : m_rolefieldlist)
+    {
+      if (!StringUtils::StartsWith(displayXXX, "display"))
+      {
+        // "contributors"
+        if (!songObj.isMember(displayXXX))
+          songObj[displayXXX] = CVariant(CVariant::VariantTypeArray);
+      }
+      else if (songObj.isMember(displayXXX) && songObj[displayXXX].isArray())
+      {
+        // Convert "displaycomposer", "displayconductor", "displayorchestra",
+        // and "displaylyricist" arrays into strings
+        std::vector<std::string> names;
+        for (CVariant::const_iterator_array field = songObj[displayXXX].begin_array();
+             field != songObj[displayXXX].end_array(); ++field)
+          names.emplace_back(field->asString());
+
+        std::string role = StringUtils::Join(
+            names,
+            CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_musicItemSeparator);
+        songObj[displayXXX] = role;
+      }
+      else
+        songObj[displayXXX] = "";
+    }
 
     return true;
   }
   catch (...)
   {
+    m_failed = true;
     m_pDS->close();
-    CLog::Log(LOGERROR, "{} failed", __FUNCTION__);
+    CLog::Log(LOGERROR, "CMusicDatabase::CSongJSONRows::{} failed", __FUNCTION__);
   }
   return false;
 }
@@ -674,6 +674,55 @@ public:
                            int& total,
                            const SortDescription& sortDescription = SortDescription());
 
+  /*!
+   \brief Songs found by GetSongsByWhereJSON(), each one is only created from the result rows
+   when it's asked for
+   */
+  class CSongJSONRows
+  {
+  public:
+    ~CSongJSONRows();
+    CSongJSONRows(const CSongJSONRows&) = delete;
+    CSongJSONRows& operator=(const CSongJSONRows&) = delete;
+
+    /*!
+     \brief Get the next song
+     \return False if there are no more songs or reading them failed
+     */
+    bool GetNext(CVariant& song);
+
+  private:
+    friend class CMusicDatabase;
+
+    CSongJSONRows(std::unique_ptr<dbiplus::Dataset> pDS, DatasetLayout joinLayout);
+
+    std::unique_ptr<dbiplus::Dataset> m_pDS;
+    DatasetLayout m_joinLayout;
+    std::vector<int> m_dbfieldindex;
+    std::vector<std::string> m_rolefieldlist;
+    std::vector<int> m_roleidlist;
+    bool m_joinAlbumArtist = false;
+    bool m_joinSongArtist = false;
+    bool m_joinRole = false;
+    size_t m_resultCount = 0;
+    bool m_failed = false;
+
+    // random order with multi-value joins can only be established once all songs are read
+    bool m_isShuffled = false;
+    std::vector<CVariant> m_shuffled;
+    size_t m_next = 0;
+  };
+
+  /*!
+   \brief Runs the query of GetSongsByWhereJSON() but leaves reading the songs to the caller
+   \param rows Receives the songs, stays empty if none were found. Must not outlive the database
+   */
+  bool GetSongsByWhereJSON(const std::set<std::string>& fields,
+                           const std::string& baseDir,
+                           std::unique_ptr<CSongJSONRows>& rows,
+                           int& total,
+                           const SortDescription& sortDescription = SortDescription());
+
   /////////////////////////////////////////////////
   // Scraper
   /////////////////////////////////////////////////
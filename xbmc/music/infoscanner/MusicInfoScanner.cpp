@@ -44,15 +44,21 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
 #include "utils/Digest.h"
 #include "utils/FileExtensionProvider.h"
 #include "utils/FileUtils.h"
+#include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <utility>
 
 using namespace MUSIC_INFO;
@@ -565,13 +571,13 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
 CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
                                                    CFileItemList& scannedItems)
 {
-  std::vector<std::string> regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromScanRegExps;
+  const std::shared_ptr<CAdvancedSettings> advancedSettings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  std::vector<std::string> regexps = advancedSettings->m_audioExcludeFromScanRegExps;
 
+  std::vector<CFileItemPtr> files;
   for (int i = 0; i < items.Size(); ++i)
   {
-    if (m_bStop)
-      return INFO_CANCELLED;
-
     CFileItemPtr pItem = items[i];
 
     if (CUtil::ExcludeFileOrFolder(pItem->GetPath(), regexps))
@@ -580,15 +586,25 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
     if (pItem->m_bIsFolder || pItem->IsPlayList() || pItem->IsPicture() || pItem->IsLyrics())
       continue;
 
+    files.push_back(pItem);
+  }
+
+  // reading tags is mostly waiting for the source, overlap the requests
+  const unsigned int threads = static_cast<unsigned int>(
+      std::min<size_t>(advancedSettings->m_iMusicLibraryTagReaderThreads, files.size()));
+  if (threads > 1)
+    LoadTags(files, threads);
+
+  for (const auto& pItem : files)
+  {
+    if (m_bStop)
+      return INFO_CANCELLED;
+
     m_currentItem++;
 
     CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
-    if (!tag.Loaded())
-    {
-      std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(*pItem));
-      if (nullptr != pLoader)
-        pLoader->Load(pItem->GetPath(), tag);
-    }
+    if (threads <= 1 && !tag.Loaded())
+      LoadTag(*pItem);
 
     if (m_handle && m_itemCount>0)
       m_handle->SetPercentage(static_cast<float>(m_currentItem * 100) / static_cast<float>(m_itemCount));
@@ -612,6 +628,74 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
   return INFO_ADDED;
 }
 
+void CMusicInfoScanner::LoadTag(CFileItem& item)
+{
+  CMusicInfoTag& tag = *item.GetMusicInfoTag();
+  std::unique_ptr<IMusicInfoTagLoader> pLoader(CMusicInfoTagLoaderFactory::CreateLoader(item));
+  if (nullptr != pLoader)
+    pLoader->Load(item.GetPath(), tag);
+}
+
+void CMusicInfoScanner::LoadTags(const std::vector<CFileItemPtr>& items, unsigned int threads)
+{
+  struct CReaderState
+  {
+    CCriticalSection section;
+    XbmcThreads::ConditionVariable condition;
+    std::atomic<size_t> next{0};
+    unsigned int running = 0;
+    unsigned int finished = 0;
+    bool cancelled = false;
+  };
+  auto state = std::make_shared<CReaderState>();
+
+  CJobQueue readers(false, threads, CJob::PRIORITY_DEDICATED);
+  for (unsigned int i = 0; i < threads; ++i)
+  {
+    // every reader takes the next file that hasn't been claimed yet, so a few slow
+    // files don't hold up the others
+    readers.Submit([this, &items, state]() {
+      {
+        std::unique_lock<CCriticalSection> lock(state->section);
+        if (state->cancelled)
+          return;
+        state->running++;
+      }
+
+      size_t index;
+      while (!m_bStop && (index = state->next++) < items.size())
+      {
+        CFileItem& item = *items[index];
+        if (!item.GetMusicInfoTag()->Loaded())
+          LoadTag(item);
+      }
+
+      {
+        std::unique_lock<CCriticalSection> lock(state->section);
+        state->running--;
+        state->finished++;
+      }
+      state->condition.notifyAll();
+    });
+  }
+
+  {
+    std::unique_lock<CCriticalSection> lock(state->section);
+    // the queue stops processing if its jobs get cancelled, e.g. on shutdown
+    while (state->finished < threads && !m_bStop && readers.IsProcessing())
+      state->condition.wait(lock, std::chrono::milliseconds(100));
+
+    // readers that haven't started yet won't run anymore
+    state->cancelled = true;
+  }
+  readers.CancelJobs();
+
+  // the running readers use items and this scanner, they have to be done before we return
+  std::unique_lock<CCriticalSection> lock(state->section);
+  while (state->running > 0)
+    state->condition.wait(lock, std::chrono::milliseconds(100));
+}
+
 static bool SortSongsByTrack(const CSong& song, const CSong& song2)
 {
   return song.iTrack < song2.iTrack;
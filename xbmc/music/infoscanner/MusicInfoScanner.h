@@ -16,8 +16,12 @@
 #include "threads/Thread.h"
 #include "utils/ScraperUrl.h"
 
+#include <memory>
+#include <vector>
+
 class CAlbum;
 class CArtist;
+class CFileItem;
 class CGUIDialogProgressBarHandle;
 
 namespace MUSIC_INFO
@@ -231,6 +235,18 @@ protected:
    \param scannedItems [in] list to populate with the scannedItems
    */
   INFO_RET ScanTags(const CFileItemList& items, CFileItemList& scannedItems);
+
+  /*! \brief Read the tag of a file with the matching tag loader
+   \param item [in/out] the file, its music info tag is filled in
+   */
+  static void LoadTag(CFileItem& item);
+
+  /*! \brief Read the tags of several files concurrently
+   Returns once all tags are read or the scan was stopped.
+   \param items [in/out] the files, their music info tags are filled in
+   \param threads number of files read at once
+   */
+  void LoadTags(const std::vector<std::shared_ptr<CFileItem>>& items, unsigned int threads);
   int GetPathHash(const CFileItemList &items, std::string &hash);
 
   void Run() override;
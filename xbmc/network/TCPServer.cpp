@@ -11,6 +11,7 @@
 #include "ServiceBroker.h"
 #include "interfaces/AnnouncementManager.h"
 #include "interfaces/json-rpc/JSONRPC.h"
+#include "interfaces/json-rpc/JSONRPCResponse.h"
 #include "network/Network.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
@@ -58,6 +59,7 @@ using namespace JSONRPC;
 namespace
 {
 constexpr size_t maxBufferLength = 64 * 1024;
+constexpr size_t responseChunkSize = 64 * 1024;
 }
 
 CTCPServer *CTCPServer::ServerInstance = NULL;
@@ -551,6 +553,17 @@ void CTCPServer::CTCPClient::Send(const char *data, unsigned int size)
   } while (sent < size);
 }
 
+void CTCPServer::CTCPClient::SendResponse(CJSONRPCResponse& response)
+{
+  // send large responses as they are written instead of as a whole
+  std::string data;
+  while (response.Read(data, responseChunkSize))
+  {
+    Send(data.c_str(), data.size());
+    data.clear();
+  }
+}
+
 void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
 {
   m_new = false;
@@ -614,8 +627,9 @@ void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, in
       }
       if (m_beginBrackets > 0 && m_endBrackets > 0 && m_beginBrackets == m_endBrackets)
       {
-        std::string line = CJSONRPC::MethodCall(m_buffer, host, this);
-        Send(line.c_str(), line.size());
+        CJSONRPCResponse response;
+        CJSONRPC::MethodCall(m_buffer, host, this, response);
+        SendResponse(response);
         m_beginChar = m_beginBrackets = m_endBrackets = 0;
         m_buffer.clear();
       }
@@ -695,6 +709,14 @@ void CTCPServer::CWebSocketClient::Send(const char *data, unsigned int size)
     CTCPClient::Send(frames.at(index)->GetFrameData(), (unsigned int)frames.at(index)->GetFrameLength());
 }
 
+void CTCPServer::CWebSocketClient::SendResponse(CJSONRPCResponse& response)
+{
+  // a websocket message has to be sent in one piece
+  std::string data;
+  if (response.Read(data, std::string::npos))
+    Send(data.c_str(), data.size());
+}
+
 void CTCPServer::CWebSocketClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
 {
   bool send;
@@ -14,9 +14,11 @@
 #include "filesystem/File.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/FileUtils.h"
+#include "utils/JobManager.h"
 #include "utils/Mime.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -28,6 +30,7 @@
 #include <mutex>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 #if defined(TARGET_POSIX)
 #include <pthread.h>
@@ -37,6 +40,8 @@
 
 #define MAX_POST_BUFFER_SIZE 2048
 
+#define READ_AHEAD_SIZE (64 * 1024)
+
 #define PAGE_FILE_NOT_FOUND \
   "<html><head><title>File not found</title></head><body>File not found</body></html>"
 #define NOT_SUPPORTED \
@@ -47,6 +52,13 @@
 
 #define HEADER_NEWLINE "\r\n"
 
+typedef struct
+{
+  std::vector<char> buffer;
+  uint64_t position = 0; // position of the buffered data in the file
+  bool failed = false;
+} HttpFileReadAhead;
+
 typedef struct
 {
   std::shared_ptr<XFILE::CFile> file;
@@ -58,8 +70,29 @@ typedef struct
   bool boundaryWritten;
   std::string contentType;
   uint64_t writePosition;
+  const CWebServer* webServer;
+  struct MHD_Connection* connection;
+  // only set if the file is read in the background
+  std::shared_ptr<HttpFileReadAhead> readAhead;
 } HttpFileDownloadContext;
 
+typedef struct
+{
+  std::vector<char> buffer;
+  size_t offset = 0; // position of the next byte to send from the buffer
+  bool end = false;
+  bool failed = false;
+} HttpStreamedChunk;
+
+typedef struct
+{
+  std::shared_ptr<IHTTPRequestHandler> handler;
+  const CWebServer* webServer;
+  struct MHD_Connection* connection;
+  // only set if the chunks are produced in the background
+  std::shared_ptr<HttpStreamedChunk> chunk;
+} HttpStreamedDownloadContext;
+
 CWebServer::CWebServer()
   : m_authenticationUsername("kodi"),
     m_authenticationPassword(""),
@@ -81,6 +114,8 @@ CWebServer::CWebServer()
 #endif
 }
 
+CWebServer::~CWebServer() = default;
+
 static MHD_Response* create_response(size_t size, const void* data, int free, int copy)
 {
   MHD_ResponseMemoryMode mode = MHD_RESPMEM_PERSISTENT;
@@ -205,43 +240,9 @@ MHD_RESULT CWebServer::HandlePartialRequest(struct MHD_Connection* connection,
       // if we got a GET request we need to check if it should be cached
       if (request.method == GET || request.method == HEAD)
       {
-        if (handler->CanBeCached())
-        {
-          bool cacheable = IsRequestCacheable(request);
-
-          CDateTime lastModified;
-          if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
-          {
-            // handle If-Modified-Since or If-Unmodified-Since
-            std::string ifModifiedSince = HTTPRequestHandlerUtils::GetRequestHeaderValue(
-                connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_MODIFIED_SINCE);
-            std::string ifUnmodifiedSince = HTTPRequestHandlerUtils::GetRequestHeaderValue(
-                connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_UNMODIFIED_SINCE);
-
-            CDateTime ifModifiedSinceDate;
-            CDateTime ifUnmodifiedSinceDate;
-            // handle If-Modified-Since (but only if the response is cacheable)
-            if (cacheable && ifModifiedSinceDate.SetFromRFC1123DateTime(ifModifiedSince) &&
-                lastModified.GetAsUTCDateTime() <= ifModifiedSinceDate)
-            {
-              struct MHD_Response* response = create_response(0, nullptr, MHD_NO, MHD_NO);
-              if (response == nullptr)
-              {
-                m_logger->error("failed to create a HTTP 304 response");
-                return MHD_NO;
-              }
-
-              return FinalizeRequest(handler, MHD_HTTP_NOT_MODIFIED, response);
-            }
-            // handle If-Unmodified-Since
-            else if (ifUnmodifiedSinceDate.SetFromRFC1123DateTime(ifUnmodifiedSince) &&
-                     lastModified.GetAsUTCDateTime() > ifUnmodifiedSinceDate)
-              return SendErrorResponse(request, MHD_HTTP_PRECONDITION_FAILED, request.method);
-          }
-
-          // pass the requested ranges on to the request handler
-          handler->SetRequestRanged(IsRequestRanged(request, lastModified));
-        }
+        MHD_RESULT result;
+        if (HandleConditionalRequest(request, handler, result))
+          return result;
       }
       // if we got a POST request we need to take care of the POST data
       else if (request.method == POST)
@@ -256,12 +257,16 @@ MHD_RESULT CWebServer::HandlePartialRequest(struct MHD_Connection* connection,
         return MHD_YES;
       }
 
-      return HandleRequest(handler);
+      return DispatchRequest(conHandler, handler, con_cls);
     }
   }
   // this is a subsequent call to AnswerToConnection for this request
   else
   {
+    // the request has been handled in the background and the connection was resumed
+    if (conHandler->requestHandled)
+      return SendRequestResponse(conHandler->requestHandler, conHandler->requestResult);
+
     // again we need to take special care of the POST data
     if (request.method == POST)
     {
@@ -283,7 +288,7 @@ MHD_RESULT CWebServer::HandlePartialRequest(struct MHD_Connection* connection,
         return SendErrorResponse(request, conHandler->errorStatus, request.method);
 
       // we have handled all POST data so it's time to invoke the IHTTPRequestHandler
-      return HandleRequest(conHandler->requestHandler);
+      return DispatchRequest(conHandler, conHandler->requestHandler, con_cls);
     }
 
     // it's unusual to get more than one call to AnswerToConnection for none-POST requests, but
@@ -297,6 +302,55 @@ MHD_RESULT CWebServer::HandlePartialRequest(struct MHD_Connection* connection,
   return SendErrorResponse(request, MHD_HTTP_NOT_FOUND, request.method);
 }
 
+bool CWebServer::HandleConditionalRequest(const HTTPRequest& request,
+                                          const std::shared_ptr<IHTTPRequestHandler>& handler,
+                                          MHD_RESULT& result)
+{
+  if (!handler->CanBeCached())
+    return false;
+
+  bool cacheable = IsRequestCacheable(request);
+
+  CDateTime lastModified;
+  if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
+  {
+    // handle If-Modified-Since or If-Unmodified-Since
+    std::string ifModifiedSince = HTTPRequestHandlerUtils::GetRequestHeaderValue(
+        request.connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_MODIFIED_SINCE);
+    std::string ifUnmodifiedSince = HTTPRequestHandlerUtils::GetRequestHeaderValue(
+        request.connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_UNMODIFIED_SINCE);
+
+    CDateTime ifModifiedSinceDate;
+    CDateTime ifUnmodifiedSinceDate;
+    // handle If-Modified-Since (but only if the response is cacheable)
+    if (cacheable && ifModifiedSinceDate.SetFromRFC1123DateTime(ifModifiedSince) &&
+        lastModified.GetAsUTCDateTime() <= ifModifiedSinceDate)
+    {
+      struct MHD_Response* response = create_response(0, nullptr, MHD_NO, MHD_NO);
+      if (response == nullptr)
+      {
+        m_logger->error("failed to create a HTTP 304 response");
+        result = MHD_NO;
+        return true;
+      }
+
+      result = FinalizeRequest(handler, MHD_HTTP_NOT_MODIFIED, response);
+      return true;
+    }
+    // handle If-Unmodified-Since
+    else if (ifUnmodifiedSinceDate.SetFromRFC1123DateTime(ifUnmodifiedSince) &&
+             lastModified.GetAsUTCDateTime() > ifUnmodifiedSinceDate)
+    {
+      result = SendErrorResponse(request, MHD_HTTP_PRECONDITION_FAILED, request.method);
+      return true;
+    }
+  }
+
+  // pass the requested ranges on to the request handler
+  handler->SetRequestRanged(IsRequestRanged(request, lastModified));
+  return false;
+}
+
 MHD_RESULT CWebServer::HandlePostField(void* cls,
                                        enum MHD_ValueKind kind,
                                        const char* key,
@@ -321,18 +375,81 @@ MHD_RESULT CWebServer::HandlePostField(void* cls,
 }
 
 MHD_RESULT CWebServer::HandleRequest(const std::shared_ptr<IHTTPRequestHandler>& handler)
+{
+  if (handler == nullptr)
+    return MHD_NO;
+
+  return SendRequestResponse(handler, handler->HandleRequest());
+}
+
+MHD_RESULT CWebServer::DispatchRequest(std::unique_ptr<ConnectionHandler>& connectionHandler,
+                                       std::shared_ptr<IHTTPRequestHandler> handler,
+                                       void** con_cls)
+{
+  if (handler == nullptr || !handler->IsLongRunning())
+    return HandleRequest(handler);
+
+  ConnectionHandler* conHandler = connectionHandler.get();
+  conHandler->requestHandler = handler;
+
+  if (!RunSuspended(handler->GetRequest().connection, m_requestQueue.get(), [conHandler]() {
+        conHandler->requestResult = conHandler->requestHandler->HandleRequest();
+        conHandler->requestHandled = true;
+      }))
+    return HandleRequest(handler);
+
+  // libmicrohttpd calls AnswerToConnection again once the connection has been resumed so
+  // ownership of the connection handler is passed to it
+  *con_cls = connectionHandler.release();
+
+  return MHD_YES;
+}
+
+bool CWebServer::RunSuspended(struct MHD_Connection* connection,
+                              CJobQueue* queue,
+                              std::function<void()> work) const
+{
+  std::unique_lock<CCriticalSection> lock(m_suspendedSection);
+  if (queue == nullptr || m_stopping)
+    return false;
+
+  MHD_suspend_connection(connection);
+  m_suspendedConnections++;
+
+  queue->Submit([this, connection, work = std::move(work)]() {
+    work();
+
+    std::unique_lock<CCriticalSection> lock(m_suspendedSection);
+    MHD_resume_connection(connection);
+    m_suspendedConnections--;
+    m_suspendedCond.notifyAll();
+  });
+
+  return true;
+}
+
+MHD_RESULT CWebServer::SendRequestResponse(const std::shared_ptr<IHTTPRequestHandler>& handler,
+                                           MHD_RESULT handled)
 {
   if (handler == nullptr)
     return MHD_NO;
 
   HTTPRequest request = handler->GetRequest();
-  MHD_RESULT ret = handler->HandleRequest();
+  MHD_RESULT ret = handled;
   if (ret == MHD_NO)
   {
     m_logger->error("failed to handle HTTP request for {}", request.pathUrl);
     return SendErrorResponse(request, MHD_HTTP_INTERNAL_SERVER_ERROR, request.method);
   }
 
+  // long running handlers may only know the last modified date once they are done
+  if (handler->IsLongRunning() && (request.method == GET || request.method == HEAD))
+  {
+    MHD_RESULT result;
+    if (HandleConditionalRequest(request, handler, result))
+      return result;
+  }
+
   const HTTPResponseDetails& responseDetails = handler->GetResponseDetails();
   struct MHD_Response* response = nullptr;
   switch (responseDetails.type)
@@ -356,6 +473,10 @@ MHD_RESULT CWebServer::HandleRequest(const std::shared_ptr<IHTTPRequestHandler>&
       ret = CreateMemoryDownloadResponse(handler, response);
       break;
 
+    case HTTPStreamedDownload:
+      ret = CreateStreamedDownloadResponse(handler, response);
+      break;
+
     case HTTPError:
       ret =
           CreateErrorResponse(request.connection, responseDetails.status, request.method, response);
@@ -822,6 +943,12 @@ MHD_RESULT CWebServer::CreateFileDownloadResponse(
   context->contentType = mimeType;
   context->boundaryWritten = false;
   context->writePosition = 0;
+  context->webServer = this;
+  context->connection = request.connection;
+
+  // read the file in the background so a slow file system doesn't hold up other connections
+  if (m_readAheadQueue != nullptr)
+    context->readAhead = std::make_shared<HttpFileReadAhead>();
 
   if (handler->IsRequestRanged())
   {
@@ -913,6 +1040,35 @@ MHD_RESULT CWebServer::CreateFileDownloadResponse(
   return MHD_YES;
 }
 
+MHD_RESULT CWebServer::CreateStreamedDownloadResponse(
+    const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response*& response) const
+{
+  // the request handler provides the data so it has to stay around until the response is done
+  auto context = std::make_unique<HttpStreamedDownloadContext>();
+  context->handler = handler;
+  context->webServer = this;
+  context->connection = handler->GetRequest().connection;
+
+  // the handler may access databases while producing the data, keep that off the polling threads
+  if (m_requestQueue != nullptr)
+    context->chunk = std::make_shared<HttpStreamedChunk>();
+
+  // without a known size the response is sent with chunked transfer encoding
+  response = MHD_create_response_from_callback(
+      MHD_SIZE_UNKNOWN, 32 * 1024, &CWebServer::StreamedContentReaderCallback, context.get(),
+      &CWebServer::StreamedContentReaderFreeCallback);
+  if (response == nullptr)
+  {
+    m_logger->error("failed to create a streamed HTTP response for {}",
+                    handler->GetRequest().pathUrl);
+    return MHD_NO;
+  }
+
+  context.release(); // ownership was passed to mhd
+
+  return MHD_YES;
+}
+
 MHD_RESULT CWebServer::CreateErrorResponse(struct MHD_Connection* connection,
                                            int responseType,
                                            HTTPMethod method,
@@ -1040,6 +1196,45 @@ ssize_t CWebServer::ContentReaderCallback(void* cls, uint64_t pos, char* buf, si
   uint64_t maximum = (uint64_t)max;
   int written = 0;
 
+  // check if the current position is within this range
+  // if not, set it to the start position
+  if (context->writePosition < start || context->writePosition > end)
+    context->writePosition = start;
+
+  // when reading in the background the data must be available before anything is written
+  if (context->readAhead != nullptr)
+  {
+    std::shared_ptr<HttpFileReadAhead> readAhead = context->readAhead;
+    if (readAhead->failed)
+      return -1;
+
+    if (context->writePosition < readAhead->position ||
+        context->writePosition >= readAhead->position + readAhead->buffer.size())
+    {
+      std::shared_ptr<XFILE::CFile> file = context->file;
+      uint64_t position = context->writePosition;
+      size_t size =
+          static_cast<size_t>(std::min<uint64_t>(READ_AHEAD_SIZE, end - position + 1));
+
+      if (context->webServer->RunSuspended(context->connection,
+                                           context->webServer->m_readAheadQueue.get(),
+                                           [file, readAhead, position, size]() {
+            if (file->GetPosition() < 0 || position != static_cast<uint64_t>(file->GetPosition()))
+              file->Seek(position);
+
+            readAhead->position = position;
+            readAhead->buffer.resize(size);
+            ssize_t res = file->Read(readAhead->buffer.data(), size);
+            readAhead->buffer.resize(res > 0 ? static_cast<size_t>(res) : 0);
+            readAhead->failed = res <= 0;
+          }))
+        return 0; // called again once the data has been read
+
+      // the web server is stopping so read the rest directly
+      context->readAhead.reset();
+    }
+  }
+
   if (context->rangeCountTotal > 1 && !context->boundaryWritten)
   {
     // add a newline before any new multipart boundary
@@ -1067,20 +1262,28 @@ ssize_t CWebServer::ContentReaderCallback(void* cls, uint64_t pos, char* buf, si
     context->boundaryWritten = true;
   }
 
-  // check if the current position is within this range
-  // if not, set it to the start position
-  if (context->writePosition < start || context->writePosition > end)
-    context->writePosition = start;
   // adjust the maximum number of read bytes
   maximum = std::min(maximum, end - context->writePosition + 1);
 
-  // seek to the position if necessary
-  if (context->file->GetPosition() < 0 ||
-      context->writePosition != static_cast<uint64_t>(context->file->GetPosition()))
-    context->file->Seek(context->writePosition);
+  ssize_t res;
+  if (context->readAhead != nullptr)
+  {
+    // copy the data that has been read in the background
+    const HttpFileReadAhead& readAhead = *context->readAhead;
+    size_t offset = static_cast<size_t>(context->writePosition - readAhead.position);
+    res = static_cast<ssize_t>(std::min<uint64_t>(maximum, readAhead.buffer.size() - offset));
+    memcpy(buf, readAhead.buffer.data() + offset, static_cast<size_t>(res));
+  }
+  else
+  {
+    // seek to the position if necessary
+    if (context->file->GetPosition() < 0 ||
+        context->writePosition != static_cast<uint64_t>(context->file->GetPosition()))
+      context->file->Seek(context->writePosition);
 
-  // read data from the file
-  ssize_t res = context->file->Read(buf, static_cast<size_t>(maximum));
+    // read data from the file
+    res = context->file->Read(buf, static_cast<size_t>(maximum));
+  }
   if (res <= 0)
     return -1;
 
@@ -1114,6 +1317,69 @@ void CWebServer::ContentReaderFreeCallback(void* cls)
     GetLogger()->debug("[OUT] done");
 }
 
+ssize_t CWebServer::StreamedContentReaderCallback(void* cls, uint64_t pos, char* buf, size_t max)
+{
+  HttpStreamedDownloadContext* context = static_cast<HttpStreamedDownloadContext*>(cls);
+  if (context == nullptr || context->handler == nullptr)
+    return MHD_CONTENT_READER_END_WITH_ERROR;
+
+  ssize_t read;
+  if (context->chunk != nullptr)
+  {
+    std::shared_ptr<HttpStreamedChunk> chunk = context->chunk;
+    if (chunk->offset >= chunk->buffer.size())
+    {
+      if (chunk->end)
+        return MHD_CONTENT_READER_END_OF_STREAM;
+      if (chunk->failed)
+        return MHD_CONTENT_READER_END_WITH_ERROR;
+
+      std::shared_ptr<IHTTPRequestHandler> handler = context->handler;
+      if (context->webServer->RunSuspended(context->connection,
+                                           context->webServer->m_requestQueue.get(),
+                                           [handler, chunk, max]() {
+                                             chunk->buffer.resize(max);
+                                             ssize_t res = handler->ReadResponseData(
+                                                 chunk->buffer.data(), max);
+                                             chunk->buffer.resize(
+                                                 res > 0 ? static_cast<size_t>(res) : 0);
+                                             chunk->offset = 0;
+                                             chunk->end = res == 0;
+                                             chunk->failed = res < 0;
+                                           }))
+        return 0; // called again once the next chunk has been produced
+
+      // the web server is stopping so produce the rest directly
+      context->chunk.reset();
+      read = context->handler->ReadResponseData(buf, max);
+    }
+    else
+    {
+      // copy the chunk that has been produced in the background
+      read = static_cast<ssize_t>(std::min(max, chunk->buffer.size() - chunk->offset));
+      memcpy(buf, chunk->buffer.data() + chunk->offset, static_cast<size_t>(read));
+      chunk->offset += static_cast<size_t>(read);
+    }
+  }
+  else
+    read = context->handler->ReadResponseData(buf, max);
+
+  if (read == 0)
+    return MHD_CONTENT_READER_END_OF_STREAM;
+  if (read < 0)
+    return MHD_CONTENT_READER_END_WITH_ERROR;
+
+  if (CServiceBroker::GetLogging().CanLogComponent(LOGWEBSERVER))
+    GetLogger()->debug("[OUT] streamed {} bytes at {}", read, pos);
+
+  return read;
+}
+
+void CWebServer::StreamedContentReaderFreeCallback(void* cls)
+{
+  delete static_cast<HttpStreamedDownloadContext*>(cls);
+}
+
 static Logger GetMhdLogger()
 {
   return CServiceBroker::GetLogging().GetLogger("libmicrohttpd");
@@ -1194,6 +1460,35 @@ struct MHD_Daemon* CWebServer::StartMHD(unsigned int flags, int port)
   unsigned int timeout = 60 * 60 * 24;
   const char* ciphers = "NORMAL:-VERS-TLS1.0";
 
+  // options depending on how connections are handled
+  std::vector<MHD_OptionItem> connectionOptions;
+
+#if (MHD_VERSION >= 0x00095500)
+  if (m_threadPoolSize > 0)
+  {
+    // a small pool of threads polls all connections (using epoll where available) and long
+    // running requests are handled in the background, so many clients don't need many threads
+    flags |= MHD_USE_AUTO | MHD_USE_INTERNAL_POLLING_THREAD | MHD_ALLOW_SUSPEND_RESUME;
+    connectionOptions.push_back(
+        {MHD_OPTION_THREAD_POOL_SIZE, static_cast<intptr_t>(m_threadPoolSize), nullptr});
+  }
+  else
+#endif
+  {
+    // one thread per connection
+    // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
+    // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
+    flags |= MHD_USE_THREAD_PER_CONNECTION;
+#if (MHD_VERSION >= 0x00095207)
+    // MHD_USE_THREAD_PER_CONNECTION must be used only with MHD_USE_INTERNAL_POLLING_THREAD since
+    // 0.9.54
+    flags |= MHD_USE_INTERNAL_POLLING_THREAD;
+#endif
+  }
+  connectionOptions.push_back({MHD_OPTION_END, 0, nullptr});
+
+  flags |= MHD_USE_DEBUG; // Print MHD error messages to log
+
   MHD_set_panic_func(&panicHandlerForMHD, nullptr);
 
   if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
@@ -1201,45 +1496,23 @@ struct MHD_Daemon* CWebServer::StartMHD(unsigned int flags, int port)
       MHD_is_feature_supported(MHD_FEATURE_SSL) == MHD_YES && LoadCert(m_key, m_cert))
     // SSL enabled
     return MHD_start_daemon(
-        flags |
-            // one thread per connection
-            // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
-            // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
-            MHD_USE_THREAD_PER_CONNECTION
-#if (MHD_VERSION >= 0x00095207)
-            |
-            MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used only with
-                                               MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
-#endif
-            | MHD_USE_DEBUG /* Print MHD error messages to log */
-            | MHD_USE_SSL,
-        port, 0, 0, &CWebServer::AnswerToConnection, this,
+        flags | MHD_USE_SSL, port, 0, 0, &CWebServer::AnswerToConnection, this,
 
         MHD_OPTION_EXTERNAL_LOGGER, &logFromMHD, 0, MHD_OPTION_CONNECTION_LIMIT, 512,
         MHD_OPTION_CONNECTION_TIMEOUT, timeout, MHD_OPTION_URI_LOG_CALLBACK,
         &CWebServer::UriRequestLogger, this, MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
         MHD_OPTION_HTTPS_MEM_KEY, m_key.c_str(), MHD_OPTION_HTTPS_MEM_CERT, m_cert.c_str(),
-        MHD_OPTION_HTTPS_PRIORITIES, ciphers, MHD_OPTION_END);
+        MHD_OPTION_HTTPS_PRIORITIES, ciphers, MHD_OPTION_ARRAY, connectionOptions.data(),
+        MHD_OPTION_END);
 
   // No SSL
   return MHD_start_daemon(
-      flags |
-          // one thread per connection
-          // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
-          // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
-          MHD_USE_THREAD_PER_CONNECTION
-#if (MHD_VERSION >= 0x00095207)
-          | MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used only with
-                                               MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
-#endif
-          | MHD_USE_DEBUG /* Print MHD error messages to log */
-      ,
-      port, 0, 0, &CWebServer::AnswerToConnection, this,
+      flags, port, 0, 0, &CWebServer::AnswerToConnection, this,
 
       MHD_OPTION_EXTERNAL_LOGGER, &logFromMHD, 0, MHD_OPTION_CONNECTION_LIMIT, 512,
       MHD_OPTION_CONNECTION_TIMEOUT, timeout, MHD_OPTION_URI_LOG_CALLBACK,
       &CWebServer::UriRequestLogger, this, MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
-      MHD_OPTION_END);
+      MHD_OPTION_ARRAY, connectionOptions.data(), MHD_OPTION_END);
 }
 
 bool CWebServer::Start(uint16_t port, const std::string& username, const std::string& password)
@@ -1250,6 +1523,21 @@ bool CWebServer::Start(uint16_t port, const std::string& username, const std::st
     // use a new logger containing the port in the name
     m_logger = CServiceBroker::GetLogging().GetLogger(StringUtils::Format("CWebserver[{}]", port));
 
+    const std::shared_ptr<CAdvancedSettings> advancedSettings =
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+#if (MHD_VERSION >= 0x00095500)
+    m_threadPoolSize = advancedSettings->m_webserverThreadPoolSize;
+#endif
+    // long running requests are handled by jobs, without the job manager they are handled by the
+    // polling threads
+    if (m_threadPoolSize > 0 && CServiceBroker::GetJobManager() != nullptr)
+    {
+      m_requestQueue = std::make_unique<CJobQueue>(
+          false, advancedSettings->m_webserverRequestWorkers, CJob::PRIORITY_NORMAL);
+      m_readAheadQueue = std::make_unique<CJobQueue>(
+          false, advancedSettings->m_webserverRequestWorkers, CJob::PRIORITY_NORMAL);
+    }
+
     int v6testSock;
     if ((v6testSock = socket(AF_INET6, SOCK_STREAM, 0)) >= 0)
     {
@@ -1265,7 +1553,11 @@ bool CWebServer::Start(uint16_t port, const std::string& username, const std::st
       m_logger->info("Started");
     }
     else
+    {
       m_logger->error("Failed to start");
+      m_requestQueue.reset();
+      m_readAheadQueue.reset();
+    }
   }
 
   return m_running;
@@ -1276,12 +1568,23 @@ bool CWebServer::Stop()
   if (!m_running)
     return true;
 
+  {
+    // suspended connections have to be resumed before the daemons can be stopped
+    std::unique_lock<CCriticalSection> lock(m_suspendedSection);
+    m_stopping = true;
+    m_suspendedCond.wait(lock, [this]() { return m_suspendedConnections == 0; });
+  }
+
   if (m_daemon_ip6 != nullptr)
     MHD_stop_daemon(m_daemon_ip6);
 
   if (m_daemon_ip4 != nullptr)
     MHD_stop_daemon(m_daemon_ip4);
 
+  m_requestQueue.reset();
+  m_readAheadQueue.reset();
+  m_stopping = false;
+
   m_running = false;
   m_logger->info("Stopped");
   m_port = 0;
@@ -9,9 +9,11 @@
 #pragma once
 
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
+#include "threads/Condition.h"
 #include "threads/CriticalSection.h"
 #include "utils/logtypes.h"
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -20,13 +22,14 @@ namespace XFILE
   class CFile;
 }
 class CDateTime;
+class CJobQueue;
 class CVariant;
 
 class CWebServer
 {
 public:
   CWebServer();
-  virtual ~CWebServer() = default;
+  virtual ~CWebServer();
 
   bool Start(uint16_t port, const std::string &username, const std::string &password);
   bool Stop();
@@ -45,6 +48,8 @@ protected:
     std::shared_ptr<IHTTPRequestHandler> requestHandler;
     struct MHD_PostProcessor *postprocessor;
     int errorStatus;
+    bool requestHandled;
+    MHD_RESULT requestResult;
 
     explicit ConnectionHandler(const std::string& uri)
       : fullUri(uri)
@@ -52,6 +57,8 @@ protected:
       , requestHandler(nullptr)
       , postprocessor(nullptr)
       , errorStatus(MHD_HTTP_OK)
+      , requestHandled(false)
+      , requestResult(MHD_NO)
     { }
   } ConnectionHandler;
 
@@ -67,9 +74,37 @@ private:
 
   std::shared_ptr<IHTTPRequestHandler> FindRequestHandler(const HTTPRequest& request) const;
 
+  MHD_RESULT DispatchRequest(std::unique_ptr<ConnectionHandler>& connectionHandler, std::shared_ptr<IHTTPRequestHandler> handler, void **con_cls);
+  MHD_RESULT SendRequestResponse(const std::shared_ptr<IHTTPRequestHandler>& handler, MHD_RESULT handled);
+
+  /*!
+   * \brief Suspends the connection and does the given work in the background.
+   *
+   * \details The connection is resumed once the work is done, after which
+   * libmicrohttpd calls the callback that suspended it again.
+   *
+   * \param connection Connection to suspend
+   * \param queue Job queue to do the work on
+   * \param work Work to do in the background
+   * \return False if the work can't be done in the background.
+   */
+  bool RunSuspended(struct MHD_Connection *connection,
+                    CJobQueue* queue,
+                    std::function<void()> work) const;
+
   MHD_RESULT AskForAuthentication(const HTTPRequest& request) const;
   bool IsAuthenticated(const HTTPRequest& request) const;
 
+  /*!
+   * \brief Answers If-Modified-Since and If-Unmodified-Since and passes the requested ranges on to
+   * the request handler.
+   *
+   * \param result Result of the sent response
+   * \return True if a response has already been sent.
+   */
+  bool HandleConditionalRequest(const HTTPRequest& request,
+                                const std::shared_ptr<IHTTPRequestHandler>& handler,
+                                MHD_RESULT& result);
   bool IsRequestCacheable(const HTTPRequest& request) const;
   bool IsRequestRanged(const HTTPRequest& request, const CDateTime &lastModified) const;
 
@@ -82,6 +117,7 @@ private:
 
   MHD_RESULT CreateRedirect(struct MHD_Connection *connection, const std::string &strURL, struct MHD_Response *&response) const;
   MHD_RESULT CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response *&response) const;
+  MHD_RESULT CreateStreamedDownloadResponse(const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response *&response) const;
   MHD_RESULT CreateErrorResponse(struct MHD_Connection *connection, int responseType, HTTPMethod method, struct MHD_Response *&response) const;
   MHD_RESULT CreateMemoryDownloadResponse(struct MHD_Connection *connection, const void *data, size_t size, bool free, bool copy, struct MHD_Response *&response) const;
 
@@ -100,6 +136,8 @@ private:
 
   static ssize_t ContentReaderCallback (void *cls, uint64_t pos, char *buf, size_t max);
   static void ContentReaderFreeCallback(void *cls);
+  static ssize_t StreamedContentReaderCallback(void *cls, uint64_t pos, char *buf, size_t max);
+  static void StreamedContentReaderFreeCallback(void *cls);
 
   static MHD_RESULT AnswerToConnection (void *cls, struct MHD_Connection *connection,
                         const char *url, const char *method,
@@ -119,6 +157,7 @@ private:
   struct MHD_Daemon *m_daemon_ip4 = nullptr;
   bool m_running = false;
   size_t m_thread_stacksize = 0;
+  unsigned int m_threadPoolSize = 0;
   bool m_authenticationRequired = false;
   std::string m_authenticationUsername;
   std::string m_authenticationPassword;
@@ -127,5 +166,13 @@ private:
   mutable CCriticalSection m_critSection;
   std::vector<IHTTPRequestHandler *> m_requestHandlers;
 
+  mutable CCriticalSection m_suspendedSection;
+  mutable XbmcThreads::ConditionVariable m_suspendedCond;
+  std::unique_ptr<CJobQueue> m_requestQueue;
+  // file downloads read ahead on their own queue so slow request handlers don't hold them up
+  std::unique_ptr<CJobQueue> m_readAheadQueue;
+  mutable unsigned int m_suspendedConnections = 0;
+  bool m_stopping = false;
+
   Logger m_logger;
 };
@@ -18,6 +18,9 @@
 #include "utils/Variant.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <cstring>
+
 #define MAX_HTTP_POST_SIZE 65536
 
 bool CHTTPJsonRpcHandler::CanHandleRequest(const HTTPRequest &request) const
@@ -72,10 +75,29 @@ MHD_RESULT CHTTPJsonRpcHandler::HandleRequest()
 
   if (isRequest)
   {
-    m_responseData = JSONRPC::CJSONRPC::MethodCall(m_requestData, &m_transportLayer, &client);
+    // only plain JSON responses are streamed, JSONP ones are wrapped as a whole
+    if (jsonpCallback.empty())
+    {
+      JSONRPC::CJSONRPC::MethodCall(m_requestData, &m_transportLayer, &client, m_streamedResponse);
+      if (m_streamedResponse.IsStreamed())
+      {
+        m_requestData.clear();
+
+        m_response.type = HTTPStreamedDownload;
+        m_response.status = MHD_HTTP_OK;
+        m_response.contentType = "application/json";
+        m_response.totalLength = 0;
+
+        return MHD_YES;
+      }
 
-    if (!jsonpCallback.empty())
+      m_streamedResponse.Read(m_responseData, std::string::npos);
+    }
+    else
+    {
+      m_responseData = JSONRPC::CJSONRPC::MethodCall(m_requestData, &m_transportLayer, &client);
       m_responseData = jsonpCallback + "(" + m_responseData + ");";
+    }
   }
   else if (jsonpCallback.empty())
   {
@@ -118,6 +140,23 @@ HttpResponseRanges CHTTPJsonRpcHandler::GetResponseData() const
   return ranges;
 }
 
+ssize_t CHTTPJsonRpcHandler::ReadResponseData(char* buffer, size_t size)
+{
+  if (m_streamedPosition >= m_responseData.size())
+  {
+    m_responseData.clear();
+    m_streamedPosition = 0;
+    if (!m_streamedResponse.Read(m_responseData, size))
+      return 0;
+  }
+
+  const size_t read = std::min(size, m_responseData.size() - m_streamedPosition);
+  memcpy(buffer, m_responseData.data() + m_streamedPosition, read);
+  m_streamedPosition += read;
+
+  return static_cast<ssize_t>(read);
+}
+
 bool CHTTPJsonRpcHandler::appendPostData(const char *data, size_t size)
 {
   if (m_requestData.size() + size > MAX_HTTP_POST_SIZE)
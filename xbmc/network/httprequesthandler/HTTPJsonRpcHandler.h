@@ -10,6 +10,7 @@
 
 #include "interfaces/json-rpc/IClient.h"
 #include "interfaces/json-rpc/ITransportLayer.h"
+#include "interfaces/json-rpc/JSONRPCResponse.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
 
 #include <string>
@@ -25,8 +26,10 @@ public:
   bool CanHandleRequest(const HTTPRequest &request) const override;
 
   MHD_RESULT HandleRequest() override;
+  bool IsLongRunning() const override { return true; }
 
   HttpResponseRanges GetResponseData() const override;
+  ssize_t ReadResponseData(char* buffer, size_t size) override;
 
   int GetPriority() const override { return 5; }
 
@@ -41,6 +44,8 @@ private:
   std::string m_requestData;
   std::string m_responseData;
   CHttpResponseRange m_responseRange;
+  JSONRPC::CJSONRPCResponse m_streamedResponse;
+  size_t m_streamedPosition = 0;
 
   class CHTTPTransportLayer : public JSONRPC::ITransportLayer
   {
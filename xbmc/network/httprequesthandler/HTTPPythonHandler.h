@@ -26,6 +26,7 @@ public:
   bool GetLastModifiedDate(CDateTime &lastModified) const override;
 
   MHD_RESULT HandleRequest() override;
+  bool IsLongRunning() const override { return true; }
 
   HttpResponseRanges GetResponseData() const override { return m_responseRanges; }
 
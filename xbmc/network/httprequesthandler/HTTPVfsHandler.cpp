@@ -21,6 +21,11 @@
 CHTTPVfsHandler::CHTTPVfsHandler(const HTTPRequest &request)
   : CHTTPFileHandler(request)
 {
+}
+
+MHD_RESULT CHTTPVfsHandler::HandleRequest()
+{
+  // the file is only looked at here because remote sources can take a while to answer
   std::string file;
   int responseStatus = MHD_HTTP_BAD_REQUEST;
 
@@ -98,6 +103,8 @@ CHTTPVfsHandler::CHTTPVfsHandler(const HTTPRequest &request)
 
   // set the file and the HTTP response status
   SetFile(file, responseStatus);
+
+  return CHTTPFileHandler::HandleRequest();
 }
 
 bool CHTTPVfsHandler::CanHandleRequest(const HTTPRequest &request) const
@@ -21,6 +21,9 @@ public:
   IHTTPRequestHandler* Create(const HTTPRequest &request) const override { return new CHTTPVfsHandler(request); }
   bool CanHandleRequest(const HTTPRequest &request) const override;
 
+  MHD_RESULT HandleRequest() override;
+  bool IsLongRunning() const override { return true; }
+
   int GetPriority() const override { return 5; }
 
 protected:
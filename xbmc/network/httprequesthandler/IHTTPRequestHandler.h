@@ -60,7 +60,10 @@ typedef enum HTTPResponseType
   HTTPMemoryDownloadFreeNoCopy,
   // creates a HTTP response from a buffer by copying followed by freeing the buffer
   // the buffer must have been malloc'ed and not new'ed
-  HTTPMemoryDownloadFreeCopy
+  HTTPMemoryDownloadFreeCopy,
+  // creates a chunked HTTP response whose content is read from the request handler
+  // while it's being sent
+  HTTPStreamedDownload
 } HTTPResponseType;
 
 typedef struct HTTPRequest
@@ -122,6 +125,15 @@ public:
    */
   virtual MHD_RESULT HandleRequest() = 0;
 
+  /*!
+   * \brief Whether handling the request may take a while, e.g. because it
+   * accesses a database or runs a script.
+   *
+   * \details If the web server supports it such requests are handled in the
+   * background so that they don't hold up other connections.
+   */
+  virtual bool IsLongRunning() const { return false; }
+
   /*!
    * \brief Whether the HTTP response could also be provided in ranges.
    */
@@ -167,6 +179,19 @@ public:
   */
   virtual std::string GetResponseFile() const { return ""; }
 
+  /*!
+   * \brief Reads the next part of the response data.
+   *
+   * \details This is only used if the response type is HTTPStreamedDownload.
+   * Like long running requests it's called in the background if the web server
+   * supports it, but never for two parts of the same response at once.
+   *
+   * \param buffer Buffer to fill
+   * \param size Size of the buffer
+   * \return Number of bytes read, 0 at the end of the response data or -1 on error.
+   */
+  virtual ssize_t ReadResponseData(char* buffer, size_t size) { return -1; }
+
   /*!
   * \brief Returns the HTTP request handled by the HTTP request handler.
   */
@@ -14,9 +14,11 @@
 #include <stdlib.h>
 
 #include <gtest/gtest.h>
+#include "ServiceBroker.h"
 #include "URL.h"
 #include "filesystem/CurlFile.h"
 #include "filesystem/File.h"
+#include "filesystem/SegmentedReader.h"
 #include "interfaces/json-rpc/JSONRPC.h"
 #include "network/WebServer.h"
 #include "network/httprequesthandler/HTTPVfsHandler.h"
@@ -24,6 +26,7 @@
 #include "settings/MediaSourceSettings.h"
 #include "test/TestUtils.h"
 #include "utils/JSONVariantParser.h"
+#include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
@@ -145,6 +148,18 @@ protected:
     return lastModified.IsValid();
   }
 
+  template<typename TReader>
+  static std::string ReadAll(TReader& reader)
+  {
+    std::string result;
+    char buffer[8];
+    ssize_t read;
+    while ((read = reader.Read(buffer, sizeof(buffer))) > 0)
+      result.append(buffer, read);
+
+    return result;
+  }
+
   void CheckHtmlTestFileResponse(const CCurlFile& curl)
   {
     // get the HTTP header details
@@ -359,6 +374,26 @@ protected:
   uint16_t webserverPort;
 };
 
+// long running requests and read-ahead are only handled in the background with a job manager
+class TestWebServerWithJobManager : public TestWebServer
+{
+protected:
+  void SetUp() override
+  {
+    CServiceBroker::RegisterJobManager(std::make_shared<CJobManager>());
+    TestWebServer::SetUp();
+  }
+
+  void TearDown() override
+  {
+    TestWebServer::TearDown();
+
+    CServiceBroker::GetJobManager()->CancelJobs();
+    CServiceBroker::GetJobManager()->Restart();
+    CServiceBroker::UnregisterJobManager();
+  }
+};
+
 TEST_F(TestWebServer, IsStarted)
 {
   ASSERT_TRUE(webserver.IsStarted());
@@ -924,3 +959,158 @@ TEST_F(TestWebServer, CanGetCachedRangedFileWithNewerIfRange)
   ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
   CheckRangesTestFileResponse(curl, result, ranges);
 }
+
+TEST_F(TestWebServer, CanOpenRangedFile)
+{
+  const std::string rangedFileContent = TEST_FILES_DATA_RANGES;
+  std::vector<std::string> rangedContent = StringUtils::Split(TEST_FILES_DATA_RANGES, ";");
+  const int64_t start = rangedContent.front().size() + 1;
+  const int64_t end = start + rangedContent.at(1).size() - 1;
+
+  // only the requested range is transferred, the length is still the one of the whole file
+  CCurlFile curl;
+  ASSERT_TRUE(curl.OpenRange(CURL(GetUrlOfTestFile(TEST_FILES_RANGES)), start, end));
+  EXPECT_EQ(static_cast<int64_t>(rangedFileContent.size()), curl.GetLength());
+  EXPECT_STREQ(rangedContent.at(1).c_str(), ReadAll(curl).c_str());
+}
+
+TEST_F(TestWebServer, CanSeekPastRangeEndOfRangedFile)
+{
+  std::vector<std::string> rangedContent = StringUtils::Split(TEST_FILES_DATA_RANGES, ";");
+  const int64_t end = rangedContent.front().size() - 1;
+  const int64_t last = std::string(TEST_FILES_DATA_RANGES).size() - rangedContent.back().size();
+
+  CCurlFile curl;
+  ASSERT_TRUE(curl.OpenRange(CURL(GetUrlOfTestFile(TEST_FILES_RANGES)), 0, end));
+  EXPECT_STREQ(rangedContent.front().c_str(), ReadAll(curl).c_str());
+
+  // the range of the open doesn't apply to following seeks
+  ASSERT_EQ(last, curl.Seek(last, SEEK_SET));
+  EXPECT_STREQ(rangedContent.back().c_str(), ReadAll(curl).c_str());
+}
+
+TEST_F(TestWebServer, CanSetRangeEndForNextSeek)
+{
+  std::vector<std::string> rangedContent = StringUtils::Split(TEST_FILES_DATA_RANGES, ";");
+  const int64_t start = rangedContent.front().size() + 1;
+  int64_t end = start + rangedContent.at(1).size() - 1;
+
+  CCurlFile curl;
+  ASSERT_TRUE(curl.Open(CURL(GetUrlOfTestFile(TEST_FILES_RANGES))));
+
+  curl.IoControl(IOCTRL_SET_RANGE_END, &end);
+  ASSERT_EQ(start, curl.Seek(start, SEEK_SET));
+  EXPECT_STREQ(rangedContent.at(1).c_str(), ReadAll(curl).c_str());
+
+  // without a new range end the next seek is open ended again
+  ASSERT_EQ(0, curl.Seek(0, SEEK_SET));
+  EXPECT_STREQ(TEST_FILES_DATA_RANGES, ReadAll(curl).c_str());
+}
+
+TEST_F(TestWebServer, CanReadFileWithSegmentedReader)
+{
+  const std::string rangedFileContent = TEST_FILES_DATA_RANGES;
+
+  // small segments so that every connection fetches several of them
+  CSegmentedReader reader(CURL(GetUrlOfTestFile(TEST_FILES_RANGES)), 3, 4,
+                          rangedFileContent.size());
+  ASSERT_TRUE(reader.Start(0));
+  EXPECT_STREQ(TEST_FILES_DATA_RANGES, ReadAll(reader).c_str());
+}
+
+TEST_F(TestWebServer, CanRestartSegmentedReader)
+{
+  const std::string rangedFileContent = TEST_FILES_DATA_RANGES;
+  std::vector<std::string> rangedContent = StringUtils::Split(TEST_FILES_DATA_RANGES, ";");
+  const int64_t last = rangedFileContent.size() - rangedContent.back().size();
+
+  CSegmentedReader reader(CURL(GetUrlOfTestFile(TEST_FILES_RANGES)), 2, 4,
+                          rangedFileContent.size());
+  ASSERT_TRUE(reader.Start(0));
+  char buffer[4];
+  ASSERT_GT(reader.Read(buffer, sizeof(buffer)), 0);
+
+  // restarting drops the pending segments and continues at the new position
+  ASSERT_TRUE(reader.Start(last));
+  EXPECT_STREQ(rangedContent.back().c_str(), ReadAll(reader).c_str());
+
+  reader.Stop();
+  EXPECT_EQ(-1, reader.Read(buffer, sizeof(buffer)));
+}
+
+TEST_F(TestWebServerWithJobManager, CanReadDataOverSuspendedJsonRpcWithHttpPost)
+{
+  // initialized JSON-RPC
+  JSONRPC::CJSONRPC::Initialize();
+
+  std::string result;
+  CCurlFile curl;
+  curl.SetMimeType("application/json");
+  ASSERT_TRUE(curl.Post(GetUrl(TEST_URL_JSONRPC), "{ \"jsonrpc\": \"2.0\", \"method\": \"JSONRPC.Version\", \"id\": 1 }", result));
+  ASSERT_FALSE(result.empty());
+
+  // parse the JSON-RPC response
+  CVariant resultObj;
+  ASSERT_TRUE(CJSONVariantParser::Parse(result, resultObj));
+  ASSERT_TRUE(resultObj.isObject());
+  ASSERT_TRUE(resultObj["result"].isMember("version"));
+
+  // Content-Type must be "application/json"
+  EXPECT_STREQ("application/json", curl.GetHttpHeader().GetMimeType().c_str());
+
+  // uninitialize JSON-RPC
+  JSONRPC::CJSONRPC::Cleanup();
+}
+
+TEST_F(TestWebServerWithJobManager, CanGetFileWithReadAhead)
+{
+  std::string result;
+  CCurlFile curl;
+  curl.SetRequestHeader(MHD_HTTP_HEADER_RANGE, "");
+  ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
+  EXPECT_STREQ(TEST_FILES_DATA_RANGES, result.c_str());
+  CheckRangesTestFileResponse(curl);
+}
+
+TEST_F(TestWebServerWithJobManager, CanGetRangedFileWithReadAhead)
+{
+  const std::string rangedFileContent = TEST_FILES_DATA_RANGES;
+  std::vector<std::string> rangedContent = StringUtils::Split(TEST_FILES_DATA_RANGES, ";");
+  const std::string range = GenerateRangeHeaderValue(0, rangedContent.front().size() - 1) + "," +
+                            GenerateRangeHeaderValue(rangedFileContent.size() - rangedContent.back().size(),
+                                                     rangedFileContent.size() - 1);
+
+  CHttpRanges ranges;
+  ASSERT_TRUE(ranges.Parse(range, rangedFileContent.size()));
+
+  // the two ranges are written from separate read-ahead jobs
+  std::string result;
+  CCurlFile curl;
+  curl.SetRequestHeader(MHD_HTTP_HEADER_RANGE, range);
+  ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
+  CheckRangesTestFileResponse(curl, result, ranges);
+}
+
+TEST_F(TestWebServerWithJobManager, CanGetCachedFileWithExactIfModifiedSince)
+{
+  // get the last modified date of the file
+  CDateTime lastModified;
+  ASSERT_TRUE(GetLastModifiedOfTestFile(TEST_FILES_RANGES, lastModified));
+
+  // the last modified date is only known once the file has been opened in the background
+  std::string result;
+  CCurlFile curl;
+  curl.SetRequestHeader(MHD_HTTP_HEADER_RANGE, "");
+  curl.SetRequestHeader(MHD_HTTP_HEADER_IF_MODIFIED_SINCE, lastModified.GetAsRFC1123DateTime());
+  ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
+  ASSERT_TRUE(result.empty());
+  CheckRangesTestFileResponse(curl, MHD_HTTP_NOT_MODIFIED, true);
+}
+
+TEST_F(TestWebServerWithJobManager, CanNotGetNonExistingFile)
+{
+  std::string result;
+  CCurlFile curl;
+  ASSERT_FALSE(curl.Get(GetUrlOfTestFile("file_does_not_exist"), result));
+  ASSERT_TRUE(result.empty());
+}
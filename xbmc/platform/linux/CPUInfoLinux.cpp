@@ -209,6 +209,20 @@ CCPUInfoLinux::CCPUInfoLinux()
 
     if (ecx & CPUID_00000001_ECX_SSE42)
       m_cpuFeatures |= CPU_FEATURE_SSE42;
+
+    // AVX2 also needs the OS to save the YMM registers on context switches
+    if ((ecx & CPUID_00000001_ECX_OSXSAVE) && (ecx & CPUID_00000001_ECX_AVX) &&
+        __get_cpuid_max(CPUID_INFOTYPE_MANUFACTURER, nullptr) >= CPUID_INFOTYPE_STRUCTURED_EXTENDED)
+    {
+      unsigned int xcr0;
+      unsigned int xcr0High;
+      __asm__ volatile("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+
+      unsigned int ebx;
+      __cpuid_count(CPUID_INFOTYPE_STRUCTURED_EXTENDED, 0, eax, ebx, ecx, edx);
+      if ((xcr0 & XCR0_SSE_AVX_STATE) == XCR0_SSE_AVX_STATE && (ebx & CPUID_00000007_EBX_AVX2))
+        m_cpuFeatures |= CPU_FEATURE_AVX2;
+    }
   }
 
   if (__get_cpuid(CPUID_INFOTYPE_EXTENDED_IMPLEMENTED, &eax, &eax, &ecx, &edx))
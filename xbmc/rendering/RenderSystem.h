@@ -24,6 +24,16 @@
 class CGUIImage;
 class CGUITextLayout;
 
+/*!
+ * \brief Draw counters of the GUI for one rendered frame
+ */
+struct GUIDrawStats
+{
+  unsigned int drawCalls = 0; ///< draw calls submitted for textures, quads and text
+  unsigned int textures = 0; ///< textures rendered by controls
+  unsigned int quads = 0; ///< quads submitted with those draw calls
+};
+
 class CRenderSystemBase
 {
 public:
@@ -77,7 +87,41 @@ public:
 
   virtual void ShowSplash(const std::string& message);
 
+  /*!
+   * \brief Start collecting GUI texture draws instead of drawing them immediately
+   *
+   * Render systems that can batch merge consecutive draws sharing texture, shader and
+   * color until EndGUIBatch() or a state change forces them out. Calls may be nested.
+   */
+  virtual void BeginGUIBatch() {}
+  virtual void EndGUIBatch() {}
+
+  /*!
+   * \brief Draw everything collected so far
+   *
+   * Must be called before drawing to the framebuffer without going through the render system.
+   */
+  virtual void FlushGUIBatch() {}
+
+  void CountGUIDrawCall(unsigned int quads)
+  {
+    m_guiDrawStatsFrame.drawCalls++;
+    m_guiDrawStatsFrame.quads += quads;
+  }
+  void CountGUITexture() { m_guiDrawStatsFrame.textures++; }
+
+  /*!
+   * \brief Draw counters of the last completed frame
+   */
+  const GUIDrawStats& GetGUIDrawStats() const { return m_guiDrawStats; }
+
 protected:
+  void ResetGUIDrawStats()
+  {
+    m_guiDrawStats = m_guiDrawStatsFrame;
+    m_guiDrawStatsFrame = {};
+  }
+
   bool                m_bRenderCreated;
   bool                m_bVSync;
   unsigned int        m_maxTextureSize;
@@ -92,6 +136,9 @@ protected:
   RENDER_STEREO_MODE m_stereoMode = RENDER_STEREO_MODE_OFF;
   bool m_limitedColorRange = false;
 
+  GUIDrawStats m_guiDrawStats;
+  GUIDrawStats m_guiDrawStatsFrame;
+
   std::unique_ptr<CGUIImage> m_splashImage;
   std::unique_ptr<CGUITextLayout> m_splashMessageLayout;
 };
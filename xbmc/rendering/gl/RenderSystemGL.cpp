@@ -10,6 +10,7 @@
 
 #include "ServiceBroker.h"
 #include "URL.h"
+#include "guilib/GUITextureBatchGL.h"
 #include "guilib/GUITextureGL.h"
 #include "rendering/MatrixGL.h"
 #include "settings/AdvancedSettings.h"
@@ -27,7 +28,8 @@
 
 using namespace std::chrono_literals;
 
-CRenderSystemGL::CRenderSystemGL() : CRenderSystemBase()
+CRenderSystemGL::CRenderSystemGL()
+  : CRenderSystemBase(), m_guiTextureBatch(std::make_unique<CGUITextureBatchGL>(*this))
 {
 }
 
@@ -151,6 +153,8 @@ bool CRenderSystemGL::ResetRenderSystem(int width, int height)
   if (!m_bRenderCreated)
     return false;
 
+  m_guiTextureBatch->Reset();
+
   m_width = width;
   m_height = height;
 
@@ -230,6 +234,8 @@ bool CRenderSystemGL::ResetRenderSystem(int width, int height)
 
 bool CRenderSystemGL::DestroyRenderSystem()
 {
+  m_guiTextureBatch->Reset();
+
   if (m_vertexArray != GL_NONE)
   {
     glDeleteVertexArrays(1, &m_vertexArray);
@@ -255,6 +261,8 @@ bool CRenderSystemGL::BeginRender()
   }
 
   m_limitedColorRange = useLimited;
+
+  ResetGUIDrawStats();
   return true;
 }
 
@@ -263,6 +271,8 @@ bool CRenderSystemGL::EndRender()
   if (!m_bRenderCreated)
     return false;
 
+  m_guiTextureBatch->Flush();
+
   return true;
 }
 
@@ -275,6 +285,8 @@ bool CRenderSystemGL::ClearBuffers(UTILS::COLOR::Color color)
   if(m_stereoMode == RENDER_STEREO_MODE_INTERLACED && m_stereoView == RENDER_STEREO_VIEW_RIGHT)
     return true;
 
+  m_guiTextureBatch->Flush();
+
   float r = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color) / 255.0f;
   float g = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color) / 255.0f;
   float b = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::B, color) / 255.0f;
@@ -353,6 +365,9 @@ void CRenderSystemGL::CaptureStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  // whoever renders next doesn't know about our pending quads
+  m_guiTextureBatch->Flush();
+
   glMatrixProject.Push();
   glMatrixModview.Push();
   glMatrixTexture.Push();
@@ -384,6 +399,8 @@ void CRenderSystemGL::SetCameraPosition(const CPoint &camera, int screenWidth, i
   if (!m_bRenderCreated)
     return;
 
+  m_guiTextureBatch->Flush();
+
   CPoint offset = camera - CPoint(screenWidth*0.5f, screenHeight*0.5f);
 
 
@@ -459,12 +476,15 @@ void CRenderSystemGL::SetViewPort(const CRect& viewPort)
   if (!m_bRenderCreated)
     return;
 
+  m_guiTextureBatch->Flush();
+
   glScissor((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   glViewport((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   m_viewPort[0] = viewPort.x1;
   m_viewPort[1] = m_height - viewPort.y1 - viewPort.Height();
   m_viewPort[2] = viewPort.Width();
   m_viewPort[3] = viewPort.Height();
+  m_scissors = {m_viewPort[0], m_viewPort[1], m_viewPort[2], m_viewPort[3]};
 }
 
 bool CRenderSystemGL::ScissorsCanEffectClipping()
@@ -497,7 +517,15 @@ void CRenderSystemGL::SetScissors(const CRect &rect)
   GLint y1 = MathUtils::round_int(static_cast<double>(rect.y1));
   GLint x2 = MathUtils::round_int(static_cast<double>(rect.x2));
   GLint y2 = MathUtils::round_int(static_cast<double>(rect.y2));
-  glScissor(x1, m_height - y2, x2-x1, y2-y1);
+
+  // GUI textures clip themselves with the scissors, so only a real change splits a batch
+  const std::array<GLint, 4> scissors = {x1, m_height - y2, x2 - x1, y2 - y1};
+  if (scissors != m_scissors)
+  {
+    m_guiTextureBatch->Flush();
+    m_scissors = scissors;
+  }
+  glScissor(scissors[0], scissors[1], scissors[2], scissors[3]);
 }
 
 void CRenderSystemGL::ResetScissors()
@@ -565,6 +593,8 @@ static const GLubyte stipple_3d[] = {
 
 void CRenderSystemGL::SetStereoMode(RENDER_STEREO_MODE mode, RENDER_STEREO_VIEW view)
 {
+  m_guiTextureBatch->Flush();
+
   CRenderSystemBase::SetStereoMode(mode, view);
 
   glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
@@ -743,6 +773,9 @@ void CRenderSystemGL::ReleaseShaders()
 
 void CRenderSystemGL::EnableShader(ShaderMethodGL method)
 {
+  // fonts and untextured quads draw straight away, so pending textures have to go first
+  m_guiTextureBatch->Flush();
+
   m_method = method;
   if (m_pShader[m_method])
   {
@@ -827,3 +860,21 @@ std::string CRenderSystemGL::GetShaderPath(const std::string &filename)
 
   return path;
 }
+
+void CRenderSystemGL::BeginGUIBatch()
+{
+  if (!CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiBatchTextures)
+    return;
+
+  m_guiTextureBatch->BeginScope();
+}
+
+void CRenderSystemGL::EndGUIBatch()
+{
+  m_guiTextureBatch->EndScope();
+}
+
+void CRenderSystemGL::FlushGUIBatch()
+{
+  m_guiTextureBatch->Flush();
+}
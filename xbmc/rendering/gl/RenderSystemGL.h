@@ -13,6 +13,7 @@
 #include "utils/ColorUtils.h"
 #include "utils/Map.h"
 
+#include <array>
 #include <map>
 #include <memory>
 
@@ -61,6 +62,8 @@ private:
                 "add/remove a mapping?");
 };
 
+class CGUITextureBatchGL;
+
 class CRenderSystemGL : public CRenderSystemBase
 {
 public:
@@ -115,6 +118,12 @@ public:
   GLint ShaderGetUniCol();
   GLint ShaderGetModel();
 
+  // batching of GUI textures
+  void BeginGUIBatch() override;
+  void EndGUIBatch() override;
+  void FlushGUIBatch() override;
+  CGUITextureBatchGL& GetGUITextureBatch() { return *m_guiTextureBatch; }
+
 protected:
   virtual void SetVSyncImpl(bool enable) = 0;
   virtual void PresentRenderImpl(bool rendered) = 0;
@@ -136,4 +145,7 @@ protected:
   std::map<ShaderMethodGL, std::unique_ptr<CGLShader>> m_pShader;
   ShaderMethodGL m_method = ShaderMethodGL::SM_DEFAULT;
   GLuint m_vertexArray = GL_NONE;
+
+  std::unique_ptr<CGUITextureBatchGL> m_guiTextureBatch;
+  std::array<GLint, 4> m_scissors = {};
 };
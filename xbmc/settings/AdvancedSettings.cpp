@@ -12,6 +12,7 @@
 #include "ServiceBroker.h"
 #include "URL.h"
 #include "application/AppParams.h"
+#include "filesystem/DirectoryCache.h"
 #include "filesystem/SpecialProtocol.h"
 #include "network/DNSNameCache.h"
 #include "profiles/ProfileManager.h"
@@ -308,12 +309,14 @@ void CAdvancedSettings::Initialize()
   m_musicArtistSeparators = { ";", " feat. ", " ft. " };
   m_videoItemSeparator = " / ";
   m_iMusicLibraryDateAdded = 1; // prefer mtime over ctime and current time
+  m_iMusicLibraryTagReaderThreads = 1;
   m_bMusicLibraryUseISODates = false;
 
   m_bVideoLibraryAllItemsOnBottom = false;
   m_iVideoLibraryRecentlyAddedItems = 25;
   m_bVideoLibraryCleanOnUpdate = false;
   m_bVideoLibraryUseFastHash = true;
+  m_iVideoLibraryScanThreads = 1;
   m_bVideoScannerIgnoreErrors = false;
   m_iVideoLibraryDateAdded = 1; // prefer mtime over ctime and current time
 
@@ -404,17 +407,35 @@ void CAdvancedSettings::Initialize()
   // as multiply of the default data read rate
   m_cacheReadFactor = 4.0f;
 
+  // number of parallel range requests used to fill the cache from http(s)/dav(s)
+  // sources, 1 disables segmented downloads
+  m_cacheSegmentConnections = 1;
+  m_cacheSegmentSize = 1024 * 1024; // 1 MiB
+  // back the memory cache by a mapped temp file, lets the kernel evict parts of large buffers
+  m_cacheMemoryMapped = false;
+  // keep earlier cached ranges of a file around after seeks
+  m_cacheSparseRanges = false;
+  g_directoryCache.ResetStatCacheTTLs();
+
   m_addonPackageFolderSize = 200;
 
   m_jsonOutputCompact = true;
   m_jsonTcpPort = 9090;
 
+  m_webserverThreadPoolSize = 2;
+  m_webserverRequestWorkers = 4;
+
   m_enableMultimediaKeys = false;
 
   m_canWindowed = true;
   m_guiVisualizeDirtyRegions = false;
   m_guiAlgorithmDirtyRegions = 3;
   m_guiSmartRedraw = false;
+  m_guiBatchTextures = true;
+  m_guiPersistFontGlyphs = false;
+  m_guiFrameProfiler = false;
+  m_guiFrameBudget = 16;
+  m_guiFrameProfilerThreshold = 100;
   m_airTunesPort = 36666;
   m_airPlayPort = 36667;
 
@@ -736,6 +757,21 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetFloat(pElement, "maxtempo", m_maxTempo, 1.5, 2.1);
     XMLUtils::GetBoolean(pElement, "preferstereostream", m_videoPreferStereoStream);
 
+    // software decoder threading: mode auto, frame or slice, thread count 0 = automatic,
+    // livemaxdelay limits the frame threading delay for live streams in ms (0 = no limit),
+    // lowlatency lets auto use slice threads for live streams with unknown slices
+    TiXmlElement* pDecoderThreads = pElement->FirstChildElement("decoderthreads");
+    if (pDecoderThreads)
+    {
+      XMLUtils::GetString(pDecoderThreads, "mode", m_videoDecoderThreadMode);
+      XMLUtils::GetInt(pDecoderThreads, "count", m_videoDecoderThreads, 0, 16);
+      XMLUtils::GetInt(pDecoderThreads, "livemaxdelay", m_videoDecoderLiveMaxDelay, 0, 1000);
+      XMLUtils::GetBoolean(pDecoderThreads, "lowlatency", m_videoDecoderLowLatency);
+    }
+
+    // file the render pacing histograms are written to when playback stops
+    XMLUtils::GetPath(pElement, "renderpacingfile", m_videoRenderPacingFile);
+
     // Store global display latency settings
     TiXmlElement* pVideoLatency = pElement->FirstChildElement("latency");
     if (pVideoLatency)
@@ -788,6 +824,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetString(pElement, "itemseparator", m_musicItemSeparator);
     XMLUtils::GetInt(pElement, "dateadded", m_iMusicLibraryDateAdded);
     XMLUtils::GetBoolean(pElement, "useisodates", m_bMusicLibraryUseISODates);
+    XMLUtils::GetInt(pElement, "tagreaderthreads", m_iMusicLibraryTagReaderThreads, 1, 32);
     //Music artist name separators
     TiXmlElement* separators = pElement->FirstChildElement("artistseparators");
     if (separators)
@@ -810,6 +847,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "recentlyaddeditems", m_iVideoLibraryRecentlyAddedItems, 1, INT_MAX);
     XMLUtils::GetBoolean(pElement, "cleanonupdate", m_bVideoLibraryCleanOnUpdate);
     XMLUtils::GetBoolean(pElement, "usefasthash", m_bVideoLibraryUseFastHash);
+    XMLUtils::GetInt(pElement, "scanthreads", m_iVideoLibraryScanThreads, 1, 16);
     XMLUtils::GetString(pElement, "itemseparator", m_videoItemSeparator);
     XMLUtils::GetBoolean(pElement, "importwatchedstate", m_bVideoLibraryImportWatchedState);
     XMLUtils::GetBoolean(pElement, "importresumepoint", m_bVideoLibraryImportResumePoint);
@@ -855,6 +893,39 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetUInt(pElement, "buffermode", m_cacheBufferMode, 0, 4);
     XMLUtils::GetUInt(pElement, "chunksize", m_cacheChunkSize, 256, 1024 * 1024);
     XMLUtils::GetFloat(pElement, "readfactor", m_cacheReadFactor);
+    XMLUtils::GetUInt(pElement, "segmentconnections", m_cacheSegmentConnections, 1, 16);
+    XMLUtils::GetUInt(pElement, "segmentsize", m_cacheSegmentSize, 64 * 1024, 64 * 1024 * 1024);
+    XMLUtils::GetBoolean(pElement, "memorymapped", m_cacheMemoryMapped);
+    XMLUtils::GetBoolean(pElement, "sparseranges", m_cacheSparseRanges);
+  }
+
+  // <statcache><ttl protocol="smb" positive="30" negative="5"/></statcache>
+  // path="smb://server/share/" limits a rule to a subtree, a ttl of 0 disables caching.
+  // Exists()/Stat() results are only cached for protocols or paths listed here.
+  pElement = pRootElement->FirstChildElement("statcache");
+  if (pElement)
+  {
+    const TiXmlElement* pTTL = pElement->FirstChildElement("ttl");
+    while (pTTL)
+    {
+      const char* prefix = pTTL->Attribute("path");
+      if (!prefix)
+        prefix = pTTL->Attribute("protocol");
+
+      int positive = 0;
+      int negative = 0;
+      if (prefix && *prefix && pTTL->QueryIntAttribute("positive", &positive) == TIXML_SUCCESS)
+      {
+        if (pTTL->QueryIntAttribute("negative", &negative) != TIXML_SUCCESS)
+          negative = positive;
+        g_directoryCache.SetStatCacheTTL(prefix, std::chrono::seconds(std::max(positive, 0)),
+                                         std::chrono::seconds(std::max(negative, 0)));
+      }
+      else
+        CLog::Log(LOGWARNING, "Ignoring <ttl> in <statcache> without protocol/path or positive");
+
+      pTTL = pTTL->NextSiblingElement("ttl");
+    }
   }
 
   pElement = pRootElement->FirstChildElement("jsonrpc");
@@ -864,6 +935,13 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetUInt(pElement, "tcpport", m_jsonTcpPort);
   }
 
+  pElement = pRootElement->FirstChildElement("webserver");
+  if (pElement)
+  {
+    XMLUtils::GetUInt(pElement, "threadpoolsize", m_webserverThreadPoolSize, 0, 64);
+    XMLUtils::GetUInt(pElement, "requestworkers", m_webserverRequestWorkers, 1, 64);
+  }
+
   pElement = pRootElement->FirstChildElement("samba");
   if (pElement)
   {
@@ -1224,6 +1302,11 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
     XMLUtils::GetInt(pElement, "algorithmdirtyregions",     m_guiAlgorithmDirtyRegions);
     XMLUtils::GetBoolean(pElement, "smartredraw", m_guiSmartRedraw);
+    XMLUtils::GetBoolean(pElement, "batchtextures", m_guiBatchTextures);
+    XMLUtils::GetBoolean(pElement, "persistfontglyphs", m_guiPersistFontGlyphs);
+    XMLUtils::GetBoolean(pElement, "frameprofiler", m_guiFrameProfiler);
+    XMLUtils::GetInt(pElement, "framebudget", m_guiFrameBudget, 1, 1000);
+    XMLUtils::GetInt(pElement, "frameprofilerthreshold", m_guiFrameProfilerThreshold, 0, 1000000);
   }
 
   std::string seekSteps;
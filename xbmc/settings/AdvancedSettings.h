@@ -173,6 +173,11 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int  m_videoFpsDetect;
     float m_maxTempo;
     bool m_videoPreferStereoStream = false;
+    std::string m_videoDecoderThreadMode = "auto";
+    int m_videoDecoderThreads = 0;
+    int m_videoDecoderLiveMaxDelay = 100;
+    bool m_videoDecoderLowLatency = false;
+    std::string m_videoRenderPacingFile;
 
     std::string m_videoDefaultPlayer;
     float m_videoPlayCountMinimumPercent;
@@ -245,6 +250,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
 
     int m_iMusicLibraryRecentlyAddedItems;
     int m_iMusicLibraryDateAdded;
+    int m_iMusicLibraryTagReaderThreads; //!< files read at once when scanning tags
     bool m_bMusicLibraryAllItemsOnBottom;
     bool m_bMusicLibraryCleanOnUpdate;
     bool m_bMusicLibraryArtistSortOnUpdate;
@@ -260,6 +266,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iVideoLibraryRecentlyAddedItems;
     bool m_bVideoLibraryCleanOnUpdate;
     bool m_bVideoLibraryUseFastHash;
+    int m_iVideoLibraryScanThreads; //!< directories fetched concurrently during a scan
     bool m_bVideoLibraryImportWatchedState{true};
     bool m_bVideoLibraryImportResumePoint{true};
 
@@ -333,16 +340,28 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_guiVisualizeDirtyRegions;
     int  m_guiAlgorithmDirtyRegions;
     bool m_guiSmartRedraw;
+    bool m_guiBatchTextures;
+    bool m_guiPersistFontGlyphs;
+    bool m_guiFrameProfiler;
+    int m_guiFrameBudget; ///< in ms
+    int m_guiFrameProfilerThreshold; ///< in us
     unsigned int m_addonPackageFolderSize;
 
     unsigned int m_cacheMemSize;
     unsigned int m_cacheBufferMode;
     unsigned int m_cacheChunkSize;
     float m_cacheReadFactor;
+    unsigned int m_cacheSegmentConnections;
+    unsigned int m_cacheSegmentSize;
+    bool m_cacheMemoryMapped;
+    bool m_cacheSparseRanges;
 
     bool m_jsonOutputCompact;
     unsigned int m_jsonTcpPort;
 
+    unsigned int m_webserverThreadPoolSize; ///< 0 for one thread per connection
+    unsigned int m_webserverRequestWorkers;
+
     bool m_enableMultimediaKeys;
     std::vector<std::string> m_settingsFiles;
     void ParseSettingsFile(const std::string &file);
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+std::atomic<uint64_t> allocationCount{0};
+
+void* Allocate(std::size_t size)
+{
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+} // namespace
+
+void* operator new(std::size_t size)
+{
+  return Allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+  return Allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+CAllocationCounter::CAllocationCounter(benchmark::State& state, int64_t itemsPerIteration)
+  : m_state(state), m_itemsPerIteration(itemsPerIteration), m_start(GetAllocationCount())
+{
+}
+
+CAllocationCounter::~CAllocationCounter()
+{
+  const double allocations = static_cast<double>(GetAllocationCount() - m_start);
+  m_state.counters["allocs"] = benchmark::Counter(allocations / m_itemsPerIteration,
+                                                  benchmark::Counter::kAvgIterations);
+}
+
+uint64_t CAllocationCounter::GetAllocationCount()
+{
+  return allocationCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,35 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <benchmark/benchmark.h>
+
+/*!
+ * \brief Counts the heap allocations made while a benchmark runs
+ *
+ * The bench binary replaces the global operator new to count allocations. Create the counter
+ * right before the benchmark loop; when it goes out of scope the number of allocations per
+ * iteration, divided by the number of items handled in one iteration, is reported as the
+ * "allocs" counter.
+ */
+class CAllocationCounter
+{
+public:
+  explicit CAllocationCounter(benchmark::State& state, int64_t itemsPerIteration = 1);
+  ~CAllocationCounter();
+
+  static uint64_t GetAllocationCount();
+
+private:
+  benchmark::State& m_state;
+  const int64_t m_itemsPerIteration;
+  const uint64_t m_start;
+};
@@ -0,0 +1,218 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "cores/AudioEngine/AESinkFactory.h"
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAE.h"
+#include "cores/AudioEngine/Interfaces/AEStream.h"
+#include "cores/AudioEngine/Sinks/AESinkNULL.h"
+#include "settings/Settings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/CPUInfo.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+// the engine pipelines a stream can end up in
+enum class Config
+{
+  PCM, // stream matches the sink
+  RESAMPLE, // 44.1 kHz stream on a sink fixed to 48 kHz
+  UPMIX, // stereo stream upmixed to 5.1
+  PASSTHROUGH, // AC3 packed into IEC 61937 bursts
+};
+
+constexpr unsigned int PCM_FRAMES_PER_ADD = 1024;
+constexpr unsigned int AC3_FRAME_BYTES = 1792; // 448 kbit/s at 48 kHz
+
+// the engine reads its settings on start, so every run brings up a fresh one
+// on top of the NULL sink
+class CNullSinkEngine
+{
+public:
+  CNullSinkEngine(Config config, bool realtime)
+  {
+    CServiceBroker::RegisterCPUInfo(CCPUInfo::GetCPUInfo());
+    CAESinkNULL::Register();
+
+    const std::string device = realtime ? "NULL:realtime" : "NULL:fast";
+    const std::shared_ptr<CSettings> settings =
+        CServiceBroker::GetSettingsComponent()->GetSettings();
+    settings->SetString(CSettings::SETTING_AUDIOOUTPUT_AUDIODEVICE, device);
+    settings->SetString(CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGHDEVICE, device);
+    settings->SetInt(CSettings::SETTING_AUDIOOUTPUT_CONFIG,
+                     config == Config::RESAMPLE ? AE_CONFIG_FIXED : AE_CONFIG_AUTO);
+    settings->SetInt(CSettings::SETTING_AUDIOOUTPUT_SAMPLERATE, 48000);
+    settings->SetInt(CSettings::SETTING_AUDIOOUTPUT_CHANNELS,
+                     config == Config::UPMIX ? AE_CH_LAYOUT_5_1 : AE_CH_LAYOUT_2_0);
+    settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_STEREOUPMIX, config == Config::UPMIX);
+    settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGH, config == Config::PASSTHROUGH);
+    settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_AC3PASSTHROUGH, true);
+
+    m_ae = std::make_unique<ActiveAE::CActiveAE>();
+    CServiceBroker::RegisterAE(m_ae.get());
+    m_ae->Start();
+  }
+
+  ~CNullSinkEngine()
+  {
+    CServiceBroker::UnregisterAE();
+    m_ae->Shutdown();
+    m_ae.reset();
+    AE::CAESinkFactory::ClearSinks();
+    CServiceBroker::UnregisterCPUInfo();
+  }
+
+  ActiveAE::CActiveAE& AE() { return *m_ae; }
+
+private:
+  std::unique_ptr<ActiveAE::CActiveAE> m_ae;
+};
+
+AEAudioFormat StreamFormat(Config config)
+{
+  AEAudioFormat format;
+  if (config == Config::PASSTHROUGH)
+  {
+    format.m_dataFormat = AE_FMT_RAW;
+    format.m_streamInfo.m_type = CAEStreamInfo::STREAM_TYPE_AC3;
+    format.m_streamInfo.m_sampleRate = 48000;
+    format.m_streamInfo.m_channels = 6;
+    format.m_streamInfo.m_repeat = 1;
+    format.m_sampleRate = 48000;
+    format.m_channelLayout = AE_CH_LAYOUT_2_0;
+    format.m_frameSize = 1;
+    return format;
+  }
+
+  format.m_dataFormat = AE_FMT_FLOAT;
+  format.m_sampleRate = config == Config::RESAMPLE ? 44100 : 48000;
+  format.m_channelLayout = AE_CH_LAYOUT_2_0;
+  format.m_frameSize = format.m_channelLayout.Count() * sizeof(float);
+  return format;
+}
+
+// a 1 kHz tone, or a single AC3 frame with a valid sync word for passthrough
+std::vector<uint8_t> StreamData(const AEAudioFormat& format)
+{
+  if (format.m_dataFormat == AE_FMT_RAW)
+  {
+    std::vector<uint8_t> frame(AC3_FRAME_BYTES);
+    frame[0] = 0x0B;
+    frame[1] = 0x77;
+    return frame;
+  }
+
+  const unsigned int channels = format.m_channelLayout.Count();
+  std::vector<float> samples(PCM_FRAMES_PER_ADD * channels);
+  for (unsigned int i = 0; i < PCM_FRAMES_PER_ADD; i++)
+  {
+    const float sample = 0.5f * std::sin(2.0f * static_cast<float>(M_PI) * 1000.0f * i /
+                                         format.m_sampleRate);
+    for (unsigned int c = 0; c < channels; c++)
+      samples[i * channels + c] = sample;
+  }
+
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(samples.data());
+  return std::vector<uint8_t>(bytes, bytes + samples.size() * sizeof(float));
+}
+
+bool AddAll(IAEStream& stream, const std::vector<uint8_t>& data, unsigned int frames)
+{
+  const uint8_t* planes[] = {data.data()};
+  unsigned int offset = 0;
+  // AddData gives up after a while without free buffers, retry a few times
+  for (int retries = 0; offset < frames && retries < 50; retries++)
+    offset += stream.AddData(planes, offset, frames - offset, nullptr);
+  return offset == frames;
+}
+} // namespace
+
+// pushes one second of synthetic audio per iteration through the engine into
+// the NULL sink, reports the input rate and the timing of the sink periods
+static void BM_ActiveAEStream(benchmark::State& state)
+{
+  const Config config = static_cast<Config>(state.range(0));
+  const bool realtime = state.range(1) != 0;
+
+  CNullSinkEngine engine(config, realtime);
+
+  AEAudioFormat format = StreamFormat(config);
+  if (format.m_dataFormat == AE_FMT_RAW && !engine.AE().SupportsRaw(format))
+  {
+    state.SkipWithError("NULL sink does not accept passthrough");
+    return;
+  }
+
+  IAE::StreamPtr stream = engine.AE().MakeStream(format);
+  if (!stream)
+  {
+    state.SkipWithError("no stream");
+    return;
+  }
+
+  const std::vector<uint8_t> data = StreamData(format);
+  const unsigned int framesPerAdd = data.size() / format.m_frameSize;
+  const double secondsPerAdd =
+      format.m_dataFormat == AE_FMT_RAW
+          ? format.m_streamInfo.GetDuration() / 1000
+          : static_cast<double>(framesPerAdd) / format.m_sampleRate;
+  const int addsPerIteration = static_cast<int>(std::ceil(1.0 / secondsPerAdd));
+
+  CAESinkNULL::ResetPeriodStats();
+
+  int64_t adds = 0;
+  for (auto _ : state)
+  {
+    for (int i = 0; i < addsPerIteration; i++)
+    {
+      if (!AddAll(*stream, data, framesPerAdd))
+      {
+        state.SkipWithError("stream stalled");
+        break;
+      }
+      adds++;
+    }
+  }
+
+  const CAESinkNULL::PeriodStats stats = CAESinkNULL::GetPeriodStats();
+  stream.get_deleter().setFinish(false);
+  stream.reset();
+
+  state.SetItemsProcessed(adds * framesPerAdd);
+  state.counters["media_s"] =
+      benchmark::Counter(adds * secondsPerAdd, benchmark::Counter::kIsRate);
+  state.counters["periods"] = stats.periods;
+  state.counters["underruns"] = stats.underruns;
+  if (stats.periods > 1)
+    state.counters["period_avg_ms"] = stats.intervalTotal / (stats.periods - 1);
+  state.counters["period_max_ms"] = stats.intervalMax;
+  state.counters["blocked_max_ms"] = stats.blockedMax;
+}
+// unthrottled device, measures the engine throughput
+BENCHMARK(BM_ActiveAEStream)
+    ->ArgNames({"config", "realtime"})
+    ->Args({static_cast<int>(Config::PCM), 0})
+    ->Args({static_cast<int>(Config::RESAMPLE), 0})
+    ->Args({static_cast<int>(Config::UPMIX), 0})
+    ->Args({static_cast<int>(Config::PASSTHROUGH), 0})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+// simulated device clock, the period counters show the engine's pacing
+BENCHMARK(BM_ActiveAEStream)
+    ->ArgNames({"config", "realtime"})
+    ->Args({static_cast<int>(Config::PCM), 1})
+    ->Args({static_cast<int>(Config::PASSTHROUGH), 1})
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/CharsetConverter.h"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+const std::string utf8Text = "Die Br\xc3\xbc"
+                             "cke am Flu\xc3\x9f - \xe6\x9d\xb1\xe4\xba\xac\xe7\x89\xa9\xe8\xaa\x9e";
+}
+
+static void BM_CharsetConverterUtf8ToW(benchmark::State& state)
+{
+  std::wstring result;
+  for (auto _ : state)
+  {
+    CCharsetConverter::utf8ToW(utf8Text, result);
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_CharsetConverterUtf8ToW);
+
+static void BM_CharsetConverterWToUtf8(benchmark::State& state)
+{
+  std::wstring wide;
+  CCharsetConverter::utf8ToW(utf8Text, wide);
+  std::string result;
+  for (auto _ : state)
+  {
+    CCharsetConverter::wToUTF8(wide, result);
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_CharsetConverterWToUtf8);
+
+static void BM_CharsetConverterUtf8ToUtf32(benchmark::State& state)
+{
+  std::u32string result;
+  for (auto _ : state)
+  {
+    CCharsetConverter::utf8ToUtf32(utf8Text, result);
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_CharsetConverterUtf8ToUtf32);
+
+static void BM_CharsetConverterUtf8ToSystem(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    std::string str(utf8Text);
+    CCharsetConverter::utf8ToSystem(str);
+    benchmark::DoNotOptimize(str);
+  }
+}
+BENCHMARK(BM_CharsetConverterUtf8ToSystem);
@@ -0,0 +1,54 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/CircularCache.h"
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using namespace XFILE;
+
+static void BM_CircularCacheWriteRead(benchmark::State& state)
+{
+  const size_t chunk = static_cast<size_t>(state.range(0));
+  CCircularCache cache(16 * 1024 * 1024, 4 * 1024 * 1024);
+  cache.Open();
+
+  std::vector<char> in(chunk, 'k');
+  std::vector<char> out(chunk);
+  for (auto _ : state)
+  {
+    cache.WriteToCache(in.data(), chunk);
+    benchmark::DoNotOptimize(cache.ReadFromCache(out.data(), chunk));
+  }
+  state.SetBytesProcessed(state.iterations() * chunk);
+
+  cache.Close();
+}
+BENCHMARK(BM_CircularCacheWriteRead)->Arg(4 * 1024)->Arg(64 * 1024)->Arg(1024 * 1024);
+
+static void BM_CircularCacheSeek(benchmark::State& state)
+{
+  constexpr size_t size = 8 * 1024 * 1024;
+  CCircularCache cache(size, size);
+  cache.Open();
+
+  std::vector<char> in(size, 'k');
+  cache.WriteToCache(in.data(), size);
+
+  int64_t pos = 0;
+  for (auto _ : state)
+  {
+    pos = (pos + 1024 * 1024 + 4096) % size;
+    benchmark::DoNotOptimize(cache.Seek(pos));
+  }
+
+  cache.Close();
+}
+BENCHMARK(BM_CircularCacheSeek);
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxUtils.h"
+#include "cores/VideoPlayer/DVDMessage.h"
+#include "cores/VideoPlayer/DVDMessageQueue.h"
+
+#include <memory>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+std::shared_ptr<CDVDMsg> MakePacket(int size)
+{
+  DemuxPacket* packet = CDVDDemuxUtils::AllocateDemuxPacket(size);
+  packet->iSize = size;
+  return std::make_shared<CDVDMsgDemuxerPacket>(packet);
+}
+} // namespace
+
+// put and get on the same thread, measures the per message overhead
+static void BM_DVDMessageQueuePutGet(benchmark::State& state)
+{
+  CDVDMessageQueue queue("bench");
+  queue.SetMaxDataSize(40 * 1024 * 1024);
+  queue.SetSingleProducerMode(state.range(0) != 0);
+  queue.Init();
+
+  std::shared_ptr<CDVDMsg> msg = MakePacket(1024);
+  for (auto _ : state)
+  {
+    queue.Put(msg);
+    queue.Get(msg, 0ms);
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  queue.End();
+}
+BENCHMARK(BM_DVDMessageQueuePutGet)->Arg(0)->Arg(1);
+
+// demuxer thread feeding a decoder thread, as VideoPlayer does
+static void BM_DVDMessageQueueThreaded(benchmark::State& state)
+{
+  constexpr int packets = 10000;
+
+  for (auto _ : state)
+  {
+    CDVDMessageQueue queue("bench");
+    queue.SetMaxDataSize(40 * 1024 * 1024);
+    queue.SetSingleProducerMode(state.range(0) != 0);
+    queue.Init();
+
+    std::thread consumer([&queue]() {
+      std::shared_ptr<CDVDMsg> msg;
+      for (int i = 0; i < packets; i++)
+        queue.Get(msg, 1s);
+    });
+
+    for (int i = 0; i < packets; i++)
+      queue.Put(MakePacket(1024));
+
+    consumer.join();
+    queue.End();
+  }
+  state.SetItemsProcessed(state.iterations() * packets);
+}
+BENCHMARK(BM_DVDMessageQueueThreaded)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
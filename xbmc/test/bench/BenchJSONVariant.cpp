@@ -0,0 +1,99 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AllocationCounter.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/Variant.h"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+CVariant CreateResult(int size)
+{
+  CVariant result(CVariant::VariantTypeObject);
+  for (int i = 0; i < size; i++)
+  {
+    CVariant item(CVariant::VariantTypeObject);
+    item["songid"] = i;
+    item["title"] = "Song title \xc3\xa4\xc3\xb6\xc3\xbc " + std::to_string(i);
+    item["artist"].push_back("Artist " + std::to_string(i % 100));
+    item["duration"] = 180 + i % 120;
+    item["rating"] = 0.5 * (i % 10);
+    result["songs"].push_back(item);
+  }
+  result["limits"]["start"] = 0;
+  result["limits"]["end"] = size;
+  result["limits"]["total"] = size;
+  return result;
+}
+} // namespace
+
+static void BM_JSONVariantWrite(benchmark::State& state)
+{
+  const CVariant result = CreateResult(state.range(0));
+  std::string output;
+  CAllocationCounter allocations(state);
+  for (auto _ : state)
+  {
+    output.clear();
+    CJSONVariantWriter::Write(result, output, true);
+    benchmark::DoNotOptimize(output);
+  }
+  state.SetBytesProcessed(state.iterations() * output.size());
+}
+BENCHMARK(BM_JSONVariantWrite)->Arg(100)->Arg(10000);
+
+static void BM_JSONVariantParse(benchmark::State& state)
+{
+  std::string json;
+  CJSONVariantWriter::Write(CreateResult(state.range(0)), json, true);
+  CAllocationCounter allocations(state, state.range(0));
+  for (auto _ : state)
+  {
+    CVariant result;
+    CJSONVariantParser::Parse(json, result);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_JSONVariantParse)->Arg(100)->Arg(10000);
+
+static void BM_JSONVariantParseRequest(benchmark::State& state)
+{
+  const std::string request =
+      R"({"jsonrpc":"2.0","method":"VideoLibrary.GetMovies","params":{"properties":["title",)"
+      R"("year","rating","art"],"limits":{"start":0,"end":50},"sort":{"method":"title"}},"id":1})";
+  CAllocationCounter allocations(state);
+  for (auto _ : state)
+  {
+    CVariant result;
+    CJSONVariantParser::Parse(request, result);
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_JSONVariantParseRequest);
+
+static void BM_JSONVariantParseRequestArena(benchmark::State& state)
+{
+  const std::string request =
+      R"({"jsonrpc":"2.0","method":"VideoLibrary.GetMovies","params":{"properties":["title",)"
+      R"("year","rating","art"],"limits":{"start":0,"end":50},"sort":{"method":"title"}},"id":1})";
+  CAllocationCounter allocations(state);
+  for (auto _ : state)
+  {
+    CVariantArena arena(4 * 1024);
+    CVariant result;
+    CJSONVariantParser::Parse(request, result, arena);
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_JSONVariantParseRequestArena);
@@ -0,0 +1,84 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "music/tags/MusicInfoTag.h"
+#include "utils/SortUtils.h"
+#include "utils/StringUtils.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+std::vector<CFileItemPtr> CreateSongs(int size)
+{
+  std::vector<CFileItemPtr> items;
+  items.reserve(size);
+  for (int i = 0; i < size; i++)
+  {
+    auto item = std::make_shared<CFileItem>(StringUtils::Format("The Song {}", i));
+    item->SetPath(StringUtils::Format("/music/Artist {}/Album {}/{:02} The Song {}.flac", i % 500,
+                                      i % 2000, i % 20, i));
+    MUSIC_INFO::CMusicInfoTag& tag = *item->GetMusicInfoTag();
+    tag.SetTitle(item->GetLabel());
+    tag.SetArtist(StringUtils::Format("Artist {}", i % 500));
+    tag.SetAlbum(StringUtils::Format("Album {}", i % 2000));
+    tag.SetTrackNumber(i % 20);
+    tag.SetLoaded(true);
+    items.push_back(item);
+  }
+
+  std::mt19937 random(42);
+  std::shuffle(items.begin(), items.end(), random);
+  return items;
+}
+
+void SortList(benchmark::State& state, SortBy sortBy, SortAttribute attributes)
+{
+  const std::vector<CFileItemPtr> items = CreateSongs(state.range(0));
+  SortDescription sorting;
+  sorting.sortBy = sortBy;
+  sorting.sortAttributes = attributes;
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    CFileItemList list;
+    for (const auto& item : items)
+      list.Add(item);
+    state.ResumeTiming();
+
+    list.Sort(sorting);
+    benchmark::DoNotOptimize(list.Get(0));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+static void BM_SortByLabel(benchmark::State& state)
+{
+  SortList(state, SortByLabel, SortAttributeIgnoreArticle);
+}
+BENCHMARK(BM_SortByLabel)->Arg(1000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+static void BM_SortByArtist(benchmark::State& state)
+{
+  SortList(state, SortByArtist, SortAttributeNone);
+}
+BENCHMARK(BM_SortByArtist)->Arg(1000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+static void BM_SortByTrackNumber(benchmark::State& state)
+{
+  SortList(state, SortByTrackNumber, SortAttributeNone);
+}
+BENCHMARK(BM_SortByTrackNumber)->Arg(1000)->Arg(50000)->Unit(benchmark::kMillisecond);
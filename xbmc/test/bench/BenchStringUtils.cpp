@@ -0,0 +1,68 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/StringUtils.h"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+static void BM_StringUtilsSplit(benchmark::State& state)
+{
+  const std::string input = "Action / Adventure / Comedy / Drama / Thriller / Science Fiction";
+  for (auto _ : state)
+    benchmark::DoNotOptimize(StringUtils::Split(input, " / "));
+}
+BENCHMARK(BM_StringUtilsSplit);
+
+static void BM_StringUtilsToLower(benchmark::State& state)
+{
+  const std::string input = "The Quick Brown Fox Jumps Over The Lazy Dog";
+  for (auto _ : state)
+    benchmark::DoNotOptimize(StringUtils::ToLower(input));
+}
+BENCHMARK(BM_StringUtilsToLower);
+
+static void BM_StringUtilsReplace(benchmark::State& state)
+{
+  const std::string input = "smb://server/share/some%20folder/some%20file%20name.mkv";
+  for (auto _ : state)
+  {
+    std::string str(input);
+    StringUtils::Replace(str, "%20", " ");
+    benchmark::DoNotOptimize(str);
+  }
+}
+BENCHMARK(BM_StringUtilsReplace);
+
+static void BM_StringUtilsFormat(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(StringUtils::Format("{} - S{:02}E{:02} - {}", "Show", 3, 12, "Title"));
+}
+BENCHMARK(BM_StringUtilsFormat);
+
+static void BM_StringUtilsAlphaNumericCompare(benchmark::State& state)
+{
+  const std::wstring left = L"Episode 10 - The Return";
+  const std::wstring right = L"Episode 9 - The Return";
+  for (auto _ : state)
+    benchmark::DoNotOptimize(StringUtils::AlphaNumericCompare(left.c_str(), right.c_str()));
+}
+BENCHMARK(BM_StringUtilsAlphaNumericCompare);
+
+static void BM_StringUtilsTrim(benchmark::State& state)
+{
+  const std::string input = "   \t some padded value \r\n  ";
+  for (auto _ : state)
+  {
+    std::string str(input);
+    benchmark::DoNotOptimize(StringUtils::Trim(str));
+  }
+}
+BENCHMARK(BM_StringUtilsTrim);
@@ -0,0 +1,53 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/URIUtils.h"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+const std::string path = "smb://nas/media/TV Shows/Some Show/Season 01/Some Show - S01E01.mkv";
+}
+
+static void BM_URIUtilsGetFileName(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(URIUtils::GetFileName(path));
+}
+BENCHMARK(BM_URIUtilsGetFileName);
+
+static void BM_URIUtilsGetExtension(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(URIUtils::GetExtension(path));
+}
+BENCHMARK(BM_URIUtilsGetExtension);
+
+static void BM_URIUtilsGetParentPath(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(URIUtils::GetParentPath(path));
+}
+BENCHMARK(BM_URIUtilsGetParentPath);
+
+static void BM_URIUtilsAddFileToFolder(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(URIUtils::AddFileToFolder("smb://nas/media/", "Movies", "file.mkv"));
+}
+BENCHMARK(BM_URIUtilsAddFileToFolder);
+
+static void BM_URIUtilsIsInternetStream(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(URIUtils::IsInternetStream(path));
+}
+BENCHMARK(BM_URIUtilsIsInternetStream);
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AllocationCounter.h"
+#include "utils/Variant.h"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+// roughly the shape of one item of a JSON-RPC library listing
+CVariant CreateItem(int index)
+{
+  CVariant item(CVariant::VariantTypeObject);
+  item["movieid"] = index;
+  item["label"] = "Some movie title " + std::to_string(index);
+  item["title"] = "Some movie title " + std::to_string(index);
+  item["year"] = 1950 + index % 70;
+  item["rating"] = 7.5;
+  item["file"] = "smb://nas/movies/Some movie title " + std::to_string(index) + ".mkv";
+  item["genre"].push_back("Drama");
+  item["genre"].push_back("Thriller");
+  item["art"]["poster"] = "image://poster" + std::to_string(index) + ".jpg/";
+  item["art"]["fanart"] = "image://fanart" + std::to_string(index) + ".jpg/";
+  return item;
+}
+
+CVariant CreateList(int size)
+{
+  CVariant list(CVariant::VariantTypeArray);
+  for (int i = 0; i < size; i++)
+    list.push_back(CreateItem(i));
+  return list;
+}
+} // namespace
+
+static void BM_VariantBuild(benchmark::State& state)
+{
+  CAllocationCounter allocations(state, state.range(0));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(CreateList(state.range(0)));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_VariantBuild)->Arg(100)->Arg(10000);
+
+static void BM_VariantCopy(benchmark::State& state)
+{
+  const CVariant list = CreateList(state.range(0));
+  CAllocationCounter allocations(state, state.range(0));
+  for (auto _ : state)
+  {
+    CVariant copy(list);
+    benchmark::DoNotOptimize(copy);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_VariantCopy)->Arg(100)->Arg(10000);
+
+static void BM_VariantLookup(benchmark::State& state)
+{
+  const CVariant item = CreateItem(1);
+  CAllocationCounter allocations(state);
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(item["title"].asString());
+    benchmark::DoNotOptimize(item["year"].asInteger());
+    benchmark::DoNotOptimize(item["art"]["poster"].asString());
+  }
+}
+BENCHMARK(BM_VariantLookup);
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "cores/VideoPlayer/VideoPlayerHeadless.h"
+
+#include <cstdlib>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+// the stages of the pipeline a run goes through
+enum class Stage
+{
+  DEMUX, // demuxer only
+  DECODE, // demuxer and software codecs
+  PRESENT, // the decoded pictures converted to BGRA as well
+};
+
+// media files are too big for the repository, CI points this at its clips
+constexpr const char* MEDIA_ENV = "KODI_BENCH_VIDEO";
+} // namespace
+
+// runs a whole file through the headless pipeline per iteration, reports the
+// decoding rate, the cpu time per frame and the A/V sync error
+static void BM_VideoPipeline(benchmark::State& state)
+{
+  const char* path = std::getenv(MEDIA_ENV);
+  if (!path || !*path)
+  {
+    state.SkipWithError("set KODI_BENCH_VIDEO to a media file");
+    return;
+  }
+
+  const Stage stage = static_cast<Stage>(state.range(0));
+  HeadlessPipelineOptions options;
+  options.decodeVideo = stage != Stage::DEMUX;
+  options.decodeAudio = stage != Stage::DEMUX;
+  options.present = stage == Stage::PRESENT;
+
+  CVideoPlayerHeadless player(options);
+  const CFileItem item(path, false);
+
+  HeadlessPipelineStats stats;
+  int64_t frames = 0;
+  int64_t packets = 0;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    if (!player.Open(item))
+    {
+      state.SkipWithError("failed to open the media file");
+      break;
+    }
+    state.ResumeTiming();
+
+    if (!player.Run())
+    {
+      state.SkipWithError("nothing decoded");
+      break;
+    }
+
+    stats = player.GetStats();
+    frames += stats.frames;
+    packets += stats.packets;
+  }
+  player.Close();
+
+  state.counters["packets"] = benchmark::Counter(packets, benchmark::Counter::kIsRate);
+  if (stage == Stage::DEMUX)
+    return;
+
+  state.SetItemsProcessed(frames);
+  state.counters["fps"] = benchmark::Counter(frames, benchmark::Counter::kIsRate);
+  state.counters["realtime_x"] = stats.seconds > 0 ? stats.mediaSeconds / stats.seconds : 0;
+  state.counters["dropped"] = stats.droppedFrames;
+  state.counters["cpu_frame_ms"] = stats.cpuAvg;
+  state.counters["cpu_frame_max_ms"] = stats.cpuMax;
+  state.counters["av_sync_avg_ms"] = stats.syncErrorAvg;
+  state.counters["av_sync_max_ms"] = stats.syncErrorMax;
+  if (stage == Stage::PRESENT)
+    state.counters["present_ms"] = stats.presentAvg;
+}
+BENCHMARK(BM_VideoPipeline)
+    ->ArgName("stage")
+    ->Arg(static_cast<int>(Stage::DEMUX))
+    ->Arg(static_cast<int>(Stage::DECODE))
+    ->Arg(static_cast<int>(Stage::PRESENT))
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
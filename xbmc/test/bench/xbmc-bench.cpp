@@ -0,0 +1,29 @@
+/*
+ *  Copyright (C) 2022 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "test/TestBasicEnvironment.h"
+
+#include <benchmark/benchmark.h>
+
+int main(int argc, char** argv)
+{
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  // same service setup as kodi-test, so benchmarks can use settings, VFS and charsets
+  TestBasicEnvironment environment;
+  environment.SetUp();
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  environment.TearDown();
+
+  return 0;
+}
@@ -435,6 +435,29 @@ bool DatabaseUtils::GetDatabaseResults(const MediaType &mediaType, const FieldLi
   if (dataset->num_rows() == 0)
     return true;
 
+  if (dataset->get_result_set().record_header.size() < fields.size())
+    return false;
+
+  std::vector<int> fieldIndexLookup;
+  fieldIndexLookup.reserve(fields.size());
+  for (FieldList::const_iterator it = fields.begin(); it != fields.end(); ++it)
+    fieldIndexLookup.push_back(GetFieldIndex(*it, mediaType));
+
+  return GetDatabaseResults(mediaType, fields, fieldIndexLookup, dataset, results);
+}
+
+bool DatabaseUtils::GetDatabaseResults(const MediaType& mediaType,
+                                       const FieldList& fields,
+                                       const std::vector<int>& fieldIndexLookup,
+                                       const std::unique_ptr<dbiplus::Dataset>& dataset,
+                                       DatabaseResults& results)
+{
+  if (dataset->num_rows() == 0)
+    return true;
+
+  if (fieldIndexLookup.size() != fields.size())
+    return false;
+
   const dbiplus::result_set &resultSet = dataset->get_result_set();
   unsigned int offset = results.size();
 
@@ -450,14 +473,6 @@ bool DatabaseUtils::GetDatabaseResults(const MediaType &mediaType, const FieldLi
     return true;
   }
 
-  if (resultSet.record_header.size() < fields.size())
-    return false;
-
-  std::vector<int> fieldIndexLookup;
-  fieldIndexLookup.reserve(fields.size());
-  for (FieldList::const_iterator it = fields.begin(); it != fields.end(); ++it)
-    fieldIndexLookup.push_back(GetFieldIndex(*it, mediaType));
-
   results.reserve(resultSet.records.size() + offset);
   for (unsigned int index = 0; index < resultSet.records.size(); index++)
   {
@@ -468,7 +483,7 @@ bool DatabaseUtils::GetDatabaseResults(const MediaType &mediaType, const FieldLi
     for (FieldList::const_iterator it = fields.begin(); it != fields.end(); ++it)
     {
       int fieldIndex = fieldIndexLookup[lookupIndex++];
-      if (fieldIndex < 0)
+      if (fieldIndex < 0 || fieldIndex >= static_cast<int>(resultSet.record_header.size()))
         return false;
 
       std::pair<Field, CVariant> value;
@@ -177,6 +177,15 @@ public:
 
   static bool GetFieldValue(const dbiplus::field_value &fieldValue, CVariant &variantValue);
   static bool GetDatabaseResults(const MediaType &mediaType, const FieldList &fields, const std::unique_ptr<dbiplus::Dataset> &dataset, DatabaseResults &results);
+  /*!
+   \brief Gets the values of the given fields from a dataset with a custom column layout
+   \param fieldIndexLookup Column of every field in the dataset, in the same order as fields
+   */
+  static bool GetDatabaseResults(const MediaType& mediaType,
+                                 const FieldList& fields,
+                                 const std::vector<int>& fieldIndexLookup,
+                                 const std::unique_ptr<dbiplus::Dataset>& dataset,
+                                 DatabaseResults& results);
 
   static std::string BuildLimitClause(int end, int start = 0);
   static std::string BuildLimitClauseOnly(int end, int start = 0);
@@ -13,7 +13,7 @@
 class CJSONVariantParserHandler
 {
 public:
-  explicit CJSONVariantParserHandler(CVariant& parsedObject);
+  CJSONVariantParserHandler(CVariant& parsedObject, CVariantArena* arena);
 
   bool Null();
   bool Bool(bool b);
@@ -44,6 +44,7 @@ private:
   void PopObject();
 
   CVariant& m_parsedObject;
+  CVariantArena* m_arena;
   std::vector<CVariant *> m_parse;
   std::string m_key;
   CVariant m_root;
@@ -57,8 +58,10 @@ private:
   PARSE_STATUS m_status;
 };
 
-CJSONVariantParserHandler::CJSONVariantParserHandler(CVariant& parsedObject)
+CJSONVariantParserHandler::CJSONVariantParserHandler(CVariant& parsedObject,
+                                                     CVariantArena* arena)
   : m_parsedObject(parsedObject),
+    m_arena(arena),
     m_parse(),
     m_key(),
     m_status(PARSE_STATUS::Variable)
@@ -114,14 +117,17 @@ bool CJSONVariantParserHandler::String(const char* str, rapidjson::SizeType leng
 
 bool CJSONVariantParserHandler::StartObject()
 {
-  PushObject(CVariant::VariantTypeObject);
+  if (m_arena != nullptr)
+    PushObject(CVariant(CVariant::VariantTypeObject, *m_arena));
+  else
+    PushObject(CVariant::VariantTypeObject);
 
   return true;
 }
 
 bool CJSONVariantParserHandler::Key(const char* str, rapidjson::SizeType length, bool copy)
 {
-  m_key = std::string(str, 0, length);
+  m_key.assign(str, length);
 
   return true;
 }
@@ -135,7 +141,10 @@ bool CJSONVariantParserHandler::EndObject(rapidjson::SizeType memberCount)
 
 bool CJSONVariantParserHandler::StartArray()
 {
-  PushObject(CVariant::VariantTypeArray);
+  if (m_arena != nullptr)
+    PushObject(CVariant(CVariant::VariantTypeArray, *m_arena));
+  else
+    PushObject(CVariant::VariantTypeArray);
 
   return true;
 }
@@ -153,8 +162,9 @@ void CJSONVariantParserHandler::PushObject(CVariant variant)
 
   if (m_status == PARSE_STATUS::Object)
   {
-    (*m_parse.back())[m_key] = std::move(variant);
-    m_parse.push_back(&((*m_parse.back())[m_key]));
+    CVariant& member = (*m_parse.back())[m_key];
+    member = std::move(variant);
+    m_parse.push_back(&member);
   }
   else if (m_status == PARSE_STATUS::Array)
   {
@@ -194,12 +204,14 @@ void CJSONVariantParserHandler::PopObject()
   }
   else
   {
-    m_parsedObject = *variant;
+    m_parsedObject = std::move(*variant);
     m_status = PARSE_STATUS::Variable;
   }
 }
 
-bool CJSONVariantParser::Parse(const char* json, CVariant& data)
+namespace
+{
+bool ParseJSON(const char* json, CVariant& data, CVariantArena* arena)
 {
   if (json == nullptr)
     return false;
@@ -207,7 +219,7 @@ bool CJSONVariantParser::Parse(const char* json, CVariant& data)
   rapidjson::Reader reader;
   rapidjson::StringStream stringStream(json);
 
-  CJSONVariantParserHandler handler(data);
+  CJSONVariantParserHandler handler(data, arena);
   // use kParseIterativeFlag to eliminate possible stack overflow
   // from json parsing via reentrant calls
   if (reader.Parse<rapidjson::kParseIterativeFlag>(stringStream, handler))
@@ -216,7 +228,24 @@ bool CJSONVariantParser::Parse(const char* json, CVariant& data)
   return false;
 }
 
+} // namespace
+
+bool CJSONVariantParser::Parse(const char* json, CVariant& data)
+{
+  return ParseJSON(json, data, nullptr);
+}
+
 bool CJSONVariantParser::Parse(const std::string& json, CVariant& data)
 {
   return Parse(json.c_str(), data);
 }
+
+bool CJSONVariantParser::Parse(const char* json, CVariant& data, CVariantArena& arena)
+{
+  return ParseJSON(json, data, &arena);
+}
+
+bool CJSONVariantParser::Parse(const std::string& json, CVariant& data, CVariantArena& arena)
+{
+  return Parse(json.c_str(), data, arena);
+}
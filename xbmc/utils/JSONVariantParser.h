@@ -19,4 +19,10 @@ public:
 
   static bool Parse(const char* json, CVariant& data);
   static bool Parse(const std::string& json, CVariant& data);
+
+  /*!
+   * \brief Parses into objects and arrays allocated on the given arena, which has to outlive data.
+   */
+  static bool Parse(const char* json, CVariant& data, CVariantArena& arena);
+  static bool Parse(const std::string& json, CVariant& data, CVariantArena& arena);
 };
@@ -11,9 +11,27 @@
 #include "utils/Variant.h"
 
 #include <rapidjson/prettywriter.h>
-#include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+namespace
+{
+// rapidjson output stream appending straight to a std::string, this saves copying the whole
+// document out of a rapidjson::StringBuffer once it's written
+class CStringOutputStream
+{
+public:
+  typedef char Ch;
+
+  explicit CStringOutputStream(std::string& output) : m_output(output) {}
+
+  void Put(Ch c) { m_output.push_back(c); }
+  void Flush() {}
+
+private:
+  std::string& m_output;
+};
+} // namespace
+
 template<class TWriter>
 bool InternalWrite(TWriter& writer, const CVariant &value)
 {
@@ -52,7 +70,7 @@ bool InternalWrite(TWriter& writer, const CVariant &value)
 
     for (CVariant::const_iterator_map itr = value.begin_map(); itr != value.end_map(); ++itr)
     {
-      if (!writer.Key(itr->first.c_str()) ||
+      if (!writer.Key(itr->first.c_str(), static_cast<rapidjson::SizeType>(itr->first.size())) ||
         !InternalWrite(writer, itr->second))
         return false;
     }
@@ -70,23 +88,24 @@ bool InternalWrite(TWriter& writer, const CVariant &value)
 
 bool CJSONVariantWriter::Write(const CVariant &value, std::string& output, bool compact)
 {
-  rapidjson::StringBuffer stringBuffer;
+  std::string json;
+  CStringOutputStream stream(json);
   if (compact)
   {
-    rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
+    rapidjson::Writer<CStringOutputStream> writer(stream);
 
     if (!InternalWrite(writer, value) || !writer.IsComplete())
       return false;
   }
   else
   {
-    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(stringBuffer);
+    rapidjson::PrettyWriter<CStringOutputStream> writer(stream);
     writer.SetIndent('\t', 1);
 
     if (!InternalWrite(writer, value) || !writer.IsComplete())
       return false;
   }
 
-  output = stringBuffer.GetString();
+  output = std::move(json);
   return true;
 }
@@ -16,7 +16,16 @@
 #include "utils/Variant.h"
 
 #include <algorithm>
+#include <future>
 #include <inttypes.h>
+#include <thread>
+
+namespace
+{
+// Tables smaller than this are sorted on the calling thread
+constexpr size_t PARALLEL_SORT_MIN_ITEMS = 8192;
+constexpr unsigned int PARALLEL_SORT_MAX_THREADS = 8;
+} // namespace
 
 std::string ArrayToString(SortAttribute attributes, const CVariant &variant, const std::string &separator = " / ")
 {
@@ -1383,3 +1392,154 @@ const std::string& SortUtils::SortOrderToString(SortOrder sortOrder)
 {
   return TypeToString<SortOrder>(sortOrders, sortOrder);
 }
+
+CSortTable::CSortTable(const SortDescription& sortDescription)
+  : m_sortDescription(sortDescription),
+    m_preparator(SortUtils::getPreparator(sortDescription.sortBy)),
+    m_fields(SortUtils::GetFieldsForSorting(sortDescription.sortBy)),
+    m_handleFolders((sortDescription.sortAttributes & SortAttributeIgnoreFolders) == 0)
+{
+}
+
+void CSortTable::Reserve(size_t count)
+{
+  m_entries.reserve(count);
+  m_labelOffsets.reserve(count);
+}
+
+void CSortTable::Add(SortItem& item)
+{
+  std::wstring sortLabel;
+  if (m_preparator != nullptr)
+  {
+    // add all fields to the item that are required for sorting if they are currently missing
+    for (const auto& field : m_fields)
+    {
+      if (item.find(field) == item.end())
+        item.insert(std::pair<Field, CVariant>(field, CVariant::ConstNullVariant));
+    }
+
+    g_charsetConverter.utf8ToW(m_preparator(m_sortDescription.sortAttributes, item), sortLabel,
+                               false);
+  }
+
+  Entry entry;
+  entry.index = static_cast<uint32_t>(m_entries.size());
+
+  entry.special = SortSpecialNone;
+  const auto itSpecial = item.find(FieldSortSpecial);
+  if (itSpecial != item.end() && itSpecial->second.asInteger() <= (int64_t)SortSpecialOnBottom)
+    entry.special = static_cast<int8_t>(itSpecial->second.asInteger());
+
+  entry.folder = -1;
+  const auto itFolder = item.find(FieldFolder);
+  if (itFolder != item.end())
+    entry.folder = itFolder->second.asBoolean() ? 1 : 0;
+
+  StringUtils::GetAlphaNumericKey(sortLabel.c_str(), entry.key);
+
+  m_labelOffsets.push_back(m_labels.size());
+  m_labels.insert(m_labels.end(), sortLabel.begin(), sortLabel.end());
+  m_labels.push_back(L'\0');
+
+  m_entries.push_back(entry);
+}
+
+bool CSortTable::Less(const Entry& left, const Entry& right) const
+{
+  // same rules as preliminarySort()
+  if (left.special != right.special)
+    return left.special == SortSpecialOnTop || right.special == SortSpecialOnBottom;
+  else if (left.special != SortSpecialNone)
+    return false;
+
+  if (m_handleFolders && left.folder >= 0 && right.folder >= 0 && left.folder != right.folder)
+    return left.folder == 1;
+
+  int64_t result;
+  if (!StringUtils::CompareAlphaNumericKeys(left.key, right.key, result))
+    result = StringUtils::AlphaNumericCompare(&m_labels[m_labelOffsets[left.index]],
+                                              &m_labels[m_labelOffsets[right.index]]);
+
+  return m_sortDescription.sortOrder == SortOrderDescending ? result > 0 : result < 0;
+}
+
+std::vector<size_t> CSortTable::Sort()
+{
+  // Without a sort label SortUtils::Sort() leaves the order as it is
+  if (m_sortDescription.sortBy != SortByNone && m_preparator != nullptr)
+  {
+    const auto less = [this](const Entry& left, const Entry& right) { return Less(left, right); };
+
+    const unsigned int threads = std::min(std::thread::hardware_concurrency(),
+                                          PARALLEL_SORT_MAX_THREADS);
+    if (m_entries.size() < PARALLEL_SORT_MIN_ITEMS || threads < 2)
+    {
+      std::stable_sort(m_entries.begin(), m_entries.end(), less);
+    }
+    else
+    {
+      // Sort chunks in parallel, then merge neighbours until a single chunk is left. Both keep
+      // equal items in order, so the result is the same as a single stable sort.
+      std::vector<size_t> bounds;
+      for (unsigned int i = 0; i < threads; i++)
+        bounds.push_back(m_entries.size() * i / threads);
+      bounds.push_back(m_entries.size());
+
+      std::vector<std::future<void>> tasks;
+      for (size_t i = 0; i + 1 < bounds.size(); i++)
+      {
+        tasks.emplace_back(std::async(std::launch::async, [this, &less, &bounds, i]() {
+          std::stable_sort(m_entries.begin() + bounds[i], m_entries.begin() + bounds[i + 1], less);
+        }));
+      }
+      for (std::future<void>& task : tasks)
+        task.wait();
+
+      while (bounds.size() > 2)
+      {
+        std::vector<size_t> merged;
+        tasks.clear();
+        for (size_t i = 0; i + 1 < bounds.size(); i += 2)
+        {
+          merged.push_back(bounds[i]);
+          if (i + 2 < bounds.size())
+          {
+            tasks.emplace_back(std::async(std::launch::async, [this, &less, &bounds, i]() {
+              std::inplace_merge(m_entries.begin() + bounds[i], m_entries.begin() + bounds[i + 1],
+                                 m_entries.begin() + bounds[i + 2], less);
+            }));
+          }
+        }
+        merged.push_back(bounds.back());
+        for (std::future<void>& task : tasks)
+          task.wait();
+
+        bounds = std::move(merged);
+      }
+    }
+  }
+
+  size_t start = 0;
+  size_t end = m_entries.size();
+  int limitEnd = m_sortDescription.limitEnd;
+  if (m_sortDescription.limitStart > 0 && (size_t)m_sortDescription.limitStart < end)
+  {
+    start = m_sortDescription.limitStart;
+    limitEnd -= m_sortDescription.limitStart;
+  }
+  if (limitEnd > 0 && (size_t)limitEnd < end - start)
+    end = start + limitEnd;
+
+  std::vector<size_t> order;
+  order.reserve(end - start);
+  for (size_t i = start; i < end; i++)
+    order.push_back(m_entries[i].index);
+
+  return order;
+}
+
+std::wstring CSortTable::GetSortLabel(size_t index) const
+{
+  return std::wstring(&m_labels[m_labelOffsets[index]]);
+}
@@ -11,6 +11,7 @@
 #include "DatabaseUtils.h"
 #include "LabelFormatter.h"
 #include "SortFileItem.h"
+#include "StringUtils.h"
 
 #include <map>
 #include <memory>
@@ -224,6 +225,8 @@ public:
   typedef bool (*SorterIndirect) (const SortItemPtr &, const SortItemPtr &);
 
 private:
+  friend class CSortTable;
+
   static const SortPreparator& getPreparator(SortBy sortBy);
   static Sorter getSorter(SortOrder sortOrder, SortAttribute attributes);
   static SorterIndirect getSorterIndirect(SortOrder sortOrder, SortAttribute attributes);
@@ -231,3 +234,63 @@ private:
   static std::map<SortBy, SortPreparator> m_preparators;
   static std::map<SortBy, Fields> m_sortingFields;
 };
+
+/*!
+ \brief Sorts a large number of items by index
+
+ Unlike SortUtils::Sort(), the items don't have to be kept around as SortItem while sorting.
+ Every added item is reduced to what the sorting needs: its sort label, stored in one shared
+ buffer, a key from StringUtils::GetAlphaNumericKey() deciding most comparisons without looking
+ at the label, and its special sorting and folder flags. Big tables are sorted in parallel.
+
+ The order is the same SortUtils::Sort() gives for the same items.
+ */
+class CSortTable
+{
+public:
+  explicit CSortTable(const SortDescription& sortDescription);
+
+  /*!
+   \brief The fields the added items need, see SortUtils::GetFieldsForSorting()
+   */
+  const Fields& GetFields() const { return m_fields; }
+
+  void Reserve(size_t count);
+
+  /*!
+   \brief Add the next item, its index is the number of items added before
+   \param item the item, missing fields needed for sorting are added to it
+   */
+  void Add(SortItem& item);
+
+  /*!
+   \brief Sort the added items
+   \return indexes of the added items in sort order, limited by the sort description
+   */
+  std::vector<size_t> Sort();
+
+  /*!
+   \brief Sort label of an added item, as SortUtils::Sort() sets it in FieldSort
+   */
+  std::wstring GetSortLabel(size_t index) const;
+
+private:
+  struct Entry
+  {
+    uint32_t key[StringUtils::ALPHANUMERIC_KEY_SIZE];
+    uint32_t index;
+    int8_t special;
+    int8_t folder; ///< -1 if unknown
+  };
+
+  bool Less(const Entry& left, const Entry& right) const;
+
+  const SortDescription m_sortDescription;
+  const SortUtils::SortPreparator m_preparator;
+  const Fields m_fields;
+  const bool m_handleFolders;
+
+  std::vector<Entry> m_entries;
+  std::vector<size_t> m_labelOffsets; ///< by index
+  std::vector<wchar_t> m_labels; ///< null terminated labels
+};
@@ -1191,6 +1191,116 @@ int64_t StringUtils::AlphaNumericCompare(const wchar_t* left, const wchar_t* rig
   return 0; // files are the same
 }
 
+namespace
+{
+// Units of an alphanumeric key, following the order of AlphaNumericCompare(). Symbols are
+// ordered by their value, other characters after all symbols. A run of digits is the DIGITS
+// unit followed by its value + 1, so it can't be taken for the end.
+constexpr uint32_t KEY_END = 0;
+constexpr uint32_t KEY_CHAR = 0x80;
+constexpr uint32_t KEY_DIGITS = KEY_CHAR + L'0';
+constexpr uint32_t KEY_UNDECIDED = 0xFFFFFFFF;
+} // namespace
+
+void StringUtils::GetAlphaNumericKey(const wchar_t* str, uint32_t* key)
+{
+  const bool useLocale = g_langInfo.UseLocaleCollation();
+
+  size_t pos = 0;
+  while (pos < ALPHANUMERIC_KEY_SIZE)
+  {
+    wchar_t c = *str;
+    if (c == 0)
+    {
+      key[pos++] = KEY_END;
+      break;
+    }
+
+    if (c >= L'0' && c <= L'9')
+    {
+      const wchar_t* d = str;
+      int64_t num = *d++ - L'0';
+      while (*d >= L'0' && *d <= L'9' && d < str + 15)
+      {
+        num *= 10;
+        num += *d++ - L'0';
+      }
+      str = d;
+
+      key[pos++] = KEY_DIGITS;
+      if (pos == ALPHANUMERIC_KEY_SIZE)
+        break;
+      if (num + 1 >= KEY_UNDECIDED)
+      {
+        key[pos++] = KEY_UNDECIDED;
+        break;
+      }
+      key[pos++] = static_cast<uint32_t>(num + 1);
+      continue;
+    }
+
+    const bool sym = (c >= 32 && c < L'0') || (c > L'9' && c < L'A') || (c > L'Z' && c < L'a') ||
+                     (c > L'z' && c < 128);
+    if (sym)
+    {
+      key[pos++] = static_cast<uint32_t>(c);
+      str++;
+      continue;
+    }
+
+    // Characters compared by the locale can't be ordered without it
+    if (useLocale)
+    {
+      key[pos++] = KEY_UNDECIDED;
+      break;
+    }
+
+    if (c > 128)
+      c = GetCollationWeight(c);
+    if (c >= L'A' && c <= L'Z')
+      c += L'a' - L'A';
+
+    // A single digit compares differently against every digit
+    if (c >= L'0' && c <= L'9')
+    {
+      key[pos++] = KEY_UNDECIDED;
+      break;
+    }
+
+    key[pos++] = KEY_CHAR + static_cast<uint32_t>(c);
+    str++;
+  }
+
+  while (pos < ALPHANUMERIC_KEY_SIZE)
+    key[pos++] = KEY_END;
+}
+
+bool StringUtils::CompareAlphaNumericKeys(const uint32_t* left,
+                                          const uint32_t* right,
+                                          int64_t& result)
+{
+  for (size_t i = 0; i < ALPHANUMERIC_KEY_SIZE; i++)
+  {
+    const uint32_t l = left[i];
+    const uint32_t r = right[i];
+    if (l == KEY_UNDECIDED || r == KEY_UNDECIDED)
+      return false;
+    if (l != r)
+    {
+      result = l < r ? -1 : 1;
+      return true;
+    }
+    if (l == KEY_END)
+    {
+      result = 0;
+      return true;
+    }
+  }
+
+  // Common prefix is longer than the key
+  return false;
+}
+
 /*
   Convert the UTF8 character to which z points into a 31-bit Unicode point.
   Return how many bytes (0 to 3) of UTF8 data encode the character.
@@ -237,6 +237,22 @@ public:
                                              size_t iMaxStrings = 0);
   static int FindNumber(const std::string& strInput, const std::string &strFind);
   static int64_t AlphaNumericCompare(const wchar_t *left, const wchar_t *right);
+  /*! \brief Fixed size prefix of the order AlphaNumericCompare() puts strings in
+
+   Comparing two keys with CompareAlphaNumericKeys() is much cheaper than comparing the strings,
+   and decides the order of most strings. Keys of strings with a long common prefix, or whose
+   order depends on the locale, are undecided and the strings have to be compared.
+
+   \param str the string to build the key for
+   \param key receives ALPHANUMERIC_KEY_SIZE key units
+   */
+  static void GetAlphaNumericKey(const wchar_t* str, uint32_t* key);
+  /*! \brief Compare two keys from GetAlphaNumericKey()
+   \param result receives the result AlphaNumericCompare() would give, if decided
+   \return true if the keys decide the order, false if the strings have to be compared
+   */
+  static bool CompareAlphaNumericKeys(const uint32_t* left, const uint32_t* right, int64_t& result);
+  static constexpr size_t ALPHANUMERIC_KEY_SIZE = 8;
   static int AlphaNumericCollation(int nKey1, const void* pKey1, int nKey2, const void* pKey2);
   static long TimeStringToSeconds(const std::string &timeString);
   static void RemoveCRLF(std::string& strLine);
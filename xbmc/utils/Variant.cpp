@@ -10,6 +10,7 @@
 
 #include "Variant.h"
 
+#include <algorithm>
 #include <charconv>
 #include <cstdlib>
 #include <cstring>
@@ -138,6 +139,42 @@ double str2double(std::wstring_view str, double fallback /* = 0.0 */)
   return fallback;
 }
 
+CVariantArena::CVariantArena(size_t blockSize /* = 16 * 1024 */) : m_blockSize(blockSize)
+{
+}
+
+CVariantArena::~CVariantArena() = default;
+
+void* CVariantArena::Allocate(size_t size, size_t alignment)
+{
+  const size_t padding =
+      (alignment - reinterpret_cast<uintptr_t>(m_current) % alignment) % alignment;
+  if (m_current == nullptr || padding + size > m_left)
+  {
+    // new[] returns memory aligned for any fundamental type
+    const size_t blockSize = std::max(m_blockSize, size);
+    m_blocks.emplace_back(new char[blockSize]);
+    m_reserved += blockSize;
+
+    // keep using the current block if it has more space left than the new one
+    if (blockSize - size < m_left)
+      return m_blocks.back().get();
+
+    m_current = m_blocks.back().get();
+    m_left = blockSize;
+  }
+  else
+  {
+    m_current += padding;
+    m_left -= padding;
+  }
+
+  void* result = m_current;
+  m_current += size;
+  m_left -= size;
+  return result;
+}
+
 CVariant::CVariant()
   : CVariant(VariantTypeNull)
 {
@@ -285,13 +322,17 @@ CVariant::CVariant(std::map<std::string, std::string>&& strMap)
 }
 
 CVariant::CVariant(const std::map<std::string, CVariant>& variantMap)
-  : m_data(std::in_place_type<VariantMap>, variantMap)
+  : m_data(std::in_place_type<VariantMap>, variantMap.begin(), variantMap.end())
 {
 }
 
 CVariant::CVariant(std::map<std::string, CVariant>&& variantMap)
-  : m_data(std::in_place_type<VariantMap>, std::move(variantMap))
 {
+  VariantMap tmpMap;
+  for (auto& elem : variantMap)
+    tmpMap.emplace_hint(tmpMap.end(), elem.first, std::move(elem.second));
+
+  m_data = std::move(tmpMap);
 }
 
 CVariant::CVariant(const CVariant& variant) : m_data(variant.m_data)
@@ -302,6 +343,20 @@ CVariant::CVariant(CVariant&& rhs) noexcept : m_data(std::move(rhs.m_data))
 {
 }
 
+CVariant::CVariant(VariantType type, CVariantArena& arena) : m_data(Null(&arena))
+{
+  if (type == VariantTypeObject)
+    MakeObject();
+  else if (type == VariantTypeArray)
+    MakeArray();
+  else if (type != VariantTypeNull)
+    *this = CVariant(type);
+}
+
+CVariant::CVariant(Null null) : m_data(null)
+{
+}
+
 CVariant::~CVariant()
 {
   cleanup();
@@ -465,18 +520,39 @@ std::wstring CVariant::asWideString(std::wstring_view fallback /*= L""*/) &&
 }
 
 CVariant& CVariant::operator[](const std::string& key) &
+{
+  return Member(key);
+}
+
+const CVariant& CVariant::operator[](const std::string& key) const&
+{
+  return Member(key);
+}
+
+CVariant CVariant::operator[](const std::string& key) &&
+{
+  return MoveMember(key);
+}
+
+CVariant& CVariant::Member(std::string_view key)
 {
   if (type() == VariantTypeNull)
   {
-    m_data = VariantMap{};
+    MakeObject();
   }
 
-  return std::visit(overloaded{[&](VariantMap& m) -> CVariant& { return m[key]; },
+  return std::visit(overloaded{[&](VariantMap& m) -> CVariant& {
+                                 auto it = m.lower_bound(key);
+                                 if (it == m.end() || it->first != key)
+                                   it = m.emplace_hint(it, key,
+                                                       CVariant(Null(m.get_allocator().GetArena())));
+                                 return it->second;
+                               },
                                [](auto&) -> CVariant& { return ConstNullVariant; }},
                     m_data);
 }
 
-const CVariant& CVariant::operator[](const std::string& key) const&
+const CVariant& CVariant::Member(std::string_view key) const
 {
   return std::visit(overloaded{[&](const VariantMap& m) -> const CVariant& {
                                  auto it = m.find(key);
@@ -486,7 +562,7 @@ const CVariant& CVariant::operator[](const std::string& key) const&
                     m_data);
 }
 
-CVariant CVariant::operator[](const std::string& key) &&
+CVariant CVariant::MoveMember(std::string_view key)
 {
   return std::visit(overloaded{[&](VariantMap& m) -> CVariant {
                                  auto it = m.find(key);
@@ -552,7 +628,7 @@ void CVariant::reserve(size_t length)
 {
   if (type() == VariantTypeNull)
   {
-    m_data = VariantArray{};
+    MakeArray();
   }
   if (type() == VariantTypeArray)
     std::get<VariantArray>(m_data).reserve(length);
@@ -562,7 +638,7 @@ void CVariant::push_back(const CVariant &variant)
 {
   if (type() == VariantTypeNull)
   {
-    m_data = VariantArray{};
+    MakeArray();
   }
 
   if (type() == VariantTypeArray)
@@ -573,7 +649,7 @@ void CVariant::push_back(CVariant &&variant)
 {
   if (type() == VariantTypeNull)
   {
-    m_data = VariantArray{};
+    MakeArray();
   }
 
   if (type() == VariantTypeArray)
@@ -689,21 +765,56 @@ void CVariant::clear()
 
 void CVariant::erase(const std::string &key)
 {
-  std::visit(overloaded{[&](Null&) { m_data = VariantMap{}; }, [&](VariantMap& m) { m.erase(key); },
+  std::visit(overloaded{[&](Null&) { MakeObject(); },
+                        [&](VariantMap& m) {
+                          auto it = m.find(key);
+                          if (it != m.end())
+                            m.erase(it);
+                        },
                         [](const auto&) {}},
              m_data);
 }
 
 void CVariant::erase(unsigned int position)
 {
-  std::visit(overloaded{[&](Null&) { m_data = VariantArray{}; },
+  std::visit(overloaded{[&](Null&) { MakeArray(); },
                         [=](VariantArray& a) { a.erase(a.begin() + position); }, [](auto&) {}},
              m_data);
 }
 
-bool CVariant::isMember(const std::string &key) const
+bool CVariant::isMember(const std::string& key) const
+{
+  return HasMember(key);
+}
+
+bool CVariant::isMember(const char* key) const
+{
+  return HasMember(key);
+}
+
+bool CVariant::HasMember(std::string_view key) const
 {
   return std::visit(overloaded{[&](const VariantMap& m) { return m.find(key) != m.end(); },
                                [](const auto&) { return false; }},
                     m_data);
 }
+
+CVariantArena* CVariant::GetArena() const
+{
+  return std::visit(
+      overloaded{[](const Null& n) { return n.arena; },
+                 [](const VariantMap& m) { return m.get_allocator().GetArena(); },
+                 [](const VariantArray& a) { return a.get_allocator().GetArena(); },
+                 [](const auto&) -> CVariantArena* { return nullptr; }},
+      m_data);
+}
+
+void CVariant::MakeObject()
+{
+  m_data.emplace<VariantMap>(VariantMap::allocator_type(GetArena()));
+}
+
+void CVariant::MakeArray()
+{
+  m_data.emplace<VariantArray>(VariantArray::allocator_type(GetArena()));
+}
@@ -9,9 +9,11 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <stdint.h>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <variant>
 #include <vector>
 #include <wchar.h>
@@ -23,6 +25,90 @@ uint64_t str2uint64(std::wstring_view, uint64_t fallback = 0);
 double str2double(std::string_view, double fallback = 0.0);
 double str2double(std::wstring_view, double fallback = 0.0);
 
+/*!
+ * \brief Memory for building big CVariant trees that are thrown away as a whole.
+ *
+ * Objects and arrays created on an arena take their members from a few large
+ * blocks instead of allocating every member separately. The memory is only
+ * released together with the arena, so the arena has to outlive every variant
+ * that uses it. Copies of such variants allocate from the heap again, moved
+ * variants keep using the arena.
+ */
+class CVariantArena
+{
+public:
+  explicit CVariantArena(size_t blockSize = 16 * 1024);
+  ~CVariantArena();
+
+  CVariantArena(const CVariantArena&) = delete;
+  CVariantArena& operator=(const CVariantArena&) = delete;
+
+  void* Allocate(size_t size, size_t alignment);
+
+  //! number of bytes taken from the heap for the blocks
+  size_t GetReservedBytes() const { return m_reserved; }
+
+private:
+  std::vector<std::unique_ptr<char[]>> m_blocks;
+  char* m_current = nullptr;
+  size_t m_left = 0;
+  size_t m_blockSize;
+  size_t m_reserved = 0;
+};
+
+/*!
+ * \brief Allocator of the CVariant containers, uses the heap unless an arena is given.
+ */
+template<typename T>
+class CVariantAllocator
+{
+public:
+  using value_type = T;
+  // the arena goes with the memory on moves and swaps, copies don't need it
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  CVariantAllocator() noexcept = default;
+  explicit CVariantAllocator(CVariantArena* arena) noexcept : m_arena(arena) {}
+  template<typename U>
+  CVariantAllocator(const CVariantAllocator<U>& other) noexcept : m_arena(other.GetArena())
+  {
+  }
+
+  T* allocate(size_t n)
+  {
+    if (m_arena != nullptr)
+      return static_cast<T*>(m_arena->Allocate(n * sizeof(T), alignof(T)));
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, size_t n) noexcept
+  {
+    // arena memory is released with the arena
+    if (m_arena == nullptr)
+      std::allocator<T>().deallocate(p, n);
+  }
+
+  CVariantAllocator select_on_container_copy_construction() const { return CVariantAllocator(); }
+
+  CVariantArena* GetArena() const { return m_arena; }
+
+  template<typename U>
+  bool operator==(const CVariantAllocator<U>& rhs) const
+  {
+    return m_arena == rhs.GetArena();
+  }
+  template<typename U>
+  bool operator!=(const CVariantAllocator<U>& rhs) const
+  {
+    return m_arena != rhs.GetArena();
+  }
+
+private:
+  CVariantArena* m_arena = nullptr;
+};
+
 #ifdef TARGET_WINDOWS_STORE
 #pragma pack(push)
 #pragma pack(8)
@@ -71,10 +157,15 @@ public:
   CVariant(std::map<std::string, CVariant>&& variantMap);
   CVariant(const CVariant &variant);
   CVariant(CVariant&& rhs) noexcept;
+  /*!
+   * \brief Creates a variant whose object or array members are allocated on the given arena.
+   *
+   * Null variants create their object or array on the arena once members are added, members
+   * added through operator[] use the arena as well.
+   */
+  CVariant(VariantType type, CVariantArena& arena);
   ~CVariant();
 
-
-
   bool isInteger() const;
   bool isSignedInteger() const;
   bool isUnsignedInteger() const;
@@ -103,6 +194,22 @@ public:
   CVariant& operator[](const std::string& key) &;
   const CVariant& operator[](const std::string& key) const&;
   CVariant operator[](const std::string& key) &&;
+  // String literal keys are looked up without creating a std::string
+  template<size_t N>
+  CVariant& operator[](const char (&key)[N]) &
+  {
+    return Member(key);
+  }
+  template<size_t N>
+  const CVariant& operator[](const char (&key)[N]) const&
+  {
+    return Member(key);
+  }
+  template<size_t N>
+  CVariant operator[](const char (&key)[N]) &&
+  {
+    return MoveMember(key);
+  }
   CVariant& operator[](unsigned int position) &;
   const CVariant& operator[](unsigned int position) const&;
   CVariant operator[](unsigned int position) &&;
@@ -123,8 +230,13 @@ public:
   void swap(CVariant& rhs) noexcept;
 
 private:
-  typedef std::vector<CVariant> VariantArray;
-  typedef std::map<std::string, CVariant> VariantMap;
+  typedef std::vector<CVariant, CVariantAllocator<CVariant>> VariantArray;
+  // Transparent comparison looks up keys without creating a std::string for them
+  typedef std::map<std::string,
+                   CVariant,
+                   std::less<>,
+                   CVariantAllocator<std::pair<const std::string, CVariant>>>
+      VariantMap;
 
 public:
   typedef VariantArray::iterator        iterator_array;
@@ -149,16 +261,31 @@ public:
   void erase(const std::string &key);
   void erase(unsigned int position);
 
-  bool isMember(const std::string &key) const;
+  bool isMember(const std::string& key) const;
+  bool isMember(const char* key) const;
 
   static CVariant ConstNullVariant;
 
 private:
   void cleanup();
 
+  CVariant& Member(std::string_view key);
+  const CVariant& Member(std::string_view key) const;
+  CVariant MoveMember(std::string_view key);
+  bool HasMember(std::string_view key) const;
+  CVariantArena* GetArena() const;
+  void MakeObject();
+  void MakeArray();
+
   struct Null
   {
+    Null() noexcept : arena(nullptr) {}
+    explicit Null(CVariantArena* nullArena) noexcept : arena(nullArena) {}
+
     bool operator==(const Null&) const { return true; }
+
+    // arena for the object or array this variant may become
+    CVariantArena* arena;
   };
   struct ConstNull
   {
@@ -178,6 +305,8 @@ private:
                VariantMap>
       m_data;
 
+  explicit CVariant(Null null);
+
   static VariantArray EMPTY_ARRAY;
   static VariantMap EMPTY_MAP;
 };
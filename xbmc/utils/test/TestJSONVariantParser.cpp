@@ -187,3 +187,23 @@ TEST(TestJSONVariantParser, CanParseArray)
   ASSERT_TRUE(variant[0]["foo"].isString());
   ASSERT_STREQ("bar", variant[0]["foo"].asString().c_str());
 }
+
+TEST(TestJSONVariantParser, CanParseIntoArena)
+{
+  CVariantArena arena;
+  CVariant variant;
+  ASSERT_TRUE(CJSONVariantParser::Parse(
+      "{ \"jsonrpc\": \"2.0\", \"params\": { \"items\": [ 1, { \"foo\": \"bar\" } ] } }", variant,
+      arena));
+  ASSERT_TRUE(variant.isObject());
+  ASSERT_STREQ("2.0", variant["jsonrpc"].asString().c_str());
+  ASSERT_TRUE(variant["params"]["items"].isArray());
+  ASSERT_EQ(2U, variant["params"]["items"].size());
+  ASSERT_EQ(1, variant["params"]["items"][0].asInteger());
+  ASSERT_STREQ("bar", variant["params"]["items"][1]["foo"].asString().c_str());
+  ASSERT_GT(arena.GetReservedBytes(), 0U);
+
+  CVariant copy = variant["params"];
+  variant.clear();
+  ASSERT_STREQ("bar", copy["items"][1]["foo"].asString().c_str());
+}
@@ -7,6 +7,7 @@
  */
 
 #include "utils/SortUtils.h"
+#include "utils/StringUtils.h"
 #include "utils/Variant.h"
 
 #include <gtest/gtest.h>
@@ -121,3 +122,88 @@ TEST(TestSortUtils, GetFieldsForSorting)
   EXPECT_EQ(FieldTrackNumber, *it);
   EXPECT_EQ((unsigned int)5, fields.size());
 }
+
+namespace
+{
+SortItemPtr MakeSortItem(const std::string& label, bool folder, SortSpecial special)
+{
+  SortItemPtr item(new SortItem());
+  (*item)[FieldLabel] = label;
+  (*item)[FieldFolder] = folder;
+  (*item)[FieldSortSpecial] = special;
+  return item;
+}
+
+void ExpectSameOrder(const SortDescription& desc, const SortItems& items)
+{
+  SortItems sorted;
+  for (unsigned int i = 0; i < items.size(); i++)
+  {
+    sorted.emplace_back(new SortItem(*items[i]));
+    (*sorted.back())[FieldId] = i;
+  }
+  SortUtils::Sort(desc, sorted);
+
+  CSortTable table(desc);
+  table.Reserve(items.size());
+  for (const auto& item : items)
+  {
+    SortItem copy(*item);
+    table.Add(copy);
+  }
+  const std::vector<size_t> order = table.Sort();
+
+  ASSERT_EQ(order.size(), sorted.size());
+  for (size_t i = 0; i < order.size(); i++)
+  {
+    EXPECT_EQ(order[i], static_cast<size_t>((*sorted[i])[FieldId].asInteger()));
+    EXPECT_EQ(table.GetSortLabel(order[i]), (*sorted[i])[FieldSort].asWideString());
+  }
+}
+} // namespace
+
+TEST(TestSortUtils, SortTable)
+{
+  SortItems items;
+  items.push_back(MakeSortItem("Movie 10", false, SortSpecialNone));
+  items.push_back(MakeSortItem("movie 9", false, SortSpecialNone));
+  items.push_back(MakeSortItem("..", true, SortSpecialOnTop));
+  items.push_back(MakeSortItem("Extras", true, SortSpecialNone));
+  items.push_back(MakeSortItem("The Movie", false, SortSpecialNone));
+  items.push_back(MakeSortItem("Add source", false, SortSpecialOnBottom));
+  items.push_back(MakeSortItem("Movie 9", false, SortSpecialNone));
+  items.push_back(MakeSortItem("[Bonus]", false, SortSpecialNone));
+  items.push_back(MakeSortItem("\xc3\x89t\xc3\xa9", false, SortSpecialNone));
+
+  SortDescription desc;
+  desc.sortBy = SortByLabel;
+  ExpectSameOrder(desc, items);
+
+  desc.sortOrder = SortOrderDescending;
+  ExpectSameOrder(desc, items);
+
+  desc.sortAttributes = static_cast<SortAttribute>(SortAttributeIgnoreFolders |
+                                                   SortAttributeIgnoreArticle);
+  ExpectSameOrder(desc, items);
+
+  desc.limitStart = 2;
+  desc.limitEnd = 6;
+  ExpectSameOrder(desc, items);
+}
+
+TEST(TestSortUtils, SortTableParallel)
+{
+  // Enough items to be sorted on several threads, with many equal labels to check stability
+  SortItems items;
+  for (unsigned int i = 0; i < 20000; i++)
+    items.push_back(MakeSortItem(StringUtils::Format("Track {}", (i * 7919) % 1000), i % 5 == 0,
+                                 SortSpecialNone));
+
+  SortDescription desc;
+  desc.sortBy = SortByLabel;
+  ExpectSameOrder(desc, items);
+
+  desc.sortOrder = SortOrderDescending;
+  ExpectSameOrder(desc, items);
+}
+
@@ -9,6 +9,7 @@
 #include "utils/StringUtils.h"
 
 #include <algorithm>
+#include <vector>
 
 #include <gtest/gtest.h>
 enum class ECG
@@ -356,6 +357,44 @@ TEST(TestStringUtils, AlphaNumericCompare)
   EXPECT_LT(var, ref);
 }
 
+TEST(TestStringUtils, AlphaNumericKey)
+{
+  const std::vector<std::wstring> strings = {
+      L"",         L"0",          L"00",       L"1",          L"2",
+      L"10",       L"0b2",        L"abc",      L"ABC",        L"abd",
+      L"ab",       L"abc 2",      L"abc 10",   L"abc10",      L"[abc]",
+      L"_abc",     L"~",          L"a\u00e9b", L"A\u00c9c",   L"\u00e2",
+      L"zz",       L"4294967294", L"4294967295", L"99999999999", L"The Long Common Prefix A",
+      L"The Long Common Prefix B",
+  };
+
+  std::vector<std::vector<uint32_t>> keys;
+  for (const auto& str : strings)
+  {
+    keys.emplace_back(StringUtils::ALPHANUMERIC_KEY_SIZE);
+    StringUtils::GetAlphaNumericKey(str.c_str(), keys.back().data());
+  }
+
+  // Whenever keys decide the order, it has to be the order of AlphaNumericCompare()
+  for (size_t i = 0; i < strings.size(); i++)
+  {
+    for (size_t j = 0; j < strings.size(); j++)
+    {
+      int64_t result;
+      if (!StringUtils::CompareAlphaNumericKeys(keys[i].data(), keys[j].data(), result))
+        continue;
+
+      const int64_t expected =
+          StringUtils::AlphaNumericCompare(strings[i].c_str(), strings[j].c_str());
+      EXPECT_EQ(result < 0, expected < 0) << i << " " << j;
+      EXPECT_EQ(result > 0, expected > 0) << i << " " << j;
+    }
+  }
+
+  int64_t result;
+  EXPECT_FALSE(StringUtils::CompareAlphaNumericKeys(keys[24].data(), keys[25].data(), result));
+}
+
 TEST(TestStringUtils, TimeStringToSeconds)
 {
   EXPECT_EQ(77455, StringUtils::TimeStringToSeconds("21:30:55"));
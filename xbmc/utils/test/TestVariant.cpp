@@ -360,6 +360,75 @@ TEST(TestVariant, isMember)
   EXPECT_FALSE(a.isMember("key2"));
 }
 
+TEST(TestVariant, memberKeys)
+{
+  CVariant a;
+  const std::string key("key1");
+  a[key] = "string1";
+  a["key2"] = "string2";
+
+  // literal and std::string keys address the same members
+  EXPECT_STREQ("string1", a["key1"].c_str());
+  EXPECT_STREQ("string2", a[std::string("key2")].c_str());
+  EXPECT_EQ(2u, a.size());
+
+  const CVariant& b = a;
+  EXPECT_TRUE(b["key3"].isNull());
+  EXPECT_EQ(2u, a.size());
+
+  EXPECT_EQ("string2", CVariant(a)["key2"].asString());
+  EXPECT_STREQ("string2", a["key2"].c_str());
+
+  std::map<std::string, std::string> strmap;
+  strmap["key1"] = "string1";
+  std::map<std::string, CVariant> variantmap;
+  variantmap["key1"] = CVariant(strmap);
+  CVariant c(std::move(variantmap));
+  EXPECT_STREQ("string1", c["key1"]["key1"].c_str());
+}
+
+TEST(TestVariant, arena)
+{
+  CVariant copy;
+  {
+    CVariantArena arena(256);
+    CVariant a(CVariant::VariantTypeObject, arena);
+    for (int i = 0; i < 100; i++)
+    {
+      CVariant& item = a["items"][std::to_string(i)];
+      item["id"] = i;
+      item["list"].push_back("entry");
+    }
+    a["moved"] = CVariant(CVariant::VariantTypeArray);
+    a["moved"].push_back(1);
+
+    // members added later come from the arena as well
+    EXPECT_GT(arena.GetReservedBytes(), 100u * sizeof(CVariant));
+    EXPECT_EQ(100u, a["items"].size());
+    EXPECT_EQ(42, a["items"]["42"]["id"].asInteger());
+    EXPECT_STREQ("entry", a["items"]["42"]["list"][0].c_str());
+
+    CVariant b(CVariant::VariantTypeArray, arena);
+    b.push_back(a["items"]["1"]);
+    b.swap(a["moved"]);
+    EXPECT_EQ(1, b[0].asInteger());
+    EXPECT_EQ(1, a["moved"][0]["id"].asInteger());
+
+    CVariant null(CVariant::VariantTypeNull, arena);
+    null["key"] = "value";
+    EXPECT_TRUE(null.isObject());
+
+    copy = a;
+    EXPECT_EQ(a, copy);
+  }
+
+  // copies don't use the arena anymore
+  copy["items"]["100"]["id"] = 100;
+  EXPECT_EQ(101u, copy["items"].size());
+  EXPECT_EQ(99, copy["items"]["99"]["id"].asInteger());
+  EXPECT_STREQ("entry", copy["items"]["99"]["list"][0].c_str());
+}
+
 TEST(TestVariant, asBoolean)
 {
   EXPECT_TRUE(CVariant("true").asBoolean());
@@ -57,6 +57,7 @@
 #include "video/windows/GUIWindowVideoBase.h"
 
 #include <algorithm>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <string>
@@ -574,8 +575,8 @@ int CVideoDatabase::GetPathId(const std::string& strPath)
 
     URIUtils::AddSlashAtEnd(strPath1);
 
-    strSQL=PrepareSQL("select idPath from path where strPath='%s'",strPath1.c_str());
-    m_pDS->query(strSQL);
+    strSQL = "select idPath from path where strPath=?";
+    m_pDS->query(strSQL, {dbiplus::field_value(strPath1)});
     if (!m_pDS->eof())
       idPath = m_pDS->fv("path.idPath").get_asInt();
 
@@ -945,9 +946,10 @@ int CVideoDatabase::AddFile(const std::string& strFileNameAndPath,
     if (idPath < 0)
       return -1;
 
-    std::string strSQL=PrepareSQL("select idFile from files where strFileName='%s' and idPath=%i", strFileName.c_str(),idPath);
+    // Run for every scanned file, keep the statements prepared
+    strSQL = "select idFile from files where strFileName=? and idPath=?";
 
-    m_pDS->query(strSQL);
+    m_pDS->query(strSQL, {dbiplus::field_value(strFileName), dbiplus::field_value(idPath)});
     if (m_pDS->num_rows() > 0)
     {
       idFile = m_pDS->fv("idFile").get_asInt() ;
@@ -956,17 +958,18 @@ int CVideoDatabase::AddFile(const std::string& strFileNameAndPath,
     }
     m_pDS->close();
 
-    std::string strPlaycount = "NULL";
+    dbiplus::field_value playCount = dbiplus::null_value();
     if (playcount > 0)
-      strPlaycount = std::to_string(playcount);
-    std::string strLastPlayed = "NULL";
+      playCount = dbiplus::field_value(playcount);
+    dbiplus::field_value lastPlayedDate = dbiplus::null_value();
     if (lastPlayed.IsValid())
-      strLastPlayed = "'" + lastPlayed.GetAsDBDateTime() + "'";
+      lastPlayedDate = dbiplus::field_value(lastPlayed.GetAsDBDateTime());
 
-    strSQL = PrepareSQL("INSERT INTO files (idFile, idPath, strFileName, playCount, lastPlayed, dateAdded) "
-                        "VALUES(NULL, %i, '%s', " + strPlaycount + ", " + strLastPlayed + ", '%s')",
-                        idPath, strFileName.c_str(), finalDateAdded.GetAsDBDateTime().c_str());
-    m_pDS->exec(strSQL);
+    strSQL = "INSERT INTO files (idFile, idPath, strFileName, playCount, lastPlayed, dateAdded) "
+             "VALUES(NULL, ?, ?, ?, ?, ?)";
+    m_pDS->exec(strSQL, {dbiplus::field_value(idPath), dbiplus::field_value(strFileName),
+                         playCount, lastPlayedDate,
+                         dbiplus::field_value(finalDateAdded.GetAsDBDateTime())});
     idFile = (int)m_pDS->lastinsertid();
     return idFile;
   }
@@ -1513,14 +1516,15 @@ int CVideoDatabase::AddToTable(const std::string& table, const std::string& firs
     if (nullptr == m_pDS)
       return -1;
 
-    std::string strSQL = PrepareSQL("select %s from %s where %s like '%s'", firstField.c_str(), table.c_str(), secondField.c_str(), value.substr(0, 255).c_str());
-    m_pDS->query(strSQL);
+    const dbiplus::field_value truncated(value.substr(0, 255));
+    std::string strSQL = PrepareSQL("select %s from %s where %s like ?", firstField.c_str(), table.c_str(), secondField.c_str());
+    m_pDS->query(strSQL, {truncated});
     if (m_pDS->num_rows() == 0)
     {
       m_pDS->close();
       // doesn't exists, add it
-      strSQL = PrepareSQL("insert into %s (%s, %s) values(NULL, '%s')", table.c_str(), firstField.c_str(), secondField.c_str(), value.substr(0, 255).c_str());
-      m_pDS->exec(strSQL);
+      strSQL = PrepareSQL("insert into %s (%s, %s) values(NULL, ?)", table.c_str(), firstField.c_str(), secondField.c_str());
+      m_pDS->exec(strSQL, {truncated});
       int id = (int)m_pDS->lastinsertid();
       return id;
     }
@@ -7744,6 +7748,372 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
   return false;
 }
 
+namespace
+{
+enum class MovieJSONFormat
+{
+  String,
+  Integer,
+  Float,
+  Array,
+  DateTime,
+  Year, // premiered, which is either a date or only a year
+  Premiered,
+  Votes, // votes and rating
+  File, // path and file name
+  Resume, // resume and total time
+  Image,
+};
+
+struct MovieJSONField
+{
+  const char* fieldJSON; // Field name in JSON schema
+  MovieJSONFormat format;
+  int column; // VIDEODB_ID_* column of movie_view, -1 to use SQL instead
+  const char* SQL; // Named column(s) of movie_view or scalar subquery
+};
+
+// clang-format off
+const MovieJSONField JSONtoDBMovie[] = {
+  { "plot",          MovieJSONFormat::String,    VIDEODB_ID_PLOT,          "" },
+  { "plotoutline",   MovieJSONFormat::String,    VIDEODB_ID_PLOTOUTLINE,   "" },
+  { "tagline",       MovieJSONFormat::String,    VIDEODB_ID_TAGLINE,       "" },
+  { "writer",        MovieJSONFormat::Array,     VIDEODB_ID_CREDITS,       "" },
+  { "sorttitle",     MovieJSONFormat::String,    VIDEODB_ID_SORTTITLE,     "" },
+  { "runtime",       MovieJSONFormat::Integer,   VIDEODB_ID_RUNTIME,       "" },
+  { "mpaa",          MovieJSONFormat::String,    VIDEODB_ID_MPAA,          "" },
+  { "top250",        MovieJSONFormat::Integer,   VIDEODB_ID_TOP250,        "" },
+  { "genre",         MovieJSONFormat::Array,     VIDEODB_ID_GENRE,         "" },
+  { "director",      MovieJSONFormat::Array,     VIDEODB_ID_DIRECTOR,      "" },
+  { "originaltitle", MovieJSONFormat::String,    VIDEODB_ID_ORIGINALTITLE, "" },
+  { "studio",        MovieJSONFormat::Array,     VIDEODB_ID_STUDIOS,       "" },
+  { "trailer",       MovieJSONFormat::String,    VIDEODB_ID_TRAILER,       "" },
+  { "country",       MovieJSONFormat::Array,     VIDEODB_ID_COUNTRY,       "" },
+  { "set",           MovieJSONFormat::String,    -1, "movie_view.strSet" },
+  { "setid",         MovieJSONFormat::Integer,   -1, "movie_view.idSet" },
+  { "userrating",    MovieJSONFormat::Integer,   -1, "movie_view.userrating" },
+  { "year",          MovieJSONFormat::Year,      -1, "movie_view.premiered" },
+  { "premiered",     MovieJSONFormat::Premiered, -1, "movie_view.premiered" },
+  { "playcount",     MovieJSONFormat::Integer,   -1, "movie_view.playCount" },
+  { "lastplayed",    MovieJSONFormat::DateTime,  -1, "movie_view.lastPlayed" },
+  { "dateadded",     MovieJSONFormat::DateTime,  -1, "movie_view.dateAdded" },
+  { "rating",        MovieJSONFormat::Float,     -1, "movie_view.rating" },
+  { "votes",         MovieJSONFormat::Votes,     -1, "movie_view.votes, movie_view.rating" },
+  { "imdbnumber",    MovieJSONFormat::String,    -1, "movie_view.uniqueid_value" },
+  { "file",          MovieJSONFormat::File,      -1, "movie_view.strPath, movie_view.strFileName" },
+  { "resume",        MovieJSONFormat::Resume,    -1, "movie_view.resumeTimeInSeconds, movie_view.totalTimeInSeconds" },
+  { "thumbnail",     MovieJSONFormat::Image,     -1, "(SELECT url FROM art WHERE art.media_id = movie_view.idMovie AND art.media_type = 'movie' AND art.type = 'thumb')" },
+  { "fanart",        MovieJSONFormat::Image,     -1, "(SELECT url FROM art WHERE art.media_id = movie_view.idMovie AND art.media_type = 'movie' AND art.type = 'fanart')" },
+};
+// clang-format on
+
+int GetColumnCount(MovieJSONFormat format)
+{
+  switch (format)
+  {
+    case MovieJSONFormat::Votes:
+    case MovieJSONFormat::File:
+    case MovieJSONFormat::Resume:
+      return 2;
+    default:
+      return 1;
+  }
+}
+
+// Only ratings in the valid range are set on a CVideoInfoTag, see CVideoInfoTag::SetRating()
+bool IsValidRating(const dbiplus::field_value& rating)
+{
+  const float value = rating.get_asFloat();
+  return value > 0 && value <= 10;
+}
+} // namespace
+
+bool CVideoDatabase::CanGetMoviesByWhereJSON(const std::set<std::string>& fields)
+{
+  for (const auto& field : fields)
+  {
+    // title is always fetched as it's used as label
+    if (field == "title")
+      continue;
+
+    if (std::none_of(std::begin(JSONtoDBMovie), std::end(JSONtoDBMovie),
+                     [&field](const MovieJSONField& movieField)
+                     { return field == movieField.fieldJSON; }))
+      return false;
+  }
+
+  return true;
+}
+
+bool CVideoDatabase::GetMoviesByWhereJSON(
+    const std::set<std::string>& fields,
+    const std::string& baseDir,
+    std::unique_ptr<CMovieJSONRows>& rows,
+    int& total,
+    const SortDescription& sortDescription /* = SortDescription() */)
+{
+  rows.reset();
+
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS)
+      return false;
+
+    total = -1;
+
+    // parse the base path to get additional filters
+    CVideoDbUrl videoUrl;
+    Filter extFilter;
+    SortDescription sorting = sortDescription;
+    if (!videoUrl.FromString(baseDir) || !GetFilter(videoUrl, extFilter, sorting))
+      return false;
+
+    std::string strSQLExtra;
+    if (!CDatabase::BuildSQL(strSQLExtra, extFilter, strSQLExtra))
+      return false;
+
+    // Apply the limiting directly here if there's no special sorting but limiting
+    if (extFilter.limit.empty() && sorting.sortBy == SortByNone &&
+        (sorting.limitStart > 0 || sorting.limitEnd > 0 ||
+         (sorting.limitStart == 0 && sorting.limitEnd == 0)))
+    {
+      total = GetSingleValueInt("SELECT COUNT(1) FROM movie_view " + strSQLExtra, m_pDS);
+      strSQLExtra += DatabaseUtils::BuildLimitClause(sorting.limitEnd, sorting.limitStart);
+    }
+
+    // Fields always fetched: id, title (used as label) and path (for locks)
+    std::vector<std::string> columns = {
+        "movie_view.idMovie", StringUtils::Format("movie_view.c{:02}", VIDEODB_ID_TITLE),
+        "movie_view.strPath"};
+
+    // Requested fields and the number of their first column in the dataset
+    std::vector<std::pair<size_t, int>> outputFields;
+    int columnCount = static_cast<int>(columns.size());
+    for (size_t i = 0; i < std::size(JSONtoDBMovie); ++i)
+    {
+      const MovieJSONField& field = JSONtoDBMovie[i];
+      if (fields.find(field.fieldJSON) == fields.end())
+        continue;
+
+      outputFields.emplace_back(i, columnCount);
+      if (field.column >= 0)
+        columns.emplace_back(StringUtils::Format("movie_view.c{:02}", field.column));
+      else
+        columns.emplace_back(field.SQL);
+      columnCount += GetColumnCount(field.format);
+    }
+
+    // Fields needed for sorting, these are at the end of the dataset
+    FieldList sortFields;
+    if (!DatabaseUtils::GetSelectFields(SortUtils::GetFieldsForSorting(sortDescription.sortBy),
+                                        MediaTypeMovie, sortFields))
+      sortFields.clear();
+    std::vector<int> sortFieldIndexes;
+    for (const auto& field : sortFields)
+    {
+      sortFieldIndexes.emplace_back(columnCount++);
+      columns.emplace_back(DatabaseUtils::GetField(field, MediaTypeMovie, DatabaseQueryPartSelect));
+    }
+
+    const std::string strSQL =
+        "SELECT " + StringUtils::Join(columns, ", ") + " FROM movie_view " + strSQLExtra;
+
+    auto start = std::chrono::steady_clock::now();
+
+    // the rows are read while the movies are handed out, so they need their own dataset
+    std::unique_ptr<dbiplus::Dataset> pDS(m_pDB->CreateDataset());
+    int iRowsFound = pDS->query(strSQL) ? pDS->num_rows() : -1;
+
+    auto end = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+    CLog::Log(LOGDEBUG, LOGDATABASE, "{} took {} ms for {} items query: {}", __FUNCTION__,
+              duration.count(), iRowsFound, strSQL);
+
+    // store the total value of items
+    if (total < iRowsFound)
+      total = iRowsFound;
+
+    if (iRowsFound <= 0)
+      return iRowsFound == 0;
+
+    DatabaseResults results;
+    results.reserve(iRowsFound);
+    if (!DatabaseUtils::GetDatabaseResults(MediaTypeMovie, sortFields, sortFieldIndexes, pDS,
+                                           results))
+      return false;
+
+    SortDescription sortLimits = sortDescription;
+    if (sortDescription.sortBy == SortByNone)
+    {
+      // already limited by the query
+      sortLimits.limitStart = 0;
+      sortLimits.limitEnd = -1;
+    }
+    SortUtils::Sort(sortLimits, results);
+
+    rows.reset(new CMovieJSONRows(std::move(pDS)));
+    rows->m_rows.reserve(results.size());
+    for (const auto& i : results)
+      rows->m_rows.emplace_back(static_cast<unsigned int>(i.at(FieldRow).asInteger()));
+    rows->m_outputFields = std::move(outputFields);
+    rows->m_outputTitle = fields.find("title") != fields.end();
+    rows->m_checkLocks = m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE &&
+                         !g_passwordManager.bMasterUser;
+    rows->m_itemSeparator =
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator;
+    return true;
+  }
+  catch (...)
+  {
+    rows.reset();
+    CLog::Log(LOGERROR, "{} failed", __FUNCTION__);
+  }
+  return false;
+}
+
+bool CVideoDatabase::GetMoviesByWhereJSON(
+    const std::set<std::string>& fields,
+    const std::string& baseDir,
+    CVariant& result,
+    int& total,
+    const SortDescription& sortDescription /* = SortDescription() */)
+{
+  std::unique_ptr<CMovieJSONRows> rows;
+  if (!GetMoviesByWhereJSON(fields, baseDir, rows, total, sortDescription))
+    return false;
+
+  CVariant& movies = result["movies"];
+  movies = CVariant(CVariant::VariantTypeArray);
+  if (!rows)
+    return true;
+
+  movies.reserve(rows->m_rows.size());
+  CVariant movie;
+  while (rows->GetNext(movie))
+    movies.push_back(std::move(movie));
+
+  return !rows->m_failed;
+}
+
+CVideoDatabase::CMovieJSONRows::CMovieJSONRows(std::unique_ptr<dbiplus::Dataset> pDS)
+  : m_pDS(std::move(pDS))
+{
+}
+
+CVideoDatabase::CMovieJSONRows::~CMovieJSONRows()
+{
+  m_pDS->close();
+}
+
+bool CVideoDatabase::CMovieJSONRows::GetNext(CVariant& movie)
+{
+  try
+  {
+    const query_data& data = m_pDS->get_result_set().records;
+    while (!m_failed && m_next < m_rows.size())
+    {
+      const dbiplus::sql_record* const record = data.at(m_rows[m_next++]);
+
+      if (m_checkLocks &&
+          !g_passwordManager.IsDatabasePathUnlocked(
+              record->at(2).get_asString(),
+              *CMediaSourceSettings::GetInstance().GetSources("video")))
+        continue;
+
+      // Same values as serializing the CVideoInfoTag of GetDetailsForMovie()
+      movie = CVariant(CVariant::VariantTypeObject);
+      movie["movieid"] = record->at(0).get_asInt();
+      movie["label"] = record->at(1).get_asString();
+      if (m_outputTitle)
+        movie["title"] = record->at(1).get_asString();
+
+      for (const auto& outputField : m_outputFields)
+      {
+        const MovieJSONField& field = JSONtoDBMovie[outputField.first];
+        const dbiplus::field_value& value = record->at(outputField.second);
+        CVariant& output = movie[field.fieldJSON];
+        switch (field.format)
+        {
+          case MovieJSONFormat::String:
+            output = value.get_asString();
+            break;
+          case MovieJSONFormat::Integer:
+            output = value.get_asInt();
+            break;
+          case MovieJSONFormat::Float:
+            output = IsValidRating(value) ? value.get_asFloat() : 0.0f;
+            break;
+          case MovieJSONFormat::Array:
+          {
+            const std::string& items = value.get_asString();
+            output = items.empty() ? CVariant(CVariant::VariantTypeArray)
+                                   : CVariant(StringUtils::Split(items, m_itemSeparator));
+            break;
+          }
+          case MovieJSONFormat::DateTime:
+          {
+            CDateTime dateTime;
+            dateTime.SetFromDBDateTime(value.get_asString());
+            output = dateTime.IsValid() ? dateTime.GetAsDBDateTime() : StringUtils::Empty;
+            break;
+          }
+          case MovieJSONFormat::Year:
+          case MovieJSONFormat::Premiered:
+          {
+            const std::string& premiered = value.get_asString();
+            CDateTime date;
+            if (premiered.size() != 4)
+              date.SetFromDBDate(premiered);
+
+            if (field.format == MovieJSONFormat::Premiered)
+              output = date.IsValid() ? date.GetAsDBDate() : StringUtils::Empty;
+            else if (premiered.size() == 4)
+              output = std::max(value.get_asInt(), 0);
+            else
+              output = date.IsValid() ? date.GetYear() : 0;
+            break;
+          }
+          case MovieJSONFormat::Votes:
+          {
+            const bool validRating = IsValidRating(record->at(outputField.second + 1));
+            output = std::to_string(validRating ? value.get_asInt() : 0);
+            break;
+          }
+          case MovieJSONFormat::File:
+          {
+            std::string file;
+            ConstructPath(file, value.get_asString(),
+                          record->at(outputField.second + 1).get_asString());
+            output = file;
+            break;
+          }
+          case MovieJSONFormat::Resume:
+            output["position"] = static_cast<double>(value.get_asInt());
+            output["total"] = static_cast<double>(record->at(outputField.second + 1).get_asInt());
+            break;
+          case MovieJSONFormat::Image:
+          {
+            const std::string& url = value.get_asString();
+            output = url.empty() ? StringUtils::Empty : CTextureUtils::GetWrappedImageURL(url);
+            break;
+          }
+        }
+      }
+
+      return true;
+    }
+  }
+  catch (...)
+  {
+    m_failed = true;
+    CLog::Log(LOGERROR, "{} failed", __FUNCTION__);
+  }
+  return false;
+}
+
 bool CVideoDatabase::GetTvShowsNav(const std::string& strBaseDir, CFileItemList& items,
                                   int idGenre /* = -1 */, int idYear /* = -1 */, int idActor /* = -1 */, int idDirector /* = -1 */, int idStudio /* = -1 */, int idTag /* = -1 */,
                                   const SortDescription &sortDescription /* = SortDescription() */, int getDetails /* = VideoDbDetailsNone */)
@@ -22,6 +22,7 @@
 
 class CFileItem;
 class CFileItemList;
+class CVariant;
 class CVideoSettings;
 class CGUIDialogProgress;
 class CGUIDialogProgressBarHandle;
@@ -881,6 +882,71 @@ public:
   bool GetEpisodesByWhere(const std::string& strBaseDir, const Filter &filter, CFileItemList& items, bool appendFullShowPath = true, const SortDescription &sortDescription = SortDescription(), int getDetails = VideoDbDetailsNone);
   bool GetMusicVideosByWhere(const std::string &baseDir, const Filter &filter, CFileItemList& items, bool checkLocks = true, const SortDescription &sortDescription = SortDescription(), int getDetails = VideoDbDetailsNone);
 
+  /*! \brief Gets movies as JSON-RPC objects straight from the query result
+   Only the columns of the requested properties are queried, no CFileItem or
+   CVideoInfoTag is created. Must only be used if CanGetMoviesByWhereJSON() is
+   true for the properties.
+   \param fields the JSON-RPC properties to fetch
+   \param baseDir the videodb:// path of the movies, including filter options
+   \param result receives the movies in its "movies" member
+   \param total receives the number of movies matching the filter, ignoring limits
+   \param sortDescription sorting and limits to apply
+   \return true on success
+   */
+  bool GetMoviesByWhereJSON(const std::set<std::string>& fields,
+                            const std::string& baseDir,
+                            CVariant& result,
+                            int& total,
+                            const SortDescription& sortDescription = SortDescription());
+
+  /*!
+   \brief Movies found by GetMoviesByWhereJSON(), each one is only created from its result row
+   when it's asked for
+   */
+  class CMovieJSONRows
+  {
+  public:
+    ~CMovieJSONRows();
+    CMovieJSONRows(const CMovieJSONRows&) = delete;
+    CMovieJSONRows& operator=(const CMovieJSONRows&) = delete;
+
+    /*!
+     \brief Get the next movie, skipping those in locked sources
+     \return False if there are no more movies or reading them failed
+     */
+    bool GetNext(CVariant& movie);
+
+  private:
+    friend class CVideoDatabase;
+
+    explicit CMovieJSONRows(std::unique_ptr<dbiplus::Dataset> pDS);
+
+    std::unique_ptr<dbiplus::Dataset> m_pDS;
+    std::vector<unsigned int> m_rows; // result rows in sorted order
+    std::vector<std::pair<size_t, int>> m_outputFields; // field and its first column
+    bool m_outputTitle = false;
+    bool m_checkLocks = false;
+    std::string m_itemSeparator;
+    size_t m_next = 0;
+    bool m_failed = false;
+  };
+
+  /*!
+   \brief Runs the query of GetMoviesByWhereJSON() but leaves creating the movies to the caller
+   \param rows Receives the movies, stays empty if none were found. Must not outlive the database
+   */
+  bool GetMoviesByWhereJSON(const std::set<std::string>& fields,
+                            const std::string& baseDir,
+                            std::unique_ptr<CMovieJSONRows>& rows,
+                            int& total,
+                            const SortDescription& sortDescription = SortDescription());
+
+  /*! \brief Whether all the given JSON-RPC properties can be fetched by GetMoviesByWhereJSON()
+   Properties like cast, art or streamdetails need additional queries and
+   can only be fetched with the full movie details.
+   */
+  static bool CanGetMoviesByWhereJSON(const std::set<std::string>& fields);
+
   // retrieve sorted and limited items
   bool GetSortedVideos(const MediaType &mediaType, const std::string& strBaseDir, const SortDescription &sortDescription, CFileItemList& items, const Filter &filter = Filter());
 
@@ -1133,7 +1199,7 @@ private:
   virtual int GetExportVersion() const { return 1; }
   const char* GetBaseDBName() const override { return "MyVideos"; }
 
-  void ConstructPath(std::string& strDest, const std::string& strPath, const std::string& strFileName);
+  static void ConstructPath(std::string& strDest, const std::string& strPath, const std::string& strFileName);
   void SplitPath(const std::string& strFileNameAndPath, std::string& strPath, std::string& strFileName);
   void InvalidatePathHash(const std::string& strPath);
 
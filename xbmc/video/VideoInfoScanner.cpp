@@ -37,8 +37,11 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "tags/VideoInfoTagLoaderFactory.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
 #include "utils/Digest.h"
 #include "utils/FileExtensionProvider.h"
+#include "utils/JobManager.h"
 #include "utils/RegExp.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -47,6 +50,9 @@
 #include "video/VideoThumbLoader.h"
 
 #include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <utility>
 
 using namespace XFILE;
@@ -99,6 +105,9 @@ namespace VIDEO
 
       auto start = std::chrono::steady_clock::now();
 
+      // the fast hash compares folder modification times, don't let it see stale ones
+      g_directoryCache.ClearStatCache();
+
       m_database.Open();
 
       m_bCanInterrupt = true;
@@ -113,6 +122,11 @@ namespace VIDEO
       m_bCanInterrupt = false;
 
       bool bCancelled = false;
+      const unsigned int scanThreads =
+          CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iVideoLibraryScanThreads;
+      if (scanThreads > 1)
+        bCancelled = !ScanParallel(scanThreads);
+
       while (!bCancelled && !m_pathsToScan.empty())
       {
         /*
@@ -161,6 +175,7 @@ namespace VIDEO
 
       CLog::Log(LOGINFO, "VideoInfoScanner: Finished scan. Scanning for video info took {} ms",
                 duration.count());
+      g_directoryCache.PrintStats();
     }
     catch (...)
     {
@@ -228,13 +243,46 @@ namespace VIDEO
     CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage(msg);
   }
 
-  bool CVideoInfoScanner::DoScan(const std::string& strDirectory)
+  struct CVideoInfoScanner::CDirectoryScan
   {
-    if (m_handle)
-    {
-      m_handle->SetText(g_localizeStrings.Get(20415));
-    }
+    std::string path;
+    ScraperPtr scraper;
+    CONTENT_TYPE content = CONTENT_NONE;
+    SScanSettings settings;
+    bool foundDirectly = false;
+    bool checkExists = false;
+    bool hasDbHash = false;
+    std::string dbHash;
+
+    // filled in by FetchDirectory()
+    bool exists = true;
+    bool noMedia = false;
+    CFileItemList items;
+    std::string hash;
+    std::string fastHash;
+  };
 
+  namespace
+  {
+  struct CFetchState
+  {
+    CCriticalSection section;
+    XbmcThreads::ConditionVariable condition;
+    std::deque<std::shared_ptr<CVideoInfoScanner::CDirectoryScan>> fetched;
+    unsigned int running = 0;
+    bool cancelled = false;
+  };
+
+  const std::vector<std::string>& GetExcludeRegExps(CONTENT_TYPE content)
+  {
+    const auto& advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+    return content == CONTENT_TVSHOWS ? advancedSettings->m_tvshowExcludeFromScanRegExps
+                                      : advancedSettings->m_moviesExcludeFromScanRegExps;
+  }
+  } // namespace
+
+  bool CVideoInfoScanner::DoScan(const std::string& strDirectory)
+  {
     /*
      * Remove this path from the list we're processing. This must be done prior to
      * the check for file or folder exclusion to prevent an infinite while loop
@@ -244,54 +292,188 @@ namespace VIDEO
     if (it != m_pathsToScan.end())
       m_pathsToScan.erase(it);
 
-    // load subfolder
-    CFileItemList items;
-    bool foundDirectly = false;
-    bool bSkip = false;
+    std::shared_ptr<CDirectoryScan> scan = PrepareScan(strDirectory, false);
+    if (!scan)
+      return true;
 
-    SScanSettings settings;
-    ScraperPtr info = m_database.GetScraperForPath(strDirectory, settings, foundDirectly);
-    CONTENT_TYPE content = info ? info->Content() : CONTENT_NONE;
+    FetchDirectory(*scan);
 
-    // exclude folders that match our exclude regexps
-    const std::vector<std::string> &regexps = content == CONTENT_TVSHOWS ? CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowExcludeFromScanRegExps
-                                                         : CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_moviesExcludeFromScanRegExps;
+    std::vector<std::string> subDirs;
+    FinishScan(*scan, subDirs);
 
-    if (CUtil::ExcludeFileOrFolder(strDirectory, regexps))
-      return true;
+    for (const auto& subDir : subDirs)
+    {
+      if (m_bStop)
+        break;
 
-    if (HasNoMedia(strDirectory))
-      return true;
+      if (!DoScan(subDir))
+      {
+        m_bStop = true;
+      }
+    }
+    return !m_bStop;
+  }
 
-    bool ignoreFolder = !m_scanAll && settings.noupdate;
-    if (content == CONTENT_NONE || ignoreFolder)
-      return true;
+  bool CVideoInfoScanner::ScanParallel(unsigned int threads)
+  {
+    CLog::Log(LOGDEBUG, "VideoInfoScanner: Fetching directories with {} threads", threads);
+
+    auto state = std::make_shared<CFetchState>();
+    CJobQueue fetchQueue(false, threads, CJob::PRIORITY_DEDICATED);
+    std::deque<std::string> subDirs;
+    std::set<std::string> started;
+    unsigned int pending = 0;
+
+    while (!m_bStop)
+    {
+      // keep a few directories queued per worker, so that they don't run idle while
+      // this thread is busy scraping and writing to the database
+      while (pending < 2 * threads)
+      {
+        std::string directory;
+        bool root = false;
+        if (!subDirs.empty())
+        {
+          directory = subDirs.front();
+          subDirs.pop_front();
+        }
+        else if (!m_pathsToScan.empty())
+        {
+          directory = *m_pathsToScan.begin();
+          root = true;
+        }
+        else
+          break;
+
+        // subfolders are in m_pathsToScan as well if they are in the database already
+        m_pathsToScan.erase(directory);
+        if (!started.insert(directory).second)
+          continue;
+
+        std::shared_ptr<CDirectoryScan> scan = PrepareScan(directory, root);
+        if (!scan)
+          continue;
+
+        pending++;
+        fetchQueue.Submit([this, scan, state]() {
+          {
+            std::unique_lock<CCriticalSection> lock(state->section);
+            if (state->cancelled)
+              return;
+            state->running++;
+          }
+
+          FetchDirectory(*scan);
+
+          {
+            std::unique_lock<CCriticalSection> lock(state->section);
+            state->running--;
+            state->fetched.push_back(scan);
+          }
+          state->condition.notifyAll();
+        });
+      }
+
+      if (pending == 0)
+        break;
+
+      std::shared_ptr<CDirectoryScan> scan;
+      {
+        std::unique_lock<CCriticalSection> lock(state->section);
+        while (state->fetched.empty() && !m_bStop)
+          state->condition.wait(lock, std::chrono::milliseconds(100));
+
+        if (state->fetched.empty())
+          break;
+
+        scan = state->fetched.front();
+        state->fetched.pop_front();
+      }
+      pending--;
+
+      std::vector<std::string> dirs;
+      FinishScan(*scan, dirs);
+
+      // depth first like the serial scan, keeps the number of queued paths low
+      subDirs.insert(subDirs.begin(), dirs.begin(), dirs.end());
+    }
+
+    // the workers must not touch the scanner anymore once we return
+    {
+      std::unique_lock<CCriticalSection> lock(state->section);
+      state->cancelled = true;
+    }
+    fetchQueue.CancelJobs();
+
+    std::unique_lock<CCriticalSection> lock(state->section);
+    while (state->running > 0)
+      state->condition.wait(lock, std::chrono::milliseconds(100));
+
+    return !m_bStop;
+  }
+
+  std::shared_ptr<CVideoInfoScanner::CDirectoryScan> CVideoInfoScanner::PrepareScan(
+      const std::string& strDirectory, bool checkExists)
+  {
+    auto scan = std::make_shared<CDirectoryScan>();
+    scan->path = strDirectory;
+    scan->checkExists = checkExists;
+    scan->scraper = m_database.GetScraperForPath(strDirectory, scan->settings, scan->foundDirectly);
+    scan->content = scan->scraper ? scan->scraper->Content() : CONTENT_NONE;
+
+    // exclude folders that match our exclude regexps
+    if (CUtil::ExcludeFileOrFolder(strDirectory, GetExcludeRegExps(scan->content)))
+      return {};
+
+    bool ignoreFolder = !m_scanAll && scan->settings.noupdate;
+    if (scan->content == CONTENT_NONE || ignoreFolder)
+      return {};
 
-    if (URIUtils::IsPlugin(strDirectory) && !CPluginDirectory::IsMediaLibraryScanningAllowed(TranslateContent(content), strDirectory))
+    if (URIUtils::IsPlugin(strDirectory) && !CPluginDirectory::IsMediaLibraryScanningAllowed(TranslateContent(scan->content), strDirectory))
     {
       CLog::Log(
           LOGINFO,
           "VideoInfoScanner: Plugin '{}' does not support media library scanning for '{}' content",
-          CURL::GetRedacted(strDirectory), TranslateContent(content));
-      return true;
+          CURL::GetRedacted(strDirectory), TranslateContent(scan->content));
+      return {};
     }
 
-    std::string hash, dbHash;
-    if (content == CONTENT_MOVIES ||content == CONTENT_MUSICVIDEOS)
+    if (scan->content == CONTENT_MOVIES || scan->content == CONTENT_MUSICVIDEOS ||
+        (scan->content == CONTENT_TVSHOWS && scan->foundDirectly &&
+         !scan->settings.parent_name_root))
+      scan->hasDbHash = m_database.GetPathHash(strDirectory, scan->dbHash);
+
+    return scan;
+  }
+
+  void CVideoInfoScanner::FetchDirectory(CDirectoryScan& scan) const
+  {
+    const std::string& strDirectory = scan.path;
+    CFileItemList& items = scan.items;
+
+    if (scan.checkExists && !CDirectory::Exists(strDirectory))
     {
-      if (m_handle)
-      {
-        int str = content == CONTENT_MOVIES ? 20317:20318;
-        m_handle->SetTitle(StringUtils::Format(g_localizeStrings.Get(str), info->Name()));
-      }
+      scan.exists = false;
+      return;
+    }
+
+    if (HasNoMedia(strDirectory))
+    {
+      scan.noMedia = true;
+      return;
+    }
+
+    if (scan.content == CONTENT_MOVIES || scan.content == CONTENT_MUSICVIDEOS)
+    {
+      const std::vector<std::string>& regexps = GetExcludeRegExps(scan.content);
 
       std::string fastHash;
       if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bVideoLibraryUseFastHash && !URIUtils::IsPlugin(strDirectory))
         fastHash = GetFastHash(strDirectory, regexps);
 
-      if (m_database.GetPathHash(strDirectory, dbHash) && !fastHash.empty() && StringUtils::EqualsNoCase(fastHash, dbHash))
+      if (scan.hasDbHash && !fastHash.empty() && StringUtils::EqualsNoCase(fastHash, scan.dbHash))
       { // fast hashes match - no need to process anything
-        hash = fastHash;
+        scan.hash = fastHash;
       }
       else
       { // need to fetch the folder
@@ -307,15 +489,74 @@ namespace VIDEO
 
         // check whether to re-use previously computed fast hash
         if (!CanFastHash(items, regexps) || fastHash.empty())
-          GetPathHash(items, hash);
+          GetPathHash(items, scan.hash);
         else
-          hash = fastHash;
+          scan.hash = fastHash;
+      }
+      scan.fastHash = fastHash;
+    }
+    else if (scan.content == CONTENT_TVSHOWS)
+    {
+      if (scan.foundDirectly && !scan.settings.parent_name_root)
+      {
+        CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
+                                 DIR_FLAG_DEFAULTS);
+        items.SetPath(strDirectory);
+        GetPathHash(items, scan.hash);
+      }
+      else
+      {
+        CFileItemPtr item(new CFileItem(URIUtils::GetFileName(strDirectory)));
+        item->SetPath(strDirectory);
+        item->m_bIsFolder = true;
+        items.Add(item);
+        items.SetPath(URIUtils::GetParentPath(item->GetPath()));
+      }
+    }
+  }
+
+  void CVideoInfoScanner::FinishScan(CDirectoryScan& scan, std::vector<std::string>& subDirs)
+  {
+    const std::string& strDirectory = scan.path;
+    const CONTENT_TYPE content = scan.content;
+    const std::string& hash = scan.hash;
+    const std::string& dbHash = scan.dbHash;
+    CFileItemList& items = scan.items;
+    bool bSkip = false;
+
+    // serial and parallel scans both get here once per directory
+    if (m_handle)
+    {
+      m_handle->SetText(g_localizeStrings.Get(20415));
+    }
+
+    if (!scan.exists)
+    {
+      /*
+       * Note that this will skip clean (if m_bClean is enabled) if the directory really
+       * doesn't exist rather than a NAS being switched off.  A manual clean from settings
+       * will still pick up and remove it though.
+       */
+      CLog::Log(LOGWARNING, "{} directory '{}' does not exist - skipping scan{}.", __FUNCTION__,
+                CURL::GetRedacted(strDirectory), m_bClean ? " and clean" : "");
+      return;
+    }
+
+    if (scan.noMedia)
+      return;
+
+    if (content == CONTENT_MOVIES ||content == CONTENT_MUSICVIDEOS)
+    {
+      if (m_handle)
+      {
+        int str = content == CONTENT_MOVIES ? 20317:20318;
+        m_handle->SetTitle(StringUtils::Format(g_localizeStrings.Get(str), scan.scraper->Name()));
       }
 
       if (StringUtils::EqualsNoCase(hash, dbHash))
       { // hash matches - skipping
         CLog::Log(LOGDEBUG, "VideoInfoScanner: Skipping dir '{}' due to no change{}",
-                  CURL::GetRedacted(strDirectory), !fastHash.empty() ? " (fasthash)" : "");
+                  CURL::GetRedacted(strDirectory), !scan.fastHash.empty() ? " (fasthash)" : "");
         bSkip = true;
       }
       else if (hash.empty())
@@ -342,33 +583,19 @@ namespace VIDEO
     else if (content == CONTENT_TVSHOWS)
     {
       if (m_handle)
-        m_handle->SetTitle(StringUtils::Format(g_localizeStrings.Get(20319), info->Name()));
+        m_handle->SetTitle(StringUtils::Format(g_localizeStrings.Get(20319), scan.scraper->Name()));
 
-      if (foundDirectly && !settings.parent_name_root)
+      if (scan.foundDirectly && !scan.settings.parent_name_root)
       {
-        CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
-                                 DIR_FLAG_DEFAULTS);
-        items.SetPath(strDirectory);
-        GetPathHash(items, hash);
-        bSkip = true;
-        if (!m_database.GetPathHash(strDirectory, dbHash) || !StringUtils::EqualsNoCase(dbHash, hash))
-          bSkip = false;
-        else
+        bSkip = scan.hasDbHash && StringUtils::EqualsNoCase(dbHash, hash);
+        if (bSkip)
           items.Clear();
       }
-      else
-      {
-        CFileItemPtr item(new CFileItem(URIUtils::GetFileName(strDirectory)));
-        item->SetPath(strDirectory);
-        item->m_bIsFolder = true;
-        items.Add(item);
-        items.SetPath(URIUtils::GetParentPath(item->GetPath()));
-      }
     }
 
     if (!bSkip)
     {
-      if (RetrieveVideoInfo(items, settings.parent_name_root, content))
+      if (RetrieveVideoInfo(items, scan.settings.parent_name_root, content))
       {
         if (!m_bStop && (content == CONTENT_MOVIES || content == CONTENT_MUSICVIDEOS))
         {
@@ -399,20 +626,11 @@ namespace VIDEO
     {
       CFileItemPtr pItem = items[i];
 
-      if (m_bStop)
-        break;
-
       // if we have a directory item (non-playlist) we then recurse into that folder
       // do not recurse for tv shows - we have already looked recursively for episodes
-      if (pItem->m_bIsFolder && !pItem->IsParentFolder() && !pItem->IsPlayList() && settings.recurse > 0 && content != CONTENT_TVSHOWS)
-      {
-        if (!DoScan(pItem->GetPath()))
-        {
-          m_bStop = true;
-        }
-      }
+      if (pItem->m_bIsFolder && !pItem->IsParentFolder() && !pItem->IsPlayList() && scan.settings.recurse > 0 && content != CONTENT_TVSHOWS)
+        subDirs.push_back(pItem->GetPath());
     }
-    return !m_bStop;
   }
 
   bool CVideoInfoScanner::RetrieveVideoInfo(CFileItemList& items, bool bDirNames, CONTENT_TYPE content, bool useLocal, CScraperUrl* pURL, bool fetchEpisodes, CGUIDialogProgress* pDlgProgress)
@@ -13,6 +13,7 @@
 #include "addons/Scraper.h"
 #include "guilib/GUIListItem.h"
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -105,10 +106,37 @@ namespace VIDEO
 
     static std::string GetMovieSetInfoFolder(const std::string& setTitle);
 
+    struct CDirectoryScan;
+
   protected:
     virtual void Process();
     bool DoScan(const std::string& strDirectory) override;
 
+    /*! \brief Scan all paths in m_pathsToScan, fetching directory listings and hashes on
+     a pool of worker threads. Lookups and database updates stay on the calling thread.
+     \param threads number of directories to fetch concurrently
+     \return false if the scan was cancelled
+     */
+    bool ScanParallel(unsigned int threads);
+
+    /*! \brief Look up the scraper and stored hash of a directory
+     \param strDirectory the directory to scan
+     \param checkExists whether FetchDirectory() should check that the directory exists
+     \return the scan to pass to FetchDirectory(), or nullptr if the directory is to be skipped
+     */
+    std::shared_ptr<CDirectoryScan> PrepareScan(const std::string& strDirectory, bool checkExists);
+
+    /*! \brief Retrieve the directory listing and hash of a directory.
+     Doesn't access the database and may be called from any thread.
+     */
+    void FetchDirectory(CDirectoryScan& scan) const;
+
+    /*! \brief Retrieve info for a fetched directory and update the database
+     \param scan the fetched directory
+     \param subDirs [out] subfolders that should be scanned next
+     */
+    void FinishScan(CDirectoryScan& scan, std::vector<std::string>& subDirs);
+
     INFO_RET RetrieveInfoForTvShow(CFileItem *pItem, bool bDirNames, ADDON::ScraperPtr &scraper, bool useLocal, CScraperUrl* pURL, bool fetchEpisodes, CGUIDialogProgress* pDlgProgress);
     INFO_RET RetrieveInfoForMovie(CFileItem *pItem, bool bDirNames, ADDON::ScraperPtr &scraper, bool useLocal, CScraperUrl* pURL, CGUIDialogProgress* pDlgProgress);
     INFO_RET RetrieveInfoForMusicVideo(CFileItem *pItem, bool bDirNames, ADDON::ScraperPtr &scraper, bool useLocal, CScraperUrl* pURL, CGUIDialogProgress* pDlgProgress);
@@ -16,10 +16,12 @@
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIControlFactory.h"
 #include "guilib/GUIControlProfiler.h"
+#include "guilib/GUIFrameProfiler.h"
 #include "guilib/GUIFontManager.h"
 #include "guilib/GUITextLayout.h"
 #include "guilib/GUIWindowManager.h"
 #include "input/WindowTranslator.h"
+#include "rendering/RenderSystem.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/CPUInfo.h"
@@ -129,6 +131,19 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
                                    .GetFPS(),
                                strCores, ucAppName, dCPU, profiling);
 #endif
+
+    const GUIDrawStats& drawStats = CServiceBroker::GetRenderSystem()->GetGUIDrawStats();
+    if (drawStats.drawCalls > 0)
+      info += StringUtils::Format("\nGUI: {} draw calls - {} textures - {} quads",
+                                  drawStats.drawCalls, drawStats.textures, drawStats.quads);
+
+    if (CGUIFrameProfiler::IsRunning())
+    {
+      const CGUIFrameProfiler& profiler = CGUIFrameProfiler::Instance();
+      info += StringUtils::Format("\nFRAMES: {} of {} over {} ms budget",
+                                  profiler.GetFramesOverBudget(), profiler.GetFrameCount(),
+                                  profiler.GetFrameBudget());
+    }
   }
 
   // render the skin debug info